@@ -0,0 +1,81 @@
+#include "admission.h"
+
+#include <algorithm>
+
+#include "neural_network/neuron.h"
+#include "simulation/animal.h"
+#include "simulation/food.h"
+#include "simulation/statistics.h"
+
+namespace cshorelark::optimizer_cli {
+
+namespace {
+
+constexpr std::size_t k_allocation_overhead = 16;  // Bookkeeping per heap block
+constexpr std::size_t k_log_json_bytes = 512;       // Serialized config, context and stats
+
+auto heap_block(std::size_t bytes) -> std::size_t { return bytes + k_allocation_overhead; }
+
+}  // namespace
+
+auto estimate_footprint(const simulation::config& config) -> std::size_t {
+    const std::size_t cells = config.brain_eye.num_cells;
+    const std::size_t neurons = config.brain_eye.num_neurons;
+    constexpr std::size_t k_outputs = 2;
+
+    // Network: one block per neuron for its bias and weights, plus the layer arrays
+    const std::size_t network =
+        neurons * heap_block((cells + 1) * sizeof(float)) +
+        k_outputs * heap_block((neurons + 1) * sizeof(float)) +
+        heap_block((neurons + k_outputs) * sizeof(neural_network::neuron<float>));
+    const std::size_t weights = (cells + 1) * neurons + (neurons + 1) * k_outputs;
+
+    // Vision and the brain's last-input cache, then the parent and child chromosomes
+    // that exist together while a generation is evolved
+    const std::size_t per_animal = sizeof(simulation::animal) + network +
+                                   2 * heap_block(cells * sizeof(float)) +
+                                   2 * heap_block(weights * sizeof(float));
+
+    return config.world.num_animals * per_animal +
+           config.world.num_foods * sizeof(simulation::food);
+}
+
+auto estimate_log_bytes(std::size_t generations) -> std::size_t {
+    return generations * (sizeof(simulation::config) + sizeof(simulation::statistics) +
+                          4 * sizeof(std::size_t) + k_log_json_bytes);
+}
+
+memory_admission::memory_admission(std::size_t budget, std::size_t max_in_flight) noexcept
+    : budget_(budget == 0 ? std::numeric_limits<std::size_t>::max() : budget),
+      max_in_flight_(std::max<std::size_t>(max_in_flight, 1)) {}
+
+auto memory_admission::select(const std::vector<std::size_t>& pending) const
+    -> std::optional<std::size_t> {
+    if (pending.empty() || in_flight_ >= max_in_flight_) {
+        return std::nullopt;
+    }
+    const std::size_t available = used_ < budget_ ? budget_ - used_ : 0;
+    for (std::size_t position = 0; position < pending.size(); ++position) {
+        if (pending[position] <= available) {
+            return position;
+        }
+    }
+    // Nothing fits even an idle budget, run the next unit alone rather than never
+    if (in_flight_ == 0) {
+        return 0;
+    }
+    return std::nullopt;
+}
+
+void memory_admission::admit(std::size_t footprint) noexcept {
+    used_ += footprint;
+    peak_ = std::max(peak_, used_);
+    ++in_flight_;
+}
+
+void memory_admission::release(std::size_t footprint) noexcept {
+    used_ -= std::min(footprint, used_);
+    --in_flight_;
+}
+
+}  // namespace cshorelark::optimizer_cli
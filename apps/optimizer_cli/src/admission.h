@@ -0,0 +1,89 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_ADMISSION_H
+#define CSHORELARK_OPTIMIZER_CLI_ADMISSION_H
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "simulation/config.h"
+
+namespace cshorelark::optimizer_cli {
+
+/**
+ * @brief Estimates the memory held by one running simulation
+ *
+ * Counts the animals with their brains, vision and the chromosomes built
+ * while evolving, and the foods. Allocator overhead is included per
+ * allocation, so the estimate errs on the high side.
+ *
+ * @param config Simulation configuration
+ * @return Estimated footprint in bytes
+ */
+auto estimate_footprint(const simulation::config& config) -> std::size_t;
+
+/**
+ * @brief Estimates the memory the log of one simulation keeps until the sweep ends
+ *
+ * @param generations Generations simulated
+ * @return Estimated log volume in bytes, including its JSON form when saved
+ */
+auto estimate_log_bytes(std::size_t generations) -> std::size_t;
+
+/**
+ * @brief Decides which work units may start under a memory budget
+ *
+ * Not thread-safe, the runner guards it with its own mutex.
+ */
+class memory_admission {
+public:
+    /**
+     * @brief Creates the controller
+     *
+     * @param budget Bytes running units may use together, 0 for no limit
+     * @param max_in_flight Maximum number of units running at once
+     */
+    memory_admission(std::size_t budget, std::size_t max_in_flight) noexcept;
+
+    /**
+     * @brief Picks the unit to start next
+     *
+     * Takes the first pending unit that fits in the remaining budget, so when
+     * the next large unit does not fit, smaller ones behind it keep the
+     * workers busy. A unit larger than the whole budget is admitted only when
+     * nothing else runs.
+     *
+     * @param pending Footprints of the pending units, in scheduling order
+     * @return Position of the unit to start, or nothing if none may start yet
+     */
+    [[nodiscard]] auto select(const std::vector<std::size_t>& pending) const
+        -> std::optional<std::size_t>;
+
+    /**
+     * @brief Records that a unit started
+     * @param footprint Footprint of the unit
+     */
+    void admit(std::size_t footprint) noexcept;
+
+    /**
+     * @brief Records that a unit finished
+     * @param footprint Footprint of the unit
+     */
+    void release(std::size_t footprint) noexcept;
+
+    [[nodiscard]] auto budget() const noexcept -> std::size_t { return budget_; }
+    [[nodiscard]] auto used() const noexcept -> std::size_t { return used_; }
+    [[nodiscard]] auto peak() const noexcept -> std::size_t { return peak_; }
+    [[nodiscard]] auto in_flight() const noexcept -> std::size_t { return in_flight_; }
+
+private:
+    std::size_t budget_;         ///< Bytes available to running units
+    std::size_t max_in_flight_;  ///< Maximum number of running units
+    std::size_t used_ = 0;       ///< Bytes of the running units
+    std::size_t peak_ = 0;       ///< Highest value of used_ so far
+    std::size_t in_flight_ = 0;  ///< Number of running units
+};
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_ADMISSION_H
@@ -0,0 +1,215 @@
+#include "autotune.h"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <utility>
+
+#include "random/random.h"
+#include "simulation/animal.h"
+#include "simulation/simulation.h"
+
+namespace cshorelark::optimizer_cli {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr int k_cache_version = 2;
+constexpr std::size_t k_warmup_steps = 4;
+constexpr std::size_t k_timed_steps = 32;
+constexpr std::size_t k_rounds = 3;
+constexpr std::uint64_t k_timing_seed = 0x5eed;
+
+constexpr std::array<std::pair<std::string_view, simulation::collision_kernel>, 2>
+    k_collision_names = {{{"brute-force", simulation::collision_kernel::k_brute_force},
+                          {"grid", simulation::collision_kernel::k_grid}}};
+constexpr std::array<std::pair<std::string_view, simulation::vision_kernel>, 2> k_vision_names = {
+    {{"brute-force", simulation::vision_kernel::k_brute_force},
+     {"grid", simulation::vision_kernel::k_grid}}};
+constexpr std::array<std::pair<std::string_view, simulation::inference_kernel>, 3>
+    k_inference_names = {{{"generic", simulation::inference_kernel::k_generic},
+                          {"jit", simulation::inference_kernel::k_jit},
+                          {"jit-embedded", simulation::inference_kernel::k_jit_embedded}}};
+
+template <typename Kernel, std::size_t N>
+auto kernel_from_name(const std::array<std::pair<std::string_view, Kernel>, N>& names,
+                      std::string_view text) -> std::optional<Kernel> {
+    for (const auto& [name, kernel] : names) {
+        if (name == text) {
+            return kernel;
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename Kernel, std::size_t N>
+auto kernel_name(const std::array<std::pair<std::string_view, Kernel>, N>& names, Kernel kernel)
+    -> std::string_view {
+    for (const auto& [name, value] : names) {
+        if (value == kernel) {
+            return name;
+        }
+    }
+    return names.front().first;
+}
+
+}  // namespace
+
+auto parse_kernels(std::string_view text)
+    -> tl::expected<std::optional<simulation::kernel_config>, std::string> {
+    if (text == "auto") {
+        return std::nullopt;
+    }
+    const auto comma = text.find(',');
+    const auto collisions = kernel_from_name(k_collision_names, text.substr(0, comma));
+    std::optional<simulation::vision_kernel> vision;
+    std::optional<simulation::inference_kernel> inference = simulation::inference_kernel::k_generic;
+    if (comma != std::string_view::npos) {
+        const auto rest = text.substr(comma + 1);
+        const auto second_comma = rest.find(',');
+        vision = kernel_from_name(k_vision_names, rest.substr(0, second_comma));
+        if (second_comma != std::string_view::npos) {
+            inference = kernel_from_name(k_inference_names, rest.substr(second_comma + 1));
+        }
+    }
+    if (!collisions || !vision || !inference) {
+        return tl::make_unexpected(
+            "Kernels must be auto or <collisions>,<vision>[,<inference>] with brute-force or "
+            "grid and generic, jit or jit-embedded, got '" +
+            std::string(text) + "'");
+    }
+    simulation::kernel_config kernels;
+    kernels.collisions = *collisions;
+    kernels.vision = *vision;
+    kernels.inference = *inference;
+    return kernels;
+}
+
+auto to_string(const simulation::kernel_config& kernels) -> std::string {
+    auto text = fmt::format("{},{}", kernel_name(k_collision_names, kernels.collisions),
+                            kernel_name(k_vision_names, kernels.vision));
+    // Generic inference is the default and left out
+    if (kernels.inference != simulation::inference_kernel::k_generic) {
+        text += fmt::format(",{}", kernel_name(k_inference_names, kernels.inference));
+    }
+    return text;
+}
+
+auto shape_key(const simulation::config& config) -> std::string {
+    return fmt::format("a{}-f{}-r{}-v{}-d{}-c{}-n{}-m{}", config.world.num_animals,
+                       config.world.num_foods, config.brain_eye.fov_range,
+                       config.brain_eye.fov_angle_deg,
+                       config.world.food_size + config.world.bird_size,
+                       config.brain_eye.num_cells, config.brain_eye.num_neurons,
+                       config.brain_eye.cache_last_input ? 1 : 0);
+}
+
+auto time_kernels(const simulation::config& config, const simulation::kernel_config& kernels)
+    -> double {
+    auto timed_config = config;
+    timed_config.kernels = kernels;
+    cshorelark::random::random_generator random(k_timing_seed);
+    auto sim = simulation::simulation::random(timed_config, random);
+
+    for (std::size_t step = 0; step < k_warmup_steps; ++step) {
+        sim.advance(random);
+    }
+    double best = std::numeric_limits<double>::max();
+    for (std::size_t round = 0; round < k_rounds; ++round) {
+        const auto started_at = std::chrono::steady_clock::now();
+        for (std::size_t step = 0; step < k_timed_steps; ++step) {
+            sim.advance(random);
+        }
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - started_at;
+        best = std::min(best, elapsed.count() / static_cast<double>(k_timed_steps));
+    }
+    return best;
+}
+
+kernel_autotuner::kernel_autotuner(std::filesystem::path cache_path)
+    : cache_path_(std::move(cache_path)) {
+    if (cache_path_.empty() || !std::filesystem::exists(cache_path_)) {
+        return;
+    }
+    try {
+        std::ifstream file(cache_path_);
+        const json cache = json::parse(file);
+        if (cache.value("version", 0) != k_cache_version) {
+            spdlog::warn("Ignoring kernel cache {} from another version", cache_path_.string());
+            return;
+        }
+        for (const auto& [key, entry] : cache.at("shapes").items()) {
+            auto kernels = parse_kernels(entry.at("kernels").get<std::string>());
+            if (kernels && *kernels) {
+                chosen_.emplace(key, **kernels);
+            }
+        }
+    } catch (const std::exception& e) {
+        spdlog::warn("Ignoring unreadable kernel cache {}: {}", cache_path_.string(), e.what());
+        chosen_.clear();
+    }
+}
+
+auto kernel_autotuner::choose(const simulation::config& config) -> simulation::kernel_config {
+    const auto key = shape_key(config);
+    if (const auto found = chosen_.find(key); found != chosen_.end()) {
+        ++cached_;
+        return found->second;
+    }
+
+    simulation::kernel_config fastest;
+    double fastest_time = std::numeric_limits<double>::max();
+    for (const auto& [collision_name, collisions] : k_collision_names) {
+        for (const auto& [vision_name, vision] : k_vision_names) {
+            for (const auto& [inference_name, inference] : k_inference_names) {
+                simulation::kernel_config kernels;
+                kernels.collisions = collisions;
+                kernels.vision = vision;
+                kernels.inference = inference;
+                const double seconds = time_kernels(config, kernels);
+                spdlog::debug("Shape {}: {} takes {:.1f} us per step", key, to_string(kernels),
+                              seconds * 1e6);
+                if (seconds < fastest_time) {
+                    fastest_time = seconds;
+                    fastest = kernels;
+                }
+            }
+        }
+    }
+    spdlog::info("Shape {}: using {} ({:.1f} us per step)", key, to_string(fastest),
+                 fastest_time * 1e6);
+    chosen_.emplace(key, fastest);
+    ++tuned_;
+    return fastest;
+}
+
+auto kernel_autotuner::knows(const simulation::config& config) const -> bool {
+    return chosen_.count(shape_key(config)) > 0;
+}
+
+auto kernel_autotuner::save() const -> tl::expected<void, std::string> {
+    if (cache_path_.empty() || tuned_ == 0) {
+        return {};
+    }
+    json shapes = json::object();
+    for (const auto& [key, kernels] : chosen_) {
+        shapes[key] = {{"kernels", to_string(kernels)}};
+    }
+    std::ofstream file(cache_path_);
+    if (!file) {
+        return tl::make_unexpected("Failed to open kernel cache: " + cache_path_.string());
+    }
+    file << json{{"version", k_cache_version}, {"shapes", shapes}}.dump(2);
+    return {};
+}
+
+}  // namespace cshorelark::optimizer_cli
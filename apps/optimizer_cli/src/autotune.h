@@ -0,0 +1,110 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_AUTOTUNE_H
+#define CSHORELARK_OPTIMIZER_CLI_AUTOTUNE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tl/expected.hpp>
+
+#include "simulation/config.h"
+
+namespace cshorelark::optimizer_cli {
+
+/**
+ * @brief Parses a kernel selection: "auto", or collisions and vision kernels as "grid,brute-force"
+ *
+ * An optional third part selects brain inference, "grid,grid,jit"; generic when left out.
+ *
+ * @param text Kernel selection
+ * @return Nothing for "auto", the fixed kernels otherwise, or an error message
+ */
+auto parse_kernels(std::string_view text)
+    -> tl::expected<std::optional<simulation::kernel_config>, std::string>;
+
+/**
+ * @brief Formats kernels like parse_kernels expects them
+ */
+auto to_string(const simulation::kernel_config& kernels) -> std::string;
+
+/**
+ * @brief Gets the key of a configuration's shape
+ *
+ * Two configurations with the same key do the same work per step, so the
+ * fastest kernels of one are the fastest of the other.
+ *
+ * @param config Simulation configuration
+ * @return Shape key
+ */
+auto shape_key(const simulation::config& config) -> std::string;
+
+/**
+ * @brief Times world steps of a configuration with the given kernels
+ *
+ * @param config Simulation configuration, its kernels are replaced
+ * @param kernels Kernels to time
+ * @return Best time per step over a few rounds, in seconds
+ */
+auto time_kernels(const simulation::config& config, const simulation::kernel_config& kernels)
+    -> double;
+
+/**
+ * @brief Picks the fastest kernels per configuration shape and remembers them on disk
+ *
+ * Decisions are only valid for the machine that measured them, so the cache
+ * belongs next to the sweeps run there.
+ */
+class kernel_autotuner {
+public:
+    /**
+     * @brief Creates the tuner, loading earlier decisions if the cache exists
+     *
+     * @param cache_path Decision cache, empty to keep decisions in memory only
+     */
+    explicit kernel_autotuner(std::filesystem::path cache_path);
+
+    /**
+     * @brief Gets the kernels for a configuration, timing every combination if its shape is new
+     *
+     * @param config Simulation configuration
+     * @return Fastest kernels for the configuration's shape
+     */
+    auto choose(const simulation::config& config) -> simulation::kernel_config;
+
+    /**
+     * @brief Tells whether choose() answers for a configuration without timing anything
+     *
+     * @param config Simulation configuration
+     * @return True if the configuration's shape was decided already
+     */
+    [[nodiscard]] auto knows(const simulation::config& config) const -> bool;
+
+    /**
+     * @brief Writes the decisions back to the cache if any were added
+     *
+     * @return Expected containing nothing or error message
+     */
+    [[nodiscard]] auto save() const -> tl::expected<void, std::string>;
+
+    /**
+     * @brief Gets the number of shapes timed since the tuner was created
+     */
+    [[nodiscard]] auto tuned() const noexcept -> std::size_t { return tuned_; }
+
+    /**
+     * @brief Gets the number of shapes answered from the cache
+     */
+    [[nodiscard]] auto cached() const noexcept -> std::size_t { return cached_; }
+
+private:
+    std::filesystem::path cache_path_;                         ///< Decision cache
+    std::map<std::string, simulation::kernel_config> chosen_;  ///< Decisions by shape key
+    std::size_t tuned_ = 0;                                    ///< Shapes timed
+    std::size_t cached_ = 0;                                   ///< Shapes found in the cache
+};
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_AUTOTUNE_H
@@ -6,21 +6,33 @@
 #include <filesystem>
 #include <string>
 #include <tl/expected.hpp>
+#include <vector>
 
+#include "autotune.h"
 #include "constants.h"
+#include "daemon.h"
+#include "placement.h"
+#include "shard.h"
 
 namespace cshorelark::optimizer_cli {
 
 auto parse_args(int argc, char* argv[]) -> tl::expected<cli_args, std::string> {
     args::ArgumentParser parser("Neural network optimizer CLI");
     parser.Prog(argv[0]);
-    parser.ProglinePostfix("{analyze|simulate}");
+    parser.ProglinePostfix("{analyze|simulate|evaluate|merge|diverge|daemon}");
     args::HelpFlag help(parser, "help", "Display this help message", {'h', "help"});
 
     // Define subcommands
     args::Command analyze_cmd(parser, "analyze", "Analyze optimization results");
     args::Command simulate_cmd(parser, "simulate",
                                "Run simulation for neural network optimization");
+    args::Command evaluate_cmd(parser, "evaluate",
+                               "Score fixed genomes on seeded episodes without evolving them");
+    args::Command merge_cmd(parser, "merge", "Merge the logs of a sharded simulate sweep");
+    args::Command diverge_cmd(parser, "diverge",
+                              "Find the first step where two runs' world digests differ");
+    args::Command daemon_cmd(parser, "daemon",
+                             "Run submitted simulate sweeps on one shared worker pool");
 
     // Arguments for analyze command
     args::ValueFlag<std::string> analyze_input_path(analyze_cmd, "input",
@@ -41,6 +53,103 @@ auto parse_args(int argc, char* argv[]) -> tl::expected<cli_args, std::string> {
         simulate_cmd, "generations", "Number of generations to simulate", {'g', "generations"},
         cshorelark::optimizer_cli::constants::k_default_generations);
 
+    args::ValueFlag<std::string> shard(simulate_cmd, "shard",
+                                       "Run only shard i of n of the sweep, as i/n", {"shard"},
+                                       "0/1");
+    args::ValueFlag<std::uint64_t> simulate_seed(
+        simulate_cmd, "seed", "Sweep seed, shards of one sweep must share it", {'s', "seed"});
+    args::ValueFlag<std::string> placement(
+        simulate_cmd, "placement",
+        "Worker thread placement: none, compact, scatter or per-node (NUMA pools)",
+        {"placement"}, "none");
+    args::ValueFlag<std::size_t> memory_budget(
+        simulate_cmd, "MiB",
+        "Memory the sweep may use, simulations only start when they fit (0 for no limit)",
+        {'m', "memory-budget"}, 0);
+    args::ValueFlag<std::size_t> interleave(
+        simulate_cmd, "count",
+        "Simulations each worker steps in turns, with their generation ends staggered so "
+        "evolution and logging of one overlap stepping of the others",
+        {"interleave"}, 1);
+    args::ValueFlag<std::string> kernels(
+        simulate_cmd, "kernels",
+        "Hot path kernels: auto to autotune, or <collisions>,<vision>[,<inference>] from "
+        "brute-force and grid, and generic, jit or jit-embedded",
+        {"kernels"}, "auto");
+    args::ValueFlag<std::string> kernel_cache(simulate_cmd, "path",
+                                              "Autotuner decisions per config shape",
+                                              {"kernel-cache"}, "kernel_cache.json");
+    args::ValueFlag<std::string> digests(
+        simulate_cmd, "dir", "Write a world digest stream per simulation to this directory",
+        {"digests"});
+    args::ValueFlag<std::string> lineage(
+        simulate_cmd, "dir",
+        "Archive every generation of each simulation to this directory, delta-compressed "
+        "against the parents (readable as genomes by evaluate and --warm-start)",
+        {"lineage"});
+    args::ValueFlag<std::string> warm_start(
+        simulate_cmd, "genomes",
+        "Start every simulation from this population (JSON or .bpack, as for evaluate), "
+        "fitted to each configuration's brain",
+        {"warm-start"});
+    args::ValueFlag<float> target_fitness(
+        simulate_cmd, "fitness",
+        "With --warm-start, report the generations saved to reach this average fitness "
+        "(runs each unit once more from a random start)",
+        {"target-fitness"});
+    args::ValueFlag<std::uint16_t> metrics_port(
+        simulate_cmd, "port",
+        "Serve Prometheus metrics of the running sweep on http://127.0.0.1:<port>/metrics",
+        {"metrics-port"});
+    args::ValueFlag<std::uint16_t> daemon_port(
+        simulate_cmd, "port",
+        "Run the sweep on the daemon listening on 127.0.0.1:<port> instead of locally",
+        {"daemon"});
+    args::ValueFlag<unsigned> priority(
+        simulate_cmd, "priority",
+        "With --daemon, share of the daemon's workers relative to other jobs, from 1 to 100",
+        {"priority"}, k_default_priority);
+
+    // Arguments for evaluate command
+    args::ValueFlag<std::string> evaluate_input_path(
+        evaluate_cmd, "input", "Path to JSON file with the genomes to evaluate", {'i', "input"},
+        args::Options::Required);
+    args::ValueFlag<std::string> evaluate_output_path(
+        evaluate_cmd, "output", "Path to save the evaluation report", {'o', "output"},
+        "evaluation.json");
+    args::ValueFlag<std::size_t> episodes(evaluate_cmd, "episodes", "Number of seeded episodes",
+                                          {'e', "episodes"},
+                                          cshorelark::optimizer_cli::constants::k_default_episodes);
+    args::ValueFlag<std::uint64_t> seed(evaluate_cmd, "seed", "Base seed of the episodes",
+                                        {'s', "seed"}, 0);
+    args::ValueFlag<std::size_t> threads(evaluate_cmd, "threads",
+                                         "Worker threads, 0 for one per core", {'t', "threads"}, 0);
+
+    // Arguments for merge command
+    args::ValueFlag<std::string> merge_output_path(merge_cmd, "output",
+                                                   "Path to save the merged log", {'o', "output"},
+                                                   args::Options::Required);
+    args::PositionalList<std::string> merge_input_paths(merge_cmd, "inputs", "Shard logs to merge",
+                                                        args::Options::Required);
+
+    // Arguments for diverge command
+    args::Positional<std::string> diverge_reference(
+        diverge_cmd, "reference", "Digest stream or directory of the reference run",
+        args::Options::Required);
+    args::Positional<std::string> diverge_candidate(
+        diverge_cmd, "candidate", "Digest stream or directory of the run under test",
+        args::Options::Required);
+
+    // Arguments for daemon command
+    args::ValueFlag<std::uint16_t> listen_port(daemon_cmd, "port", "Port to accept jobs on",
+                                               {'p', "port"}, k_default_daemon_port);
+    args::ValueFlag<std::size_t> daemon_workers(
+        daemon_cmd, "workers", "Worker threads shared by all jobs, 0 for one per core",
+        {'w', "workers"}, 0);
+    args::ValueFlag<std::string> daemon_kernel_cache(daemon_cmd, "path",
+                                                     "Autotuner decisions per config shape",
+                                                     {"kernel-cache"}, "kernel_cache.json");
+
     try {
         parser.ParseCLI(argc, argv);
     } catch (const args::Help&) {
@@ -69,10 +178,114 @@ auto parse_args(int argc, char* argv[]) -> tl::expected<cli_args, std::string> {
         args_data.iterations = args::get(iterations);
         args_data.generations = args::get(generations);
 
+        auto shard_spec = parse_shard(args::get(shard));
+        if (!shard_spec) {
+            return tl::make_unexpected("Invalid argument: " + shard_spec.error());
+        }
+        args_data.shard = *shard_spec;
+        if (simulate_seed) {
+            args_data.seed = args::get(simulate_seed);
+        }
+
+        auto placement_spec = parse_placement(args::get(placement));
+        if (!placement_spec) {
+            return tl::make_unexpected("Invalid argument: " + placement_spec.error());
+        }
+        args_data.placement = *placement_spec;
+        args_data.memory_budget_mib = args::get(memory_budget);
+        args_data.interleave = args::get(interleave);
+        if (args_data.interleave == 0) {
+            return tl::make_unexpected(
+                std::string("Invalid argument: --interleave must be at least 1"));
+        }
+
+        auto kernel_spec = parse_kernels(args::get(kernels));
+        if (!kernel_spec) {
+            return tl::make_unexpected("Invalid argument: " + kernel_spec.error());
+        }
+        args_data.kernels = *kernel_spec;
+        args_data.kernel_cache = std::filesystem::path(args::get(kernel_cache));
+        if (digests) {
+            args_data.digest_dir = std::filesystem::path(args::get(digests));
+        }
+        if (lineage) {
+            args_data.lineage_dir = std::filesystem::path(args::get(lineage));
+        }
+        if (warm_start) {
+            args_data.warm_start = std::filesystem::path(args::get(warm_start));
+        }
+        if (target_fitness) {
+            if (!warm_start) {
+                return tl::make_unexpected(
+                    std::string("Invalid argument: --target-fitness needs --warm-start"));
+            }
+            args_data.target_fitness = args::get(target_fitness);
+        }
+        if (metrics_port) {
+            args_data.metrics_port = args::get(metrics_port);
+        }
+        if (daemon_port) {
+            // The daemon's workers run the sweep, local run options have nothing to apply to
+            if (warm_start || digests || lineage || metrics_port || placement || memory_budget ||
+                interleave) {
+                return tl::make_unexpected(std::string(
+                    "Invalid argument: --daemon cannot be combined with --warm-start, "
+                    "--digests, --lineage, --metrics-port, --placement, --memory-budget or "
+                    "--interleave"));
+            }
+            args_data.daemon_port = args::get(daemon_port);
+        }
+        args_data.priority = args::get(priority);
+        if (args_data.priority < k_min_priority || args_data.priority > k_max_priority) {
+            return tl::make_unexpected(std::string("Invalid argument: --priority must be in [") +
+                                       std::to_string(k_min_priority) + ", " +
+                                       std::to_string(k_max_priority) + "]");
+        }
+
         return cli_args{cli_args::command_type::simulate, args_data};
     }
 
-    return tl::make_unexpected("Please specify a command: analyze or simulate\n" + parser.Help());
+    if (evaluate_cmd) {
+        evaluate_args args_data;
+        args_data.input_path = std::filesystem::path(args::get(evaluate_input_path));
+        args_data.output_path = std::filesystem::path(args::get(evaluate_output_path));
+        args_data.episodes = args::get(episodes);
+        args_data.seed = args::get(seed);
+        args_data.threads = args::get(threads);
+
+        return cli_args{cli_args::command_type::evaluate, args_data};
+    }
+
+    if (merge_cmd) {
+        merge_args args_data;
+        for (const auto& path : args::get(merge_input_paths)) {
+            args_data.input_paths.emplace_back(path);
+        }
+        args_data.output_path = std::filesystem::path(args::get(merge_output_path));
+
+        return cli_args{cli_args::command_type::merge, args_data};
+    }
+
+    if (diverge_cmd) {
+        diverge_args args_data;
+        args_data.reference_path = std::filesystem::path(args::get(diverge_reference));
+        args_data.candidate_path = std::filesystem::path(args::get(diverge_candidate));
+
+        return cli_args{cli_args::command_type::diverge, args_data};
+    }
+
+    if (daemon_cmd) {
+        daemon_args args_data;
+        args_data.port = args::get(listen_port);
+        args_data.workers = args::get(daemon_workers);
+        args_data.kernel_cache = std::filesystem::path(args::get(daemon_kernel_cache));
+
+        return cli_args{cli_args::command_type::daemon, args_data};
+    }
+
+    return tl::make_unexpected(
+        "Please specify a command: analyze, simulate, evaluate, merge, diverge or daemon\n" +
+        parser.Help());
 }
 
 }  // namespace cshorelark::optimizer_cli
@@ -1,14 +1,20 @@
 #ifndef CSHORELARK_OPTIMIZER_CLI_CLI_ARGS_H
 #define CSHORELARK_OPTIMIZER_CLI_CLI_ARGS_H
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
 #include <tl/expected.hpp>
 #include <variant>
+#include <vector>
 
 #include "common.h"
 #include "constants.h"
+#include "daemon.h"
+#include "placement.h"
+#include "simulation/config.h"
+#include "shard.h"
 
 namespace cshorelark::optimizer_cli {
 
@@ -31,6 +37,57 @@ struct simulate_args {
     std::size_t generations =
         cshorelark::optimizer_cli::constants::k_default_generations;  ///< Number of generations
                                                                       ///< to simulate
+    shard_spec shard;                   ///< Slice of the sweep to run
+    std::optional<std::uint64_t> seed;  ///< Sweep seed, drawn at random when not given
+    placement_policy placement = placement_policy::k_none;  ///< Worker thread placement
+    std::size_t memory_budget_mib = 0;  ///< Memory the sweep may use in MiB, 0 for no limit
+    std::size_t interleave = 1;         ///< Simulations each worker steps in turns
+    std::optional<simulation::kernel_config> kernels;  ///< Fixed kernels, autotuned if unset
+    std::filesystem::path kernel_cache;                ///< Autotuner decision cache
+    std::filesystem::path digest_dir;  ///< Directory for world digest streams, none if empty
+    std::filesystem::path lineage_dir;  ///< Directory for lineage archives, none if empty
+    std::filesystem::path warm_start;  ///< Genome file to start every simulation from
+    std::optional<float> target_fitness;  ///< Fitness to time warm starts against cold ones
+    std::optional<std::uint16_t> metrics_port;  ///< Port of the metrics endpoint, off if unset
+    std::optional<std::uint16_t> daemon_port;   ///< Submit to the daemon on this port if set
+    unsigned priority = k_default_priority;     ///< Share of the daemon's workers
+};
+
+/**
+ * @brief Command line arguments for the daemon command
+ */
+struct daemon_args {
+    std::uint16_t port = k_default_daemon_port;  ///< Port to accept jobs on
+    std::size_t workers = 0;                     ///< Shared worker threads, 0 for one per core
+    std::filesystem::path kernel_cache;          ///< Autotuner decisions shared by all jobs
+};
+
+/**
+ * @brief Command line arguments for the evaluate command
+ */
+struct evaluate_args {
+    std::filesystem::path input_path;   ///< Path to the genome file
+    std::filesystem::path output_path;  ///< Path to save the evaluation report to
+    std::size_t episodes =
+        cshorelark::optimizer_cli::constants::k_default_episodes;  ///< Number of episodes
+    std::uint64_t seed = 0;                                         ///< Base seed of the episodes
+    std::size_t threads = 0;  ///< Worker threads, 0 for one per core
+};
+
+/**
+ * @brief Command line arguments for the merge command
+ */
+struct merge_args {
+    std::vector<std::filesystem::path> input_paths;  ///< Shard logs to merge
+    std::filesystem::path output_path;               ///< Path to save the merged log to
+};
+
+/**
+ * @brief Command line arguments for the diverge command
+ */
+struct diverge_args {
+    std::filesystem::path reference_path;  ///< Digest stream or directory of the reference run
+    std::filesystem::path candidate_path;  ///< Digest stream or directory of the run under test
 };
 
 /**
@@ -39,10 +96,12 @@ struct simulate_args {
  * This structure matches the command-based structure in the Rust implementation
  */
 struct cli_args {
-    enum class command_type { analyze, simulate };
+    enum class command_type { analyze, simulate, evaluate, merge, diverge, daemon };
 
-    command_type cmd;                                ///< Which command to execute
-    std::variant<analyze_args, simulate_args> args;  ///< Arguments for the selected command
+    command_type cmd;  ///< Which command to execute
+    std::variant<analyze_args, simulate_args, evaluate_args, merge_args, diverge_args,
+                 daemon_args>
+        args;  ///< Arguments for the selected command
 };
 
 /**
@@ -45,6 +45,7 @@ constexpr std::size_t k_simulation_stats_alignment = 16;
 // Default values
 constexpr std::size_t k_default_iterations = 15;
 constexpr std::size_t k_default_generations = 30;
+constexpr std::size_t k_default_episodes = 16;
 
 }  // namespace cshorelark::optimizer_cli::constants
 
@@ -0,0 +1,586 @@
+#include "daemon.h"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <asio.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <deque>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "autotune.h"
+#include "simulate.h"
+#include "simulation/simulation.h"
+
+namespace cshorelark::optimizer_cli {
+
+using asio::ip::tcp;
+using json = nlohmann::json;
+
+namespace {
+
+// Longest request line accepted, requests are a few hundred bytes
+constexpr std::size_t k_max_request_bytes = 64 * 1024;
+constexpr std::size_t k_max_name_length = 128;
+// Largest sweep a client may submit, a job plans all its units up front
+constexpr std::size_t k_max_iterations = 100;
+constexpr std::size_t k_max_generations = 100000;
+
+auto message_line(const json& message) -> std::string { return message.dump() + "\n"; }
+
+auto error_line(const std::string& message) -> std::string {
+    return message_line({{"type", "error"}, {"message", message}});
+}
+
+}  // namespace
+
+auto encode_request(const job_request& request) -> std::string {
+    json message = {{"type", "submit"},
+                    {"name", request.name},
+                    {"priority", request.priority},
+                    {"iterations", request.iterations},
+                    {"generations", request.generations},
+                    {"seed", request.seed},
+                    {"shard", fmt::format("{}/{}", request.shard.index, request.shard.count)},
+                    {"kernels", request.kernels ? to_string(*request.kernels) : "auto"}};
+    return message.dump();
+}
+
+auto decode_request(const std::string& line) -> tl::expected<job_request, std::string> {
+    try {
+        const auto message = json::parse(line);
+        if (message.value("type", "") != "submit") {
+            return tl::make_unexpected(std::string("Expected a submit message"));
+        }
+
+        job_request request;
+        request.name = message.value("name", "");
+        request.priority = message.value("priority", k_default_priority);
+        request.iterations = message.at("iterations").get<std::size_t>();
+        request.generations = message.at("generations").get<std::size_t>();
+        request.seed = message.at("seed").get<std::uint64_t>();
+
+        if (request.name.size() > k_max_name_length) {
+            return tl::make_unexpected(
+                fmt::format("Job name is longer than {} characters", k_max_name_length));
+        }
+        if (request.priority < k_min_priority || request.priority > k_max_priority) {
+            return tl::make_unexpected(fmt::format("Priority must be in [{}, {}], got {}",
+                                                   k_min_priority, k_max_priority,
+                                                   request.priority));
+        }
+        if (request.iterations == 0 || request.generations == 0) {
+            return tl::make_unexpected(std::string("Iterations and generations must be positive"));
+        }
+        if (request.iterations > k_max_iterations || request.generations > k_max_generations) {
+            return tl::make_unexpected(
+                fmt::format("Iterations must be at most {} and generations at most {}",
+                            k_max_iterations, k_max_generations));
+        }
+
+        auto shard = parse_shard(message.value("shard", "0/1"));
+        if (!shard) {
+            return tl::make_unexpected(shard.error());
+        }
+        request.shard = *shard;
+
+        auto kernels = parse_kernels(message.value("kernels", "auto"));
+        if (!kernels) {
+            return tl::make_unexpected(kernels.error());
+        }
+        request.kernels = *kernels;
+        return request;
+    } catch (const std::exception& e) {
+        return tl::make_unexpected(std::string("Malformed request: ") + e.what());
+    }
+}
+
+struct sweep_daemon::impl {
+    explicit impl(daemon_options daemon_config)
+        : options(std::move(daemon_config)),
+          combinations(generate_combinations()),
+          tuner(options.kernel_cache) {}
+
+    struct job;
+    class session;
+
+    void accept();
+    void submit(const std::shared_ptr<session>& client, job_request request);
+    void queue(const std::shared_ptr<job>& submitted);
+    void tune();
+    void cancel(const std::shared_ptr<job>& cancelled);
+    void work();
+    void run_unit(const std::shared_ptr<job>& owner, std::size_t unit_index);
+    void send(const std::shared_ptr<job>& owner, std::string line, bool last = false);
+
+    daemon_options options;
+    std::vector<simulation::config> combinations;
+    asio::io_context io;
+    tcp::acceptor acceptor{io};
+    std::thread io_thread;
+    std::thread tuning_thread;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;                   ///< Guards the scheduler, the jobs and their counts
+    std::condition_variable wake;       ///< Signalled on new units, new jobs to tune or stop
+    std::condition_variable quiet;      ///< Signalled when no unit runs anymore
+    fair_share_scheduler scheduler;     ///< Which job runs next
+    std::map<fair_share_scheduler::job_id, std::shared_ptr<job>> jobs;  ///< Live jobs
+    std::deque<std::shared_ptr<job>> untuned;  ///< Jobs waiting for their kernels
+    std::size_t running = 0;            ///< Units the workers are running
+    bool tuning = false;                ///< Set while timing, workers start no new units
+    std::atomic<bool> stopping{false};  ///< Set once on stop
+
+    kernel_autotuner tuner;  ///< Shared by all jobs so a shape is tuned once, tuning thread only
+};
+
+/**
+ * @brief A submitted sweep and the work units planned for it
+ */
+struct sweep_daemon::impl::job {
+    fair_share_scheduler::job_id id = 0;      ///< Id in the scheduler
+    job_request request;                      ///< What the client asked for
+    std::vector<simulation::config> configs;  ///< Every configuration of the sweep
+    std::vector<work_unit> units;             ///< Units of the requested shard
+    std::weak_ptr<session> client;            ///< Connection results go to
+    std::atomic<bool> cancelled{false};       ///< Set when the client went away
+    std::size_t finished = 0;                 ///< Units done, under the daemon lock
+};
+
+/**
+ * @brief One client: reads its request, then writes its job's messages in order
+ *
+ * Keeps reading after the request only to notice the client leaving.
+ */
+class sweep_daemon::impl::session : public std::enable_shared_from_this<session> {
+public:
+    session(tcp::socket socket, impl& daemon)
+        : socket_(std::move(socket)), input_(k_max_request_bytes), daemon_(daemon) {}
+
+    void start() {
+        asio::async_read_until(
+            socket_, input_, '\n',
+            [self = shared_from_this()](const asio::error_code& error, std::size_t) {
+                if (error) {
+                    self->close();
+                    return;
+                }
+                std::istream input(&self->input_);
+                std::string line;
+                std::getline(input, line);
+
+                auto request = decode_request(line);
+                if (!request) {
+                    self->send(error_line(request.error()), true);
+                    return;
+                }
+                // An exception leaving a handler would stop the io thread for every client
+                try {
+                    self->daemon_.submit(self, std::move(*request));
+                } catch (const std::exception& e) {
+                    spdlog::error("Cannot plan a job: {}", e.what());
+                    self->send(error_line(std::string("Cannot plan the job: ") + e.what()), true);
+                    return;
+                }
+                self->watch();
+            });
+    }
+
+    void set_job(std::shared_ptr<job> submitted) { job_ = std::move(submitted); }
+
+    /**
+     * @brief Queues a message, closing the connection after it if it is the last
+     */
+    void send(std::string line, bool last = false) {
+        if (closed_) {
+            return;
+        }
+        const bool idle = outbox_.empty();
+        outbox_.push_back(std::move(line));
+        last_queued_ = last_queued_ || last;
+        if (idle) {
+            write_next();
+        }
+    }
+
+private:
+    void watch() {
+        // Clients send nothing after their request, any read completion means they left
+        asio::async_read(socket_, input_, asio::transfer_at_least(1),
+                         [self = shared_from_this()](const asio::error_code& error, std::size_t) {
+                             if (error && error != asio::error::operation_aborted) {
+                                 self->close();
+                             } else if (!error) {
+                                 self->input_.consume(self->input_.size());
+                                 self->watch();
+                             }
+                         });
+    }
+
+    void write_next() {
+        asio::async_write(socket_, asio::buffer(outbox_.front()),
+                          [self = shared_from_this()](const asio::error_code& error, std::size_t) {
+                              if (error) {
+                                  self->close();
+                                  return;
+                              }
+                              self->outbox_.pop_front();
+                              if (!self->outbox_.empty()) {
+                                  self->write_next();
+                              } else if (self->last_queued_) {
+                                  self->close();
+                              }
+                          });
+    }
+
+    void close() {
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        outbox_.clear();
+        asio::error_code ignored;
+        socket_.shutdown(tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+        if (auto submitted = std::exchange(job_, nullptr)) {
+            daemon_.cancel(submitted);
+        }
+    }
+
+    tcp::socket socket_;
+    asio::streambuf input_;
+    impl& daemon_;
+    std::shared_ptr<job> job_;
+    std::deque<std::string> outbox_;
+    bool last_queued_ = false;
+    bool closed_ = false;
+};
+
+void sweep_daemon::impl::accept() {
+    acceptor.async_accept([this](const asio::error_code& error, tcp::socket socket) {
+        if (error) {
+            if (error != asio::error::operation_aborted) {
+                spdlog::warn("Daemon accept failed: {}", error.message());
+                accept();
+            }
+            return;
+        }
+        std::make_shared<session>(std::move(socket), *this)->start();
+        accept();
+    });
+}
+
+void sweep_daemon::impl::submit(const std::shared_ptr<session>& client, job_request request) {
+    auto submitted = std::make_shared<job>();
+    submitted->configs = combinations;
+    submitted->units = plan_shard(submitted->configs, request.iterations, request.generations,
+                                  request.seed, request.shard);
+    submitted->client = client;
+    submitted->request = std::move(request);
+    client->set_job(submitted);
+
+    if (submitted->request.kernels) {
+        for (auto& config : submitted->configs) {
+            config.kernels = *submitted->request.kernels;
+        }
+        queue(submitted);
+        return;
+    }
+
+    // Timing kernels takes a while, the tuning thread queues the job once they are chosen
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        untuned.push_back(std::move(submitted));
+    }
+    wake.notify_all();
+}
+
+void sweep_daemon::impl::queue(const std::shared_ptr<job>& submitted) {
+    const auto client = submitted->client.lock();
+    if (!client || submitted->cancelled) {
+        return;
+    }
+
+    std::size_t queued_jobs = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!submitted->units.empty()) {
+            submitted->id =
+                scheduler.add_job(submitted->units.size(), submitted->request.priority);
+            jobs[submitted->id] = submitted;
+        }
+        queued_jobs = scheduler.jobs();
+    }
+    wake.notify_all();
+
+    spdlog::info("Job {} '{}': {} units at priority {}, {} jobs running", submitted->id,
+                 submitted->request.name, submitted->units.size(), submitted->request.priority,
+                 queued_jobs);
+    client->send(message_line({{"type", "accepted"},
+                               {"job", submitted->id},
+                               {"units", submitted->units.size()},
+                               {"jobs", queued_jobs}}));
+    if (submitted->units.empty()) {
+        client->set_job(nullptr);
+        client->send(message_line({{"type", "done"}, {"units", 0}}), true);
+    }
+}
+
+void sweep_daemon::impl::tune() {
+    for (;;) {
+        std::shared_ptr<job> next;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !untuned.empty(); });
+            if (stopping) {
+                return;
+            }
+            next = std::move(untuned.front());
+            untuned.pop_front();
+        }
+
+        std::vector<bool> used(next->configs.size(), false);
+        bool new_shapes = false;
+        for (const auto& unit : next->units) {
+            used[unit.config_index] = true;
+            new_shapes = new_shapes || !tuner.knows(next->configs[unit.config_index]);
+        }
+        if (new_shapes && !next->cancelled) {
+            // Running units finish and no new ones start, so the timings see an idle machine
+            std::unique_lock<std::mutex> lock(mutex);
+            tuning = true;
+            quiet.wait(lock, [this] { return stopping || running == 0; });
+        }
+        if (!stopping && !next->cancelled) {
+            for (std::size_t i = 0; i < next->configs.size(); ++i) {
+                if (used[i]) {
+                    next->configs[i].kernels = tuner.choose(next->configs[i]);
+                }
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tuning = false;
+        }
+        wake.notify_all();
+
+        asio::post(io, [this, next] { queue(next); });
+    }
+}
+
+void sweep_daemon::impl::cancel(const std::shared_ptr<job>& target) {
+    target->cancelled = true;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (jobs.count(target->id) == 0) {
+        return;
+    }
+    spdlog::info("Job {} '{}': client left, dropping {} queued units", target->id,
+                 target->request.name, scheduler.pending(target->id));
+    if (scheduler.cancel(target->id)) {
+        jobs.erase(target->id);
+    }
+}
+
+void sweep_daemon::impl::send(const std::shared_ptr<job>& owner, std::string line, bool last) {
+    asio::post(io, [client = owner->client, line = std::move(line), last]() mutable {
+        if (auto session = client.lock()) {
+            session->send(std::move(line), last);
+        }
+    });
+}
+
+void sweep_daemon::impl::work() {
+    for (;;) {
+        fair_share_scheduler::dispatch next;
+        std::shared_ptr<job> owner;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || (!tuning && scheduler.has_pending()); });
+            if (stopping) {
+                return;
+            }
+            next = *scheduler.next();
+            owner = jobs.at(next.job);
+            ++running;
+        }
+
+        try {
+            run_unit(owner, next.unit);
+        } catch (const std::exception& e) {
+            spdlog::error("Job {} '{}': unit {} failed: {}", owner->id, owner->request.name,
+                          next.unit, e.what());
+            send(owner, error_line(e.what()), true);
+            cancel(owner);
+        }
+
+        std::size_t finished = 0;
+        bool done = false;
+        bool idle = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = ++owner->finished;
+            idle = --running == 0;
+            if (scheduler.finish(owner->id)) {
+                jobs.erase(owner->id);
+                done = !owner->cancelled;
+            }
+        }
+        if (idle) {
+            quiet.notify_all();
+        }
+        // A unit cut short by a stop has sent only part of its results
+        if (owner->cancelled || stopping) {
+            continue;
+        }
+        send(owner, message_line({{"type", "progress"},
+                                  {"finished", finished},
+                                  {"units", owner->units.size()}}));
+        if (done) {
+            spdlog::info("Job {} '{}': done", owner->id, owner->request.name);
+            send(owner, message_line({{"type", "done"}, {"units", owner->units.size()}}), true);
+        }
+    }
+}
+
+void sweep_daemon::impl::run_unit(const std::shared_ptr<job>& owner, std::size_t unit_index) {
+    const auto& unit = owner->units[unit_index];
+    const auto& config = owner->configs[unit.config_index];
+
+    // Seeded per work unit like simulate, so the results match a local run of the sweep
+    cshorelark::random::random_generator random(unit.seed);
+    auto sim = simulation::simulation::random(config, random);
+    for (std::size_t gen = 0; gen < owner->request.generations; ++gen) {
+        if (owner->cancelled || stopping) {
+            return;
+        }
+        const auto stats = sim.train(random);
+        const simulation_log_entry entry{config,         unit.config_index, gen,
+                                         unit.iteration, unit.seed,         stats};
+        send(owner, message_line({{"type", "result"}, {"entry", log_entry_json(entry)}}));
+    }
+}
+
+sweep_daemon::sweep_daemon(daemon_options options)
+    : impl_(std::make_shared<impl>(std::move(options))) {}
+
+sweep_daemon::~sweep_daemon() { stop(); }
+
+auto sweep_daemon::start() -> tl::expected<std::uint16_t, std::string> {
+    try {
+        const tcp::endpoint endpoint(asio::ip::make_address(impl_->options.address),
+                                     impl_->options.port);
+        impl_->acceptor.open(endpoint.protocol());
+        impl_->acceptor.set_option(tcp::acceptor::reuse_address(true));
+        impl_->acceptor.bind(endpoint);
+        impl_->acceptor.listen();
+    } catch (const std::exception& e) {
+        return tl::make_unexpected(fmt::format("Cannot listen on {}:{}: {}",
+                                               impl_->options.address, impl_->options.port,
+                                               e.what()));
+    }
+
+    const auto port = impl_->acceptor.local_endpoint().port();
+    const std::size_t workers =
+        impl_->options.workers > 0 ? impl_->options.workers
+                                   : std::max(1U, std::thread::hardware_concurrency());
+    impl_->accept();
+    impl_->io_thread = std::thread([daemon = impl_] { daemon->io.run(); });
+    impl_->tuning_thread = std::thread([daemon = impl_] { daemon->tune(); });
+    for (std::size_t i = 0; i < workers; ++i) {
+        impl_->workers.emplace_back([daemon = impl_] { daemon->work(); });
+    }
+    spdlog::info("Daemon listening on {}:{} with {} workers", impl_->options.address, port,
+                 workers);
+    return port;
+}
+
+void sweep_daemon::wait_for_signal() {
+    asio::io_context signals_io;
+    asio::signal_set signals(signals_io, SIGINT, SIGTERM);
+    signals.async_wait([](const asio::error_code&, int signal) {
+        spdlog::info("Received signal {}, stopping", signal);
+    });
+    signals_io.run();
+    stop();
+}
+
+void sweep_daemon::stop() {
+    if (!impl_->io_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->stopping = true;
+    }
+    impl_->wake.notify_all();
+    impl_->quiet.notify_all();
+    for (auto& worker : impl_->workers) {
+        worker.join();
+    }
+    impl_->workers.clear();
+    impl_->tuning_thread.join();
+    impl_->io.stop();
+    impl_->io_thread.join();
+
+    if (auto saved = impl_->tuner.save(); !saved) {
+        spdlog::warn(saved.error());
+    }
+}
+
+auto submit_sweep(const std::string& address, std::uint16_t port, const job_request& request,
+                  const std::filesystem::path& output_path)
+    -> tl::expected<std::string, std::string> {
+    try {
+        asio::io_context io;
+        tcp::socket socket(io);
+        socket.connect({asio::ip::make_address(address), port});
+        asio::write(socket, asio::buffer(encode_request(request) + "\n"));
+
+        json logs = json::array();
+        asio::streambuf input;
+        std::istream lines(&input);
+        for (;;) {
+            asio::error_code error;
+            asio::read_until(socket, input, '\n', error);
+            if (error) {
+                return tl::make_unexpected(
+                    "Daemon closed the connection before the job was done: " + error.message());
+            }
+            std::string line;
+            std::getline(lines, line);
+            const auto message = json::parse(line);
+            const auto type = message.value("type", "");
+
+            if (type == "accepted") {
+                spdlog::info("Job {} accepted: {} simulations, {} jobs on the daemon",
+                             message.at("job").get<std::uint64_t>(),
+                             message.at("units").get<std::size_t>(),
+                             message.at("jobs").get<std::size_t>());
+            } else if (type == "result") {
+                logs.push_back(message.at("entry"));
+            } else if (type == "progress") {
+                spdlog::info("Progress: {}/{}", message.at("finished").get<std::size_t>(),
+                             message.at("units").get<std::size_t>());
+            } else if (type == "done") {
+                return write_log(output_path, logs);
+            } else if (type == "error") {
+                return tl::make_unexpected("Daemon error: " +
+                                           message.value("message", std::string()));
+            }
+        }
+    } catch (const std::exception& e) {
+        return tl::make_unexpected(
+            fmt::format("Cannot submit to the daemon on {}:{}: {}", address, port, e.what()));
+    }
+}
+
+}  // namespace cshorelark::optimizer_cli
@@ -0,0 +1,129 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_DAEMON_H
+#define CSHORELARK_OPTIMIZER_CLI_DAEMON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tl/expected.hpp>
+
+#include "fair_share.h"
+#include "shard.h"
+#include "simulation/config.h"
+
+namespace cshorelark::optimizer_cli {
+
+/// Port the daemon listens on unless told otherwise
+constexpr std::uint16_t k_default_daemon_port = 7879;
+
+/**
+ * @brief A sweep submitted to the daemon, the arguments of one simulate run
+ */
+struct job_request {
+    std::string name;                                  ///< Shown in the daemon's log
+    unsigned priority = k_default_priority;            ///< Share of the shared workers
+    std::size_t iterations = 0;                        ///< Iterations per configuration
+    std::size_t generations = 0;                       ///< Generations per simulation
+    std::uint64_t seed = 0;                            ///< Sweep seed
+    shard_spec shard;                                  ///< Slice of the sweep to run
+    std::optional<simulation::kernel_config> kernels;  ///< Fixed kernels, tuned if unset
+};
+
+/**
+ * @brief Encodes a request as one line of the daemon protocol
+ *
+ * @param request Request to encode
+ * @return JSON message, without the line break
+ */
+auto encode_request(const job_request& request) -> std::string;
+
+/**
+ * @brief Decodes and validates a request line
+ *
+ * @param line JSON message sent by a client
+ * @return The request, or an error message for the client
+ */
+auto decode_request(const std::string& line) -> tl::expected<job_request, std::string>;
+
+/**
+ * @brief How the daemon listens and runs jobs
+ */
+struct daemon_options {
+    std::string address = "127.0.0.1";           ///< Address to listen on
+    std::uint16_t port = k_default_daemon_port;  ///< Port to listen on, 0 picks one
+    std::size_t workers = 0;                     ///< Shared worker threads, 0 for one per core
+    std::filesystem::path kernel_cache;          ///< Autotuner decisions shared by all jobs
+};
+
+/**
+ * @brief Runs sweep jobs of many clients on one shared worker pool
+ *
+ * Clients connect over TCP and send one request line. Its work units join a
+ * fair-share scheduler, and every worker takes the next unit of whichever job is
+ * furthest behind its share, so concurrent sweeps neither oversubscribe the
+ * machine nor wait for each other to finish. Results and progress are streamed
+ * back on the same connection as JSON lines; a client that disconnects cancels
+ * its job's remaining units.
+ */
+class sweep_daemon {
+public:
+    /**
+     * @brief Creates a daemon, call start() to listen
+     * @param options Address, port, workers and kernel cache
+     */
+    explicit sweep_daemon(daemon_options options);
+
+    /**
+     * @brief Stops the daemon
+     */
+    ~sweep_daemon();
+
+    sweep_daemon(const sweep_daemon&) = delete;
+    sweep_daemon& operator=(const sweep_daemon&) = delete;
+    sweep_daemon(sweep_daemon&&) = delete;
+    sweep_daemon& operator=(sweep_daemon&&) = delete;
+
+    /**
+     * @brief Binds the listening socket and starts the server and worker threads
+     * @return The bound port, or an error message
+     */
+    auto start() -> tl::expected<std::uint16_t, std::string>;
+
+    /**
+     * @brief Blocks until SIGINT or SIGTERM, then stops the daemon
+     */
+    void wait_for_signal();
+
+    /**
+     * @brief Stops the threads, letting running units finish their generation first
+     *
+     * Safe to call more than once. Jobs still queued are dropped, their clients
+     * see the connection close before the final message.
+     */
+    void stop();
+
+private:
+    struct impl;
+    std::shared_ptr<impl> impl_;
+};
+
+/**
+ * @brief Submits a sweep to a daemon and saves its results like simulate does
+ *
+ * Blocks until the daemon reports the job done, logging progress on the way.
+ *
+ * @param address Address of the daemon
+ * @param port Port of the daemon
+ * @param request Sweep to run
+ * @param output_path Path to save the sweep log to
+ * @return Expected containing success message or error
+ */
+auto submit_sweep(const std::string& address, std::uint16_t port, const job_request& request,
+                  const std::filesystem::path& output_path)
+    -> tl::expected<std::string, std::string>;
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_DAEMON_H
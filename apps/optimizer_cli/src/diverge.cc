@@ -0,0 +1,126 @@
+#include "diverge.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "simulation/digest.h"
+#include "simulation/simulation_error.h"
+
+namespace cshorelark::optimizer_cli {
+
+namespace {
+
+constexpr const char* k_digest_extension = ".digest";
+
+auto load_stream(const std::filesystem::path& path)
+    -> tl::expected<std::vector<simulation::step_digest>, std::string> {
+    std::ifstream file(path);
+    if (!file) {
+        return tl::make_unexpected("Failed to open digest stream: " + path.string());
+    }
+    auto digests = simulation::read_digests(file);
+    if (!digests) {
+        return tl::make_unexpected(std::string(simulation::simulation_error_to_string(
+                                       digests.error())) +
+                                   ": " + path.string());
+    }
+    return std::move(*digests);
+}
+
+// Compares one pair of streams; the error holds the divergence report
+auto compare_streams(const std::filesystem::path& reference_path,
+                     const std::filesystem::path& candidate_path)
+    -> tl::expected<std::size_t, std::string> {
+    auto reference = load_stream(reference_path);
+    if (!reference) {
+        return tl::make_unexpected(reference.error());
+    }
+    auto candidate = load_stream(candidate_path);
+    if (!candidate) {
+        return tl::make_unexpected(candidate.error());
+    }
+
+    const auto divergence = simulation::first_divergence(*reference, *candidate);
+    if (!divergence) {
+        return reference->size();
+    }
+    std::string report = reference_path.filename().string() + ": first divergence at step " +
+                         std::to_string(divergence->step);
+    if (divergence->phase) {
+        report += " in phase " + std::string(simulation::to_string(*divergence->phase));
+    } else if (divergence->index == std::min(reference->size(), candidate->size())) {
+        report += ", where the " +
+                  std::string(reference->size() < candidate->size() ? "reference" : "candidate") +
+                  " stream ends";
+    } else {
+        report += ", the streams number their steps differently";
+    }
+    return tl::make_unexpected(report);
+}
+
+}  // namespace
+
+auto digest_stream_name(std::size_t config_index, std::size_t iteration) -> std::string {
+    return std::to_string(config_index) + "-" + std::to_string(iteration) + k_digest_extension;
+}
+
+auto compare_digests(const std::filesystem::path& reference_path,
+                     const std::filesystem::path& candidate_path)
+    -> tl::expected<std::string, std::string> {
+    std::error_code error;
+    const bool reference_is_dir = std::filesystem::is_directory(reference_path, error);
+    const bool candidate_is_dir = std::filesystem::is_directory(candidate_path, error);
+    if (reference_is_dir != candidate_is_dir) {
+        return tl::make_unexpected(
+            std::string("Compare two digest streams or two digest directories, not one of each"));
+    }
+
+    if (!reference_is_dir) {
+        auto steps = compare_streams(reference_path, candidate_path);
+        if (!steps) {
+            return tl::make_unexpected(steps.error());
+        }
+        return "Digest streams match over " + std::to_string(*steps) + " steps";
+    }
+
+    std::vector<std::filesystem::path> names;
+    for (const auto& entry : std::filesystem::directory_iterator(reference_path, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == k_digest_extension) {
+            names.push_back(entry.path().filename());
+        }
+    }
+    if (error) {
+        return tl::make_unexpected("Failed to list digest directory: " + reference_path.string());
+    }
+    if (names.empty()) {
+        return tl::make_unexpected("No digest streams in " + reference_path.string());
+    }
+    std::sort(names.begin(), names.end());
+
+    std::size_t steps = 0;
+    std::vector<std::string> divergent;
+    for (const auto& name : names) {
+        auto compared = compare_streams(reference_path / name, candidate_path / name);
+        if (compared) {
+            steps += *compared;
+        } else {
+            divergent.push_back(compared.error());
+        }
+    }
+    if (!divergent.empty()) {
+        std::string report = std::to_string(divergent.size()) + " of " +
+                             std::to_string(names.size()) + " digest streams diverge";
+        for (const auto& line : divergent) {
+            report += "\n  " + line;
+        }
+        return tl::make_unexpected(report);
+    }
+    return std::to_string(names.size()) + " digest streams match over " + std::to_string(steps) +
+           " steps";
+}
+
+}  // namespace cshorelark::optimizer_cli
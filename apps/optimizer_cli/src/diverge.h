@@ -0,0 +1,37 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_DIVERGE_H
+#define CSHORELARK_OPTIMIZER_CLI_DIVERGE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <tl/expected.hpp>
+
+namespace cshorelark::optimizer_cli {
+
+/**
+ * @brief Gets the file name of the digest stream of one work unit
+ *
+ * @param config_index Index of the configuration in the sweep
+ * @param iteration Iteration of the configuration
+ * @return File name, the same in every run of the sweep
+ */
+auto digest_stream_name(std::size_t config_index, std::size_t iteration) -> std::string;
+
+/**
+ * @brief Compares the world digests of a reference run and a candidate run
+ *
+ * Both paths are digest streams, or both are directories written by
+ * simulate --digests, in which case every stream of the reference is compared
+ * with the stream of the same name in the candidate.
+ *
+ * @param reference_path Streams of the reference run
+ * @param candidate_path Streams of the run under test
+ * @return Summary if every stream matches, otherwise the first divergent step and phase
+ */
+auto compare_digests(const std::filesystem::path& reference_path,
+                     const std::filesystem::path& candidate_path)
+    -> tl::expected<std::string, std::string>;
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_DIVERGE_H
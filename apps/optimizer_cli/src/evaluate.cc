@@ -0,0 +1,270 @@
+#include "evaluate.h"
+
+#include <spdlog/spdlog.h>
+#include <transwarp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "genetic_algorithm/lineage.h"
+#include "neural_network/brain_pack.h"
+#include "random/random.h"
+#include "simulation/animal.h"
+#include "simulation/simulation.h"
+
+namespace cshorelark::optimizer_cli {
+
+using json = nlohmann::json;
+
+evaluation_arena::evaluation_arena(genome_set genomes, std::size_t episodes, std::uint64_t seed)
+    : genomes_(std::move(genomes)), episodes_(episodes), seed_(seed) {}
+
+auto evaluation_arena::episode_seed(std::uint64_t seed, std::size_t episode) -> std::uint64_t {
+    return cshorelark::random::derive_seed(seed, episode);
+}
+
+auto evaluation_arena::run_episode(std::size_t episode) const
+    -> tl::expected<std::vector<float>, std::string> {
+    cshorelark::random::random_generator random(episode_seed(seed_, episode));
+    auto sim = simulation::simulation::from_chromosomes(genomes_.config, genomes_.genomes, random);
+    if (!sim) {
+        return tl::make_unexpected("Genomes do not fit the configured brain: error code " +
+                                   std::to_string(static_cast<int>(sim.error())));
+    }
+
+    for (std::size_t step = 0; step < genomes_.config.sim.generation_length; ++step) {
+        sim->advance(random);
+    }
+
+    std::vector<float> fitness;
+    fitness.reserve(genomes_.genomes.size());
+    for (const auto& animal : sim->get_world().get_animals()) {
+        fitness.push_back(static_cast<float>(animal.food_eaten()));
+    }
+    return fitness;
+}
+
+auto evaluation_arena::run(std::size_t threads) const
+    -> tl::expected<std::vector<genome_report>, std::string> {
+    if (genomes_.genomes.empty()) {
+        return tl::make_unexpected(std::string("No genomes to evaluate"));
+    }
+    if (episodes_ == 0) {
+        return tl::make_unexpected(std::string("At least one episode is required"));
+    }
+
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    spdlog::info("Evaluating {} genomes on {} episodes of {} steps using {} threads",
+                 genomes_.genomes.size(), episodes_, genomes_.config.sim.generation_length,
+                 threads);
+
+    transwarp::parallel executor(threads);
+    using episode_result = tl::expected<std::vector<float>, std::string>;
+    std::vector<std::shared_ptr<transwarp::task<episode_result>>> tasks;
+    tasks.reserve(episodes_);
+    for (std::size_t episode = 0; episode < episodes_; ++episode) {
+        auto task = transwarp::make_task(transwarp::root,
+                                         [this, episode] { return run_episode(episode); });
+        task->schedule(executor);
+        tasks.push_back(std::move(task));
+    }
+
+    std::vector<genome_report> reports(genomes_.genomes.size());
+    for (std::size_t i = 0; i < reports.size(); ++i) {
+        reports[i].index = i;
+        reports[i].fitness.reserve(episodes_);
+    }
+    for (auto& task : tasks) {
+        const auto& result = task->get();
+        if (!result) {
+            return tl::make_unexpected(result.error());
+        }
+        for (std::size_t i = 0; i < reports.size(); ++i) {
+            reports[i].fitness.push_back((*result)[i]);
+        }
+    }
+
+    for (auto& report : reports) {
+        report.summary = analyze::compute_stats(report.fitness);
+        float variance = 0.0F;
+        for (const float value : report.fitness) {
+            const float diff = value - report.summary.avg_fitness;
+            variance += diff * diff;
+        }
+        report.std_dev = std::sqrt(variance / static_cast<float>(report.fitness.size()));
+    }
+    return reports;
+}
+
+namespace {
+
+// Simulation brains are always eye cells -> neurons -> 2 outputs with ReLU, and every genome
+// of a set shares the brain configuration of the first
+auto load_brain_pack(const std::filesystem::path& input_path)
+    -> tl::expected<genome_set, std::string> {
+    auto pack = neural_network::brain_pack::open(input_path);
+    if (!pack) {
+        return tl::make_unexpected("Failed to open brain pack " + input_path.string() +
+                                   ": error code " +
+                                   std::to_string(static_cast<int>(pack.error())));
+    }
+
+    genome_set set;
+    for (std::size_t i = 0; i < pack->size(); ++i) {
+        auto view = pack->view(i);
+        if (!view) {
+            return tl::make_unexpected("Invalid network " + std::to_string(i) + " in brain pack");
+        }
+        const auto layers = view->layer_sizes();
+        if (layers.size() != 3 || layers[2] != 2) {
+            return tl::make_unexpected("Network " + std::to_string(i) +
+                                       " does not have the topology of a simulation brain");
+        }
+        if (view->activation() != neural_network::activation_function::k_relu) {
+            return tl::make_unexpected("Network " + std::to_string(i) +
+                                       " does not use ReLU like a simulation brain");
+        }
+        if (i == 0) {
+            set.config.brain_eye.num_cells = layers[0];
+            set.config.brain_eye.num_neurons = layers[1];
+        } else if (layers[0] != set.config.brain_eye.num_cells ||
+                   layers[1] != set.config.brain_eye.num_neurons) {
+            // Same weight count is not enough: 3 cells and 4 neurons take 26 weights, and so
+            // do 5 cells and 3 neurons
+            return tl::make_unexpected("Network " + std::to_string(i) +
+                                       " does not have the topology of network 0");
+        }
+        const auto weights = view->weights();
+        set.genomes.emplace_back(std::vector<float>(weights.begin(), weights.end()));
+    }
+    return set;
+}
+
+// Reads the fields genome files may set, keeping the defaults of the others
+void read_genome_config(const json& data, simulation::config& config) {
+    if (data.contains("brain_eye")) {
+        const auto& eye = data.at("brain_eye");
+        auto& cfg = config.brain_eye;
+        cfg.fov_range = eye.value("fov_range", cfg.fov_range);
+        cfg.fov_angle_deg = eye.value("fov_angle_deg", cfg.fov_angle_deg);
+        cfg.num_cells = eye.value("num_cells", cfg.num_cells);
+        cfg.num_neurons = eye.value("num_neurons", cfg.num_neurons);
+    }
+    if (data.contains("world")) {
+        const auto& world = data.at("world");
+        config.world.num_foods = world.value("num_foods", config.world.num_foods);
+    }
+}
+
+auto load_lineage(const std::filesystem::path& input_path)
+    -> tl::expected<genome_set, std::string> {
+    auto archive = genetic::lineage_archive::open(input_path);
+    if (!archive) {
+        return tl::make_unexpected("Failed to open lineage archive " + input_path.string() +
+                                   ": " + archive.error().message);
+    }
+    if (archive->generations() == 0) {
+        return tl::make_unexpected("Lineage archive " + input_path.string() + " is empty");
+    }
+    auto genomes = archive->reconstruct_generation(archive->generations() - 1);
+    if (!genomes) {
+        return tl::make_unexpected("Failed to reconstruct the last generation of " +
+                                   input_path.string() + ": " + genomes.error().message);
+    }
+
+    genome_set set;
+    set.genomes = std::move(*genomes);
+    if (!archive->metadata().empty()) {
+        try {
+            read_genome_config(json::parse(archive->metadata()), set.config);
+        } catch (const std::exception& e) {
+            return tl::make_unexpected(std::string("Invalid lineage archive metadata: ") +
+                                       e.what());
+        }
+    }
+    return set;
+}
+
+}  // namespace
+
+auto load_genomes(const std::filesystem::path& input_path)
+    -> tl::expected<genome_set, std::string> {
+    if (input_path.extension() == ".bpack") {
+        return load_brain_pack(input_path);
+    }
+    if (input_path.extension() == ".lineage") {
+        return load_lineage(input_path);
+    }
+
+    try {
+        std::ifstream file(input_path);
+        if (!file) {
+            return tl::make_unexpected("Failed to open genome file: " + input_path.string());
+        }
+        const json data = json::parse(file);
+
+        genome_set set;
+        read_genome_config(data, set.config);
+
+        for (const auto& weights : data.at("genomes")) {
+            set.genomes.emplace_back(weights.get<std::vector<float>>());
+        }
+        return set;
+    } catch (const std::exception& e) {
+        return tl::make_unexpected(std::string("Error loading genomes: ") + e.what());
+    }
+}
+
+auto genome_config_json(const simulation::config& config) -> json {
+    json data;
+    data["brain_eye"] = {{"fov_range", config.brain_eye.fov_range},
+                         {"fov_angle_deg", config.brain_eye.fov_angle_deg},
+                         {"num_cells", config.brain_eye.num_cells},
+                         {"num_neurons", config.brain_eye.num_neurons}};
+    data["world"] = {{"num_foods", config.world.num_foods}};
+    return data;
+}
+
+auto save_reports(const std::filesystem::path& output_path,
+                  const std::vector<genome_report>& reports, std::uint64_t seed)
+    -> tl::expected<std::string, std::string> {
+    try {
+        json genomes_json = json::array();
+        for (const auto& report : reports) {
+            json genome;
+            genome["index"] = report.index;
+            genome["min"] = report.summary.min_fitness;
+            genome["max"] = report.summary.max_fitness;
+            genome["mean"] = report.summary.avg_fitness;
+            genome["median"] = report.summary.median_fitness;
+            genome["std_dev"] = report.std_dev;
+            genome["fitness"] = report.fitness;
+            genomes_json.push_back(genome);
+        }
+
+        json output;
+        output["seed"] = seed;
+        output["episodes"] = reports.empty() ? 0 : reports.front().fitness.size();
+        output["genomes"] = genomes_json;
+
+        std::ofstream file(output_path);
+        if (!file) {
+            return tl::make_unexpected("Failed to open output file: " + output_path.string());
+        }
+        file << output.dump(2);
+
+        return std::string("Evaluation saved to: ") + output_path.string();
+    } catch (const std::exception& e) {
+        return tl::make_unexpected(std::string("Error saving evaluation: ") + e.what());
+    }
+}
+
+}  // namespace cshorelark::optimizer_cli
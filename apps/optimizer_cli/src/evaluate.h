@@ -0,0 +1,127 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_EVALUATE_H
+#define CSHORELARK_OPTIMIZER_CLI_EVALUATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <tl/expected.hpp>
+#include <vector>
+
+#include "analyze.h"
+#include "genetic_algorithm/chromosome.h"
+#include "simulation/config.h"
+
+namespace cshorelark::optimizer_cli {
+
+/**
+ * @brief Fitness distribution of one genome over all episodes
+ */
+struct genome_report {
+    std::size_t index = 0;       ///< Position of the genome in the input file
+    std::vector<float> fitness;  ///< Food eaten in each episode, by episode index
+    analyze::stats summary{};    ///< Min, max, mean and median over the episodes
+    float std_dev = 0.0F;        ///< Standard deviation over the episodes
+};
+
+/**
+ * @brief Genomes to evaluate together with the configuration they were trained with
+ */
+struct genome_set {
+    simulation::config config;
+    std::vector<genetic::chromosome> genomes;
+};
+
+/**
+ * @brief Scores a fixed set of genomes on seeded episodes without evolving them
+ *
+ * Every episode places all genomes in one world, as during training, and runs
+ * generation_length steps through simulation::advance, so the genetic algorithm
+ * is never involved. Episodes are independent and run in parallel; each one
+ * draws from its own generator seeded from the base seed and the episode
+ * index, so results do not depend on the number of threads.
+ */
+class evaluation_arena {
+public:
+    /**
+     * @brief Constructor for the evaluation arena
+     *
+     * @param genomes Genomes and configuration to evaluate
+     * @param episodes Number of episodes to run
+     * @param seed Base seed of the episodes
+     */
+    evaluation_arena(genome_set genomes, std::size_t episodes, std::uint64_t seed);
+
+    /**
+     * @brief Runs all episodes
+     *
+     * @param threads Number of worker threads, 0 for one per core
+     * @return One report per genome in input order, or an error message
+     */
+    auto run(std::size_t threads) const -> tl::expected<std::vector<genome_report>, std::string>;
+
+    /**
+     * @brief Derives the seed of an episode
+     *
+     * @param seed Base seed
+     * @param episode Episode index
+     * @return Well-mixed seed for the episode's generator
+     */
+    [[nodiscard]] static auto episode_seed(std::uint64_t seed, std::size_t episode)
+        -> std::uint64_t;
+
+private:
+    /**
+     * @brief Runs one episode
+     *
+     * @param episode Episode index
+     * @return Food eaten by each genome, or an error message
+     */
+    auto run_episode(std::size_t episode) const -> tl::expected<std::vector<float>, std::string>;
+
+    genome_set genomes_;    ///< Genomes to evaluate
+    std::size_t episodes_;  ///< Number of episodes
+    std::uint64_t seed_;    ///< Base seed
+};
+
+/**
+ * @brief Loads genomes from a JSON file or a brain pack
+ *
+ * A JSON file holds an object with a "genomes" array of weight arrays and an
+ * optional "brain_eye" object (fov_range, fov_angle_deg, num_cells,
+ * num_neurons) and "world" object (num_foods); missing fields keep their
+ * defaults. A ".bpack" file is read as a brain pack and the brain topology is
+ * taken from its networks. A ".lineage" archive written by simulate --lineage
+ * gives its last generation, configured by the archive's metadata, which has
+ * the same "brain_eye" and "world" objects.
+ *
+ * @param input_path Path to the genome file
+ * @return The genomes and configuration, or an error message
+ */
+auto load_genomes(const std::filesystem::path& input_path)
+    -> tl::expected<genome_set, std::string>;
+
+/**
+ * @brief Describes the brain and world genomes were trained in, as load_genomes reads it
+ *
+ * @param config Configuration the genomes were trained with
+ * @return JSON object with the "brain_eye" and "world" fields
+ */
+auto genome_config_json(const simulation::config& config) -> nlohmann::json;
+
+/**
+ * @brief Saves evaluation reports as JSON
+ *
+ * @param output_path Path of the report file
+ * @param reports Reports to save
+ * @param seed Base seed the episodes were run with
+ * @return Success message or error
+ */
+auto save_reports(const std::filesystem::path& output_path,
+                  const std::vector<genome_report>& reports, std::uint64_t seed)
+    -> tl::expected<std::string, std::string>;
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_EVALUATE_H
@@ -0,0 +1,84 @@
+#include "fair_share.h"
+
+#include <algorithm>
+
+namespace cshorelark::optimizer_cli {
+
+namespace {
+
+// Stride of priority 1, 2^7 * 3^2 * 5^3 * 7 so the strides of common priorities are exact
+constexpr std::uint64_t k_stride_base = 1'008'000;
+
+}  // namespace
+
+auto fair_share_scheduler::add_job(std::size_t units, unsigned priority) -> job_id {
+    const auto clamped = std::clamp(priority, k_min_priority, k_max_priority);
+    const auto id = next_id_++;
+    jobs_[id] = job_state{units, 0, 0, k_stride_base / clamped, pass_};
+    return id;
+}
+
+auto fair_share_scheduler::next() -> std::optional<dispatch> {
+    job_state* best = nullptr;
+    job_id best_id = 0;
+    for (auto& [id, job] : jobs_) {
+        if (job.next_unit < job.units && (best == nullptr || job.pass < best->pass)) {
+            best = &job;
+            best_id = id;
+        }
+    }
+    if (best == nullptr) {
+        return std::nullopt;
+    }
+
+    pass_ = best->pass;
+    best->pass += best->stride;
+    ++best->running;
+    return dispatch{best_id, best->next_unit++};
+}
+
+auto fair_share_scheduler::finish(job_id job) -> bool {
+    const auto found = jobs_.find(job);
+    if (found == jobs_.end()) {
+        return false;
+    }
+    auto& state = found->second;
+    if (state.running > 0) {
+        --state.running;
+    }
+    if (state.running == 0 && state.next_unit >= state.units) {
+        jobs_.erase(found);
+        return true;
+    }
+    return false;
+}
+
+auto fair_share_scheduler::cancel(job_id job) -> bool {
+    const auto found = jobs_.find(job);
+    if (found == jobs_.end()) {
+        return true;
+    }
+    found->second.units = found->second.next_unit;
+    if (found->second.running == 0) {
+        jobs_.erase(found);
+        return true;
+    }
+    return false;
+}
+
+auto fair_share_scheduler::has_pending() const noexcept -> bool {
+    return std::any_of(jobs_.begin(), jobs_.end(),
+                       [](const auto& job) { return job.second.next_unit < job.second.units; });
+}
+
+auto fair_share_scheduler::pending(job_id job) const noexcept -> std::size_t {
+    const auto found = jobs_.find(job);
+    return found == jobs_.end() ? 0 : found->second.units - found->second.next_unit;
+}
+
+auto fair_share_scheduler::running(job_id job) const noexcept -> std::size_t {
+    const auto found = jobs_.find(job);
+    return found == jobs_.end() ? 0 : found->second.running;
+}
+
+}  // namespace cshorelark::optimizer_cli
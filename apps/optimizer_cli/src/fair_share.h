@@ -0,0 +1,107 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_FAIR_SHARE_H
+#define CSHORELARK_OPTIMIZER_CLI_FAIR_SHARE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace cshorelark::optimizer_cli {
+
+/// Lowest job priority
+constexpr unsigned k_min_priority = 1;
+/// Highest job priority
+constexpr unsigned k_max_priority = 100;
+/// Priority of jobs submitted without one
+constexpr unsigned k_default_priority = 10;
+
+/**
+ * @brief Shares workers between jobs in proportion to their priority
+ *
+ * A stride scheduler: every job has a pass that advances by a stride inversely
+ * proportional to its priority each time one of its units is handed out, and the
+ * job with the lowest pass goes next. A job of priority 20 thus gets twice the
+ * units of a job of priority 10 while both have work, and a job that joins late
+ * starts at the pass of the last dispatch instead of catching up on the time it
+ * was not queued. Not thread-safe, callers hold their own lock.
+ */
+class fair_share_scheduler {
+public:
+    using job_id = std::uint64_t;
+
+    /**
+     * @brief A unit handed to a worker
+     */
+    struct dispatch {
+        job_id job = 0;         ///< Job the unit belongs to
+        std::size_t unit = 0;   ///< Index of the unit in the job, dispatched in order
+    };
+
+    /**
+     * @brief Queues a job
+     * @param units Number of units of the job
+     * @param priority Share of the workers, clamped to [k_min_priority, k_max_priority]
+     * @return Id of the job, unique for the scheduler's lifetime
+     */
+    auto add_job(std::size_t units, unsigned priority) -> job_id;
+
+    /**
+     * @brief Hands out the next unit of the job furthest behind its share
+     * @return The unit, or nullopt if no job has units left
+     */
+    auto next() -> std::optional<dispatch>;
+
+    /**
+     * @brief Marks a dispatched unit of a job finished
+     * @param job Job of the unit
+     * @return Whether that was the job's last unit, the job is forgotten then
+     */
+    auto finish(job_id job) -> bool;
+
+    /**
+     * @brief Drops the units of a job that were not handed out yet
+     *
+     * Units already running still have to be finished.
+     *
+     * @param job Job to cancel
+     * @return Whether no unit of the job is running, the job is forgotten then
+     */
+    auto cancel(job_id job) -> bool;
+
+    /**
+     * @brief Gets whether any job has units left to hand out
+     */
+    [[nodiscard]] auto has_pending() const noexcept -> bool;
+
+    /**
+     * @brief Gets the units of a job not handed out yet, 0 for unknown jobs
+     */
+    [[nodiscard]] auto pending(job_id job) const noexcept -> std::size_t;
+
+    /**
+     * @brief Gets the units of a job handed out but not finished, 0 for unknown jobs
+     */
+    [[nodiscard]] auto running(job_id job) const noexcept -> std::size_t;
+
+    /**
+     * @brief Gets the number of jobs with units pending or running
+     */
+    [[nodiscard]] auto jobs() const noexcept -> std::size_t { return jobs_.size(); }
+
+private:
+    struct job_state {
+        std::size_t units = 0;      ///< Units of the job, lowered on cancel
+        std::size_t next_unit = 0;  ///< Next unit to hand out
+        std::size_t running = 0;    ///< Units handed out but not finished
+        std::uint64_t stride = 0;   ///< Pass advance per unit
+        std::uint64_t pass = 0;     ///< Virtual time of the job's next unit
+    };
+
+    std::map<job_id, job_state> jobs_;  ///< Jobs by id, so equal passes go first come first
+    job_id next_id_ = 1;                ///< Id of the next job
+    std::uint64_t pass_ = 0;            ///< Pass of the last dispatch
+};
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_FAIR_SHARE_H
@@ -1,10 +1,17 @@
 #include <spdlog/common.h>
 #include <spdlog/spdlog.h>
 
+#include <cstdint>
 #include <iostream>
+#include <random>
+#include <utility>
 
 #include "analyze.h"
 #include "cli_args.h"
+#include "daemon.h"
+#include "diverge.h"
+#include "evaluate.h"
+#include "shard.h"
 #include "simulate.h"
 
 int main(int argc, char* argv[]) {
@@ -43,14 +50,145 @@ int main(int argc, char* argv[]) {
             const auto& simulate_args =
                 std::get<cshorelark::optimizer_cli::simulate_args>(args.args);
 
+            // Without a seed the sweep cannot be split or repeated, log the one drawn
+            std::uint64_t seed = 0;
+            if (simulate_args.seed) {
+                seed = *simulate_args.seed;
+            } else {
+                std::random_device device;
+                seed = (static_cast<std::uint64_t>(device()) << 32U) | device();
+                spdlog::info("No seed given, using {}", seed);
+            }
+
+            // Hand the sweep to a running daemon, which streams the results back
+            if (simulate_args.daemon_port) {
+                cshorelark::optimizer_cli::job_request request;
+                request.name = simulate_args.output_path.filename().string();
+                request.priority = simulate_args.priority;
+                request.iterations = simulate_args.iterations;
+                request.generations = simulate_args.generations;
+                request.seed = seed;
+                request.shard = simulate_args.shard;
+                request.kernels = simulate_args.kernels;
+
+                auto result = cshorelark::optimizer_cli::submit_sweep(
+                    "127.0.0.1", *simulate_args.daemon_port, request, simulate_args.output_path);
+                if (!result) {
+                    spdlog::error(result.error());
+                    return 1;
+                }
+                spdlog::info(result.value());
+                break;
+            }
+
             // Create and run simulation
+            cshorelark::optimizer_cli::sweep_options options;
+            options.shard = simulate_args.shard;
+            options.seed = seed;
+            options.placement = simulate_args.placement;
+            options.memory_budget = simulate_args.memory_budget_mib << 20U;
+            options.interleave = simulate_args.interleave;
+            options.kernels = simulate_args.kernels;
+            options.kernel_cache = simulate_args.kernel_cache;
+            options.digest_dir = simulate_args.digest_dir;
+            options.lineage_dir = simulate_args.lineage_dir;
+            options.warm_start = simulate_args.warm_start;
+            options.target_fitness = simulate_args.target_fitness;
+            options.metrics_port = simulate_args.metrics_port;
+
             cshorelark::optimizer_cli::simulation_runner runner(
-                simulate_args.iterations, simulate_args.generations, simulate_args.output_path);
+                simulate_args.iterations, simulate_args.generations, simulate_args.output_path,
+                options);
 
             runner.run();
 
             break;
         }
+
+        case cshorelark::optimizer_cli::cli_args::command_type::evaluate: {
+            // Handle evaluate command
+            const auto& evaluate_args =
+                std::get<cshorelark::optimizer_cli::evaluate_args>(args.args);
+
+            auto genomes = cshorelark::optimizer_cli::load_genomes(evaluate_args.input_path);
+            if (!genomes) {
+                spdlog::error(genomes.error());
+                return 1;
+            }
+
+            const cshorelark::optimizer_cli::evaluation_arena arena(
+                std::move(*genomes), evaluate_args.episodes, evaluate_args.seed);
+            auto reports = arena.run(evaluate_args.threads);
+            if (!reports) {
+                spdlog::error(reports.error());
+                return 1;
+            }
+
+            for (const auto& report : *reports) {
+                spdlog::info("Genome {}: mean {:.2f} (std dev {:.2f}), median {:.1f}, range {}-{}",
+                             report.index, report.summary.avg_fitness, report.std_dev,
+                             report.summary.median_fitness, report.summary.min_fitness,
+                             report.summary.max_fitness);
+            }
+
+            auto saved = cshorelark::optimizer_cli::save_reports(evaluate_args.output_path,
+                                                                 *reports, evaluate_args.seed);
+            if (!saved) {
+                spdlog::error(saved.error());
+                return 1;
+            }
+            spdlog::info(saved.value());
+            break;
+        }
+
+        case cshorelark::optimizer_cli::cli_args::command_type::merge: {
+            // Handle merge command
+            const auto& merge_args = std::get<cshorelark::optimizer_cli::merge_args>(args.args);
+
+            auto result = cshorelark::optimizer_cli::merge_logs(merge_args.input_paths,
+                                                                merge_args.output_path);
+            if (!result) {
+                spdlog::error(result.error());
+                return 1;
+            }
+
+            spdlog::info(result.value());
+            break;
+        }
+
+        case cshorelark::optimizer_cli::cli_args::command_type::diverge: {
+            // Handle diverge command, failing on the first divergence so CI can gate on it
+            const auto& diverge_args =
+                std::get<cshorelark::optimizer_cli::diverge_args>(args.args);
+
+            auto result = cshorelark::optimizer_cli::compare_digests(diverge_args.reference_path,
+                                                                     diverge_args.candidate_path);
+            if (!result) {
+                spdlog::error(result.error());
+                return 1;
+            }
+
+            spdlog::info(result.value());
+            break;
+        }
+
+        case cshorelark::optimizer_cli::cli_args::command_type::daemon: {
+            // Handle daemon command, serving jobs until interrupted
+            const auto& daemon_args = std::get<cshorelark::optimizer_cli::daemon_args>(args.args);
+
+            cshorelark::optimizer_cli::daemon_options options;
+            options.port = daemon_args.port;
+            options.workers = daemon_args.workers;
+            options.kernel_cache = daemon_args.kernel_cache;
+
+            cshorelark::optimizer_cli::sweep_daemon daemon(options);
+            if (auto started = daemon.start(); !started) {
+                spdlog::error(started.error());
+                return 1;
+            }
+            daemon.wait_for_signal();
+            break;
+        }
     }
 
     return 0;
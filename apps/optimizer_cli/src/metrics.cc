@@ -0,0 +1,332 @@
+#include "metrics.h"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <asio.hpp>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace cshorelark::optimizer_cli {
+
+using asio::ip::tcp;
+
+namespace {
+
+// Longest request head accepted, scrapers send a few hundred bytes
+constexpr std::size_t k_max_request_bytes = 8192;
+constexpr std::int64_t k_idle = -1;
+constexpr double k_ns_per_second = 1e9;
+
+void write_header(std::string& out, const char* name, const char* type, const char* help) {
+    fmt::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name,
+                   type);
+}
+
+template <typename Value>
+void write_sample(std::string& out, const char* name, const char* type, const char* help,
+                  Value value) {
+    write_header(out, name, type, help);
+    fmt::format_to(std::back_inserter(out), "{} {}\n", name, value);
+}
+
+auto per_second(std::uint64_t count, double seconds) -> double {
+    return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+}
+
+}  // namespace
+
+/**
+ * @brief Counters of one worker, written by that worker only
+ */
+struct alignas(64) sweep_metrics::worker_counters {
+    std::atomic<std::uint64_t> steps{0};              ///< Simulation steps run
+    std::atomic<std::uint64_t> generations{0};        ///< Generations completed
+    std::atomic<std::int64_t> busy_ns{0};             ///< Time spent on finished units
+    std::atomic<std::int64_t> busy_since_ns{k_idle};  ///< Start of the running units, if any
+    std::atomic<std::size_t> running{0};              ///< Units started and not finished
+};
+
+sweep_metrics::sweep_metrics(std::size_t workers, std::size_t total_units)
+    : started_at_(std::chrono::steady_clock::now()),
+      workers_(std::max<std::size_t>(workers, 1)),
+      total_units_(total_units),
+      counters_(std::make_unique<worker_counters[]>(workers_)) {}
+
+sweep_metrics::~sweep_metrics() = default;
+
+auto sweep_metrics::slot(std::size_t worker) noexcept -> worker_counters& {
+    return counters_[std::min(worker, workers_ - 1)];
+}
+
+auto sweep_metrics::now_ns() const noexcept -> std::int64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                started_at_)
+        .count();
+}
+
+// A worker interleaving several units stays busy from the first start to the last finish
+void sweep_metrics::unit_started(std::size_t worker) noexcept {
+    started_.fetch_add(1, std::memory_order_relaxed);
+    auto& counters = slot(worker);
+    if (counters.running.fetch_add(1, std::memory_order_relaxed) == 0) {
+        counters.busy_since_ns.store(now_ns(), std::memory_order_relaxed);
+    }
+}
+
+void sweep_metrics::unit_finished(std::size_t worker) noexcept {
+    auto& counters = slot(worker);
+    if (counters.running.load(std::memory_order_relaxed) > 0 &&
+        counters.running.fetch_sub(1, std::memory_order_relaxed) == 1) {
+        const auto since = counters.busy_since_ns.exchange(k_idle, std::memory_order_relaxed);
+        if (since != k_idle) {
+            counters.busy_ns.fetch_add(now_ns() - since, std::memory_order_relaxed);
+        }
+    }
+    completed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Single writer per slot: a load and a store, no locked read-modify-write on the step path
+void sweep_metrics::add_step(std::size_t worker) noexcept {
+    auto& steps = slot(worker).steps;
+    steps.store(steps.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void sweep_metrics::add_generation(std::size_t worker) noexcept {
+    auto& generations = slot(worker).generations;
+    generations.store(generations.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+}
+
+void sweep_metrics::results_recorded(std::size_t count) noexcept {
+    recorded_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void sweep_metrics::results_written(std::size_t count) noexcept {
+    written_.fetch_add(count, std::memory_order_relaxed);
+}
+
+auto sweep_metrics::render() const -> std::string {
+    const auto now = now_ns();
+    const double elapsed = static_cast<double>(now) / k_ns_per_second;
+    std::uint64_t steps = 0;
+    std::uint64_t generations = 0;
+    for (std::size_t worker = 0; worker < workers_; ++worker) {
+        steps += counters_[worker].steps.load(std::memory_order_relaxed);
+        generations += counters_[worker].generations.load(std::memory_order_relaxed);
+    }
+    const auto started = started_.load(std::memory_order_relaxed);
+    const auto completed = completed_.load(std::memory_order_relaxed);
+    const auto recorded = recorded_.load(std::memory_order_relaxed);
+    const auto written = written_.load(std::memory_order_relaxed);
+
+    std::string out;
+    write_sample(out, "cshorelark_sweep_elapsed_seconds", "gauge",
+                 "Seconds since the sweep started", elapsed);
+    write_sample(out, "cshorelark_sweep_units", "gauge", "Work units in this shard of the sweep",
+                 total_units_);
+    write_sample(out, "cshorelark_sweep_units_completed_total", "counter",
+                 "Work units finished", completed);
+    write_sample(out, "cshorelark_sweep_queue_depth", "gauge",
+                 "Work units no worker has picked up yet",
+                 total_units_ - std::min<std::uint64_t>(started, total_units_));
+    write_sample(out, "cshorelark_sweep_steps_total", "counter", "Simulation steps run", steps);
+    write_sample(out, "cshorelark_sweep_steps_per_second", "gauge",
+                 "Simulation steps per second since the sweep started",
+                 per_second(steps, elapsed));
+    write_sample(out, "cshorelark_sweep_generations_total", "counter", "Generations completed",
+                 generations);
+    write_sample(out, "cshorelark_sweep_generations_per_second", "gauge",
+                 "Generations per second since the sweep started",
+                 per_second(generations, elapsed));
+    write_sample(out, "cshorelark_sweep_results_pending", "gauge",
+                 "Results recorded but not yet saved by the result writer",
+                 recorded - std::min(written, recorded));
+
+    // A unit still running counts up to now
+    std::string busy;
+    std::string utilization;
+    write_header(busy, "cshorelark_sweep_worker_busy_seconds_total", "counter",
+                 "Seconds each worker spent running work units");
+    write_header(utilization, "cshorelark_sweep_worker_utilization", "gauge",
+                 "Share of the elapsed time each worker spent running work units");
+    for (std::size_t worker = 0; worker < workers_; ++worker) {
+        const auto& counters = counters_[worker];
+        const auto since = counters.busy_since_ns.load(std::memory_order_relaxed);
+        const auto busy_ns = counters.busy_ns.load(std::memory_order_relaxed) +
+                             (since == k_idle ? 0 : std::max<std::int64_t>(now - since, 0));
+        const double seconds = static_cast<double>(busy_ns) / k_ns_per_second;
+        fmt::format_to(std::back_inserter(busy), "{}{{worker=\"{}\"}} {}\n",
+                       "cshorelark_sweep_worker_busy_seconds_total", worker, seconds);
+        fmt::format_to(std::back_inserter(utilization), "{}{{worker=\"{}\"}} {}\n",
+                       "cshorelark_sweep_worker_utilization", worker,
+                       elapsed > 0.0 ? std::min(seconds / elapsed, 1.0) : 0.0);
+    }
+    out += busy;
+    out += utilization;
+
+    if (const auto rss = resident_set_bytes()) {
+        write_sample(out, "process_resident_memory_bytes", "gauge", "Resident memory size in bytes",
+                     *rss);
+    }
+    return out;
+}
+
+auto resident_set_bytes() -> std::optional<std::size_t> {
+#ifdef __linux__
+    // Second field of statm is the resident size in pages
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size_pages = 0;
+    std::size_t resident_pages = 0;
+    if (!(statm >> size_pages >> resident_pages)) {
+        return std::nullopt;
+    }
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        return std::nullopt;
+    }
+    return resident_pages * static_cast<std::size_t>(page_size);
+#else
+    return std::nullopt;
+#endif
+}
+
+struct metrics_server::impl {
+    impl(const sweep_metrics& counters, std::string listen_address, std::uint16_t listen_port)
+        : metrics(counters), address(std::move(listen_address)), port(listen_port) {}
+
+    void accept();
+
+    const sweep_metrics& metrics;
+    std::string address;
+    std::uint16_t port;
+    asio::io_context io;
+    tcp::acceptor acceptor{io};
+    std::thread thread;
+};
+
+namespace {
+
+/**
+ * @brief One scrape: reads the request head, answers and closes
+ */
+class metrics_connection : public std::enable_shared_from_this<metrics_connection> {
+public:
+    metrics_connection(tcp::socket socket, std::function<std::string()> render)
+        : socket_(std::move(socket)),
+          request_(k_max_request_bytes),
+          render_(std::move(render)) {}
+
+    void start() {
+        asio::async_read_until(
+            socket_, request_, "\r\n\r\n",
+            [self = shared_from_this()](const asio::error_code& error, std::size_t) {
+                if (error) {
+                    self->close();
+                    return;
+                }
+                self->respond();
+            });
+    }
+
+private:
+    void respond() {
+        std::istream request(&request_);
+        std::string method;
+        std::string target;
+        request >> method >> target;
+
+        std::string status = "200 OK";
+        std::string body;
+        if (method != "GET") {
+            status = "405 Method Not Allowed";
+        } else if (target == "/metrics") {
+            body = render_();
+        } else {
+            status = "404 Not Found";
+        }
+        response_ = fmt::format(
+            "HTTP/1.1 {}\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+            "Content-Length: {}\r\nConnection: close\r\n\r\n{}",
+            status, body.size(), body);
+        asio::async_write(socket_, asio::buffer(response_),
+                          [self = shared_from_this()](const asio::error_code&, std::size_t) {
+                              self->close();
+                          });
+    }
+
+    void close() {
+        asio::error_code ignored;
+        socket_.shutdown(tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+    }
+
+    tcp::socket socket_;
+    asio::streambuf request_;
+    std::function<std::string()> render_;
+    std::string response_;
+};
+
+}  // namespace
+
+void metrics_server::impl::accept() {
+    acceptor.async_accept([this](const asio::error_code& error, tcp::socket socket) {
+        if (error) {
+            if (error != asio::error::operation_aborted) {
+                spdlog::warn("Metrics accept failed: {}", error.message());
+                accept();
+            }
+            return;
+        }
+        // The metrics outlive the server, so connections only need a pointer to them
+        std::make_shared<metrics_connection>(std::move(socket), [counters = &metrics] {
+            return counters->render();
+        })->start();
+        accept();
+    });
+}
+
+metrics_server::metrics_server(const sweep_metrics& metrics, std::string address,
+                               std::uint16_t port)
+    : impl_(std::make_shared<impl>(metrics, std::move(address), port)) {}
+
+metrics_server::~metrics_server() { stop(); }
+
+auto metrics_server::start() -> tl::expected<std::uint16_t, std::string> {
+    try {
+        const tcp::endpoint endpoint(asio::ip::make_address(impl_->address), impl_->port);
+        impl_->acceptor.open(endpoint.protocol());
+        impl_->acceptor.set_option(tcp::acceptor::reuse_address(true));
+        impl_->acceptor.bind(endpoint);
+        impl_->acceptor.listen();
+    } catch (const std::exception& e) {
+        return tl::make_unexpected(fmt::format("Cannot serve metrics on {}:{}: {}",
+                                               impl_->address, impl_->port, e.what()));
+    }
+
+    const auto port = impl_->acceptor.local_endpoint().port();
+    impl_->accept();
+    impl_->thread = std::thread([server = impl_] { server->io.run(); });
+    spdlog::info("Serving metrics on http://{}:{}/metrics", impl_->address, port);
+    return port;
+}
+
+void metrics_server::stop() {
+    if (!impl_->thread.joinable()) {
+        return;
+    }
+    // Scrapes in flight are cut short, the server has nothing left to report
+    impl_->io.stop();
+    impl_->thread.join();
+}
+
+}  // namespace cshorelark::optimizer_cli
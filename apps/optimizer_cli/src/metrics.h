@@ -0,0 +1,145 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_METRICS_H
+#define CSHORELARK_OPTIMIZER_CLI_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tl/expected.hpp>
+
+namespace cshorelark::optimizer_cli {
+
+/**
+ * @brief Live counters of a running sweep
+ *
+ * Workers update their own cache line with relaxed atomics and never wait on a
+ * reader; render() sums the lines whenever a scrape comes in, so a scrape may
+ * see one worker a step ahead of another but never blocks the sweep.
+ */
+class sweep_metrics {
+public:
+    /**
+     * @brief Creates zeroed counters, starting the elapsed time now
+     * @param workers Number of worker threads
+     * @param total_units Work units the sweep will run
+     */
+    sweep_metrics(std::size_t workers, std::size_t total_units);
+
+    sweep_metrics(const sweep_metrics&) = delete;
+    sweep_metrics& operator=(const sweep_metrics&) = delete;
+    sweep_metrics(sweep_metrics&&) = delete;
+    sweep_metrics& operator=(sweep_metrics&&) = delete;
+    ~sweep_metrics();
+
+    /**
+     * @brief Marks a worker busy with a new work unit
+     * @param worker Index of the worker, from 0
+     */
+    void unit_started(std::size_t worker) noexcept;
+
+    /**
+     * @brief Counts a finished unit, marking its worker idle once none of its units run
+     * @param worker Index of the worker, from 0
+     */
+    void unit_finished(std::size_t worker) noexcept;
+
+    /**
+     * @brief Counts one simulation step, only ever called by the worker itself
+     * @param worker Index of the worker, from 0
+     */
+    void add_step(std::size_t worker) noexcept;
+
+    /**
+     * @brief Counts one completed generation, only ever called by the worker itself
+     * @param worker Index of the worker, from 0
+     */
+    void add_generation(std::size_t worker) noexcept;
+
+    /**
+     * @brief Counts results handed to the result writer
+     * @param count Number of results
+     */
+    void results_recorded(std::size_t count) noexcept;
+
+    /**
+     * @brief Counts results the result writer has saved
+     * @param count Number of results
+     */
+    void results_written(std::size_t count) noexcept;
+
+    /**
+     * @brief Renders every metric in the Prometheus text exposition format
+     * @return Metrics text, one sample per line
+     */
+    [[nodiscard]] auto render() const -> std::string;
+
+private:
+    struct worker_counters;
+
+    [[nodiscard]] auto slot(std::size_t worker) noexcept -> worker_counters&;
+    [[nodiscard]] auto now_ns() const noexcept -> std::int64_t;
+
+    std::chrono::steady_clock::time_point started_at_;  ///< Zero of the elapsed time
+    std::size_t workers_;                                ///< Number of worker slots
+    std::size_t total_units_;                            ///< Units of the whole sweep
+    std::unique_ptr<worker_counters[]> counters_;        ///< One cache line per worker
+    std::atomic<std::uint64_t> started_{0};              ///< Units a worker picked up
+    std::atomic<std::uint64_t> completed_{0};            ///< Units finished
+    std::atomic<std::uint64_t> recorded_{0};             ///< Results handed to the writer
+    std::atomic<std::uint64_t> written_{0};              ///< Results the writer saved
+};
+
+/**
+ * @brief Reads the resident set size of this process
+ * @return Bytes in RAM, or nullopt where the platform does not say
+ */
+auto resident_set_bytes() -> std::optional<std::size_t>;
+
+/**
+ * @brief Serves sweep metrics over HTTP for Prometheus to scrape
+ *
+ * Answers GET /metrics on its own thread, closing the connection after every
+ * response. Any other path gets 404.
+ */
+class metrics_server {
+public:
+    /**
+     * @brief Creates a server, call start() to listen
+     * @param metrics Counters to serve, must outlive the server
+     * @param address Address to listen on
+     * @param port Port to listen on, 0 picks a free one
+     */
+    metrics_server(const sweep_metrics& metrics, std::string address, std::uint16_t port);
+
+    /**
+     * @brief Stops the server
+     */
+    ~metrics_server();
+
+    metrics_server(const metrics_server&) = delete;
+    metrics_server& operator=(const metrics_server&) = delete;
+    metrics_server(metrics_server&&) = delete;
+    metrics_server& operator=(metrics_server&&) = delete;
+
+    /**
+     * @brief Binds the listening socket and starts the server thread
+     * @return The bound port, or an error message
+     */
+    auto start() -> tl::expected<std::uint16_t, std::string>;
+
+    /**
+     * @brief Stops the server thread, safe to call more than once
+     */
+    void stop();
+
+private:
+    struct impl;
+    std::shared_ptr<impl> impl_;
+};
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_METRICS_H
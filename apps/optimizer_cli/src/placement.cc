@@ -0,0 +1,211 @@
+#include "placement.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cshorelark::optimizer_cli {
+
+namespace {
+
+thread_local std::size_t t_current_node = 0;
+
+auto parse_cpu(std::string_view text) -> tl::expected<unsigned, std::string> {
+    unsigned value = 0;
+    const auto* end = text.data() + text.size();
+    const auto [ptr, error] = std::from_chars(text.data(), end, value);
+    if (text.empty() || error != std::errc() || ptr != end) {
+        return tl::make_unexpected("Not a CPU id: '" + std::string(text) + "'");
+    }
+    return value;
+}
+
+// Every CPU on one node, used when the topology cannot be read
+auto single_node() -> cpu_topology {
+    const unsigned count = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<unsigned> cpus(count);
+    for (unsigned cpu = 0; cpu < count; ++cpu) {
+        cpus[cpu] = cpu;
+    }
+    return cpu_topology{{std::move(cpus)}};
+}
+
+// CPUs visited alternating between nodes, paired with their node
+auto scatter_order(const cpu_topology& topology)
+    -> std::vector<std::pair<std::size_t, unsigned>> {
+    std::vector<std::pair<std::size_t, unsigned>> order;
+    order.reserve(topology.cpu_count());
+    for (std::size_t rank = 0; order.size() < topology.cpu_count(); ++rank) {
+        for (std::size_t node = 0; node < topology.nodes.size(); ++node) {
+            if (rank < topology.nodes[node].size()) {
+                order.emplace_back(node, topology.nodes[node][rank]);
+            }
+        }
+    }
+    return order;
+}
+
+}  // namespace
+
+auto cpu_topology::cpu_count() const noexcept -> std::size_t {
+    std::size_t count = 0;
+    for (const auto& cpus : nodes) {
+        count += cpus.size();
+    }
+    return count;
+}
+
+auto parse_placement(std::string_view text) -> tl::expected<placement_policy, std::string> {
+    for (const auto policy : {placement_policy::k_none, placement_policy::k_compact,
+                              placement_policy::k_scatter, placement_policy::k_per_node}) {
+        if (text == to_string(policy)) {
+            return policy;
+        }
+    }
+    return tl::make_unexpected("Placement must be none, compact, scatter or per-node, got '" +
+                               std::string(text) + "'");
+}
+
+auto to_string(placement_policy policy) -> std::string_view {
+    switch (policy) {
+        case placement_policy::k_compact:
+            return "compact";
+        case placement_policy::k_scatter:
+            return "scatter";
+        case placement_policy::k_per_node:
+            return "per-node";
+        case placement_policy::k_none:
+        default:
+            return "none";
+    }
+}
+
+auto parse_cpu_list(std::string_view text) -> tl::expected<std::vector<unsigned>, std::string> {
+    while (!text.empty() && (text.back() == '\n' || text.back() == ' ')) {
+        text.remove_suffix(1);
+    }
+
+    std::vector<unsigned> cpus;
+    while (!text.empty()) {
+        const auto comma = text.find(',');
+        const auto range = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+
+        const auto dash = range.find('-');
+        auto first = parse_cpu(range.substr(0, dash));
+        auto last = dash == std::string_view::npos ? first : parse_cpu(range.substr(dash + 1));
+        if (!first) {
+            return tl::make_unexpected(first.error());
+        }
+        if (!last) {
+            return tl::make_unexpected(last.error());
+        }
+        if (*last < *first) {
+            return tl::make_unexpected("Decreasing CPU range: '" + std::string(range) + "'");
+        }
+        for (unsigned cpu = *first; cpu <= *last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+auto detect_topology() -> cpu_topology {
+#ifdef __linux__
+    const std::filesystem::path root = "/sys/devices/system/node";
+    cpu_topology topology;
+    std::error_code error;
+    for (std::size_t node = 0;; ++node) {
+        const auto path = root / ("node" + std::to_string(node)) / "cpulist";
+        if (!std::filesystem::exists(path, error)) {
+            break;
+        }
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        auto cpus = parse_cpu_list(line);
+        if (!cpus) {
+            return single_node();
+        }
+        // Memory-only nodes have no CPUs and take no workers
+        if (!cpus->empty()) {
+            topology.nodes.push_back(std::move(*cpus));
+        }
+    }
+    if (topology.cpu_count() > 0) {
+        return topology;
+    }
+#endif
+    return single_node();
+}
+
+auto plan_placement(const cpu_topology& topology, placement_policy policy, std::size_t workers)
+    -> std::vector<worker_slot> {
+    std::vector<worker_slot> slots;
+    if (policy == placement_policy::k_none || topology.cpu_count() == 0) {
+        return slots;
+    }
+
+    std::vector<std::pair<std::size_t, unsigned>> order;
+    if (policy == placement_policy::k_compact) {
+        for (std::size_t node = 0; node < topology.nodes.size(); ++node) {
+            for (const auto cpu : topology.nodes[node]) {
+                order.emplace_back(node, cpu);
+            }
+        }
+    } else {
+        order = scatter_order(topology);
+    }
+
+    slots.reserve(workers);
+    for (std::size_t worker = 0; worker < workers; ++worker) {
+        const auto& [node, cpu] = order[worker % order.size()];
+        if (policy == placement_policy::k_per_node) {
+            // Pools get workers in proportion to their CPUs, free to move within the node
+            slots.push_back(worker_slot{node, topology.nodes[node]});
+        } else {
+            slots.push_back(worker_slot{node, {cpu}});
+        }
+    }
+    return slots;
+}
+
+auto pin_current_thread(const worker_slot& slot) -> bool {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto cpu : slot.cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        return false;
+    }
+    t_current_node = slot.node;
+
+    // Allocate on the node the thread runs on, even if the process was started interleaved.
+    // Failure only costs locality, so it is not reported.
+    syscall(SYS_set_mempolicy, MPOL_LOCAL, nullptr, 0);
+    return true;
+#else
+    static_cast<void>(slot);
+    return false;
+#endif
+}
+
+auto current_node() noexcept -> std::size_t { return t_current_node; }
+
+}  // namespace cshorelark::optimizer_cli
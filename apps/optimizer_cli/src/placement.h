@@ -0,0 +1,102 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_PLACEMENT_H
+#define CSHORELARK_OPTIMIZER_CLI_PLACEMENT_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tl/expected.hpp>
+#include <vector>
+
+namespace cshorelark::optimizer_cli {
+
+/**
+ * @brief How sweep worker threads are placed on CPUs
+ */
+enum class placement_policy {
+    k_none,     ///< Leave placement to the scheduler
+    k_compact,  ///< One CPU per worker, filling a NUMA node before using the next
+    k_scatter,  ///< One CPU per worker, alternating between NUMA nodes
+    k_per_node  ///< Workers split into one pool per NUMA node, free within their node
+};
+
+/**
+ * @brief CPUs of the machine grouped by NUMA node
+ */
+struct cpu_topology {
+    std::vector<std::vector<unsigned>> nodes;  ///< CPU ids of each node
+
+    /**
+     * @brief Gets the total number of CPUs
+     */
+    [[nodiscard]] auto cpu_count() const noexcept -> std::size_t;
+};
+
+/**
+ * @brief CPUs a worker thread is pinned to
+ */
+struct worker_slot {
+    std::size_t node = 0;        ///< NUMA node of the CPUs
+    std::vector<unsigned> cpus;  ///< CPUs the worker may run on
+};
+
+/**
+ * @brief Parses a placement policy name: none, compact, scatter or per-node
+ *
+ * @param text Policy name
+ * @return The policy or an error message
+ */
+auto parse_placement(std::string_view text) -> tl::expected<placement_policy, std::string>;
+
+/**
+ * @brief Gets the name of a placement policy, as accepted by parse_placement
+ */
+auto to_string(placement_policy policy) -> std::string_view;
+
+/**
+ * @brief Parses a kernel CPU list such as "0-3,8,10-11"
+ *
+ * @param text CPU list
+ * @return The CPU ids in order or an error message
+ */
+auto parse_cpu_list(std::string_view text) -> tl::expected<std::vector<unsigned>, std::string>;
+
+/**
+ * @brief Detects the NUMA topology of the machine
+ *
+ * Reads /sys/devices/system/node on Linux; elsewhere, or when it cannot be
+ * read, every CPU is reported on a single node.
+ */
+auto detect_topology() -> cpu_topology;
+
+/**
+ * @brief Assigns CPUs to workers according to a policy
+ *
+ * With more workers than CPUs the assignment wraps around.
+ *
+ * @param topology Machine topology
+ * @param policy Placement policy
+ * @param workers Number of worker threads
+ * @return One slot per worker, empty for placement_policy::k_none
+ */
+auto plan_placement(const cpu_topology& topology, placement_policy policy, std::size_t workers)
+    -> std::vector<worker_slot>;
+
+/**
+ * @brief Pins the calling thread to a slot
+ *
+ * Also asks the kernel to allocate the thread's memory on its own node, so
+ * worlds and brains built by the worker stay local to it.
+ *
+ * @param slot CPUs to run on
+ * @return Whether the thread could be pinned; always false outside Linux
+ */
+auto pin_current_thread(const worker_slot& slot) -> bool;
+
+/**
+ * @brief Gets the NUMA node of the calling thread's slot, 0 when it is not pinned
+ */
+auto current_node() noexcept -> std::size_t;
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_PLACEMENT_H
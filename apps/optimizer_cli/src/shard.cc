@@ -0,0 +1,159 @@
+#include "shard.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "random/random.h"
+
+namespace cshorelark::optimizer_cli {
+
+using json = nlohmann::json;
+
+namespace {
+
+auto parse_size(std::string_view text) -> tl::expected<std::size_t, std::string> {
+    std::size_t value = 0;
+    const auto* end = text.data() + text.size();
+    const auto [ptr, error] = std::from_chars(text.data(), end, value);
+    if (text.empty() || error != std::errc() || ptr != end) {
+        return tl::make_unexpected("Not a number: '" + std::string(text) + "'");
+    }
+    return value;
+}
+
+}  // namespace
+
+auto parse_shard(std::string_view text) -> tl::expected<shard_spec, std::string> {
+    const auto slash = text.find('/');
+    if (slash == std::string_view::npos) {
+        return tl::make_unexpected("Shard must be given as i/n, got '" + std::string(text) + "'");
+    }
+    auto index = parse_size(text.substr(0, slash));
+    auto count = parse_size(text.substr(slash + 1));
+    if (!index) {
+        return tl::make_unexpected(index.error());
+    }
+    if (!count) {
+        return tl::make_unexpected(count.error());
+    }
+    if (*count == 0 || *index >= *count) {
+        return tl::make_unexpected("Shard index must be in [0, n), got '" + std::string(text) +
+                                   "'");
+    }
+    return shard_spec{*index, *count};
+}
+
+auto estimate_cost(const simulation::config& config, std::size_t generations) -> double {
+    const auto cells = static_cast<double>(config.brain_eye.num_cells);
+    const auto neurons = static_cast<double>(config.brain_eye.num_neurons);
+    const double weights = (cells + 1.0) * neurons + (neurons + 1.0) * 2.0;
+    const auto animals = static_cast<double>(config.world.num_animals);
+    const auto foods = static_cast<double>(config.world.num_foods);
+
+    const double per_step = animals * (2.0 * foods + weights);
+    const double steps = static_cast<double>(generations) *
+                         static_cast<double>(config.sim.generation_length + 1);
+    return per_step * steps;
+}
+
+auto plan_shard(const std::vector<simulation::config>& configs, std::size_t iterations,
+                std::size_t generations, std::uint64_t seed, shard_spec shard)
+    -> std::vector<work_unit> {
+    std::vector<work_unit> units;
+    units.reserve(configs.size() * iterations);
+    for (std::size_t config_index = 0; config_index < configs.size(); ++config_index) {
+        const double cost = estimate_cost(configs[config_index], generations);
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+            const auto stream = static_cast<std::uint64_t>(config_index * iterations + iteration);
+            units.push_back(work_unit{config_index, iteration,
+                                      cshorelark::random::derive_seed(seed, stream), cost});
+        }
+    }
+
+    // Longest processing time first, ties in sweep order
+    std::stable_sort(units.begin(), units.end(), [](const work_unit& lhs, const work_unit& rhs) {
+        return lhs.cost > rhs.cost;
+    });
+
+    std::vector<double> loads(shard.count, 0.0);
+    std::vector<work_unit> mine;
+    for (const auto& unit : units) {
+        const auto lightest = static_cast<std::size_t>(
+            std::distance(loads.begin(), std::min_element(loads.begin(), loads.end())));
+        loads[lightest] += unit.cost;
+        if (lightest == shard.index) {
+            mine.push_back(unit);
+        }
+    }
+    return mine;
+}
+
+auto merge_logs(const std::vector<std::filesystem::path>& input_paths,
+                const std::filesystem::path& output_path)
+    -> tl::expected<std::string, std::string> {
+    try {
+        using entry_key = std::tuple<std::size_t, std::size_t, std::size_t>;
+        std::map<entry_key, json> entries;
+        std::map<std::pair<std::size_t, std::size_t>, std::size_t> unit_sources;
+
+        for (std::size_t source = 0; source < input_paths.size(); ++source) {
+            const auto& path = input_paths[source];
+            std::ifstream file(path);
+            if (!file) {
+                return tl::make_unexpected("Failed to open shard log: " + path.string());
+            }
+            const json log = json::parse(file);
+            if (!log.is_array()) {
+                return tl::make_unexpected("Shard log is not a JSON array: " + path.string());
+            }
+
+            for (const auto& entry : log) {
+                const auto& context = entry.at("ctxt");
+                if (!context.contains("c")) {
+                    return tl::make_unexpected("Shard log has no configuration indices: " +
+                                               path.string());
+                }
+                const auto config_index = context.at("c").get<std::size_t>();
+                const auto iteration = context.at("i").get<std::size_t>();
+                const auto generation = context.at("g").get<std::size_t>();
+
+                const auto [unit, inserted] =
+                    unit_sources.try_emplace({config_index, iteration}, source);
+                if (!inserted && unit->second != source) {
+                    return tl::make_unexpected(
+                        fmt::format("Work unit (config {}, iteration {}) appears in both {} and {}",
+                                    config_index, iteration,
+                                    input_paths[unit->second].string(), path.string()));
+                }
+                entries[{config_index, iteration, generation}] = entry;
+            }
+        }
+
+        json merged = json::array();
+        for (auto& [key, entry] : entries) {
+            merged.push_back(std::move(entry));
+        }
+
+        std::ofstream file(output_path);
+        if (!file) {
+            return tl::make_unexpected("Failed to open output file: " + output_path.string());
+        }
+        file << merged.dump(2);
+
+        return fmt::format("Merged {} work units from {} shard logs into {}",
+                           unit_sources.size(), input_paths.size(), output_path.string());
+    } catch (const std::exception& e) {
+        return tl::make_unexpected(std::string("Error merging shard logs: ") + e.what());
+    }
+}
+
+}  // namespace cshorelark::optimizer_cli
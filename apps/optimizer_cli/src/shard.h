@@ -0,0 +1,93 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_SHARD_H
+#define CSHORELARK_OPTIMIZER_CLI_SHARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <tl/expected.hpp>
+#include <vector>
+
+#include "simulation/config.h"
+
+namespace cshorelark::optimizer_cli {
+
+/**
+ * @brief Slice of a sweep taken by one process
+ */
+struct shard_spec {
+    std::size_t index = 0;  ///< Zero-based shard index, below count
+    std::size_t count = 1;  ///< Total number of shards
+};
+
+/**
+ * @brief One simulation of a sweep: a configuration and an iteration of it
+ */
+struct work_unit {
+    std::size_t config_index = 0;  ///< Index into the combination list
+    std::size_t iteration = 0;     ///< Iteration of the configuration
+    std::uint64_t seed = 0;        ///< Seed of the unit's random generator
+    double cost = 0.0;             ///< Estimated cost, in relative units
+};
+
+/**
+ * @brief Parses a shard given as "i/n"
+ *
+ * @param text Shard text, i in [0, n)
+ * @return The shard or an error message
+ */
+auto parse_shard(std::string_view text) -> tl::expected<shard_spec, std::string>;
+
+/**
+ * @brief Estimates the cost of one simulation of a configuration
+ *
+ * Proportional to the work done per step (collisions and vision scan every
+ * food for every animal, inference touches every brain weight) times the
+ * number of steps.
+ *
+ * @param config Simulation configuration
+ * @param generations Number of generations simulated
+ * @return Relative cost
+ */
+auto estimate_cost(const simulation::config& config, std::size_t generations) -> double;
+
+/**
+ * @brief Computes the work units of one shard of a sweep
+ *
+ * Every process of a sweep computes the same plan from the same inputs, so
+ * shards are disjoint and together cover every (config, iteration) unit
+ * without any coordination. Units are assigned greedily, most expensive
+ * first, to the shard with the least estimated cost so far; ties are broken
+ * by index, which keeps the plan deterministic. Each unit's seed is derived
+ * from the sweep seed and the unit's position in the sweep, so it does not
+ * depend on the shard count.
+ *
+ * @param configs All configurations of the sweep
+ * @param iterations Iterations per configuration
+ * @param generations Generations per iteration, used for the cost estimate
+ * @param seed Sweep seed
+ * @param shard Shard to plan for
+ * @return The shard's units, most expensive first
+ */
+auto plan_shard(const std::vector<simulation::config>& configs, std::size_t iterations,
+                std::size_t generations, std::uint64_t seed, shard_spec shard)
+    -> std::vector<work_unit>;
+
+/**
+ * @brief Merges the logs written by the shards of a sweep
+ *
+ * Entries are ordered by configuration, iteration and generation; a unit
+ * present in more than one input is an error.
+ *
+ * @param input_paths Shard logs
+ * @param output_path Path of the merged log
+ * @return Success message or error
+ */
+auto merge_logs(const std::vector<std::filesystem::path>& input_paths,
+                const std::filesystem::path& output_path)
+    -> tl::expected<std::string, std::string>;
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_SHARD_H
@@ -3,27 +3,79 @@
 #include <spdlog/spdlog.h>
 #include <transwarp.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstddef>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <thread>
 
+#include "admission.h"
+#include "autotune.h"
 #include "common.h"
+#include "diverge.h"
+#include "evaluate.h"
+#include "genetic_algorithm/lineage.h"
 #include "simulation/config.h"
+#include "simulation/digest.h"
 #include "simulation/simulation.h"
+#include "simulation/simulation_error.h"
+#include "warm_start.h"
 
 namespace cshorelark::optimizer_cli {
 
 namespace tw = transwarp;
 using json = nlohmann::json;
 
+namespace {
+
+// Index of the executor thread running the current work unit, for the metrics
+thread_local std::size_t t_worker_index = 0;
+
+// Name of the lineage archive of a work unit
+auto lineage_file_name(const work_unit& unit) -> std::string {
+    return std::to_string(unit.config_index) + "-" + std::to_string(unit.iteration) + ".lineage";
+}
+
+// Opens a file a work unit writes to, so an unwritable output directory fails the sweep
+// before any simulation runs
+void check_writable(const std::filesystem::path& path) {
+    std::ofstream probe(path);
+    if (!probe) {
+        throw std::runtime_error("Cannot write to " + path.string());
+    }
+}
+
+// Stops the progress thread when run() returns or throws, a joinable thread would terminate
+struct progress_stopper {
+    std::atomic<bool>& is_done;
+    std::thread& thread;
+
+    ~progress_stopper() {
+        is_done = true;
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+};
+
+}  // namespace
+
 simulation_runner::simulation_runner(size_t iterations, size_t generations,
-                                     std::filesystem::path output_path)
-    : iterations_(iterations), generations_(generations), output_path_(std::move(output_path)) {}
+                                     std::filesystem::path output_path, sweep_options options)
+    : iterations_(iterations),
+      generations_(generations),
+      output_path_(std::move(output_path)),
+      options_(std::move(options)) {}
 
 void simulation_runner::run() {
     spdlog::info("Starting neural network optimization simulation");
@@ -31,12 +83,62 @@ void simulation_runner::run() {
     spdlog::info("Iterations: {}", iterations_);
 
     try {
-        // Generate all parameter combinations to test
+        // Generate all parameter combinations to test and take this shard's slice
         auto combinations = generate_combinations();
-        size_t total_steps = combinations.size() * iterations_;
+        const auto units =
+            plan_shard(combinations, iterations_, generations_, options_.seed, options_.shard);
+        size_t total_steps = units.size();
         spdlog::info(
             "Testing {} parameter combinations with {} iterations each ({} total simulations)",
-            combinations.size(), iterations_, total_steps);
+            combinations.size(), iterations_, combinations.size() * iterations_);
+        spdlog::info("Shard {}/{} with seed {}: {} simulations", options_.shard.index,
+                     options_.shard.count, options_.seed, total_steps);
+
+        // Pick the hot path kernels of every configuration this shard runs. Kernels do not
+        // change results, only speed, so this happens before the sweep is timed.
+        select_kernels(combinations, units);
+        if (!options_.warm_start.empty()) {
+            auto population = load_genomes(options_.warm_start);
+            if (!population) {
+                throw std::runtime_error(population.error());
+            }
+            spdlog::info("Warm starting from {} genomes of {} ({} cells, {} neurons)",
+                         population->genomes.size(), options_.warm_start.string(),
+                         population->config.brain_eye.num_cells,
+                         population->config.brain_eye.num_neurons);
+
+            // Every configuration of the shard must accept the saved genomes, a unit that
+            // cannot start would otherwise only fail once the sweep runs
+            std::vector<bool> checked(combinations.size(), false);
+            for (const auto& unit : units) {
+                if (checked[unit.config_index]) {
+                    continue;
+                }
+                checked[unit.config_index] = true;
+                auto fitted = warm_start_population(*population, combinations[unit.config_index]);
+                if (!fitted) {
+                    throw std::runtime_error("Cannot warm start config " +
+                                             std::to_string(unit.config_index) + ": " +
+                                             fitted.error());
+                }
+            }
+            warm_population_ = std::move(*population);
+        }
+        if (!options_.digest_dir.empty()) {
+            std::filesystem::create_directories(options_.digest_dir);
+            if (!units.empty()) {
+                check_writable(options_.digest_dir / digest_stream_name(units.front().config_index,
+                                                                        units.front().iteration));
+            }
+            spdlog::info("Writing world digests to {}", options_.digest_dir.string());
+        }
+        if (!options_.lineage_dir.empty()) {
+            std::filesystem::create_directories(options_.lineage_dir);
+            if (!units.empty()) {
+                check_writable(options_.lineage_dir / lineage_file_name(units.front()));
+            }
+            spdlog::info("Archiving every generation to {}", options_.lineage_dir.string());
+        }
 
         // Setup tracking for completed steps
         std::atomic<size_t> done_steps{0};
@@ -46,30 +148,129 @@ void simulation_runner::run() {
         auto start_time = std::chrono::steady_clock::now();
         std::thread progress_thread(monitor_progress, total_steps, std::ref(done_steps),
                                     std::ref(is_done), start_time);
+        const progress_stopper stop_progress{is_done, progress_thread};
 
         // Prepare storage for results with thread safety
         std::vector<simulation_log_entry> log_entries;
         std::mutex log_mutex;
 
-        // Create the executor with hardware concurrency
-        transwarp::parallel executor(std::thread::hardware_concurrency());
+        // Create the executor with hardware concurrency, pinning its threads as they start.
+        // Each simulation is built inside its task, so its world and brains are allocated on
+        // the node of the worker running it.
+        const auto topology = detect_topology();
+        const std::size_t workers = std::max(1U, std::thread::hardware_concurrency());
+        const auto slots = plan_placement(topology, options_.placement, workers);
+        std::atomic<size_t> pinned{0};
+        std::vector<size_t> node_units(topology.nodes.size(), 0);
+
+        // Counters the workers update as they go, served over HTTP when asked for
+        metrics_ = std::make_unique<sweep_metrics>(workers, units.size());
+        std::optional<metrics_server> metrics_endpoint;
+        if (options_.metrics_port) {
+            metrics_endpoint.emplace(*metrics_, "127.0.0.1", *options_.metrics_port);
+            if (auto started = metrics_endpoint->start(); !started) {
+                spdlog::warn(started.error());
+            }
+        }
 
-        // Create tasks for each combination
+        transwarp::parallel executor(workers, [&slots, &pinned](std::size_t thread_index) {
+            t_worker_index = thread_index;
+            if (thread_index < slots.size() && pin_current_thread(slots[thread_index])) {
+                pinned.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        // Logs stay in memory until the sweep ends, running units share what is left
+        const size_t log_bytes = units.size() * estimate_log_bytes(generations_);
+        size_t unit_budget = 0;
+        if (options_.memory_budget > 0) {
+            if (log_bytes >= options_.memory_budget) {
+                spdlog::warn("Logs alone need about {} MiB, running one simulation at a time",
+                             log_bytes >> 20U);
+            }
+            unit_budget =
+                log_bytes < options_.memory_budget ? options_.memory_budget - log_bytes : 1;
+        }
+        memory_admission admission(unit_budget, workers);
+        std::mutex admission_mutex;
+        std::condition_variable admission_changed;
+
+        // Tasks run groups of consecutive units, which the plan orders by cost, so the
+        // units interleaved on one worker take about as long as each other
+        const size_t interleave = std::max<size_t>(1, options_.interleave);
+        std::vector<size_t> pending;
+        std::vector<size_t> pending_footprints;
+        for (size_t first = 0; first < units.size(); first += interleave) {
+            size_t footprint = 0;
+            for (size_t i = first; i < std::min(first + interleave, units.size()); ++i) {
+                footprint += estimate_footprint(combinations[units[i].config_index]);
+            }
+            pending.push_back(first);
+            pending_footprints.push_back(footprint);
+        }
+        if (interleave > 1) {
+            spdlog::info("Interleaving {} simulations per worker task", interleave);
+        }
+
+        // Start work units, most expensive first, as workers and memory become free
         std::vector<std::shared_ptr<transwarp::task<void>>> tasks;
-        tasks.reserve(combinations.size());
-
-        for (const auto& params : combinations) {
-            // Create a task for each parameter combination
-            auto task = transwarp::make_task(
-                transwarp::root, [this, params, &log_entries, &log_mutex, &done_steps]() {
-                    this->run_simulation(params, log_entries, log_mutex, done_steps);
-                });
+        tasks.reserve(pending.size());
+
+        while (!pending.empty()) {
+            std::unique_lock<std::mutex> lock(admission_mutex);
+            std::optional<size_t> next;
+            admission_changed.wait(lock, [&admission, &pending_footprints, &next]() {
+                next = admission.select(pending_footprints);
+                return next.has_value();
+            });
+            const nonstd::span<const work_unit> group =
+                nonstd::span<const work_unit>(units).subspan(
+                    pending[*next], std::min(interleave, units.size() - pending[*next]));
+            const size_t footprint = pending_footprints[*next];
+            pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(*next));
+            pending_footprints.erase(pending_footprints.begin() +
+                                     static_cast<std::ptrdiff_t>(*next));
+            admission.admit(footprint);
+            lock.unlock();
+
+            auto release = [&admission, &admission_mutex, &admission_changed, footprint]() {
+                {
+                    std::lock_guard<std::mutex> guard(admission_mutex);
+                    admission.release(footprint);
+                }
+                admission_changed.notify_one();
+            };
+            auto task = transwarp::make_task(transwarp::root, [this, &combinations, group,
+                                                               &log_entries, &log_mutex,
+                                                               &done_steps, &node_units,
+                                                               release]() {
+                // The worker is busy from the first unit to the last one of the group, each
+                // unit counts as completed when finish_unit() records it
+                for (size_t i = 0; i < group.size(); ++i) {
+                    metrics_->unit_started(t_worker_index);
+                }
+                try {
+                    this->run_simulations(combinations, group, log_entries, log_mutex,
+                                          done_steps);
+                } catch (...) {
+                    release();
+                    throw;
+                }
+                release();
+
+                std::lock_guard<std::mutex> guard(log_mutex);
+                node_units[std::min(current_node(), node_units.size() - 1)] += group.size();
+            });
             task->schedule(executor);
             // Store the task in the vector
             tasks.push_back(std::move(task));
         }
 
-        // Wait for all tasks to complete
+        // Wait for all tasks to complete before rethrowing the error of a failed one, the
+        // others still use this frame
+        for (auto& task : tasks) {
+            task->wait();
+        }
         for (auto& task : tasks) {
             task->get();
         }
@@ -80,9 +281,34 @@ void simulation_runner::run() {
             progress_thread.join();
         }
 
+        // Report throughput, to compare placement policies on the same sweep
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_time;
+        const double seconds = std::max(elapsed.count(), 1e-9);
+        spdlog::info("Placement {} on {} NUMA node(s), {}/{} workers pinned",
+                     to_string(options_.placement), topology.nodes.size(), pinned.load(), workers);
+        spdlog::info("Throughput: {:.2f} simulations/s, {:.1f} generations/s over {:.1f}s",
+                     static_cast<double>(units.size()) / seconds,
+                     static_cast<double>(units.size() * generations_) / seconds, seconds);
+        if (!slots.empty()) {
+            for (size_t node = 0; node < node_units.size(); ++node) {
+                spdlog::info("  Node {}: {} simulations", node, node_units[node]);
+            }
+        }
+        if (options_.memory_budget > 0) {
+            spdlog::info("Memory budget {} MiB, peak estimate {} MiB running plus {} MiB of logs",
+                         options_.memory_budget >> 20U, admission.peak() >> 20U, log_bytes >> 20U);
+        }
+
+        if (warm_population_ && options_.target_fitness) {
+            spdlog::info(
+                summarize_warm_start(warm_results_, generations_, *options_.target_fitness));
+        }
+
         // Save results and report
         auto result = save_results(log_entries);
         if (result) {
+            metrics_->results_written(log_entries.size());
             spdlog::info("{}", *result);
         } else {
             spdlog::error("Failed to save results: {}", result.error());
@@ -93,43 +319,226 @@ void simulation_runner::run() {
     }
 }
 
-void simulation_runner::run_simulation(const simulation::config& sim_config,
-                                       std::vector<simulation_log_entry>& log_entries,
-                                       std::mutex& log_mutex, std::atomic<size_t>& done_steps) {
-    // Initialize random generator
-    cshorelark::random::random_generator random;
-
-    // Collect statistics for multiple iterations
-    for (size_t iter = 0; iter < iterations_; ++iter) {
-        // Create random simulation instance - equivalent to Rust's let mut sim =
-        // Simulation::random(config, &mut rng);
-        auto sim = simulation::simulation::random(sim_config, random);
-
-        // Run the simulation for specified number of generations
-        for (size_t gen = 0; gen < generations_; ++gen) {
-            // Train the simulation - equivalent to Rust's let stats = sim.train(&mut rng);
-            auto stats = sim.train(random);
-
-            // Record statistics
-            simulation_log_entry entry{
-                sim_config, gen, iter, stats  // Directly assign stats to entry.stats
-            };
+void simulation_runner::select_kernels(std::vector<simulation::config>& combinations,
+                                       const std::vector<work_unit>& units) const {
+    if (options_.kernels) {
+        spdlog::info("Kernels fixed to {}", to_string(*options_.kernels));
+        for (auto& config : combinations) {
+            config.kernels = *options_.kernels;
+        }
+        return;
+    }
+
+    kernel_autotuner tuner(options_.kernel_cache);
+    std::vector<bool> used(combinations.size(), false);
+    for (const auto& unit : units) {
+        used[unit.config_index] = true;
+    }
+    for (size_t i = 0; i < combinations.size(); ++i) {
+        if (used[i]) {
+            combinations[i].kernels = tuner.choose(combinations[i]);
+        }
+    }
+    spdlog::info("Kernels: {} shapes tuned, {} from the cache", tuner.tuned(), tuner.cached());
+    if (auto saved = tuner.save(); !saved) {
+        spdlog::warn(saved.error());
+    }
+}
 
-            spdlog::info("Iteration: {}, Generation: {}, Stats: {}", iter, gen, stats);
+struct simulation_runner::running_unit {
+    running_unit(const simulation::config& unit_params, const work_unit& unit_spec,
+                 cshorelark::random::random_generator unit_random, simulation::simulation unit_sim)
+        : params(unit_params),
+          unit(unit_spec),
+          random(unit_random),
+          sim(std::move(unit_sim)) {}
+
+    const simulation::config& params;             ///< Configuration of the unit
+    const work_unit& unit;                        ///< Unit being run
+    cshorelark::random::random_generator random;  ///< Generator of this unit only
+    simulation::simulation sim;                   ///< Simulation of the unit
+    std::ofstream digests;                        ///< Digest stream, closed if digests are off
+    std::optional<size_t> target_generation;      ///< First generation at the target fitness
+    size_t generation = 0;                        ///< Generations completed
+};
+
+void simulation_runner::run_simulations(const std::vector<simulation::config>& combinations,
+                                        nonstd::span<const work_unit> units,
+                                        std::vector<simulation_log_entry>& log_entries,
+                                        std::mutex& log_mutex, std::atomic<size_t>& done_steps) {
+    size_t remaining = units.size();
+    try {
+        // Turn lengths split a generation evenly between the units; each unit's first turn is
+        // longer by its position, so the units reach their generation ends one round apart
+        std::vector<std::unique_ptr<running_unit>> runs;
+        std::vector<size_t> turn_steps;
+        std::vector<size_t> first_steps;
+        runs.reserve(units.size());
+        for (size_t i = 0; i < units.size(); ++i) {
+            const auto& params = combinations[units[i].config_index];
+            runs.push_back(start_unit(params, units[i]));
+            const size_t turn = std::max<size_t>(
+                1, (params.sim.generation_length + units.size() - 1) / units.size());
+            turn_steps.push_back(turn);
+            first_steps.push_back(turn * (i + 1));
+        }
 
-            // Thread-safe addition to log entries
-            {
-                std::lock_guard<std::mutex> lock(log_mutex);
-                log_entries.push_back(std::move(entry));
+        for (bool first_round = true; remaining > 0; first_round = false) {
+            for (size_t i = 0; i < runs.size(); ++i) {
+                if (!runs[i]) {
+                    continue;
+                }
+                const size_t steps = first_round ? first_steps[i] : turn_steps[i];
+                if (advance_unit(*runs[i], steps, log_entries, log_mutex)) {
+                    finish_unit(*runs[i], log_mutex, done_steps);
+                    runs[i].reset();
+                    --remaining;
+                }
             }
         }
+    } catch (...) {
+        // Units cut short still leave the worker, so it does not look busy forever
+        for (size_t i = 0; i < remaining; ++i) {
+            metrics_->unit_finished(t_worker_index);
+        }
+        throw;
+    }
+}
 
-        // Increment completed steps counter
-        done_steps.fetch_add(1, std::memory_order_relaxed);
+auto simulation_runner::start_unit(const simulation::config& sim_config,
+                                   const work_unit& unit) const -> std::unique_ptr<running_unit> {
+    // Seeded per work unit, so a unit gives the same results on any shard
+    cshorelark::random::random_generator random(unit.seed);
+
+    // Create random simulation instance - equivalent to Rust's let mut sim =
+    // Simulation::random(config, &mut rng); or start from the saved population
+    auto sim = [&]() {
+        if (!warm_population_) {
+            return simulation::simulation::random(sim_config, random);
+        }
+        auto population = warm_start_population(*warm_population_, sim_config);
+        if (!population) {
+            throw std::runtime_error(population.error());
+        }
+        auto warm = simulation::simulation::from_chromosomes(sim_config, *population, random);
+        if (!warm) {
+            throw std::runtime_error(std::string("Failed to warm start: ") +
+                                     simulation::simulation_error_to_string(warm.error()));
+        }
+        return std::move(*warm);
+    }();
+    auto run = std::make_unique<running_unit>(sim_config, unit, random, std::move(sim));
+
+    // With digests on, every step is written so another run can be compared to this one
+    if (!options_.digest_dir.empty()) {
+        const auto path =
+            options_.digest_dir / digest_stream_name(unit.config_index, unit.iteration);
+        run->digests.open(path);
+        if (!run->digests) {
+            throw std::runtime_error("Failed to open digest stream: " + path.string());
+        }
+        run->sim.set_digest_enabled(true);
     }
+
+    // Every generation is archived as its parents and differences from them
+    if (!options_.lineage_dir.empty() && !run->sim.get_world().get_animals().empty()) {
+        const auto path = options_.lineage_dir / lineage_file_name(unit);
+        auto lineage = genetic::lineage_writer::create(
+            path, run->sim.get_world().get_animals().front().as_chromosome().size(),
+            genetic::lineage_writer::k_default_keyframe_interval,
+            genome_config_json(sim_config).dump());
+        if (!lineage) {
+            throw std::runtime_error(lineage.error().message);
+        }
+        run->sim.set_lineage(std::make_unique<genetic::lineage_writer>(std::move(*lineage)));
+    }
+    return run;
 }
 
-auto simulation_runner::generate_combinations() -> std::vector<simulation::config> {
+auto simulation_runner::advance_unit(running_unit& run, size_t steps,
+                                     std::vector<simulation_log_entry>& log_entries,
+                                     std::mutex& log_mutex) -> bool {
+    for (size_t step = 0; step < steps && run.generation < generations_; ++step) {
+        // Step like sim.train(), keeping every step's digest
+        const auto trained = run.sim.step(run.random);
+        metrics_->add_step(t_worker_index);
+        if (auto digest = run.sim.get_last_digest()) {
+            simulation::write_digest(run.digests, *digest);
+        }
+        if (!trained) {
+            continue;
+        }
+
+        const size_t gen = run.generation++;
+        const auto& stats = *trained;
+        if (options_.target_fitness && !run.target_generation &&
+            stats.ga_stats().avg_fitness() >= *options_.target_fitness) {
+            run.target_generation = gen;
+        }
+
+        // Record statistics
+        simulation_log_entry entry{run.params,         run.unit.config_index, gen,
+                                   run.unit.iteration, run.unit.seed,         stats};
+
+        spdlog::info("Config: {}, Iteration: {}, Generation: {}, Stats: {}",
+                     run.unit.config_index, run.unit.iteration, gen, stats);
+
+        // Thread-safe addition to log entries
+        {
+            std::lock_guard<std::mutex> lock(log_mutex);
+            log_entries.push_back(std::move(entry));
+        }
+        metrics_->results_recorded(1);
+        metrics_->add_generation(t_worker_index);
+    }
+    return run.generation == generations_;
+}
+
+void simulation_runner::finish_unit(const running_unit& run, std::mutex& log_mutex,
+                                    std::atomic<size_t>& done_steps) {
+    // Time the warm start against the same unit started at random
+    if (warm_population_ && options_.target_fitness) {
+        warm_start_result result{run.unit.config_index, run.unit.iteration,
+                                 run.target_generation, run_cold_baseline(run.params, run.unit)};
+        std::lock_guard<std::mutex> lock(log_mutex);
+        warm_results_.push_back(result);
+    }
+
+    // Increment completed steps counter
+    done_steps.fetch_add(1, std::memory_order_relaxed);
+    metrics_->unit_finished(t_worker_index);
+}
+
+auto simulation_runner::run_cold_baseline(const simulation::config& sim_config,
+                                          const work_unit& unit) const
+    -> std::optional<size_t> {
+    cshorelark::random::random_generator random(unit.seed);
+    auto sim = simulation::simulation::random(sim_config, random);
+    for (size_t gen = 0; gen < generations_; ++gen) {
+        const auto stats = sim.train(random);
+        metrics_->add_generation(t_worker_index);
+        if (stats.ga_stats().avg_fitness() >= *options_.target_fitness) {
+            return gen;
+        }
+    }
+    return std::nullopt;
+}
+
+auto simulation_runner::save_results(const std::vector<simulation_log_entry>& log_entries) const
+    -> tl::expected<std::string, std::string> {
+    try {
+        // Create the main JSON array to hold all log entries
+        json logs_json = json::array();
+        for (const auto& entry : log_entries) {
+            logs_json.push_back(log_entry_json(entry));
+        }
+        return write_log(output_path_, logs_json);
+    } catch (const std::exception& e) {
+        return tl::make_unexpected(std::string("Error saving results: ") + e.what());
+    }
+}
+
+auto generate_combinations() -> std::vector<simulation::config> {
     // Get parameter options from config
     const parameter_options options;
     std::vector<simulation::config> combinations;
@@ -163,56 +572,51 @@ auto simulation_runner::generate_combinations() -> std::vector<simulation::confi
     return combinations;
 }
 
-auto simulation_runner::save_results(const std::vector<simulation_log_entry>& log_entries) const
+auto log_entry_json(const simulation_log_entry& entry) -> json {
+    // Create a JSON object for this log entry (OptLog)
+    json log_entry;
+
+    // Add configuration (OptConfig with renamed fields)
+    json config;
+    config["c"] = static_cast<uint8_t>(entry.config.brain_eye.num_neurons);  // brain_neurons
+    config["d"] = entry.config.brain_eye.fov_range;                          // eye_fov_range
+    config["e"] = entry.config.brain_eye.fov_angle_deg;                      // eye_fov_angle
+    config["f"] = static_cast<size_t>(entry.config.brain_eye.num_cells);     // eye_cells
+    config["g"] = entry.config.genetic.mutation_chance;                      // ga_mut_chance
+    config["h"] = entry.config.genetic.mutation_coeff;                       // ga_mut_coeff
+    log_entry["cfg"] = config;
+
+    // Add context (OptContext with renamed fields)
+    json context;
+    context["g"] = entry.generation;    // gen
+    context["i"] = entry.iteration;     // iter
+    context["c"] = entry.config_index;  // config index in the sweep
+    context["s"] = entry.seed;          // work unit seed
+    log_entry["ctxt"] = context;
+
+    // Add statistics (OptStatistics with renamed fields)
+    json stats;
+    stats["a"] = entry.stats.ga_stats().min_fitness();     // min_fitness
+    stats["b"] = entry.stats.ga_stats().max_fitness();     // max_fitness
+    stats["c"] = entry.stats.ga_stats().avg_fitness();     // avg_fitness
+    stats["d"] = entry.stats.ga_stats().median_fitness();  // median_fitness
+    log_entry["stats"] = stats;
+
+    return log_entry;
+}
+
+auto write_log(const std::filesystem::path& output_path, const json& logs)
     -> tl::expected<std::string, std::string> {
     try {
-        // Create the main JSON array to hold all log entries
-        json logs_json = json::array();
-
-        // Process each log entry
-        for (const auto& entry : log_entries) {
-            // Create a JSON object for this log entry (OptLog)
-            json log_entry;
-
-            // Add configuration (OptConfig with renamed fields)
-            json config;
-            config["c"] =
-                static_cast<uint8_t>(entry.config.brain_eye.num_neurons);         // brain_neurons
-            config["d"] = entry.config.brain_eye.fov_range;                       // eye_fov_range
-            config["e"] = entry.config.brain_eye.fov_angle_deg;                   // eye_fov_angle
-            config["f"] = static_cast<size_t>(entry.config.brain_eye.num_cells);  // eye_cells
-            config["g"] = entry.config.genetic.mutation_chance;                   // ga_mut_chance
-            config["h"] = entry.config.genetic.mutation_coeff;                    // ga_mut_coeff
-            log_entry["cfg"] = config;
-
-            // Add context (OptContext with renamed fields)
-            json context;
-            context["g"] = entry.generation;  // gen
-            context["i"] = entry.iteration;   // iter
-            log_entry["ctxt"] = context;
-
-            // Add statistics (OptStatistics with renamed fields)
-            json stats;
-            stats["a"] = entry.stats.ga_stats().min_fitness();     // min_fitness
-            stats["b"] = entry.stats.ga_stats().max_fitness();     // max_fitness
-            stats["c"] = entry.stats.ga_stats().avg_fitness();     // avg_fitness
-            stats["d"] = entry.stats.ga_stats().median_fitness();  // median_fitness
-            log_entry["stats"] = stats;
-
-            // Add this log entry to the array
-            logs_json.push_back(log_entry);
-        }
-
-        // Write to file
-        std::ofstream file(output_path_);
+        std::ofstream file(output_path);
         if (!file) {
-            return tl::make_unexpected("Failed to open output file: " + output_path_.string());
+            return tl::make_unexpected("Failed to open output file: " + output_path.string());
         }
 
         // Write the JSON with proper formatting
-        file << logs_json.dump(2);
+        file << logs.dump(2);
 
-        return std::string("Results saved to: ") + output_path_.string();
+        return std::string("Results saved to: ") + output_path.string();
     } catch (const std::exception& e) {
         return tl::make_unexpected(std::string("Error saving results: ") + e.what());
     }
@@ -4,9 +4,13 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <mutex>
+#include <nlohmann/json.hpp>
+#include <nonstd/span.hpp>
+#include <optional>
 #include <thread>
 #include <tl/expected.hpp>
 #include <vector>
@@ -14,8 +18,13 @@
 #include "analyze.h"
 #include "common.h"
 #include "constants.h"
+#include "evaluate.h"
 #include "genetic_algorithm/individual.h"
+#include "metrics.h"
 #include "neural_network/network.h"
+#include "placement.h"
+#include "shard.h"
+#include "warm_start.h"
 #include "simulation/animal.h"
 #include "simulation/config.h"
 #include "simulation/statistics.h"
@@ -28,11 +37,56 @@ namespace cshorelark::optimizer_cli {
  */
 struct simulation_log_entry {
     simulation::config config;     ///< Configuration used
+    size_t config_index = 0;       ///< Index of the configuration in the sweep
     size_t generation = 0;         ///< Generation number
     size_t iteration = 0;          ///< Iteration number
+    std::uint64_t seed = 0;        ///< Seed of the work unit
     simulation::statistics stats;  ///< Statistics for this generation
 };
 
+/**
+ * @brief Converts a log entry to its JSON form in the sweep log
+ *
+ * @param entry Log entry to convert
+ * @return JSON object with the configuration, context and statistics
+ */
+auto log_entry_json(const simulation_log_entry& entry) -> nlohmann::json;
+
+/**
+ * @brief Writes a sweep log
+ *
+ * @param output_path Path to save the log to
+ * @param logs JSON array of log entries
+ * @return Expected containing success message or error
+ */
+auto write_log(const std::filesystem::path& output_path, const nlohmann::json& logs)
+    -> tl::expected<std::string, std::string>;
+
+/**
+ * @brief Generates all parameter combinations of a sweep
+ *
+ * @return Vector of all parameter combinations to test
+ */
+auto generate_combinations() -> std::vector<simulation::config>;
+
+/**
+ * @brief How a sweep is split, placed and run
+ */
+struct sweep_options {
+    shard_spec shard;                                       ///< Slice of the sweep to run
+    std::uint64_t seed = 0;                                 ///< Work unit seeds derive from it
+    placement_policy placement = placement_policy::k_none;  ///< Worker thread placement
+    std::size_t memory_budget = 0;                          ///< Bytes to use, 0 for no limit
+    std::optional<simulation::kernel_config> kernels;       ///< Fixed kernels, tuned if unset
+    std::filesystem::path kernel_cache;                     ///< Tuned kernels per config shape
+    std::filesystem::path digest_dir;                       ///< Digest stream directory if set
+    std::filesystem::path lineage_dir;                      ///< Lineage archive directory if set
+    std::size_t interleave = 1;                             ///< Simulations stepped per task
+    std::filesystem::path warm_start;                       ///< Saved population, random if empty
+    std::optional<float> target_fitness;                    ///< Fitness warm starts are timed to
+    std::optional<std::uint16_t> metrics_port;              ///< Serve metrics on localhost if set
+};
+
 /**
  * @brief Coordinates the optimization process with data saving
  */
@@ -44,8 +98,10 @@ public:
      * @param iterations Number of iterations to run
      * @param generations Number of generations
      * @param output_path Path to save output files
+     * @param options Sharding, placement, memory and kernel options
      */
-    simulation_runner(size_t iterations, size_t generations, std::filesystem::path output_path);
+    simulation_runner(size_t iterations, size_t generations, std::filesystem::path output_path,
+                      sweep_options options = {});
 
     /**
      * @brief Run the optimization process
@@ -56,23 +112,85 @@ public:
 
 private:
     /**
-     * @brief Generate all parameter combinations
+     * @brief Sets the kernels of the configurations run by this shard
      *
-     * @return Vector of all parameter combinations to test
+     * Uses the fixed kernels when given, otherwise the autotuner's choice.
+     *
+     * @param combinations All configurations of the sweep
+     * @param units Work units of this shard
+     */
+    void select_kernels(std::vector<simulation::config>& combinations,
+                        const std::vector<work_unit>& units) const;
+
+    /**
+     * @brief A work unit in progress: its simulation, generator and outputs
      */
-    auto generate_combinations() -> std::vector<simulation::config>;
+    struct running_unit;
 
     /**
-     * @brief Run a single simulation with specific parameters
+     * @brief Run work units on the calling worker, interleaved
+     *
+     * Units take turns of about generation_length / units.size() steps. The
+     * first turn of unit j is j turns longer, which staggers the generation
+     * ends: in each round of turns about one unit evolves and logs while the
+     * others only step, instead of every unit reaching the same serial phase at
+     * once. Each unit keeps its own generator, so its results do not depend on
+     * the others.
+     *
+     * @param combinations All configurations of the sweep
+     * @param units Work units to run
+     * @param log_entries Vector to store log entries
+     * @param log_mutex Mutex to protect log entries vector
+     * @param done_steps Counter for completed steps
+     */
+    void run_simulations(const std::vector<simulation::config>& combinations,
+                         nonstd::span<const work_unit> units,
+                         std::vector<simulation_log_entry>& log_entries, std::mutex& log_mutex,
+                         std::atomic<size_t>& done_steps);
+
+    /**
+     * @brief Creates the simulation of a work unit and opens its outputs
      *
      * @param params Simulation parameters to use
+     * @param unit Work unit to run
+     * @return The unit at generation 0
+     */
+    [[nodiscard]] auto start_unit(const simulation::config& params, const work_unit& unit) const
+        -> std::unique_ptr<running_unit>;
+
+    /**
+     * @brief Steps a work unit, logging every generation it completes
+     *
+     * @param run Unit to step
+     * @param steps Most steps to take
      * @param log_entries Vector to store log entries
      * @param log_mutex Mutex to protect log entries vector
+     * @return Whether the unit completed all its generations
+     */
+    auto advance_unit(running_unit& run, size_t steps,
+                      std::vector<simulation_log_entry>& log_entries, std::mutex& log_mutex)
+        -> bool;
+
+    /**
+     * @brief Records the results of a completed work unit
+     *
+     * @param run Unit that completed all its generations
+     * @param log_mutex Mutex to protect log entries vector
      * @param done_steps Counter for completed steps
      */
-    void run_simulation(const simulation::config& params,
-                        std::vector<simulation_log_entry>& log_entries, std::mutex& log_mutex,
-                        std::atomic<size_t>& done_steps);
+    void finish_unit(const running_unit& run, std::mutex& log_mutex,
+                     std::atomic<size_t>& done_steps);
+
+    /**
+     * @brief Runs a work unit from a random population until it reaches the target fitness
+     *
+     * @param params Simulation parameters to use
+     * @param unit Work unit to run
+     * @return First generation at the target, or nullopt if none of the generations reached it
+     */
+    [[nodiscard]] auto run_cold_baseline(const simulation::config& params,
+                                         const work_unit& unit) const
+        -> std::optional<std::size_t>;
 
     /**
      * @brief Progress monitoring function that runs in a separate thread
@@ -95,9 +213,13 @@ private:
     [[nodiscard]] auto save_results(const std::vector<simulation_log_entry>& log_entries) const
         -> tl::expected<std::string, std::string>;
 
-    size_t iterations_;                  ///< Number of iterations to run
-    size_t generations_;                 ///< Number of generations
-    std::filesystem::path output_path_;  ///< Path to save output files
+    size_t iterations_;                            ///< Number of iterations to run
+    size_t generations_;                           ///< Number of generations
+    std::filesystem::path output_path_;            ///< Path to save output files
+    sweep_options options_;                        ///< How the sweep is split, placed and run
+    std::optional<genome_set> warm_population_;    ///< Loaded warm start population
+    std::vector<warm_start_result> warm_results_;  ///< Warm and cold runs against the target
+    std::unique_ptr<sweep_metrics> metrics_;       ///< Live counters of the running sweep
 };
 
 }  // namespace cshorelark::optimizer_cli
@@ -0,0 +1,55 @@
+#include "warm_start.h"
+
+#include <fmt/format.h>
+
+#include <string>
+#include <utility>
+
+#include "simulation/brain.h"
+#include "simulation/simulation_error.h"
+
+namespace cshorelark::optimizer_cli {
+
+auto warm_start_population(const genome_set& population, const simulation::config& config)
+    -> tl::expected<std::vector<genetic::chromosome>, std::string> {
+    if (population.genomes.empty()) {
+        return tl::make_unexpected(std::string("The warm start population is empty"));
+    }
+
+    const auto& saved = population.config.brain_eye;
+    std::vector<genetic::chromosome> chromosomes;
+    chromosomes.reserve(config.world.num_animals);
+    for (std::size_t i = 0; i < config.world.num_animals; ++i) {
+        const auto& genome = population.genomes[i % population.genomes.size()];
+        auto adapted = simulation::brain::adapt_chromosome(genome, saved.num_cells,
+                                                           saved.num_neurons, config);
+        if (!adapted) {
+            return tl::make_unexpected(
+                "Warm start genome " + std::to_string(i % population.genomes.size()) + ": " +
+                simulation::simulation_error_to_string(adapted.error()));
+        }
+        chromosomes.push_back(std::move(*adapted));
+    }
+    return chromosomes;
+}
+
+auto summarize_warm_start(nonstd::span<const warm_start_result> results, std::size_t generations,
+                          float target_fitness) -> std::string {
+    std::size_t warm_reached = 0;
+    std::size_t cold_reached = 0;
+    long long saved = 0;
+    for (const auto& result : results) {
+        warm_reached += result.warm_generation ? 1 : 0;
+        cold_reached += result.cold_generation ? 1 : 0;
+        saved += static_cast<long long>(result.cold_generation.value_or(generations)) -
+                 static_cast<long long>(result.warm_generation.value_or(generations));
+    }
+    const double mean_saved =
+        results.empty() ? 0.0 : static_cast<double>(saved) / static_cast<double>(results.size());
+    return fmt::format(
+        "Average fitness {:.2f} reached by {}/{} warm and {}/{} cold runs, warm start saved "
+        "{:.1f} generations per run",
+        target_fitness, warm_reached, results.size(), cold_reached, results.size(), mean_saved);
+}
+
+}  // namespace cshorelark::optimizer_cli
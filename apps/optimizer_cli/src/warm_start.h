@@ -0,0 +1,58 @@
+#ifndef CSHORELARK_OPTIMIZER_CLI_WARM_START_H
+#define CSHORELARK_OPTIMIZER_CLI_WARM_START_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <tl/expected.hpp>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "evaluate.h"
+#include "genetic_algorithm/chromosome.h"
+#include "simulation/config.h"
+
+namespace cshorelark::optimizer_cli {
+
+/**
+ * @brief Builds the first generation of a warm-started simulation
+ *
+ * Takes the saved genomes in order, starting over when there are fewer than
+ * config.world.num_animals, and fits each to the configured brain with
+ * simulation::brain::adapt_chromosome.
+ *
+ * @param population Saved genomes and the brain they were trained with
+ * @param config Configuration of the simulation to start
+ * @return One chromosome per animal, or an error message
+ */
+auto warm_start_population(const genome_set& population, const simulation::config& config)
+    -> tl::expected<std::vector<genetic::chromosome>, std::string>;
+
+/**
+ * @brief When the warm and cold runs of a work unit reached the target fitness
+ */
+struct warm_start_result {
+    std::size_t config_index = 0;                ///< Index of the configuration in the sweep
+    std::size_t iteration = 0;                   ///< Iteration of the configuration
+    std::optional<std::size_t> warm_generation;  ///< First generation at target, warm start
+    std::optional<std::size_t> cold_generation;  ///< First generation at target, random start
+};
+
+/**
+ * @brief Summarizes the generations a warm start saved over a sweep
+ *
+ * A run that never reached the target counts as reaching it after the last
+ * generation, so savings are a lower bound when the cold run never got there.
+ *
+ * @param results Results of every work unit
+ * @param generations Generations each run was given
+ * @param target_fitness Average fitness the runs had to reach
+ * @return Human readable summary
+ */
+auto summarize_warm_start(nonstd::span<const warm_start_result> results, std::size_t generations,
+                          float target_fitness) -> std::string;
+
+}  // namespace cshorelark::optimizer_cli
+
+#endif  // CSHORELARK_OPTIMIZER_CLI_WARM_START_H
@@ -0,0 +1,63 @@
+#include "admission.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace cshorelark::optimizer_cli;
+
+TEST_CASE("Admission - Footprint estimate", "[admission]") {
+    cshorelark::simulation::config small;
+    cshorelark::simulation::config wide = small;
+    wide.brain_eye.num_neurons *= 4;
+    cshorelark::simulation::config crowded = small;
+    crowded.world.num_animals *= 4;
+
+    CHECK(estimate_footprint(small) > 0);
+    CHECK(estimate_footprint(wide) > estimate_footprint(small));
+    CHECK(estimate_footprint(crowded) > 3 * estimate_footprint(small));
+    CHECK(estimate_log_bytes(20) == 2 * estimate_log_bytes(10));
+}
+
+TEST_CASE("Admission - Select", "[admission]") {
+    SECTION("Smaller units fill the budget around a large one") {
+        memory_admission admission(100, 4);
+        admission.admit(60);
+
+        const std::vector<std::size_t> pending{50, 40, 10};
+        const auto next = admission.select(pending);
+        REQUIRE(next.has_value());
+        CHECK(*next == 1);
+    }
+
+    SECTION("Nothing starts once the budget is used") {
+        memory_admission admission(100, 4);
+        admission.admit(95);
+
+        CHECK_FALSE(admission.select({10, 20}).has_value());
+        admission.release(95);
+        CHECK(admission.select({10, 20}) == 0);
+    }
+
+    SECTION("Workers bound the running units") {
+        memory_admission admission(0, 2);
+        admission.admit(1000);
+        admission.admit(1000);
+
+        CHECK_FALSE(admission.select({1}).has_value());
+        admission.release(1000);
+        CHECK(admission.select({1}).has_value());
+    }
+
+    SECTION("A unit larger than the budget runs alone") {
+        memory_admission admission(100, 4);
+
+        CHECK(admission.select({500, 10}) == 1);
+        admission.admit(10);
+        CHECK_FALSE(admission.select({500}).has_value());
+        admission.release(10);
+        CHECK(admission.select({500}) == 0);
+        admission.admit(500);
+        CHECK_FALSE(admission.select({10}).has_value());
+        CHECK(admission.peak() == 500);
+    }
+}
@@ -0,0 +1,88 @@
+#include "autotune.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+
+using namespace cshorelark::optimizer_cli;
+using cshorelark::simulation::collision_kernel;
+using cshorelark::simulation::inference_kernel;
+using cshorelark::simulation::vision_kernel;
+
+namespace {
+
+auto small_config() -> cshorelark::simulation::config {
+    cshorelark::simulation::config config;
+    config.world.num_animals = 8;
+    config.world.num_foods = 16;
+    return config;
+}
+
+}  // namespace
+
+TEST_CASE("Autotune - Parse kernels", "[autotune]") {
+    auto automatic = parse_kernels("auto");
+    REQUIRE(automatic.has_value());
+    CHECK_FALSE(automatic->has_value());
+
+    auto fixed = parse_kernels("grid,brute-force");
+    REQUIRE(fixed.has_value());
+    REQUIRE(fixed->has_value());
+    CHECK((*fixed)->collisions == collision_kernel::k_grid);
+    CHECK((*fixed)->vision == vision_kernel::k_brute_force);
+    CHECK((*fixed)->inference == inference_kernel::k_generic);
+    CHECK(to_string(**fixed) == "grid,brute-force");
+
+    auto generated = parse_kernels("brute-force,grid,jit-embedded");
+    REQUIRE(generated.has_value());
+    REQUIRE(generated->has_value());
+    CHECK((*generated)->inference == inference_kernel::k_jit_embedded);
+    CHECK(to_string(**generated) == "brute-force,grid,jit-embedded");
+
+    CHECK_FALSE(parse_kernels("grid").has_value());
+    CHECK_FALSE(parse_kernels("grid,simd").has_value());
+    CHECK_FALSE(parse_kernels("grid,grid,llvm").has_value());
+}
+
+TEST_CASE("Autotune - Shape keys", "[autotune]") {
+    const auto config = small_config();
+    auto same_shape = config;
+    same_shape.genetic.mutation_chance *= 2;
+    auto other_shape = config;
+    other_shape.brain_eye.fov_range /= 2;
+    // The field of view decides how many foods each eye scans
+    auto other_angle = config;
+    other_angle.brain_eye.fov_angle_deg /= 2;
+
+    CHECK(shape_key(config) == shape_key(same_shape));
+    CHECK(shape_key(config) != shape_key(other_shape));
+    CHECK(shape_key(config) != shape_key(other_angle));
+}
+
+TEST_CASE("Autotune - Decisions are cached on disk", "[autotune]") {
+    const auto cache = std::filesystem::temp_directory_path() / "cshorelark_kernel_cache.json";
+    std::filesystem::remove(cache);
+    const auto config = small_config();
+
+    cshorelark::simulation::kernel_config first;
+    {
+        kernel_autotuner tuner(cache);
+        first = tuner.choose(config);
+        CHECK(tuner.tuned() == 1);
+
+        // The same shape is answered without timing again
+        tuner.choose(config);
+        CHECK(tuner.tuned() == 1);
+        CHECK(tuner.cached() == 1);
+        REQUIRE(tuner.save().has_value());
+    }
+
+    kernel_autotuner reloaded(cache);
+    const auto second = reloaded.choose(config);
+    CHECK(reloaded.tuned() == 0);
+    CHECK(reloaded.cached() == 1);
+    CHECK(second.collisions == first.collisions);
+    CHECK(second.vision == first.vision);
+    CHECK(second.inference == first.inference);
+
+    std::filesystem::remove(cache);
+}
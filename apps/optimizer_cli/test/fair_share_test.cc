@@ -0,0 +1,128 @@
+#include "fair_share.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <map>
+
+using namespace cshorelark::optimizer_cli;
+
+namespace {
+
+// Dispatches and immediately finishes units, counting them per job
+auto run_units(fair_share_scheduler& scheduler, std::size_t count)
+    -> std::map<fair_share_scheduler::job_id, std::size_t> {
+    std::map<fair_share_scheduler::job_id, std::size_t> dispatched;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto next = scheduler.next();
+        if (!next) {
+            break;
+        }
+        ++dispatched[next->job];
+        scheduler.finish(next->job);
+    }
+    return dispatched;
+}
+
+}  // namespace
+
+TEST_CASE("Fair share - Units in order", "[fair_share]") {
+    fair_share_scheduler scheduler;
+    const auto job = scheduler.add_job(3, k_default_priority);
+    CHECK(scheduler.pending(job) == 3);
+
+    for (std::size_t unit = 0; unit < 3; ++unit) {
+        const auto next = scheduler.next();
+        REQUIRE(next.has_value());
+        CHECK(next->job == job);
+        CHECK(next->unit == unit);
+    }
+    CHECK_FALSE(scheduler.next().has_value());
+    CHECK_FALSE(scheduler.has_pending());
+    CHECK(scheduler.running(job) == 3);
+
+    CHECK_FALSE(scheduler.finish(job));
+    CHECK_FALSE(scheduler.finish(job));
+    CHECK(scheduler.finish(job));
+    CHECK(scheduler.jobs() == 0);
+}
+
+TEST_CASE("Fair share - Equal priorities alternate", "[fair_share]") {
+    fair_share_scheduler scheduler;
+    const auto first = scheduler.add_job(100, 10);
+    const auto second = scheduler.add_job(100, 10);
+
+    auto dispatched = run_units(scheduler, 40);
+    CHECK(dispatched[first] == 20);
+    CHECK(dispatched[second] == 20);
+}
+
+TEST_CASE("Fair share - Shares follow priorities", "[fair_share]") {
+    fair_share_scheduler scheduler;
+    const auto low = scheduler.add_job(1000, 10);
+    const auto high = scheduler.add_job(1000, 30);
+
+    auto dispatched = run_units(scheduler, 400);
+    CHECK(dispatched[low] == 100);
+    CHECK(dispatched[high] == 300);
+}
+
+TEST_CASE("Fair share - Late jobs do not catch up", "[fair_share]") {
+    fair_share_scheduler scheduler;
+    const auto early = scheduler.add_job(1000, 10);
+    run_units(scheduler, 50);
+
+    // Joining after 50 units of the other job, it still only gets half from now on
+    const auto late = scheduler.add_job(1000, 10);
+    auto dispatched = run_units(scheduler, 20);
+    CHECK(dispatched[early] == 10);
+    CHECK(dispatched[late] == 10);
+}
+
+TEST_CASE("Fair share - Finished jobs leave the others the workers", "[fair_share]") {
+    fair_share_scheduler scheduler;
+    const auto small = scheduler.add_job(2, 10);
+    const auto large = scheduler.add_job(100, 10);
+
+    auto dispatched = run_units(scheduler, 10);
+    CHECK(dispatched[small] == 2);
+    CHECK(dispatched[large] == 8);
+    CHECK(scheduler.jobs() == 1);
+}
+
+TEST_CASE("Fair share - Cancel", "[fair_share]") {
+    fair_share_scheduler scheduler;
+    const auto job = scheduler.add_job(10, 10);
+    const auto other = scheduler.add_job(10, 10);
+
+    SECTION("Without running units the job is forgotten at once") {
+        CHECK(scheduler.cancel(job));
+        CHECK(scheduler.pending(job) == 0);
+        CHECK(scheduler.jobs() == 1);
+        auto dispatched = run_units(scheduler, 20);
+        CHECK(dispatched.count(job) == 0);
+        CHECK(dispatched[other] == 10);
+    }
+
+    SECTION("Running units are waited for") {
+        const auto next = scheduler.next();
+        REQUIRE(next.has_value());
+        REQUIRE(next->job == job);
+
+        CHECK_FALSE(scheduler.cancel(job));
+        CHECK(scheduler.pending(job) == 0);
+        CHECK(scheduler.running(job) == 1);
+        CHECK(scheduler.next()->job == other);
+        CHECK(scheduler.finish(job));
+        CHECK(scheduler.jobs() == 1);
+    }
+}
+
+TEST_CASE("Fair share - Priorities are clamped", "[fair_share]") {
+    fair_share_scheduler scheduler;
+    const auto zero = scheduler.add_job(1000, 0);
+    const auto lowest = scheduler.add_job(1000, k_min_priority);
+
+    auto dispatched = run_units(scheduler, 100);
+    CHECK(dispatched[zero] == 50);
+    CHECK(dispatched[lowest] == 50);
+}
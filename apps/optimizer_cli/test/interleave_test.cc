@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "shard.h"
+#include "simulate.h"
+
+using namespace cshorelark::optimizer_cli;
+
+namespace {
+
+constexpr std::size_t k_generations = 2;
+constexpr std::uint64_t k_seed = 5;
+
+// The last shard of 3000 holds three of the cheapest units of the sweep
+constexpr shard_spec k_shard{2999, 3000};
+
+// Runs the shard with the given interleave and returns its log in unit and generation order
+auto run_sweep(std::size_t interleave) -> std::vector<nlohmann::json> {
+    const auto path = std::filesystem::temp_directory_path() /
+                      ("cshorelark_interleave_" + std::to_string(interleave) + ".json");
+    std::filesystem::remove(path);
+
+    sweep_options options;
+    options.shard = k_shard;
+    options.seed = k_seed;
+    options.kernels = cshorelark::simulation::kernel_config{};
+    options.interleave = interleave;
+    simulation_runner(1, k_generations, path, options).run();
+
+    std::ifstream file(path);
+    REQUIRE(file);
+    const auto log = nlohmann::json::parse(file);
+    file.close();
+    std::filesystem::remove(path);
+
+    std::vector<nlohmann::json> entries(log.begin(), log.end());
+    const auto key = [](const nlohmann::json& entry) {
+        const auto& context = entry.at("ctxt");
+        return std::make_tuple(context.at("c").get<std::size_t>(),
+                               context.at("i").get<std::size_t>(),
+                               context.at("g").get<std::size_t>());
+    };
+    std::sort(entries.begin(), entries.end(),
+              [&key](const nlohmann::json& lhs, const nlohmann::json& rhs) {
+                  return key(lhs) < key(rhs);
+              });
+    return entries;
+}
+
+}  // namespace
+
+TEST_CASE("Interleave - Grouped units log what they log alone", "[interleave]") {
+    const auto units = plan_shard(generate_combinations(), 1, k_generations, k_seed, k_shard);
+    REQUIRE(units.size() == 3);
+
+    const auto alone = run_sweep(1);
+    REQUIRE(alone.size() == units.size() * k_generations);
+
+    // Groups of two split the 2500-step generation evenly; groups of three do not, so the
+    // staggered first turns and the uneven turns end generations at different steps
+    for (const std::size_t interleave : {2U, 3U}) {
+        INFO("Interleave " << interleave);
+        const auto grouped = run_sweep(interleave);
+        REQUIRE(grouped.size() == alone.size());
+        for (std::size_t i = 0; i < alone.size(); ++i) {
+            CHECK(grouped[i] == alone[i]);
+        }
+    }
+}
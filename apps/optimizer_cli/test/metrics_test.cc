@@ -0,0 +1,113 @@
+#include "metrics.h"
+
+#include <asio.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+using namespace cshorelark::optimizer_cli;
+
+namespace {
+
+// Sends one request head to the server and reads the response until it closes
+auto scrape(std::uint16_t port, const std::string& target) -> std::string {
+    asio::io_context io;
+    asio::ip::tcp::socket socket(io);
+    socket.connect({asio::ip::make_address("127.0.0.1"), port});
+    const std::string request = "GET " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    asio::write(socket, asio::buffer(request));
+
+    std::string response;
+    asio::error_code error;
+    asio::read(socket, asio::dynamic_buffer(response), error);
+    return response;
+}
+
+auto contains(const std::string& text, const std::string& part) -> bool {
+    return text.find(part) != std::string::npos;
+}
+
+}  // namespace
+
+TEST_CASE("Metrics - Counters", "[metrics]") {
+    sweep_metrics metrics(2, 5);
+    metrics.unit_started(0);
+    metrics.unit_started(1);
+    for (int i = 0; i < 3; ++i) {
+        metrics.add_step(0);
+        metrics.add_step(1);
+    }
+    metrics.add_generation(1);
+    metrics.results_recorded(4);
+    metrics.results_written(1);
+    metrics.unit_finished(0);
+
+    const auto text = metrics.render();
+    CHECK(contains(text, "# TYPE cshorelark_sweep_steps_total counter\n"));
+    CHECK(contains(text, "\ncshorelark_sweep_units 5\n"));
+    CHECK(contains(text, "\ncshorelark_sweep_units_completed_total 1\n"));
+    CHECK(contains(text, "\ncshorelark_sweep_queue_depth 3\n"));
+    CHECK(contains(text, "\ncshorelark_sweep_steps_total 6\n"));
+    CHECK(contains(text, "\ncshorelark_sweep_generations_total 1\n"));
+    CHECK(contains(text, "\ncshorelark_sweep_results_pending 3\n"));
+    CHECK(contains(text, "cshorelark_sweep_worker_utilization{worker=\"1\"} "));
+    // Workers past the configured count share the last slot
+    metrics.add_step(7);
+    CHECK(contains(metrics.render(), "\ncshorelark_sweep_steps_total 7\n"));
+}
+
+TEST_CASE("Metrics - Interleaved units", "[metrics]") {
+    sweep_metrics metrics(1, 3);
+    const auto busy_seconds = [&metrics]() {
+        const std::string name = "\ncshorelark_sweep_worker_busy_seconds_total{worker=\"0\"} ";
+        const auto text = metrics.render();
+        return std::stod(text.substr(text.find(name) + name.size()));
+    };
+
+    metrics.unit_started(0);
+    metrics.unit_started(0);
+    metrics.unit_finished(0);
+    CHECK(contains(metrics.render(), "\ncshorelark_sweep_units_completed_total 1\n"));
+
+    // The worker stays busy while the other unit of its group runs
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const double running = busy_seconds();
+    CHECK(running >= 0.02);
+
+    metrics.unit_finished(0);
+    CHECK(contains(metrics.render(), "\ncshorelark_sweep_units_completed_total 2\n"));
+    const double finished = busy_seconds();
+    CHECK(finished >= running);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(busy_seconds() == finished);
+}
+
+TEST_CASE("Metrics - Scraping localhost", "[metrics]") {
+    sweep_metrics metrics(1, 2);
+    metrics.unit_started(0);
+    metrics.add_step(0);
+
+    metrics_server server(metrics, "127.0.0.1", 0);
+    const auto port = server.start();
+    REQUIRE(port.has_value());
+
+    SECTION("GET /metrics answers with the current counters") {
+        auto response = scrape(*port, "/metrics");
+        CHECK(contains(response, "HTTP/1.1 200 OK\r\n"));
+        CHECK(contains(response, "text/plain; version=0.0.4"));
+        CHECK(contains(response, "\ncshorelark_sweep_steps_total 1\n"));
+
+        metrics.add_step(0);
+        response = scrape(*port, "/metrics");
+        CHECK(contains(response, "\ncshorelark_sweep_steps_total 2\n"));
+    }
+
+    SECTION("Other paths are not found") {
+        CHECK(contains(scrape(*port, "/"), "HTTP/1.1 404 Not Found\r\n"));
+    }
+
+    server.stop();
+    server.stop();
+}
@@ -0,0 +1,90 @@
+#include "placement.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace cshorelark::optimizer_cli;
+
+namespace {
+
+// Two nodes of four CPUs, numbered like a typical dual-socket host
+auto dual_socket() -> cpu_topology { return cpu_topology{{{0, 1, 2, 3}, {4, 5, 6, 7}}}; }
+
+}  // namespace
+
+TEST_CASE("Placement - Parse", "[placement]") {
+    SECTION("Policies round trip through their names") {
+        for (const auto policy : {placement_policy::k_none, placement_policy::k_compact,
+                                  placement_policy::k_scatter, placement_policy::k_per_node}) {
+            auto parsed = parse_placement(to_string(policy));
+            REQUIRE(parsed.has_value());
+            CHECK(*parsed == policy);
+        }
+        CHECK_FALSE(parse_placement("spread").has_value());
+    }
+
+    SECTION("CPU lists") {
+        auto cpus = parse_cpu_list("0-2,5,8-9\n");
+        REQUIRE(cpus.has_value());
+        CHECK(*cpus == std::vector<unsigned>{0, 1, 2, 5, 8, 9});
+
+        auto empty = parse_cpu_list("\n");
+        REQUIRE(empty.has_value());
+        CHECK(empty->empty());
+
+        CHECK_FALSE(parse_cpu_list("3-1").has_value());
+        CHECK_FALSE(parse_cpu_list("0-x").has_value());
+    }
+}
+
+TEST_CASE("Placement - Plan", "[placement]") {
+    const auto topology = dual_socket();
+
+    SECTION("None leaves threads alone") {
+        CHECK(plan_placement(topology, placement_policy::k_none, 8).empty());
+    }
+
+    SECTION("Compact fills a node first") {
+        const auto slots = plan_placement(topology, placement_policy::k_compact, 6);
+        REQUIRE(slots.size() == 6);
+        for (std::size_t worker = 0; worker < 4; ++worker) {
+            CHECK(slots[worker].node == 0);
+            CHECK(slots[worker].cpus == std::vector<unsigned>{static_cast<unsigned>(worker)});
+        }
+        CHECK(slots[4].node == 1);
+        CHECK(slots[5].cpus == std::vector<unsigned>{5});
+    }
+
+    SECTION("Scatter alternates between nodes") {
+        const auto slots = plan_placement(topology, placement_policy::k_scatter, 4);
+        REQUIRE(slots.size() == 4);
+        CHECK(slots[0].cpus == std::vector<unsigned>{0});
+        CHECK(slots[1].cpus == std::vector<unsigned>{4});
+        CHECK(slots[2].cpus == std::vector<unsigned>{1});
+        CHECK(slots[3].cpus == std::vector<unsigned>{5});
+    }
+
+    SECTION("Per-node pools span their whole node") {
+        const auto slots = plan_placement(topology, placement_policy::k_per_node, 8);
+        REQUIRE(slots.size() == 8);
+        std::size_t on_first = 0;
+        for (const auto& slot : slots) {
+            CHECK(slot.cpus == topology.nodes[slot.node]);
+            on_first += slot.node == 0 ? 1 : 0;
+        }
+        CHECK(on_first == 4);
+    }
+
+    SECTION("Workers beyond the CPU count wrap around") {
+        const auto slots = plan_placement(topology, placement_policy::k_compact, 10);
+        REQUIRE(slots.size() == 10);
+        CHECK(slots[8].cpus == std::vector<unsigned>{0});
+        CHECK(slots[9].cpus == std::vector<unsigned>{1});
+    }
+}
+
+TEST_CASE("Placement - Detect topology", "[placement]") {
+    const auto topology = detect_topology();
+    REQUIRE_FALSE(topology.nodes.empty());
+    CHECK(topology.cpu_count() > 0);
+}
@@ -0,0 +1,163 @@
+#include "shard.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace cshorelark::optimizer_cli;
+
+namespace {
+
+auto make_configs() -> std::vector<cshorelark::simulation::config> {
+    std::vector<cshorelark::simulation::config> configs;
+    for (std::size_t neurons : {2U, 4U, 8U, 16U, 32U}) {
+        cshorelark::simulation::config config;
+        config.brain_eye.num_neurons = neurons;
+        configs.push_back(config);
+    }
+    return configs;
+}
+
+auto log_entry(std::size_t config_index, std::size_t iteration, std::size_t generation)
+    -> nlohmann::json {
+    return {{"cfg", nlohmann::json::object()},
+            {"ctxt", {{"c", config_index}, {"i", iteration}, {"g", generation}}},
+            {"stats", nlohmann::json::object()}};
+}
+
+void write_log(const std::filesystem::path& path, const nlohmann::json& log) {
+    std::ofstream file(path);
+    file << log.dump();
+}
+
+}  // namespace
+
+TEST_CASE("Shard - Parse", "[shard]") {
+    SECTION("Valid shards") {
+        auto shard = parse_shard("2/5");
+        REQUIRE(shard.has_value());
+        CHECK(shard->index == 2);
+        CHECK(shard->count == 5);
+    }
+
+    SECTION("Invalid shards") {
+        CHECK_FALSE(parse_shard("5/5").has_value());
+        CHECK_FALSE(parse_shard("0/0").has_value());
+        CHECK_FALSE(parse_shard("1").has_value());
+        CHECK_FALSE(parse_shard("a/2").has_value());
+        CHECK_FALSE(parse_shard("1/2x").has_value());
+        CHECK_FALSE(parse_shard("/2").has_value());
+    }
+}
+
+TEST_CASE("Shard - Plan", "[shard]") {
+    const auto configs = make_configs();
+    constexpr std::size_t k_iterations = 3;
+    constexpr std::size_t k_shards = 4;
+
+    std::vector<std::vector<work_unit>> plans;
+    for (std::size_t index = 0; index < k_shards; ++index) {
+        plans.push_back(plan_shard(configs, k_iterations, 10, 42, shard_spec{index, k_shards}));
+    }
+
+    SECTION("Shards are disjoint and cover the sweep") {
+        std::set<std::pair<std::size_t, std::size_t>> seen;
+        std::size_t total = 0;
+        for (const auto& plan : plans) {
+            for (const auto& unit : plan) {
+                seen.emplace(unit.config_index, unit.iteration);
+                ++total;
+            }
+        }
+        CHECK(total == configs.size() * k_iterations);
+        CHECK(seen.size() == total);
+    }
+
+    SECTION("Shards are balanced") {
+        std::vector<double> loads;
+        for (const auto& plan : plans) {
+            double load = 0.0;
+            for (const auto& unit : plan) {
+                load += unit.cost;
+            }
+            loads.push_back(load);
+        }
+        const auto [lightest, heaviest] = std::minmax_element(loads.begin(), loads.end());
+        double largest_unit = 0.0;
+        for (const auto& plan : plans) {
+            for (const auto& unit : plan) {
+                largest_unit = std::max(largest_unit, unit.cost);
+            }
+        }
+        // Greedy assignment keeps the spread within one unit
+        CHECK(*heaviest - *lightest <= largest_unit);
+    }
+
+    SECTION("Seeds do not depend on the shard count") {
+        const auto whole = plan_shard(configs, k_iterations, 10, 42, shard_spec{});
+        for (const auto& plan : plans) {
+            for (const auto& unit : plan) {
+                const auto same = std::find_if(whole.begin(), whole.end(), [&](const auto& other) {
+                    return other.config_index == unit.config_index &&
+                           other.iteration == unit.iteration;
+                });
+                REQUIRE(same != whole.end());
+                CHECK(same->seed == unit.seed);
+            }
+        }
+    }
+
+    SECTION("Plans are deterministic") {
+        const auto again = plan_shard(configs, k_iterations, 10, 42, shard_spec{1, k_shards});
+        REQUIRE(again.size() == plans[1].size());
+        for (std::size_t i = 0; i < again.size(); ++i) {
+            CHECK(again[i].config_index == plans[1][i].config_index);
+            CHECK(again[i].iteration == plans[1][i].iteration);
+            CHECK(again[i].seed == plans[1][i].seed);
+        }
+    }
+}
+
+TEST_CASE("Shard - Merge logs", "[shard]") {
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto first = dir / "cshorelark_shard_0.json";
+    const auto second = dir / "cshorelark_shard_1.json";
+    const auto merged = dir / "cshorelark_shard_merged.json";
+
+    SECTION("Entries are ordered by config, iteration and generation") {
+        write_log(first, {log_entry(1, 0, 1), log_entry(1, 0, 0)});
+        write_log(second, {log_entry(0, 1, 0), log_entry(0, 0, 0)});
+
+        REQUIRE(merge_logs({first, second}, merged).has_value());
+
+        std::ifstream file(merged);
+        const auto log = nlohmann::json::parse(file);
+        REQUIRE(log.size() == 4);
+        CHECK(log[0] == log_entry(0, 0, 0));
+        CHECK(log[1] == log_entry(0, 1, 0));
+        CHECK(log[2] == log_entry(1, 0, 0));
+        CHECK(log[3] == log_entry(1, 0, 1));
+    }
+
+    SECTION("A unit in two logs is an error") {
+        write_log(first, {log_entry(0, 0, 0)});
+        write_log(second, {log_entry(0, 0, 1)});
+
+        CHECK_FALSE(merge_logs({first, second}, merged).has_value());
+    }
+
+    SECTION("Logs without configuration indices are rejected") {
+        write_log(first, {{{"ctxt", {{"i", 0}, {"g", 0}}}}});
+
+        CHECK_FALSE(merge_logs({first}, merged).has_value());
+    }
+
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+    std::filesystem::remove(merged);
+}
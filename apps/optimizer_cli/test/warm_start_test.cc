@@ -0,0 +1,67 @@
+#include "warm_start.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "random/random.h"
+#include "simulation/brain.h"
+
+using namespace cshorelark::optimizer_cli;
+
+namespace {
+
+auto saved_population(std::size_t size) -> genome_set {
+    genome_set population;
+    population.config.brain_eye.num_cells = 4;
+    population.config.brain_eye.num_neurons = 3;
+    cshorelark::random::random_generator random(5);
+    for (std::size_t i = 0; i < size; ++i) {
+        population.genomes.push_back(
+            cshorelark::simulation::brain::random(population.config, random).as_chromosome());
+    }
+    return population;
+}
+
+}  // namespace
+
+TEST_CASE("Warm start - Population", "[warm_start]") {
+    const auto population = saved_population(3);
+    cshorelark::simulation::config config;
+    config.world.num_animals = 7;
+    config.brain_eye.num_cells = 6;
+    config.brain_eye.num_neurons = 2;
+
+    SECTION("Genomes repeat and fit the configured brain") {
+        auto chromosomes = warm_start_population(population, config);
+        REQUIRE(chromosomes.has_value());
+        REQUIRE(chromosomes->size() == 7);
+        for (const auto& chromosome : *chromosomes) {
+            CHECK(cshorelark::simulation::brain::from_chromosome(config, chromosome).has_value());
+        }
+        const auto first = (*chromosomes)[0].genes();
+        const auto repeated = (*chromosomes)[3].genes();
+        CHECK(std::vector<float>(first.begin(), first.end()) ==
+              std::vector<float>(repeated.begin(), repeated.end()));
+    }
+
+    SECTION("Empty or mislabeled populations are rejected") {
+        CHECK_FALSE(warm_start_population(genome_set{}, config).has_value());
+        auto mislabeled = saved_population(1);
+        mislabeled.config.brain_eye.num_neurons = 5;
+        CHECK_FALSE(warm_start_population(mislabeled, config).has_value());
+    }
+}
+
+TEST_CASE("Warm start - Summary", "[warm_start]") {
+    const std::vector<warm_start_result> results = {
+        {0, 0, 2, 6},             // Saved 4
+        {1, 0, 3, std::nullopt},  // Cold never got there in 10: saved at least 7
+        {2, 0, std::nullopt, std::nullopt},
+    };
+    const auto summary = summarize_warm_start(results, 10, 12.5F);
+    CHECK(summary.find("12.50") != std::string::npos);
+    CHECK(summary.find("2/3 warm and 1/3 cold") != std::string::npos);
+    CHECK(summary.find("saved 3.7 generations") != std::string::npos);
+}
@@ -0,0 +1,126 @@
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <args.hxx>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "random/random.h"
+#include "simulation/config.h"
+#include "simulation/simulation.h"
+#include "world_stream/frame.h"
+#include "world_stream/server.h"
+
+namespace {
+
+std::atomic<bool> g_stop_requested{false};
+
+void request_stop(int /*signal*/) { g_stop_requested = true; }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    namespace ws = cshorelark::world_stream;
+
+    args::ArgumentParser parser("CShorelark Simulation Server",
+                                "Runs the simulation headless and streams it to simulation_ui");
+    args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+    args::ValueFlag<std::string> address(parser, "address", "Address to listen on", {"address"},
+                                         "127.0.0.1");
+    args::ValueFlag<std::uint16_t> port(parser, "port", "Port to listen on", {'p', "port"},
+                                        ws::k_default_port);
+    args::ValueFlag<std::uint64_t> seed(parser, "seed", "Random seed, random if not given",
+                                        {'s', "seed"});
+    args::ValueFlag<std::size_t> animals(parser, "animals", "Number of animals", {"animals"},
+                                         cshorelark::simulation::world_config{}.num_animals);
+    args::ValueFlag<std::size_t> foods(parser, "foods", "Number of foods", {"foods"},
+                                       cshorelark::simulation::world_config{}.num_foods);
+    args::ValueFlag<std::size_t> generation_length(
+        parser, "steps", "Steps per generation", {"generation-length"},
+        cshorelark::simulation::sim_config{}.generation_length);
+    args::ValueFlag<float> max_fps(parser, "fps", "Highest frame rate a client may ask for",
+                                   {"max-fps"}, 120.0F);
+    args::ValueFlag<float> steps_per_second(
+        parser, "steps", "Simulation steps per second, 0 runs as fast as possible",
+        {"steps-per-second"}, 0.0F);
+    args::Flag debug_mode(parser, "debug", "Enable debug logging", {'d', "debug"});
+
+    try {
+        parser.ParseCLI(argc, argv);
+    } catch (const args::Help&) {
+        std::cout << parser;
+        return 0;
+    } catch (const args::ParseError& e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+    spdlog::set_level(debug_mode ? spdlog::level::debug : spdlog::level::info);
+
+    cshorelark::simulation::config config;
+    config.world.num_animals = args::get(animals);
+    config.world.num_foods = args::get(foods);
+    config.sim.generation_length = args::get(generation_length);
+
+    auto rng = seed ? cshorelark::random::random_generator(args::get(seed))
+                    : cshorelark::random::random_generator();
+    auto sim = cshorelark::simulation::simulation::random(config, rng);
+
+    ws::server_options options;
+    options.address = args::get(address);
+    options.port = args::get(port);
+    options.max_frame_rate = args::get(max_fps);
+    ws::stream_server server(ws::to_world_info(config), options);
+    if (auto started = server.start(); !started) {
+        spdlog::critical("Cannot start server: {}", ws::stream_error_to_string(started.error()));
+        return 1;
+    }
+
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+
+    using clock = std::chrono::steady_clock;
+    const auto frame_interval = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<float>(1.0F / std::max(args::get(max_fps), 1.0F)));
+    const auto step_interval =
+        args::get(steps_per_second) > 0.0F
+            ? std::chrono::duration_cast<clock::duration>(
+                  std::chrono::duration<float>(1.0F / args::get(steps_per_second)))
+            : clock::duration::zero();
+
+    // Snapshots are only taken when a client may use them, at most at the highest client rate
+    std::uint64_t sequence = 0;
+    auto next_frame = clock::now();
+    auto next_step = clock::now();
+    while (!g_stop_requested) {
+        if (auto stats = sim.step(rng)) {
+            spdlog::info("Generation {}: min={:.2f}, max={:.2f}, avg={:.2f}", stats->generation(),
+                         stats->ga_stats().min_fitness(), stats->ga_stats().max_fitness(),
+                         stats->ga_stats().avg_fitness());
+            server.publish_stats(ws::to_generation_stats(*stats));
+        }
+
+        const auto now = clock::now();
+        if (server.client_count() > 0 && now >= next_frame) {
+            auto frame = std::make_shared<ws::world_frame>();
+            ws::capture_frame(sim, ++sequence, *frame);
+            server.publish(std::move(frame));
+            next_frame = now + frame_interval;
+        }
+
+        if (step_interval > clock::duration::zero()) {
+            next_step += step_interval;
+            std::this_thread::sleep_until(next_step);
+        }
+    }
+
+    spdlog::info("Stopping server");
+    server.stop();
+    return 0;
+}
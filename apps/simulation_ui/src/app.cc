@@ -2,9 +2,11 @@
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <imgui_internal.h>
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <stdexcept>
@@ -22,6 +24,23 @@ void GlfwErrorCallback(int error, const char* description) {
 
 constexpr const char* kGlslVersion = "#version 130";
 
+// Longest time an idle frame blocks before checking the idle callback again
+constexpr double kIdleWaitSeconds = 0.25;
+
+// Frames keep being drawn this long after input so hover delays and tooltips settle
+constexpr std::chrono::milliseconds kInputGracePeriod{500};
+
+// Set by the refresh callback when the window contents were damaged
+std::atomic<bool> g_window_damaged{false};
+
+void GlfwRefreshCallback(GLFWwindow* /*window*/) { g_window_damaged = true; }
+
+// Input events reach ImGui's queue during event polling and are consumed by NewFrame
+bool HasPendingInput() {
+    const ::ImGuiContext* context = ImGui::GetCurrentContext();
+    return context != nullptr && context->InputEventsQueue.Size > 0;
+}
+
 // Path to the icons directory
 const std::filesystem::path kIconsPath = "apps/simulation_ui/assets/icons";
 const std::filesystem::path kIconsPathAlt = "assets/icons";
@@ -58,6 +77,16 @@ App::App(std::string_view title, int width, int height)
 App::~App() {
     spdlog::debug("App destructor: cleaning up resources");
 
+    if (window_) {
+        spdlog::info(
+            "Render loop: {} frames drawn in {:.1f} s at {:.1f}% UI thread CPU ({:.1f}% "
+            "process), {} frames skipped in {:.1f} s at {:.1f}% ({:.1f}% process)",
+            loop_stats_.frames_drawn, loop_stats_.active.total_seconds(),
+            loop_stats_.active.total_thread_percent(), loop_stats_.active.total_process_percent(),
+            loop_stats_.frames_skipped, loop_stats_.idle.total_seconds(),
+            loop_stats_.idle.total_thread_percent(), loop_stats_.idle.total_process_percent());
+    }
+
     imgui_context_.reset();
     spdlog::debug("ImGui context destroyed");
 
@@ -75,7 +104,9 @@ App::App(App&& other) noexcept
       title_(std::move(other.title_)),
       width_(other.width_),
       height_(other.height_),
-      imgui_context_(std::move(other.imgui_context_)) {
+      imgui_context_(std::move(other.imgui_context_)),
+      is_idle_(std::move(other.is_idle_)),
+      loop_stats_(other.loop_stats_) {
     spdlog::debug("App move constructor");
 }
 
@@ -93,6 +124,8 @@ App& App::operator=(App&& other) noexcept {
         width_ = other.width_;
         height_ = other.height_;
         imgui_context_ = std::move(other.imgui_context_);
+        is_idle_ = std::move(other.is_idle_);
+        loop_stats_ = other.loop_stats_;
     }
     return *this;
 }
@@ -105,11 +138,48 @@ bool App::ShouldClose() const noexcept {
     return should_close;
 }
 
+void App::RequestRedraw() noexcept {
+    redraw_requested_ = true;
+    glfwPostEmptyEvent();
+}
+
+bool App::WaitForChange() {
+    glfwWaitEventsTimeout(kIdleWaitSeconds);
+
+    int width = 0;
+    int height = 0;
+    glfwGetFramebufferSize(window_, &width, &height);
+    const bool resized = width != framebuffer_width_ || height != framebuffer_height_;
+    framebuffer_width_ = width;
+    framebuffer_height_ = height;
+
+    const bool damaged = g_window_damaged.exchange(false);
+    return HasPendingInput() || redraw_requested_.exchange(false) || resized || damaged;
+}
+
 void App::RunFrame(const std::function<void()>& render_callback) {
     spdlog::trace("RunFrame: starting new frame");
-
-    // Poll events
-    glfwPollEvents();
+    using clock = std::chrono::steady_clock;
+    const auto start_time = clock::now();
+    const auto start_thread_cpu = thread_cpu_time();
+    const auto start_process_cpu = process_cpu_time();
+
+    // Block while nothing changes, otherwise just poll
+    const bool may_idle = is_idle_ && !redraw_requested_.exchange(false) &&
+                          start_time - last_input_time_ > kInputGracePeriod && is_idle_();
+    if (may_idle && !WaitForChange()) {
+        ++loop_stats_.frames_skipped;
+        loop_stats_.idle.add(clock::now() - start_time, thread_cpu_time() - start_thread_cpu,
+                             process_cpu_time() - start_process_cpu);
+        spdlog::trace("RunFrame: nothing changed, frame skipped");
+        return;
+    }
+    if (!may_idle) {
+        glfwPollEvents();
+    }
+    if (HasPendingInput()) {
+        last_input_time_ = clock::now();
+    }
 
     // Start the Dear ImGui frame
     spdlog::trace("RunFrame: starting ImGui frame");
@@ -132,6 +202,10 @@ void App::RunFrame(const std::function<void()>& render_callback) {
     spdlog::trace("RunFrame: swapping buffers");
     glfwSwapBuffers(window_);
 
+    ++loop_stats_.frames_drawn;
+    loop_stats_.active.add(clock::now() - start_time, thread_cpu_time() - start_thread_cpu,
+                           process_cpu_time() - start_process_cpu);
+
     spdlog::trace("RunFrame: frame completed");
 }
 
@@ -164,6 +238,9 @@ void App::InitGlfw() {
     }
     spdlog::debug("GLFW window created successfully");
 
+    glfwSetWindowRefreshCallback(window_, GlfwRefreshCallback);
+    glfwGetFramebufferSize(window_, &framebuffer_width_, &framebuffer_height_);
+
     glfwMakeContextCurrent(window_);
     glfwSwapInterval(1);  // Enable vsync
     spdlog::debug("OpenGL context made current, vsync enabled");
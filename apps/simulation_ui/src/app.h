@@ -1,6 +1,8 @@
 #ifndef CSHORELARK_APPS_SIMULATION_UI_APP_H
 #define CSHORELARK_APPS_SIMULATION_UI_APP_H
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -8,6 +10,7 @@
 #include <vector>
 
 #include "imgui_context.h"
+#include "perf_stats.h"
 
 struct GLFWwindow;
 
@@ -43,10 +46,34 @@ public:
 
     /**
      * @brief Runs a single frame of the application.
+     *
+     * When the idle callback reports that nothing changed and there was no recent input,
+     * the frame blocks in glfwWaitEventsTimeout and is only drawn if input, a redraw
+     * request or a window change arrives while waiting.
+     *
      * @param render_callback Optional callback function to render content before the frame ends
      */
     void RunFrame(const std::function<void()>& render_callback = nullptr);
 
+    /**
+     * @brief Sets the callback telling whether the content is unchanged since the last frame.
+     * @param is_idle Returns true when a frame may be skipped, called on the UI thread
+     */
+    void SetIdleCallback(std::function<bool()> is_idle) { is_idle_ = std::move(is_idle); }
+
+    /**
+     * @brief Wakes the render loop to draw the next frame, callable from any thread.
+     */
+    void RequestRedraw() noexcept;
+
+    /**
+     * @brief Gets the CPU use of drawn versus skipped frames.
+     * @return Render loop statistics
+     */
+    [[nodiscard]] const render_loop_stats& GetRenderLoopStats() const noexcept {
+        return loop_stats_;
+    }
+
     /**
      * @brief Gets the ImGui context for UI rendering.
      * @return Reference to the ImGui context
@@ -63,13 +90,22 @@ private:
     void InitGlfw();
     void InitGlew();
     void SetWindowIcon();
+    [[nodiscard]] bool WaitForChange();
 
     GLFWwindow* window_;
     std::string title_;
     int width_;
     int height_;
     std::unique_ptr<ImGuiContext> imgui_context_;
-    
+
+    // Idle mode
+    std::function<bool()> is_idle_;
+    std::atomic<bool> redraw_requested_{true};
+    std::chrono::steady_clock::time_point last_input_time_{};
+    int framebuffer_width_ = 0;
+    int framebuffer_height_ = 0;
+    render_loop_stats loop_stats_;
+
     // Icon data
     struct IconData {
         std::vector<unsigned char> pixels;
@@ -0,0 +1,113 @@
+#include "fitness_history.h"
+
+#include <algorithm>
+
+namespace cshorelark {
+
+namespace {
+
+auto single_value(float value) -> fitness_range { return fitness_range{value, value, value}; }
+
+void merge_range(fitness_range& into, const fitness_range& from) {
+    into.lo = std::min(into.lo, from.lo);
+    into.hi = std::max(into.hi, from.hi);
+    into.sum += from.sum;
+}
+
+void merge_bucket(fitness_bucket& into, const fitness_bucket& from) {
+    if (into.count == 0) {
+        into = from;
+        return;
+    }
+    into.count += from.count;
+    merge_range(into.min, from.min);
+    merge_range(into.max, from.max);
+    merge_range(into.avg, from.avg);
+    merge_range(into.median, from.median);
+}
+
+}  // namespace
+
+void fitness_history::push(const fitness_sample& sample) {
+    fitness_bucket bucket;
+    bucket.first_generation = sample.generation;
+    bucket.count = 1;
+    bucket.min = single_value(sample.min);
+    bucket.max = single_value(sample.max);
+    bucket.avg = single_value(sample.avg);
+    bucket.median = single_value(sample.median);
+
+    append(0, bucket);
+    latest_ = sample;
+    ++size_;
+}
+
+void fitness_history::clear() {
+    for (auto& lvl : levels_) {
+        lvl.head = 0;
+        lvl.total = 0;
+        lvl.pending = fitness_bucket{};
+        lvl.pending_children = 0;
+    }
+    size_ = 0;
+    latest_ = fitness_sample{};
+}
+
+void fitness_history::append(std::size_t level_index, const fitness_bucket& bucket) {
+    auto& lvl = levels_[level_index];
+    lvl.ring[lvl.head] = bucket;
+    lvl.head = (lvl.head + 1) % k_level_capacity;
+    ++lvl.total;
+
+    if (level_index + 1 == k_levels) {
+        return;
+    }
+    auto& next = levels_[level_index + 1];
+    merge_bucket(next.pending, bucket);
+    if (++next.pending_children == k_downsample_factor) {
+        const fitness_bucket completed = next.pending;
+        next.pending = fitness_bucket{};
+        next.pending_children = 0;
+        append(level_index + 1, completed);
+    }
+}
+
+auto fitness_history::collect(std::size_t max_points, std::vector<fitness_bucket>& out) const
+    -> std::size_t {
+    out.clear();
+    max_points = std::max<std::size_t>(max_points, 1);
+
+    // Finest level that still holds the whole history within the point budget
+    std::size_t level_index = k_levels - 1;
+    for (std::size_t i = 0; i < k_levels; ++i) {
+        const auto& lvl = levels_[i];
+        const std::size_t points = lvl.total + 1;
+        if (lvl.total <= k_level_capacity && points <= max_points) {
+            level_index = i;
+            break;
+        }
+    }
+
+    const auto& lvl = levels_[level_index];
+    const std::size_t stored = std::min(lvl.total, k_level_capacity);
+    const std::size_t first = (lvl.head + k_level_capacity - stored) % k_level_capacity;
+    out.reserve(stored + 1);
+    for (std::size_t i = 0; i < stored; ++i) {
+        out.push_back(lvl.ring[(first + i) % k_level_capacity]);
+    }
+
+    // Partially filled buckets of this level and the finer ones carry the most recent
+    // generations, oldest first
+    fitness_bucket tail;
+    for (std::size_t i = level_index; i > 0; --i) {
+        if (levels_[i].pending_children > 0) {
+            merge_bucket(tail, levels_[i].pending);
+        }
+    }
+    if (tail.count > 0) {
+        out.push_back(tail);
+    }
+    return level_index;
+}
+
+}  // namespace cshorelark
@@ -0,0 +1,107 @@
+#ifndef CSHORELARK_APPS_SIMULATION_UI_FITNESS_HISTORY_H
+#define CSHORELARK_APPS_SIMULATION_UI_FITNESS_HISTORY_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace cshorelark {
+
+/**
+ * @brief Fitness statistics of one completed generation.
+ */
+struct fitness_sample {
+    std::size_t generation{0};
+    float min{0.0F};
+    float max{0.0F};
+    float avg{0.0F};
+    float median{0.0F};
+};
+
+/**
+ * @brief Envelope of one statistic over the generations of a bucket.
+ */
+struct fitness_range {
+    float lo{0.0F};   ///< Smallest value in the bucket
+    float hi{0.0F};   ///< Largest value in the bucket
+    float sum{0.0F};  ///< Sum of the values, for the bucket mean
+};
+
+/**
+ * @brief Downsampled summary of consecutive generations.
+ */
+struct fitness_bucket {
+    std::size_t first_generation{0};  ///< First generation covered by the bucket
+    std::size_t count{0};             ///< Number of generations covered
+    fitness_range min;
+    fitness_range max;
+    fitness_range avg;
+    fitness_range median;
+};
+
+/**
+ * @brief Bounded-memory history of generation fitness statistics.
+ *
+ * Keeps k_levels ring buffers of k_level_capacity buckets each. Level 0 holds
+ * individual generations; every k_downsample_factor buckets of a level are
+ * merged into one bucket of the next level, keeping the min/max envelope of
+ * each statistic. Memory stays constant however long the simulation runs and
+ * charts read the finest level that covers the whole history.
+ */
+class fitness_history {
+public:
+    static constexpr std::size_t k_levels = 8;
+    static constexpr std::size_t k_level_capacity = 256;
+    static constexpr std::size_t k_downsample_factor = 4;
+
+    /**
+     * @brief Records the statistics of a completed generation.
+     * @param sample The generation statistics
+     */
+    void push(const fitness_sample& sample);
+
+    /**
+     * @brief Removes all recorded generations.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of generations recorded since the last clear.
+     * @return Number of generations
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+
+    /**
+     * @brief Gets the most recent sample.
+     * @return The last pushed sample, zeroed if the history is empty
+     */
+    [[nodiscard]] auto latest() const noexcept -> const fitness_sample& { return latest_; }
+
+    /**
+     * @brief Collects the buckets of the finest level that fits a point budget.
+     *
+     * @param max_points Maximum number of buckets wanted, usually the chart width
+     * @param out Receives the buckets from oldest to newest, cleared first
+     * @return The level the buckets were read from
+     */
+    auto collect(std::size_t max_points, std::vector<fitness_bucket>& out) const -> std::size_t;
+
+private:
+    struct level {
+        std::array<fitness_bucket, k_level_capacity> ring{};
+        std::size_t head{0};       ///< Next slot to write
+        std::size_t total{0};      ///< Buckets completed since the last clear
+        fitness_bucket pending{};  ///< Bucket being filled from the level below
+        std::size_t pending_children{0};
+    };
+
+    void append(std::size_t level_index, const fitness_bucket& bucket);
+
+    std::vector<level> levels_ = std::vector<level>(k_levels);  // Heap allocated, ~150 KiB
+    std::size_t size_{0};
+    fitness_sample latest_{};
+};
+
+}  // namespace cshorelark
+
+#endif  // CSHORELARK_APPS_SIMULATION_UI_FITNESS_HISTORY_H
@@ -3,12 +3,34 @@
 #include <spdlog/spdlog.h>
 
 #include <args.hxx>
+#include <charconv>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 
 #include "app.h"
 #include "simulation_window.h"
+#include "world_stream/server.h"
+
+namespace {
+
+// Parses the port of --connect, only 1 to 65535 names a server
+auto parse_port(const std::string& text) -> std::optional<std::uint16_t> {
+    unsigned long value = 0;
+    const char* end = text.data() + text.size();
+    const auto [ptr, error] = std::from_chars(text.data(), end, value);
+    if (error != std::errc() || ptr != end || value == 0 ||
+        value > std::numeric_limits<std::uint16_t>::max()) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint16_t>(value);
+}
+
+}  // namespace
 
 int main(int argc, char* argv[]) {
     // Setup command line argument parsing
@@ -35,6 +57,13 @@ int main(int argc, char* argv[]) {
     args::ValueFlag<std::string> windowTitle(parser, "title", "Window title", {'t', "title"},
                                              "CShorelark Simulation");
 
+    // Remote simulation settings
+    args::ValueFlag<std::string> connectTo(
+        parser, "host:port", "Show the simulation streamed by a simulation_server",
+        {"connect"});
+    args::ValueFlag<float> streamFps(parser, "fps", "Frame rate requested from the server",
+                                     {"fps"}, 60.0f);
+
     try {
         spdlog::info("Parsing command line arguments");
         parser.ParseCLI(argc, argv);
@@ -48,6 +77,24 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Split --connect into host and port before any window opens
+    std::string connect_host;
+    std::uint16_t connect_port = cshorelark::world_stream::k_default_port;
+    if (connectTo) {
+        const std::string& target = args::get(connectTo);
+        const auto separator = target.rfind(':');
+        connect_host = separator == std::string::npos ? target : target.substr(0, separator);
+        if (separator != std::string::npos) {
+            const auto port = parse_port(target.substr(separator + 1));
+            if (!port) {
+                spdlog::error("Invalid port in --connect {}", target);
+                std::cerr << "--connect needs a port from 1 to 65535, got " << target << std::endl;
+                return 1;
+            }
+            connect_port = *port;
+        }
+    }
+
     // Configure logging level
     if (traceMode) {
         spdlog::set_level(spdlog::level::trace);
@@ -72,6 +119,14 @@ int main(int argc, char* argv[]) {
 
         // Create simulation window
         cshorelark::simulation_window sim_window;
+        sim_window.set_redraw_callback([&app]() { app.RequestRedraw(); });
+        sim_window.set_render_loop_stats(&app.GetRenderLoopStats());
+        app.SetIdleCallback([&sim_window]() { return sim_window.is_idle(); });
+        if (connectTo) {
+            if (!sim_window.connect(connect_host, connect_port, args::get(streamFps))) {
+                spdlog::warn("Running the local simulation instead");
+            }
+        }
 
         spdlog::info("Entering main application loop");
         int frame_count = 0;
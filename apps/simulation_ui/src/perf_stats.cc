@@ -0,0 +1,144 @@
+#include "perf_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace cshorelark {
+
+void rolling_histogram::add(float value) noexcept {
+    values_[next_] = value;
+    next_ = (next_ + 1) % k_capacity;
+    count_ = std::min(count_ + 1, k_capacity);
+}
+
+void rolling_histogram::clear() noexcept {
+    next_ = 0;
+    count_ = 0;
+}
+
+auto rolling_histogram::percentile(float fraction) const -> float {
+    if (count_ == 0) {
+        return 0.0F;
+    }
+    scratch_.assign(values_.begin(), values_.begin() + static_cast<std::ptrdiff_t>(count_));
+    const float clamped = std::clamp(fraction, 0.0F, 1.0F);
+    const auto rank =
+        static_cast<std::size_t>(std::lround(clamped * static_cast<float>(count_ - 1)));
+    std::nth_element(scratch_.begin(), scratch_.begin() + static_cast<std::ptrdiff_t>(rank),
+                     scratch_.end());
+    return scratch_[rank];
+}
+
+auto rolling_histogram::mean() const noexcept -> float {
+    if (count_ == 0) {
+        return 0.0F;
+    }
+    const float sum = std::accumulate(
+        values_.begin(), values_.begin() + static_cast<std::ptrdiff_t>(count_), 0.0F);
+    return sum / static_cast<float>(count_);
+}
+
+auto rolling_histogram::last() const noexcept -> float {
+    if (count_ == 0) {
+        return 0.0F;
+    }
+    return values_[(next_ + k_capacity - 1) % k_capacity];
+}
+
+void rate_counter::add(std::size_t events, std::chrono::duration<float> elapsed) noexcept {
+    events_ += events;
+    seconds_ += elapsed.count();
+    if (seconds_ >= k_window_seconds) {
+        rate_ = static_cast<float>(events_) / seconds_;
+        events_ = 0;
+        seconds_ = 0.0F;
+    }
+}
+
+void cpu_usage_meter::add(std::chrono::duration<float> wall, std::chrono::nanoseconds thread_cpu,
+                          std::chrono::nanoseconds process_cpu) noexcept {
+    const float thread_seconds = std::chrono::duration<float>(thread_cpu).count();
+    const float process_seconds = std::chrono::duration<float>(process_cpu).count();
+    total_seconds_ += wall.count();
+    total_thread_seconds_ += thread_seconds;
+    total_process_seconds_ += process_seconds;
+
+    window_seconds_ += wall.count();
+    window_thread_seconds_ += thread_seconds;
+    window_process_seconds_ += process_seconds;
+    if (window_seconds_ >= k_window_seconds) {
+        thread_percent_ = 100.0F * window_thread_seconds_ / window_seconds_;
+        process_percent_ = 100.0F * window_process_seconds_ / window_seconds_;
+        window_seconds_ = 0.0F;
+        window_thread_seconds_ = 0.0F;
+        window_process_seconds_ = 0.0F;
+    }
+}
+
+auto cpu_usage_meter::total_thread_percent() const noexcept -> float {
+    return total_seconds_ > 0.0F ? 100.0F * total_thread_seconds_ / total_seconds_ : 0.0F;
+}
+
+auto cpu_usage_meter::total_process_percent() const noexcept -> float {
+    return total_seconds_ > 0.0F ? 100.0F * total_process_seconds_ / total_seconds_ : 0.0F;
+}
+
+auto thread_cpu_time() noexcept -> std::chrono::nanoseconds {
+#ifdef _WIN32
+    FILETIME creation_time;
+    FILETIME exit_time;
+    FILETIME kernel_time;
+    FILETIME user_time;
+    if (GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time,
+                       &user_time) == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+    const auto to_ticks = [](const FILETIME &time) {
+        return (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    // FILETIME counts 100 ns ticks
+    return std::chrono::nanoseconds{(to_ticks(kernel_time) + to_ticks(user_time)) * 100};
+#else
+    timespec time{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return std::chrono::nanoseconds{0};
+    }
+    return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+#endif
+}
+
+auto process_cpu_time() noexcept -> std::chrono::nanoseconds {
+#ifdef _WIN32
+    FILETIME creation_time;
+    FILETIME exit_time;
+    FILETIME kernel_time;
+    FILETIME user_time;
+    if (GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time,
+                        &user_time) == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+    const auto to_ticks = [](const FILETIME &time) {
+        return (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return std::chrono::nanoseconds{(to_ticks(kernel_time) + to_ticks(user_time)) * 100};
+#else
+    timespec time{};
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) {
+        return std::chrono::nanoseconds{0};
+    }
+    return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+#endif
+}
+
+}  // namespace cshorelark
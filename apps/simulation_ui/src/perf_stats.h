@@ -0,0 +1,186 @@
+#ifndef CSHORELARK_APPS_SIMULATION_UI_PERF_STATS_H
+#define CSHORELARK_APPS_SIMULATION_UI_PERF_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cshorelark {
+
+/**
+ * @brief Fixed-size window of the most recent samples of a timing.
+ *
+ * Adding a sample is a single store; percentiles are only computed when the
+ * overlay asks for them.
+ */
+class rolling_histogram {
+public:
+    static constexpr std::size_t k_capacity = 256;
+
+    /**
+     * @brief Adds a sample, overwriting the oldest one when the window is full.
+     * @param value The sample
+     */
+    void add(float value) noexcept;
+
+    /**
+     * @brief Removes all samples.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Gets the number of samples in the window.
+     * @return Sample count, at most k_capacity
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return count_; }
+
+    /**
+     * @brief Computes a percentile of the window.
+     * @param fraction Percentile as a fraction in [0, 1]
+     * @return The percentile, 0 when the window is empty
+     */
+    [[nodiscard]] auto percentile(float fraction) const -> float;
+
+    /**
+     * @brief Computes the mean of the window.
+     * @return The mean, 0 when the window is empty
+     */
+    [[nodiscard]] auto mean() const noexcept -> float;
+
+    /**
+     * @brief Gets the most recent sample.
+     * @return The last sample, 0 when the window is empty
+     */
+    [[nodiscard]] auto last() const noexcept -> float;
+
+    /**
+     * @brief Raw ring storage, for ImGui plots together with offset().
+     * @return Pointer to the samples
+     */
+    [[nodiscard]] auto data() const noexcept -> const float* { return values_.data(); }
+
+    /**
+     * @brief Index of the oldest sample in data().
+     * @return Ring offset
+     */
+    [[nodiscard]] auto offset() const noexcept -> int {
+        return count_ < k_capacity ? 0 : static_cast<int>(next_);
+    }
+
+private:
+    std::array<float, k_capacity> values_{};
+    std::size_t next_{0};
+    std::size_t count_{0};
+    mutable std::vector<float> scratch_;
+};
+
+/**
+ * @brief Measures the rate of an event over windows of a minimum duration.
+ */
+class rate_counter {
+public:
+    /**
+     * @brief Records events and elapsed time, closing the window when due.
+     * @param events Number of events since the last call
+     * @param elapsed Time since the last call
+     */
+    void add(std::size_t events, std::chrono::duration<float> elapsed) noexcept;
+
+    /**
+     * @brief Gets the rate of the last closed window.
+     * @return Events per second
+     */
+    [[nodiscard]] auto per_second() const noexcept -> float { return rate_; }
+
+private:
+    static constexpr float k_window_seconds = 0.5F;
+
+    std::size_t events_{0};
+    float seconds_{0.0F};
+    float rate_{0.0F};
+};
+
+/**
+ * @brief Measures CPU use of a thread and of the whole process as a share of wall time.
+ */
+class cpu_usage_meter {
+public:
+    /**
+     * @brief Records a span of wall time and the CPU time consumed during it.
+     * @param wall Wall time of the span
+     * @param thread_cpu CPU time of the measured thread during the span
+     * @param process_cpu CPU time of all threads of the process during the span
+     */
+    void add(std::chrono::duration<float> wall, std::chrono::nanoseconds thread_cpu,
+             std::chrono::nanoseconds process_cpu) noexcept;
+
+    /**
+     * @brief Gets the thread CPU use of the last closed window.
+     * @return Percentage of one core
+     */
+    [[nodiscard]] auto thread_percent() const noexcept -> float { return thread_percent_; }
+
+    /**
+     * @brief Gets the process CPU use of the last closed window.
+     * @return Percentage of one core, above 100 when several cores are busy
+     */
+    [[nodiscard]] auto process_percent() const noexcept -> float { return process_percent_; }
+
+    /**
+     * @brief Gets the thread CPU use over everything recorded.
+     * @return Percentage of one core
+     */
+    [[nodiscard]] auto total_thread_percent() const noexcept -> float;
+
+    /**
+     * @brief Gets the process CPU use over everything recorded.
+     * @return Percentage of one core
+     */
+    [[nodiscard]] auto total_process_percent() const noexcept -> float;
+
+    /**
+     * @brief Gets the wall time recorded.
+     * @return Seconds
+     */
+    [[nodiscard]] auto total_seconds() const noexcept -> float { return total_seconds_; }
+
+private:
+    static constexpr float k_window_seconds = 1.0F;
+
+    float window_seconds_{0.0F};
+    float window_thread_seconds_{0.0F};
+    float window_process_seconds_{0.0F};
+    float thread_percent_{0.0F};
+    float process_percent_{0.0F};
+    float total_seconds_{0.0F};
+    float total_thread_seconds_{0.0F};
+    float total_process_seconds_{0.0F};
+};
+
+/**
+ * @brief Time the render loop spent drawing frames versus waiting for events.
+ */
+struct render_loop_stats {
+    cpu_usage_meter active;         ///< Iterations that drew a frame
+    cpu_usage_meter idle;           ///< Iterations that waited and skipped drawing
+    std::uint64_t frames_drawn{0};
+    std::uint64_t frames_skipped{0};
+};
+
+/**
+ * @brief Gets the CPU time consumed by the calling thread.
+ * @return Thread CPU time, zero if the platform cannot report it
+ */
+[[nodiscard]] auto thread_cpu_time() noexcept -> std::chrono::nanoseconds;
+
+/**
+ * @brief Gets the CPU time consumed by all threads of the process.
+ * @return Process CPU time, zero if the platform cannot report it
+ */
+[[nodiscard]] auto process_cpu_time() noexcept -> std::chrono::nanoseconds;
+
+}  // namespace cshorelark
+
+#endif  // CSHORELARK_APPS_SIMULATION_UI_PERF_STATS_H
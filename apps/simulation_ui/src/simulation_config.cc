@@ -25,7 +25,8 @@ auto create_brain_eye_table(const simulation::brain_eye_config& config) -> toml:
     return toml::table{{"fov_range", config.fov_range},
                        {"fov_angle_deg", config.fov_angle_deg},
                        {"num_cells", static_cast<int64_t>(config.num_cells)},
-                       {"num_neurons", static_cast<int64_t>(config.num_neurons)}};
+                       {"num_neurons", static_cast<int64_t>(config.num_neurons)},
+                       {"cache_last_input", config.cache_last_input}};
 }
 
 // Helper to create a TOML table from SimConfig
@@ -50,7 +51,9 @@ auto create_ui_table(const ui_config& config) -> toml::table {
     return toml::table{{"simulation_speed", config.simulation_speed},
                        {"show_vision_cones", config.show_vision_cones},
                        {"show_stats", config.show_stats},
-                       {"show_grid", config.show_grid}};
+                       {"show_grid", config.show_grid},
+                       {"show_perf_overlay", config.show_perf_overlay},
+                       {"idle_rendering", config.idle_rendering}};
 }
 
 // Parse world configuration from TOML
@@ -85,6 +88,7 @@ auto parse_brain_eye_config(const toml::table& table)
         config.fov_angle_deg = table["fov_angle_deg"].value_or(225.0F);
         config.num_cells = static_cast<std::size_t>(table["num_cells"].value_or(9));
         config.num_neurons = static_cast<std::size_t>(table["num_neurons"].value_or(9));
+        config.cache_last_input = table["cache_last_input"].value_or(true);
 
         spdlog::info(
             "Parsed brain & eye config: fov_range={}, fov_angle_deg={}, num_cells={}, "
@@ -155,6 +159,8 @@ auto parse_ui_config(const toml::table& table) -> tl::expected<ui_config, std::e
         config.show_vision_cones = table["show_vision_cones"].value_or(true);
         config.show_stats = table["show_stats"].value_or(true);
         config.show_grid = table["show_grid"].value_or(false);
+        config.show_perf_overlay = table["show_perf_overlay"].value_or(false);
+        config.idle_rendering = table["idle_rendering"].value_or(true);
 
         return config;
     } catch (const std::exception& e) {
@@ -13,10 +13,12 @@ namespace cshorelark {
  * @brief UI-specific configuration parameters
  */
 struct alignas(8) ui_config {
-    float simulation_speed = 1.0F;  ///< Simulation speed multiplier
-    bool show_vision_cones = true;  ///< Whether to show vision cones
-    bool show_stats = true;         ///< Whether to show statistics
-    bool show_grid = false;         ///< Whether to show grid
+    float simulation_speed = 1.0F;   ///< Simulation speed multiplier
+    bool show_vision_cones = true;   ///< Whether to show vision cones
+    bool show_stats = true;          ///< Whether to show statistics
+    bool show_grid = false;          ///< Whether to show grid
+    bool show_perf_overlay = false;  ///< Whether to show the performance overlay
+    bool idle_rendering = true;      ///< Whether to skip redraws while nothing changes
 };
 
 /**
@@ -3,7 +3,6 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <spdlog/spdlog.h>
-#include <stdint.h>  // For uintptr_t
 
 #include <algorithm>
 #include <chrono>
@@ -25,14 +24,23 @@ namespace cshorelark {
 
 namespace {
 
-auto rotate_vector(const ImVec2 &vector_in, float angle) -> ImVec2 {
-    const float cos_angle = std::cosf(angle);
-    const float sin_angle = std::sinf(angle);
-    return ImVec2{vector_in.x * cos_angle - vector_in.y * sin_angle,
-                  vector_in.x * sin_angle + vector_in.y * cos_angle};
+constexpr auto min_sleep_time_ms = 10;  // Minimum sleep time in milliseconds
+constexpr auto remote_poll_time_ms = 2;  // Frame polling interval of the remote thread
+constexpr auto paused_wait_time_ms = 100;  // Longest wait of the paused simulation thread
+constexpr float fitness_chart_width = 300.0F;
+constexpr float fitness_chart_height = 120.0F;
+constexpr float perf_plot_width = 280.0F;
+constexpr float perf_plot_height = 40.0F;
+
+auto to_milliseconds(std::chrono::steady_clock::duration duration) -> float {
+    return std::chrono::duration<float, std::milli>(duration).count();
 }
 
-constexpr auto min_sleep_time_ms = 10;  // Minimum sleep time in milliseconds
+auto to_fitness_sample(const simulation::statistics &stats) -> fitness_sample {
+    const auto &ga_stats = stats.ga_stats();
+    return fitness_sample{stats.generation(), ga_stats.min_fitness(), ga_stats.max_fitness(),
+                          ga_stats.avg_fitness(), ga_stats.median_fitness()};
+}
 
 }  // namespace
 
@@ -78,6 +86,49 @@ simulation_window::~simulation_window() {
     spdlog::debug("Simulation window destroyed");
 }
 
+auto simulation_window::is_idle() const -> bool {
+    return config_.get_ui().idle_rendering && !gui_data_updated_ && !file_dialog_open_ &&
+           !evolution_in_progress_;
+}
+
+void simulation_window::set_redraw_callback(std::function<void()> callback) {
+    const std::lock_guard<std::mutex> lock(gui_data_mutex_);
+    redraw_callback_ = std::move(callback);
+}
+
+auto simulation_window::connect(const std::string &host, std::uint16_t port, float frame_rate)
+    -> bool {
+    spdlog::info("Connecting to simulation server {}:{}", host, port);
+    stop_simulation_thread();
+
+    auto client = std::make_unique<world_stream::stream_client>();
+    const auto info = client->connect(host, port, paused_ ? 0.0F : frame_rate);
+    if (!info) {
+        spdlog::error("Cannot connect to {}:{}: {}", host, port,
+                      world_stream::stream_error_to_string(info.error()));
+        console_history_.push_back("Connection to " + host + " failed, running locally");
+        start_simulation_thread();
+        return false;
+    }
+
+    // Draw with the parameters of the remote world
+    auto sim_config = config_.get_simulation();
+    sim_config.world.food_size = info->food_size;
+    sim_config.world.bird_size = info->bird_size;
+    sim_config.brain_eye.fov_range = info->fov_range;
+    sim_config.brain_eye.fov_angle_deg = info->fov_angle_deg;
+    config_.set_simulation(sim_config);
+
+    drain_fitness_samples();
+    fitness_history_.clear();
+    remote_ = std::move(client);
+    remote_frame_rate_ = frame_rate;
+    thread_should_exit_ = false;
+    remote_thread_ = std::thread(&simulation_window::remote_thread_function, this);
+    console_history_.push_back("Connected to " + host + ":" + std::to_string(port));
+    return true;
+}
+
 void simulation_window::reset_world() {
     spdlog::info("Resetting simulation world");
     const auto &sim_config = config_.get_simulation();
@@ -87,21 +138,51 @@ void simulation_window::reset_world() {
         std::move(simulation::simulation::random(sim_config, random_)));
 
     elapsed_time_ = 0.0F;
+    drain_fitness_samples();
+    fitness_history_.clear();
     spdlog::info("World reset complete");
 }
 
-void simulation_window::spawn_animal() { simulation_->spawn_animal(random_); }
+// Spawns are queued for the simulation thread, woken in case it is paused
+void simulation_window::spawn_animal() {
+    simulation_->spawn_animal();
+    wake_simulation_thread();
+}
+
+void simulation_window::spawn_food() {
+    simulation_->spawn_food();
+    wake_simulation_thread();
+}
 
-void simulation_window::spawn_food() { simulation_->spawn_food(random_); }
+// The paused thread checks for changes under gui_data_mutex_, taking it before notifying
+// means a change queued just before cannot slip in between its check and its wait
+void simulation_window::wake_simulation_thread() {
+    {
+        const std::lock_guard<std::mutex> lock(gui_data_mutex_);
+    }
+    simulation_cv_.notify_all();
+}
 
 void simulation_window::render() {
     spdlog::trace("Rendering simulation window");
 
-    // Access the GUI data safely from the simulation thread
-    {
+    collect_perf_samples();
+    if (!ImGui::GetIO().WantTextInput && ImGui::IsKeyPressed(ImGuiKey_F3, false)) {
+        auto ui_cfg = config_.get_ui();
+        ui_cfg.show_perf_overlay = !ui_cfg.show_perf_overlay;
+        config_.set_ui(ui_cfg);
+    }
+
+    // Take a snapshot of the latest GUI data so the world can be rendered without the lock
+    if (gui_data_updated_) {
+        const auto lock_start = std::chrono::steady_clock::now();
         std::lock_guard<std::mutex> lock(gui_data_mutex_);
-        // Reset the updated flag
+        const auto copy_start = std::chrono::steady_clock::now();
+        render_data_.birds.assign(gui_data_.birds.begin(), gui_data_.birds.end());
+        render_data_.foods.assign(gui_data_.foods.begin(), gui_data_.foods.end());
         gui_data_updated_ = false;
+        perf_.ui_lock_wait_ms.add(to_milliseconds(copy_start - lock_start));
+        perf_.snapshot_copy_ms.add(to_milliseconds(std::chrono::steady_clock::now() - copy_start));
     }
 
     // Get full viewport size
@@ -183,6 +264,10 @@ void simulation_window::render() {
     render_console();
     ImGui::End();
 
+    if (config_.get_ui().show_perf_overlay) {
+        render_perf_overlay();
+    }
+
     // Process file dialog if it's open
     if (file_dialog_open_ && !ifd::FileDialog::Instance().IsDone("ConfigPathDlg")) {
         ifd::FileDialog::Instance().IsDone(
@@ -240,81 +325,56 @@ void simulation_window::render_world() {
     // Calculate scale factors - now scaling from [0,1] to screen coordinates
     const float scale = std::min(canvas_size.x, canvas_size.y);
 
-    // Scale the radius from normalized units to screen pixels
-    const float min_radius = 2.0F;  // Minimum radius in pixels
-    const auto food_size = world_config.food_size * scale;
-    const float radius = std::max(food_size, min_radius);
-    // Draw food with increased size and brighter color
-    spdlog::trace("Drawing {} food items", gui_data_.foods.size());
-    for (const auto &food : gui_data_.foods) {
-        const float pos_x = canvas_pos.x + food.pos_x * scale;
-        const float pos_y = canvas_pos.y + food.pos_y * scale;
-        // Draw food with brighter green color
-        draw_list->AddCircleFilled(ImVec2(pos_x, pos_y), radius, IM_COL32(50, 255, 50, 255));
-    }
-
-    // Scale the radius from normalized units to screen pixels
+    // Scale the radii from normalized units to screen pixels
+    const float min_radius = 2.0F;       // Minimum radius in pixels
     const float bird_min_radius = 3.0F;  // Minimum radius in pixels
-    const auto bird_size = world_config.bird_size * scale;
-    const float bird_radius = std::max(bird_size, bird_min_radius);
     const float fov_degrees = config_.get_simulation().brain_eye.fov_angle_deg;
-    const float fov_radians = fov_degrees * (simulation::constants::k_pi / 180.0f);
-    // Draw birds with increased size
-    spdlog::trace("Drawing {} birds", gui_data_.birds.size());
-    for (const auto &bird : gui_data_.birds) {
-        const float position_x = canvas_pos.x + bird.pos_x * scale;
-        const float position_y = canvas_pos.y + bird.pos_y * scale;
-
-        // Draw body with brighter white color
-        draw_list->AddCircleFilled(ImVec2(position_x, position_y), bird_radius,
-                                   IM_COL32(255, 255, 255, 255));
-
-        // Use bird.rotation directly for correct direction
-        const float display_rotation = bird.rotation;
-
-        // Draw direction indicator
-        const float direction_length = bird_radius * 2.5f;  // Made longer
-        const ImVec2 direction = rotate_vector(ImVec2(direction_length, 0), display_rotation);
-        draw_list->AddLine(ImVec2(position_x, position_y),
-                           ImVec2(position_x + direction.x, position_y + direction.y),
-                           IM_COL32(255, 50, 50, 255), 2.0F);
-
-        // Draw vision cone if enabled with increased visibility
-        if (ui_config.show_vision_cones) {
-            const float start_angle = display_rotation - fov_radians * 0.5F;
-            const float end_angle = display_rotation + fov_radians * 0.5F;
-            const float vision_radius = radius * 6.0F;  // Made larger
-            draw_list->PathArcTo(ImVec2(position_x, position_y), vision_radius, start_angle,
-                                 end_angle, 32);
-            draw_list->PathStroke(IM_COL32(255, 255, 0, 128), ImDrawFlags_None, 2.0F);
-        }
-
-        // Add invisible button for tooltip interaction
-        ImGui::SetCursorScreenPos(ImVec2(position_x - bird_radius, position_y - bird_radius));
-        ImGui::InvisibleButton(
-            ("##animal" + std::to_string(reinterpret_cast<uintptr_t>(&bird))).c_str(),
-            ImVec2(bird_radius * 2, bird_radius * 2));
 
-        // Show tooltip when hovering over the animal
-        if (ImGui::IsItemHovered()) {
-            ImGui::BeginTooltip();
-            ImGui::Text("Animal Statistics:");
-            ImGui::Separator();
-            ImGui::Text("Fitness: %zu", bird.fitness);
-            ImGui::Text("Speed: %.3f", bird.speed);
-            ImGui::Text("Orientation: %.2f°", bird.rotation * 180.0f / simulation::constants::k_pi);
-            ImGui::Text("Position: (%.1f, %.1f)", bird.pos_x, bird.pos_y);
-            ImGui::EndTooltip();
+    world_render_params params;
+    params.canvas_pos = canvas_pos;
+    params.scale = scale;
+    params.food_radius = std::max(world_config.food_size * scale, min_radius);
+    params.bird_radius = std::max(world_config.bird_size * scale, bird_min_radius);
+    params.vision_radius = params.food_radius * 6.0F;
+    params.fov_radians = fov_degrees * (simulation::constants::k_pi / 180.0f);
+    params.show_vision_cones = ui_config.show_vision_cones;
+    params.white_uv = draw_list->_Data->TexUvWhitePixel;
+
+    // Build food, bird and vision cone geometry on the worker threads
+    spdlog::trace("Drawing {} food items and {} birds", render_data_.foods.size(),
+                  render_data_.birds.size());
+    world_renderer_.render(draw_list, render_data_, params);
+
+    // Show a tooltip for the bird under the mouse cursor
+    const ImVec2 mouse_pos = ImGui::GetMousePos();
+    if (ImGui::IsWindowHovered()) {
+        const float hover_radius_sq = params.bird_radius * params.bird_radius;
+        for (const auto &bird : render_data_.birds) {
+            const float delta_x = canvas_pos.x + bird.pos_x * scale - mouse_pos.x;
+            const float delta_y = canvas_pos.y + bird.pos_y * scale - mouse_pos.y;
+            if (delta_x * delta_x + delta_y * delta_y <= hover_radius_sq) {
+                ImGui::BeginTooltip();
+                ImGui::Text("Animal Statistics:");
+                ImGui::Separator();
+                ImGui::Text("Fitness: %zu", bird.fitness);
+                ImGui::Text("Speed: %.3f", bird.speed);
+                ImGui::Text("Orientation: %.2f°",
+                            bird.rotation * 180.0f / simulation::constants::k_pi);
+                ImGui::Text("Position: (%.1f, %.1f)", bird.pos_x, bird.pos_y);
+                ImGui::EndTooltip();
+                break;
+            }
         }
     }
 
     // Add invisible button for interaction
+    ImGui::SetCursorScreenPos(canvas_pos);
     ImVec2 safe_canvas_size = ImVec2(std::max(canvas_size.x, 1.0F), std::max(canvas_size.y, 1.0F));
     ImGui::InvisibleButton("canvas", safe_canvas_size,
                            ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight);
 
-    // Handle mouse interactions with the simulation
-    if (ImGui::IsItemHovered()) {
+    // Handle mouse interactions with the simulation, a remote one cannot be changed
+    if (!remote_ && ImGui::IsItemHovered()) {
         // Implement mouse interaction here if needed
         // Example: spawn food when clicked
         if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
@@ -324,10 +384,25 @@ void simulation_window::render_world() {
 
             if (world_x >= 0 && world_x < 1.0F && world_y >= 0 && world_y < 1.0F) {
                 simulation_->spawn_food(world_x, world_y);
+                wake_simulation_thread();
                 spdlog::debug("Food spawned via mouse click at ({}, {})", world_x, world_y);
+            }
+        }
 
-                // Update GUI data after spawning food to show it immediately
-                update_data();
+        // Right click removes the food under the cursor
+        if (ImGui::IsMouseClicked(ImGuiMouseButton_Right)) {
+            const ImVec2 mouse_pos = ImGui::GetMousePos();
+            const float pick_radius_sq = params.food_radius * params.food_radius * 4.0F;
+            for (const auto &food : render_data_.foods) {
+                const float delta_x = canvas_pos.x + food.pos_x * scale - mouse_pos.x;
+                const float delta_y = canvas_pos.y + food.pos_y * scale - mouse_pos.y;
+                if (delta_x * delta_x + delta_y * delta_y <= pick_radius_sq) {
+                    simulation_->despawn_food(food.handle);
+                    wake_simulation_thread();
+                    spdlog::debug("Food despawned via mouse click at ({}, {})", food.pos_x,
+                                  food.pos_y);
+                    break;
+                }
             }
         }
     }
@@ -342,7 +417,17 @@ void simulation_window::render_controls() {
     config_.set_ui(ui);
 
     if (ImGui::Button(paused_ ? "Resume" : "Pause")) {
-        paused_ = !paused_;
+        set_paused(!paused_);
+    }
+
+    if (remote_) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("Streaming: %s, %llu frames, %.1f MiB",
+                            remote_->is_connected() ? "connected" : "disconnected",
+                            static_cast<unsigned long long>(remote_->frames_received()),
+                            static_cast<double>(remote_->bytes_received()) / (1024.0 * 1024.0));
+        ImGui::PopItemWidth();
+        return;
     }
 
     ImGui::SameLine();
@@ -459,16 +544,224 @@ void simulation_window::render_controls() {
 }
 
 void simulation_window::render_statistics() {
-    ImGui::Text("Generation: %zu", simulation_->get_generation());
+    ImGui::Text("Generation: %zu", get_generation());
     ImGui::Text("Time: %.1f s", elapsed_time_);
     ImGui::Text("Best Fitness: %zu", best_fitness_);
     ImGui::Text("Average Fitness: %.2f", avg_fitness_);
+    ImGui::Separator();
+    render_fitness_chart();
+}
+
+void simulation_window::collect_perf_samples() {
+    const auto frame_start = std::chrono::steady_clock::now();
+    const auto frame_cpu = thread_cpu_time();
+    if (perf_.has_last_frame) {
+        const auto frame_duration = frame_start - perf_.last_frame_start;
+        perf_.frame_ms.add(to_milliseconds(frame_duration));
+        perf_.ui_cpu_ms.add(
+            std::chrono::duration<float, std::milli>(frame_cpu - perf_.last_frame_cpu).count());
+        perf_.last_frame_seconds = std::chrono::duration<float>(frame_duration).count();
+    }
+    perf_.last_frame_start = frame_start;
+    perf_.last_frame_cpu = frame_cpu;
+    perf_.has_last_frame = true;
+
+    std::size_t steps = 0;
+    while (auto step_time = step_time_queue_.try_pop()) {
+        perf_.step_ms.add(*step_time);
+        ++steps;
+    }
+    perf_.step_rate.add(steps, std::chrono::duration<float>(perf_.last_frame_seconds));
+
+    while (auto sample = sim_loop_queue_.try_pop()) {
+        perf_.sim_lock_wait_ms.add(sample->lock_wait_ms);
+        perf_.sim_publish_ms.add(sample->publish_ms);
+        perf_.brain_cache = sample->brain_cache;
+    }
+}
+
+void simulation_window::render_perf_overlay() {
+    const ImGuiViewport *viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(
+        ImVec2(viewport->WorkPos.x + viewport->WorkSize.x * 0.5F, viewport->WorkPos.y + 10),
+        ImGuiCond_Always, ImVec2(0.5F, 0.0F));
+    ImGui::SetNextWindowBgAlpha(0.75F);
+    const ImGuiWindowFlags overlay_flags =
+        ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+    if (!ImGui::Begin("Performance", nullptr, overlay_flags)) {
+        ImGui::End();
+        return;
+    }
+
+    const auto &frame = perf_.frame_ms;
+    const float frame_mean = frame.mean();
+    ImGui::Text("Frame: %.2f ms (p50 %.2f, p99 %.2f) %.0f FPS", frame.last(),
+                frame.percentile(0.5F), frame.percentile(0.99F),
+                frame_mean > 0.0F ? 1000.0F / frame_mean : 0.0F);
+    ImGui::Text("UI thread CPU: %.2f ms/frame (%.0f%% of frame time)", perf_.ui_cpu_ms.mean(),
+                frame_mean > 0.0F ? 100.0F * perf_.ui_cpu_ms.mean() / frame_mean : 0.0F);
+    ImGui::PlotHistogram("##frame_ms", frame.data(), static_cast<int>(frame.size()),
+                         frame.offset(), "frame ms", 0.0F, frame.percentile(1.0F) * 1.2F,
+                         ImVec2(perf_plot_width, perf_plot_height));
+
+    ImGui::Separator();
+    const auto &step = perf_.step_ms;
+    ImGui::Text("Simulation: %.0f steps/s", perf_.step_rate.per_second());
+    ImGui::Text("Step: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms",
+                step.percentile(0.5F), step.percentile(0.9F), step.percentile(0.99F),
+                step.percentile(1.0F));
+    ImGui::PlotHistogram("##step_ms", step.data(), static_cast<int>(step.size()), step.offset(),
+                         "step ms", 0.0F, step.percentile(1.0F) * 1.2F,
+                         ImVec2(perf_plot_width, perf_plot_height));
+
+    ImGui::Separator();
+    ImGui::Text("Snapshot: publish %.3f ms (sim), copy %.3f ms (UI)", perf_.sim_publish_ms.mean(),
+                perf_.snapshot_copy_ms.mean());
+    ImGui::Text("gui_data_mutex_ wait: UI %.3f ms (p99 %.3f), sim %.3f ms (p99 %.3f)",
+                perf_.ui_lock_wait_ms.mean(), perf_.ui_lock_wait_ms.percentile(0.99F),
+                perf_.sim_lock_wait_ms.mean(), perf_.sim_lock_wait_ms.percentile(0.99F));
+
+    const auto &cache = perf_.brain_cache;
+    if (cache.hits() + cache.misses > 0) {
+        ImGui::Text("Brain cache: %.1f%% hits (zero input %llu, repeated %llu, inferred %llu)",
+                    100.0F * cache.hit_rate(), static_cast<unsigned long long>(cache.zero_hits),
+                    static_cast<unsigned long long>(cache.repeat_hits),
+                    static_cast<unsigned long long>(cache.misses));
+    }
+
+    ImGui::Separator();
+    const auto &geometry = world_renderer_.last_stats();
+    ImGui::Text("World geometry: %zu vertices, %zu indices, %zu chunks (%s)",
+                geometry.vertex_count, geometry.index_count, geometry.chunk_count,
+                geometry.parallel ? "parallel" : "serial");
+    const ImGuiIO &io = ImGui::GetIO();
+    ImGui::Text("Draw data: %d vertices, %d indices", io.MetricsRenderVertices,
+                io.MetricsRenderIndices);
+
+    if (render_loop_stats_ != nullptr) {
+        const auto &loop = *render_loop_stats_;
+        ImGui::Separator();
+        ImGui::Text("Render loop: %llu frames drawn, %llu skipped (idle rendering %s)",
+                    static_cast<unsigned long long>(loop.frames_drawn),
+                    static_cast<unsigned long long>(loop.frames_skipped),
+                    config_.get_ui().idle_rendering ? "on" : "off");
+        ImGui::Text("CPU active: UI thread %.1f%%, process %.1f%%", loop.active.thread_percent(),
+                    loop.active.process_percent());
+        ImGui::Text("CPU idle:   UI thread %.1f%%, process %.1f%% (%.1f s idle in total)",
+                    loop.idle.thread_percent(), loop.idle.process_percent(),
+                    loop.idle.total_seconds());
+    }
+    ImGui::End();
+}
+
+void simulation_window::drain_fitness_samples() {
+    while (auto sample = fitness_queue_.try_pop()) {
+        fitness_history_.push(*sample);
+    }
+}
+
+void simulation_window::render_fitness_chart() {
+    drain_fitness_samples();
+    if (fitness_history_.size() == 0) {
+        ImGui::TextDisabled("Fitness history: waiting for the first generation");
+        return;
+    }
+
+    const auto &latest = fitness_history_.latest();
+    ImGui::Text("Fitness history (%zu generations)", fitness_history_.size());
+    ImGui::TextColored(ImVec4(0.3F, 1.0F, 0.3F, 1.0F), "max %.1f", latest.max);
+    ImGui::SameLine();
+    ImGui::TextColored(ImVec4(1.0F, 0.9F, 0.2F, 1.0F), "avg %.1f", latest.avg);
+    ImGui::SameLine();
+    ImGui::TextColored(ImVec4(0.3F, 0.8F, 1.0F, 1.0F), "median %.1f", latest.median);
+    ImGui::SameLine();
+    ImGui::TextColored(ImVec4(1.0F, 0.4F, 0.4F, 1.0F), "min %.1f", latest.min);
+
+    // Read the finest resolution that fits one bucket per pixel
+    const std::size_t level = fitness_history_.collect(
+        static_cast<std::size_t>(fitness_chart_width), fitness_buckets_);
+
+    const ImVec2 chart_pos = ImGui::GetCursorScreenPos();
+    const ImVec2 chart_size(fitness_chart_width, fitness_chart_height);
+    ImGui::InvisibleButton("fitness_chart", chart_size);
+    ImDrawList *draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(chart_pos,
+                             ImVec2(chart_pos.x + chart_size.x, chart_pos.y + chart_size.y),
+                             IM_COL32(20, 20, 20, 255));
+
+    float top = 1.0F;
+    for (const auto &bucket : fitness_buckets_) {
+        top = std::max(top, bucket.max.hi);
+    }
+    const std::size_t count = fitness_buckets_.size();
+    const float step_x = count > 1 ? chart_size.x / static_cast<float>(count - 1) : 0.0F;
+    const auto to_y = [&](float value) {
+        return chart_pos.y + chart_size.y - (value / top) * (chart_size.y - 2.0F) - 1.0F;
+    };
+
+    // Min/max envelope of downsampled buckets as vertical bars, bucket means as lines
+    const auto draw_series = [&](auto range_of, ImU32 color) {
+        const ImU32 band_color = (color & ~IM_COL32_A_MASK) | IM_COL32(0, 0, 0, 70);
+        ImVec2 previous;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto &bucket = fitness_buckets_[i];
+            const fitness_range &range = range_of(bucket);
+            const float pos_x = chart_pos.x + step_x * static_cast<float>(i);
+            if (range.hi > range.lo) {
+                draw_list->AddLine(ImVec2(pos_x, to_y(range.lo)), ImVec2(pos_x, to_y(range.hi)),
+                                   band_color);
+            }
+            const ImVec2 point(pos_x, to_y(range.sum / static_cast<float>(bucket.count)));
+            if (i > 0) {
+                draw_list->AddLine(previous, point, color, 1.5F);
+            }
+            previous = point;
+        }
+    };
+    draw_series([](const fitness_bucket &b) -> const fitness_range & { return b.min; },
+                IM_COL32(255, 100, 100, 255));
+    draw_series([](const fitness_bucket &b) -> const fitness_range & { return b.median; },
+                IM_COL32(80, 200, 255, 255));
+    draw_series([](const fitness_bucket &b) -> const fitness_range & { return b.avg; },
+                IM_COL32(255, 230, 50, 255));
+    draw_series([](const fitness_bucket &b) -> const fitness_range & { return b.max; },
+                IM_COL32(80, 255, 80, 255));
+
+    if (ImGui::IsItemHovered() && count > 0) {
+        const float rel_x = ImGui::GetMousePos().x - chart_pos.x;
+        const auto index = std::min(
+            count - 1, static_cast<std::size_t>(std::max(
+                           0.0F, step_x > 0.0F ? rel_x / step_x + 0.5F : 0.0F)));
+        const auto &bucket = fitness_buckets_[index];
+        const auto mean = [&](const fitness_range &range) {
+            return range.sum / static_cast<float>(bucket.count);
+        };
+        ImGui::BeginTooltip();
+        if (bucket.count == 1) {
+            ImGui::Text("Generation %zu", bucket.first_generation);
+        } else {
+            ImGui::Text("Generations %zu-%zu (level %zu)", bucket.first_generation,
+                        bucket.first_generation + bucket.count - 1, level);
+        }
+        ImGui::Separator();
+        ImGui::Text("Max: %.2f [%.2f, %.2f]", mean(bucket.max), bucket.max.lo, bucket.max.hi);
+        ImGui::Text("Avg: %.2f [%.2f, %.2f]", mean(bucket.avg), bucket.avg.lo, bucket.avg.hi);
+        ImGui::Text("Median: %.2f [%.2f, %.2f]", mean(bucket.median), bucket.median.lo,
+                    bucket.median.hi);
+        ImGui::Text("Min: %.2f [%.2f, %.2f]", mean(bucket.min), bucket.min.lo, bucket.min.hi);
+        ImGui::EndTooltip();
+    }
 }
 
 std::string simulation_window::train(size_t generations) {
     if (evolution_in_progress_) {
         return "Evolution already in progress";
     }
+    if (remote_) {
+        return "Training is not available while showing a remote simulation";
+    }
 
     evolution_in_progress_ = true;
     const bool was_paused = paused_;
@@ -490,7 +783,9 @@ std::string simulation_window::train(size_t generations) {
             // Add the stats for this generation directly
             result += stats.to_string();
 
-            // Update statistics
+            // Update statistics, the UI thread owns the history so it is fed directly
+            drain_fitness_samples();
+            fitness_history_.push(to_fitness_sample(stats));
             best_fitness_ = static_cast<size_t>(stats.ga_stats().max_fitness());
             avg_fitness_ = stats.ga_stats().avg_fitness();
 
@@ -635,6 +930,7 @@ void simulation_window::render_config_controls() {
             config_changed |= ImGui::DragInt(
                 "Neurons", reinterpret_cast<int *>(&eye_config.num_neurons), 1, 1, 16);
             ImGui::PopItemWidth();
+            config_changed |= ImGui::Checkbox("Cache Last Input", &eye_config.cache_last_input);
             ImGui::TreePop();
         }
 
@@ -679,6 +975,12 @@ void simulation_window::render_config_controls() {
 
         ImGui::PushItemWidth(input_width);
         config_changed |= ImGui::Checkbox("Show Vision Cones", &ui_config.show_vision_cones);
+        config_changed |= ImGui::Checkbox("Show Performance Overlay (F3)",
+                                          &ui_config.show_perf_overlay);
+        config_changed |= ImGui::Checkbox("Idle Rendering", &ui_config.idle_rendering);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Skip redraws while paused or while no new frame arrived");
+        }
         ImGui::PopItemWidth();
 
         if (config_changed) {
@@ -752,6 +1054,18 @@ void simulation_window::render_console() {
                     console_history_.emplace_back(
                         "  spawn animal - Add a new animal to the simulation");
                     console_history_.emplace_back("  spawn food - Add new food to the simulation");
+                    console_history_.emplace_back("  perf - Toggle the performance overlay (F3)");
+                } else if (command == "perf") {
+                    auto ui_cfg = config_.get_ui();
+                    ui_cfg.show_perf_overlay = !ui_cfg.show_perf_overlay;
+                    config_.set_ui(ui_cfg);
+                    console_history_.emplace_back(ui_cfg.show_perf_overlay
+                                                      ? "Performance overlay shown."
+                                                      : "Performance overlay hidden.");
+                } else if (remote_ && (command == "reset" || command == "t" ||
+                                       command == "train" || command == "spawn")) {
+                    console_history_.emplace_back(
+                        "Not available while showing a remote simulation.");
                 } else if (command == "reset") {
                     reset_world();
                     console_history_.emplace_back("Simulation reset.");
@@ -768,7 +1082,7 @@ void simulation_window::render_console() {
                         console_history_.emplace_back(result);
                     }
                 } else if (command == "p" || command == "pause" || command == "play") {
-                    paused_ = !paused_;
+                    set_paused(!paused_);
                     console_history_.emplace_back(paused_ ? "Simulation paused."
                                                           : "Simulation resumed.");
                 } else if (command == "spawn") {
@@ -859,12 +1173,14 @@ void simulation_window::update_data() {
     }
 
     // Copy foods to GUI foods
-    const auto &foods = simulation_->get_world().get_foods();
+    const auto &world = simulation_->get_world();
+    const auto foods = world.foods();
     gui_data_.foods.reserve(foods.size());
-    for (const auto &food : foods) {
+    for (std::size_t i = 0; i < foods.size(); ++i) {
         gui_food f;
-        f.pos_x = food.position().x();
-        f.pos_y = food.position().y();
+        f.pos_x = foods[i].position().x();
+        f.pos_y = foods[i].position().y();
+        f.handle = world.food_handle_at(i);
         gui_data_.foods.push_back(f);
     }
 
@@ -872,6 +1188,34 @@ void simulation_window::update_data() {
     avg_fitness_ = animals.empty() ? 0.0f : static_cast<float>(fitness_sum) / animals.size();
 }
 
+// Copy a frame received from the server to the GUI data structure for rendering
+void simulation_window::update_remote_data(const world_stream::world_frame &frame) {
+    gui_data_.birds.resize(frame.birds.size());
+    size_t fitness_sum = 0;
+    best_fitness_ = 0;
+    for (size_t i = 0; i < frame.birds.size(); ++i) {
+        const auto &state = frame.birds[i];
+        auto &bird = gui_data_.birds[i];
+        bird.pos_x = state.pos_x;
+        bird.pos_y = state.pos_y;
+        bird.rotation = state.rotation;
+        bird.speed = state.speed;
+        bird.fitness = state.fitness;
+        best_fitness_ = std::max<size_t>(best_fitness_, state.fitness);
+        fitness_sum += state.fitness;
+    }
+
+    gui_data_.foods.resize(frame.foods.size());
+    for (size_t i = 0; i < frame.foods.size(); ++i) {
+        gui_data_.foods[i].pos_x = frame.foods[i].pos_x;
+        gui_data_.foods[i].pos_y = frame.foods[i].pos_y;
+    }
+
+    avg_fitness_ = frame.birds.empty()
+                       ? 0.0f
+                       : static_cast<float>(fitness_sum) / static_cast<float>(frame.birds.size());
+}
+
 // Start the simulation thread
 void simulation_window::start_simulation_thread() {
     spdlog::debug("Starting simulation thread");
@@ -895,12 +1239,18 @@ void simulation_window::stop_simulation_thread() {
 
         // Signal thread to exit
         thread_should_exit_ = true;
+        simulation_cv_.notify_all();
 
         // Wait for thread to finish
         simulation_thread_.join();
 
         spdlog::debug("Simulation thread stopped");
     }
+    if (remote_thread_.joinable()) {
+        thread_should_exit_ = true;
+        remote_thread_.join();
+        remote_->disconnect();
+    }
 }
 
 // The main simulation thread function
@@ -911,6 +1261,16 @@ void simulation_window::simulation_thread_function() {
     using clock_type = std::chrono::steady_clock;
     last_step_time_ = clock_type::now();
 
+    // Steps the simulation, reporting step time and completed generations to the UI thread
+    const auto run_step = [this] {
+        const auto step_start = clock_type::now();
+        auto stats = simulation_->step(random_);
+        step_time_queue_.try_push(to_milliseconds(clock_type::now() - step_start));
+        if (stats) {
+            fitness_queue_.try_push(to_fitness_sample(*stats));
+        }
+    };
+
     // Main thread loop
     while (!thread_should_exit_) {
         // Check if simulation is paused
@@ -932,11 +1292,11 @@ void simulation_window::simulation_thread_function() {
                 int steps = static_cast<int>(std::ceil(dt / max_dt));
 
                 for (int i = 0; i < steps && !paused_ && !thread_should_exit_; i++) {
-                    simulation_->step(random_);
+                    run_step();
                 }
             } else {
                 // Single step
-                simulation_->step(random_);
+                run_step();
             }
 
             // Update elapsed time counter
@@ -944,10 +1304,39 @@ void simulation_window::simulation_thread_function() {
 
             // Update GUI data with a thread-safe approach
             {
+                const auto lock_start = clock_type::now();
                 const std::lock_guard<std::mutex> lock(gui_data_mutex_);
+                const auto publish_start = clock_type::now();
+                update_data();
+                gui_data_updated_ = true;
+                if (redraw_callback_) {
+                    redraw_callback_();
+                }
+                sim_loop_queue_.try_push(
+                    sim_loop_sample{to_milliseconds(publish_start - lock_start),
+                                    to_milliseconds(clock_type::now() - publish_start),
+                                    simulation_->get_brain_cache_stats()});
+            }
+        }
+
+        // While paused, sleep until resumed or until changes are queued instead of waking up
+        // every few milliseconds
+        if (paused_) {
+            std::unique_lock<std::mutex> lock(gui_data_mutex_);
+            simulation_cv_.wait_for(lock, std::chrono::milliseconds(paused_wait_time_ms), [this] {
+                return !paused_ || thread_should_exit_ || simulation_->has_pending();
+            });
+            last_step_time_ = clock_type::now();  // Don't catch up on the paused time
+
+            // Spawns and despawns made while paused show up without waiting for a step
+            if (simulation_->apply_pending(random_)) {
                 update_data();
                 gui_data_updated_ = true;
+                if (redraw_callback_) {
+                    redraw_callback_();
+                }
             }
+            continue;
         }
 
         // Sleep to avoid consuming too much CPU
@@ -958,4 +1347,39 @@ void simulation_window::simulation_thread_function() {
     spdlog::debug("Simulation thread function exiting");
 }
 
+// Receives frames and statistics from the server while connected
+void simulation_window::remote_thread_function() {
+    spdlog::debug("Remote thread function started");
+
+    using clock_type = std::chrono::steady_clock;
+    while (!thread_should_exit_) {
+        if (remote_->take_frame(remote_frame_)) {
+            const auto lock_start = clock_type::now();
+            const std::lock_guard<std::mutex> lock(gui_data_mutex_);
+            const auto publish_start = clock_type::now();
+            update_remote_data(remote_frame_);
+            remote_generation_ = remote_frame_.generation;
+            gui_data_updated_ = true;
+            if (redraw_callback_) {
+                redraw_callback_();
+            }
+            sim_loop_queue_.try_push(sim_loop_sample{
+                to_milliseconds(publish_start - lock_start),
+                to_milliseconds(clock_type::now() - publish_start), {}});
+        }
+        while (auto stats = remote_->take_stats()) {
+            fitness_queue_.try_push(fitness_sample{stats->generation, stats->min_fitness,
+                                                   stats->max_fitness, stats->avg_fitness,
+                                                   stats->median_fitness});
+        }
+        if (!remote_->is_connected()) {
+            spdlog::warn("Connection to the simulation server lost");
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(remote_poll_time_ms));
+    }
+
+    spdlog::debug("Remote thread function exiting");
+}
+
 }  // namespace cshorelark
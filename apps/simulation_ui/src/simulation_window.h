@@ -6,7 +6,9 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <nonstd/span.hpp>
@@ -14,33 +16,20 @@
 #include <thread>  // Added for hardware_concurrency
 #include <vector>
 
+#include "fitness_history.h"
+#include "perf_stats.h"
 #include "random/random.h"
 #include "simulation/animal.h"
 #include "simulation/simulation.h"
 #include "simulation/world.h"
 #include "simulation_config.h"
+#include "spsc_queue.h"
+#include "world_renderer.h"
+#include "world_stream/client.h"
+#include "world_stream/frame.h"
 
 namespace cshorelark {
 
-// GUI representations of simulation entities
-struct gui_bird {
-    float pos_x;
-    float pos_y;
-    float rotation;
-    float speed;
-    size_t fitness;
-};
-
-struct gui_food {
-    float pos_x;
-    float pos_y;
-};
-
-struct gui_world_data {
-    std::vector<gui_bird> birds;
-    std::vector<gui_food> foods;
-};
-
 /**
  * @brief Main window for the simulation visualization and control.
  */
@@ -104,14 +93,22 @@ public:
         return config_.get_simulation().world;
     }
     [[nodiscard]] float get_elapsed_time() const { return elapsed_time_; }
-    [[nodiscard]] size_t get_generation() const { return simulation_->get_generation(); }
+    [[nodiscard]] size_t get_generation() const {
+        return remote_ ? remote_generation_.load() : simulation_->get_generation();
+    }
     [[nodiscard]] float get_best_fitness() const { return best_fitness_; }
     [[nodiscard]] float get_average_fitness() const { return avg_fitness_; }
     [[nodiscard]] bool is_paused() const { return paused_; }
     [[nodiscard]] float get_simulation_speed() const { return config_.get_ui().simulation_speed; }
 
     // Control methods
-    void set_paused(bool paused) { paused_ = paused; }
+    void set_paused(bool paused) {
+        paused_ = paused;
+        if (remote_) {
+            remote_->set_frame_rate(paused ? 0.0F : remote_frame_rate_);
+        }
+        wake_simulation_thread();
+    }
     void set_simulation_speed(float speed) {
         auto ui_cfg = config_.get_ui();
         ui_cfg.simulation_speed = speed;
@@ -119,21 +116,70 @@ public:
     }
     [[nodiscard]] auto train(size_t generations = 1) -> std::string;
 
+    /**
+     * @brief Shows a simulation streamed by a simulation_server instead of the local one.
+     *
+     * The local simulation thread is stopped; controls that change the simulation are
+     * disabled and pausing asks the server to stop sending frames.
+     *
+     * @param host Server host name or address
+     * @param port Server port
+     * @param frame_rate Frames per second requested from the server
+     * @return true if connected, otherwise the local simulation keeps running
+     */
+    [[nodiscard]] auto connect(const std::string& host, std::uint16_t port, float frame_rate)
+        -> bool;
+
+    /**
+     * @brief Checks whether the next frame would look like the last one.
+     *
+     * True when idle rendering is enabled, no snapshot arrived since the last frame and
+     * nothing else animates, so the render loop may wait for input instead of drawing.
+     *
+     * @return true if a frame can be skipped
+     */
+    [[nodiscard]] auto is_idle() const -> bool;
+
+    /**
+     * @brief Sets the callback waking the render loop when a new snapshot is published.
+     * @param callback Called from the simulation or network thread, must be thread-safe
+     */
+    void set_redraw_callback(std::function<void()> callback);
+
+    /**
+     * @brief Shows render loop statistics in the performance overlay.
+     * @param stats Statistics owned by the App, must outlive the window
+     */
+    void set_render_loop_stats(const render_loop_stats* stats) { render_loop_stats_ = stats; }
+
+    /**
+     * @brief Checks whether the window shows a remote simulation.
+     * @return true while connected to a server
+     */
+    [[nodiscard]] bool is_remote() const { return remote_ != nullptr; }
+
 private:
     void reset_world();
     void render_world();
     void render_controls();
     void render_statistics();
+    void render_fitness_chart();
+    void render_perf_overlay();
+    void collect_perf_samples();
     void render_config_controls();
     void render_console();
     void spawn_animal();
     void spawn_food();
+    void wake_simulation_thread();
     void update_data();
+    void update_remote_data(const world_stream::world_frame& frame);
+    void drain_fitness_samples();
 
     // Thread management methods
     void start_simulation_thread();
     void stop_simulation_thread();
     void simulation_thread_function();
+    void remote_thread_function();
 
     std::shared_ptr<transwarp::task<void>> create_batch_task(size_t batch_start, size_t batch_size);
 
@@ -148,6 +194,7 @@ private:
     transwarp::parallel executor_{
         std::thread::hardware_concurrency()};  // Initialize with number of CPU cores
     size_t last_population_size_{0};
+    world_renderer world_renderer_{executor_};
 
     // Evolution state
     float elapsed_time_{0.0F};
@@ -160,14 +207,54 @@ private:
     std::thread simulation_thread_;
     std::atomic<bool> thread_should_exit_{false};
     std::mutex gui_data_mutex_;
-    std::condition_variable simulation_cv_;
+    std::condition_variable simulation_cv_;  ///< Wakes the paused simulation thread
     std::chrono::steady_clock::time_point last_step_time_;
+    std::function<void()> redraw_callback_;  ///< Guarded by gui_data_mutex_
+
+    // Remote simulation, frames are received on remote_thread_
+    std::unique_ptr<world_stream::stream_client> remote_;
+    std::thread remote_thread_;
+    world_stream::world_frame remote_frame_;  ///< Owned by remote_thread_
+    std::atomic<std::uint64_t> remote_generation_{0};
+    float remote_frame_rate_{0.0F};
 
     // GUI state
     gui_world_data gui_data_;
+    gui_world_data render_data_;  ///< Snapshot of gui_data_ owned by the UI thread
     std::atomic<bool> gui_data_updated_{false};
     float step_interval_{0.016F};  // Target 60 FPS as base rate
 
+    // Fitness history, fed by the simulation thread through a lock-free queue
+    spsc_queue<fitness_sample, 1024> fitness_queue_;
+    fitness_history fitness_history_;
+    std::vector<fitness_bucket> fitness_buckets_;
+
+    // Performance overlay, the simulation thread reports through lock-free queues
+    struct sim_loop_sample {
+        float lock_wait_ms;  ///< Time spent acquiring gui_data_mutex_
+        float publish_ms;    ///< Time spent copying the world into gui_data_
+        simulation::brain_cache_stats brain_cache;  ///< Totals, zero for remote worlds
+    };
+    struct perf_state {
+        rolling_histogram frame_ms;
+        rolling_histogram ui_cpu_ms;
+        rolling_histogram step_ms;
+        rolling_histogram snapshot_copy_ms;
+        rolling_histogram ui_lock_wait_ms;
+        rolling_histogram sim_publish_ms;
+        rolling_histogram sim_lock_wait_ms;
+        rate_counter step_rate;
+        simulation::brain_cache_stats brain_cache;
+        std::chrono::steady_clock::time_point last_frame_start;
+        std::chrono::nanoseconds last_frame_cpu{0};
+        bool has_last_frame{false};
+        float last_frame_seconds{0.0F};
+    };
+    spsc_queue<float, 4096> step_time_queue_;
+    spsc_queue<sim_loop_sample, 256> sim_loop_queue_;
+    perf_state perf_;
+    const render_loop_stats* render_loop_stats_{nullptr};
+
     // Console state
     std::string console_input_buffer_;
     std::vector<std::string> console_history_;
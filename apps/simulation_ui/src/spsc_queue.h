@@ -0,0 +1,63 @@
+#ifndef CSHORELARK_APPS_SIMULATION_UI_SPSC_QUEUE_H
+#define CSHORELARK_APPS_SIMULATION_UI_SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace cshorelark {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer and one consumer thread.
+ *
+ * Used to hand samples from the simulation thread to the UI thread without
+ * either side ever blocking; when the queue is full new items are dropped.
+ *
+ * @tparam T Trivially copyable item type
+ * @tparam Capacity Number of slots, must be a power of two
+ */
+template <typename T, std::size_t Capacity>
+class spsc_queue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "spsc_queue capacity must be a power of two");
+
+public:
+    /**
+     * @brief Pushes an item, called from the producer thread only.
+     * @param item The item to push
+     * @return false if the queue was full and the item was dropped
+     */
+    auto try_push(const T& item) noexcept -> bool {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots_[tail & (Capacity - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pops the oldest item, called from the consumer thread only.
+     * @return The item, or nullopt if the queue is empty
+     */
+    auto try_pop() noexcept -> std::optional<T> {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        T item = slots_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return item;
+    }
+
+private:
+    std::array<T, Capacity> slots_{};
+    alignas(64) std::atomic<std::size_t> head_{0};  ///< Next slot to read
+    alignas(64) std::atomic<std::size_t> tail_{0};  ///< Next slot to write
+};
+
+}  // namespace cshorelark
+
+#endif  // CSHORELARK_APPS_SIMULATION_UI_SPSC_QUEUE_H
@@ -0,0 +1,254 @@
+#include "world_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace cshorelark {
+
+namespace {
+
+constexpr float k_pi = 3.14159265358979323846F;
+constexpr ImU32 k_food_color = IM_COL32(50, 255, 50, 255);
+constexpr ImU32 k_bird_color = IM_COL32(255, 255, 255, 255);
+constexpr ImU32 k_direction_color = IM_COL32(255, 50, 50, 255);
+constexpr ImU32 k_vision_color = IM_COL32(255, 255, 0, 128);
+constexpr float k_line_thickness = 2.0F;
+constexpr float k_direction_length_factor = 2.5F;
+constexpr float k_circle_max_error = 0.3F;  // Same as ImGui's default tessellation error
+constexpr int k_min_circle_segments = 8;
+constexpr int k_max_circle_segments = 48;
+
+// Unit circle offsets shared by all circles of a chunk
+auto unit_circle(int segments) -> std::vector<ImVec2> {
+    std::vector<ImVec2> points(static_cast<std::size_t>(segments));
+    const float step = 2.0F * k_pi / static_cast<float>(segments);
+    for (int i = 0; i < segments; ++i) {
+        const float angle = step * static_cast<float>(i);
+        points[static_cast<std::size_t>(i)] = ImVec2(std::cos(angle), std::sin(angle));
+    }
+    return points;
+}
+
+void add_filled_circle(world_renderer::geometry_chunk &chunk, const ImVec2 &center, float radius,
+                       nonstd::span<const ImVec2> circle, ImVec2 uv, ImU32 color) {
+    const auto base = static_cast<ImDrawIdx>(chunk.vertices.size());
+    const auto segments = static_cast<ImDrawIdx>(circle.size());
+    chunk.vertices.push_back(ImDrawVert{center, uv, color});
+    for (const auto &offset : circle) {
+        chunk.vertices.push_back(ImDrawVert{
+            ImVec2(center.x + offset.x * radius, center.y + offset.y * radius), uv, color});
+    }
+    for (ImDrawIdx i = 0; i < segments; ++i) {
+        chunk.indices.push_back(base);
+        chunk.indices.push_back(static_cast<ImDrawIdx>(base + 1 + i));
+        chunk.indices.push_back(static_cast<ImDrawIdx>(base + 1 + (i + 1) % segments));
+    }
+}
+
+void add_line(world_renderer::geometry_chunk &chunk, const ImVec2 &from, const ImVec2 &to,
+              float thickness, ImVec2 uv, ImU32 color) {
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    if (length > 0.0F) {
+        dx /= length;
+        dy /= length;
+    }
+    const float half = thickness * 0.5F;
+    const ImVec2 normal(-dy * half, dx * half);
+
+    const auto base = static_cast<ImDrawIdx>(chunk.vertices.size());
+    chunk.vertices.push_back(ImDrawVert{ImVec2(from.x + normal.x, from.y + normal.y), uv, color});
+    chunk.vertices.push_back(ImDrawVert{ImVec2(to.x + normal.x, to.y + normal.y), uv, color});
+    chunk.vertices.push_back(ImDrawVert{ImVec2(to.x - normal.x, to.y - normal.y), uv, color});
+    chunk.vertices.push_back(ImDrawVert{ImVec2(from.x - normal.x, from.y - normal.y), uv, color});
+    for (const ImDrawIdx idx : {0, 1, 2, 0, 2, 3}) {
+        chunk.indices.push_back(static_cast<ImDrawIdx>(base + idx));
+    }
+}
+
+// Strokes an arc given as unit offsets already rotated around the center
+void add_arc(world_renderer::geometry_chunk &chunk, const ImVec2 &center, float radius,
+             float thickness, nonstd::span<const ImVec2> arc, float cos_rot, float sin_rot,
+             ImVec2 uv, ImU32 color) {
+    const auto base = static_cast<ImDrawIdx>(chunk.vertices.size());
+    const float inner = radius - thickness * 0.5F;
+    const float outer = radius + thickness * 0.5F;
+    for (const auto &offset : arc) {
+        const float x = offset.x * cos_rot - offset.y * sin_rot;
+        const float y = offset.x * sin_rot + offset.y * cos_rot;
+        chunk.vertices.push_back(ImDrawVert{ImVec2(center.x + x * inner, center.y + y * inner), uv,
+                                            color});
+        chunk.vertices.push_back(ImDrawVert{ImVec2(center.x + x * outer, center.y + y * outer), uv,
+                                            color});
+    }
+    const auto segments = static_cast<ImDrawIdx>(arc.size() - 1);
+    for (ImDrawIdx i = 0; i < segments; ++i) {
+        const auto idx = static_cast<ImDrawIdx>(base + 2 * i);
+        chunk.indices.push_back(idx);
+        chunk.indices.push_back(static_cast<ImDrawIdx>(idx + 1));
+        chunk.indices.push_back(static_cast<ImDrawIdx>(idx + 3));
+        chunk.indices.push_back(idx);
+        chunk.indices.push_back(static_cast<ImDrawIdx>(idx + 3));
+        chunk.indices.push_back(static_cast<ImDrawIdx>(idx + 2));
+    }
+}
+
+auto food_vertex_count(const world_render_params &params) -> std::size_t {
+    return static_cast<std::size_t>(world_renderer::circle_segments(params.food_radius)) + 1;
+}
+
+auto bird_vertex_count(const world_render_params &params) -> std::size_t {
+    const auto segments = world_renderer::circle_segments(params.bird_radius);
+    std::size_t count = static_cast<std::size_t>(segments) + 1 + 4;
+    if (params.show_vision_cones) {
+        count += 2 * (world_renderer::k_arc_segments + 1);
+    }
+    return count;
+}
+
+}  // namespace
+
+world_renderer::world_renderer(transwarp::executor &executor) : executor_(executor) {}
+
+auto world_renderer::circle_segments(float radius) -> int {
+    if (radius <= k_circle_max_error) {
+        return k_min_circle_segments;
+    }
+    const float segments = std::ceil(k_pi / std::acos(1.0F - k_circle_max_error / radius));
+    const int rounded = (static_cast<int>(segments) + 1) & ~1;
+    return std::clamp(rounded, k_min_circle_segments, k_max_circle_segments);
+}
+
+void world_renderer::build_foods(nonstd::span<const gui_food> foods,
+                                 const world_render_params &params, geometry_chunk &chunk) {
+    const auto circle = unit_circle(circle_segments(params.food_radius));
+    chunk.vertices.reserve(chunk.vertices.size() + foods.size() * (circle.size() + 1));
+    chunk.indices.reserve(chunk.indices.size() + foods.size() * circle.size() * 3);
+    for (const auto &food : foods) {
+        const ImVec2 center(params.canvas_pos.x + food.pos_x * params.scale,
+                            params.canvas_pos.y + food.pos_y * params.scale);
+        add_filled_circle(chunk, center, params.food_radius, circle, params.white_uv,
+                          k_food_color);
+    }
+}
+
+void world_renderer::build_birds(nonstd::span<const gui_bird> birds,
+                                 const world_render_params &params, geometry_chunk &chunk) {
+    const auto circle = unit_circle(circle_segments(params.bird_radius));
+
+    // Arc offsets relative to a bird facing along +x, rotated per bird below
+    std::vector<ImVec2> arc;
+    if (params.show_vision_cones) {
+        arc.resize(k_arc_segments + 1);
+        const float start = -params.fov_radians * 0.5F;
+        const float step = params.fov_radians / static_cast<float>(k_arc_segments);
+        for (int i = 0; i <= k_arc_segments; ++i) {
+            const float angle = start + step * static_cast<float>(i);
+            arc[static_cast<std::size_t>(i)] = ImVec2(std::cos(angle), std::sin(angle));
+        }
+    }
+
+    chunk.vertices.reserve(chunk.vertices.size() + birds.size() * bird_vertex_count(params));
+    const float direction_length = params.bird_radius * k_direction_length_factor;
+    for (const auto &bird : birds) {
+        const ImVec2 center(params.canvas_pos.x + bird.pos_x * params.scale,
+                            params.canvas_pos.y + bird.pos_y * params.scale);
+        const float cos_rot = std::cos(bird.rotation);
+        const float sin_rot = std::sin(bird.rotation);
+
+        add_filled_circle(chunk, center, params.bird_radius, circle, params.white_uv,
+                          k_bird_color);
+        add_line(chunk, center,
+                 ImVec2(center.x + direction_length * cos_rot,
+                        center.y + direction_length * sin_rot),
+                 k_line_thickness, params.white_uv, k_direction_color);
+        if (params.show_vision_cones) {
+            add_arc(chunk, center, params.vision_radius, k_line_thickness, arc, cos_rot, sin_rot,
+                    params.white_uv, k_vision_color);
+        }
+    }
+}
+
+void world_renderer::build_chunk(const chunk_job &job, const gui_world_data &data,
+                                 const world_render_params &params, geometry_chunk &chunk) const {
+    chunk.vertices.clear();
+    chunk.indices.clear();
+    if (job.is_bird) {
+        build_birds(nonstd::span<const gui_bird>(data.birds.data() + job.first, job.count), params,
+                    chunk);
+    } else {
+        build_foods(nonstd::span<const gui_food>(data.foods.data() + job.first, job.count), params,
+                    chunk);
+    }
+}
+
+void world_renderer::render(ImDrawList *draw_list, const gui_world_data &data,
+                            const world_render_params &params) {
+    // Split the snapshot into chunks, foods first to keep the serial draw order
+    const std::size_t food_chunk =
+        std::min(k_food_chunk_size, k_max_chunk_vertices / food_vertex_count(params));
+    const std::size_t bird_chunk =
+        std::min(k_bird_chunk_size, k_max_chunk_vertices / bird_vertex_count(params));
+    jobs_.clear();
+    for (std::size_t first = 0; first < data.foods.size(); first += food_chunk) {
+        jobs_.push_back({first, std::min(food_chunk, data.foods.size() - first), false});
+    }
+    for (std::size_t first = 0; first < data.birds.size(); first += bird_chunk) {
+        jobs_.push_back({first, std::min(bird_chunk, data.birds.size() - first), true});
+    }
+    if (chunks_.size() < jobs_.size()) {
+        chunks_.resize(jobs_.size());
+    }
+
+    // Build the chunks, the UI thread takes the first one while workers do the rest
+    const bool parallel =
+        jobs_.size() > 1 && data.foods.size() + data.birds.size() >= k_parallel_threshold;
+    if (parallel) {
+        tasks_.clear();
+        for (std::size_t i = 1; i < jobs_.size(); ++i) {
+            auto task = transwarp::make_task(transwarp::root, [this, i, &data, &params] {
+                build_chunk(jobs_[i], data, params, chunks_[i]);
+            });
+            task->schedule(executor_);
+            tasks_.push_back(std::move(task));
+        }
+        build_chunk(jobs_[0], data, params, chunks_[0]);
+        for (const auto &task : tasks_) {
+            task->get();
+        }
+    } else {
+        for (std::size_t i = 0; i < jobs_.size(); ++i) {
+            build_chunk(jobs_[i], data, params, chunks_[i]);
+        }
+    }
+
+    // Merge in order, rebasing chunk-relative indices on the draw list
+    stats_ = world_render_stats{};
+    stats_.chunk_count = jobs_.size();
+    stats_.parallel = parallel;
+    for (std::size_t i = 0; i < jobs_.size(); ++i) {
+        const auto &chunk = chunks_[i];
+        const auto vtx_count = static_cast<int>(chunk.vertices.size());
+        const auto idx_count = static_cast<int>(chunk.indices.size());
+        if (vtx_count == 0) {
+            continue;
+        }
+        draw_list->PrimReserve(idx_count, vtx_count);
+        const auto base = static_cast<ImDrawIdx>(draw_list->_VtxCurrentIdx);
+        std::memcpy(draw_list->_VtxWritePtr, chunk.vertices.data(),
+                    chunk.vertices.size() * sizeof(ImDrawVert));
+        for (int idx = 0; idx < idx_count; ++idx) {
+            draw_list->_IdxWritePtr[idx] =
+                static_cast<ImDrawIdx>(base + chunk.indices[static_cast<std::size_t>(idx)]);
+        }
+        draw_list->_VtxWritePtr += vtx_count;
+        draw_list->_IdxWritePtr += idx_count;
+        draw_list->_VtxCurrentIdx += static_cast<unsigned int>(vtx_count);
+        stats_.vertex_count += chunk.vertices.size();
+        stats_.index_count += chunk.indices.size();
+    }
+}
+
+}  // namespace cshorelark
@@ -0,0 +1,156 @@
+#ifndef CSHORELARK_APPS_SIMULATION_UI_WORLD_RENDERER_H
+#define CSHORELARK_APPS_SIMULATION_UI_WORLD_RENDERER_H
+
+#include <imgui.h>
+#include <transwarp.h>
+
+#include <cstddef>
+#include <memory>
+#include <nonstd/span.hpp>
+#include <vector>
+
+#include "simulation/food.h"
+#include "simulation/slot_map.h"
+
+namespace cshorelark {
+
+// GUI representations of simulation entities
+struct gui_bird {
+    float pos_x;
+    float pos_y;
+    float rotation;
+    float speed;
+    size_t fitness;
+};
+
+struct gui_food {
+    float pos_x;
+    float pos_y;
+    simulation::slot_handle<simulation::food> handle;  ///< Invalid for a remote world
+};
+
+struct gui_world_data {
+    std::vector<gui_bird> birds;
+    std::vector<gui_food> foods;
+};
+
+/**
+ * @brief Screen-space parameters needed to turn a world snapshot into geometry.
+ */
+struct world_render_params {
+    ImVec2 canvas_pos{0.0F, 0.0F};  ///< Top-left corner of the canvas in screen pixels
+    float scale{1.0F};              ///< Pixels per world unit
+    float food_radius{2.0F};        ///< Food radius in pixels
+    float bird_radius{3.0F};        ///< Bird body radius in pixels
+    float vision_radius{12.0F};     ///< Vision cone radius in pixels
+    float fov_radians{0.0F};        ///< Vision cone aperture
+    bool show_vision_cones{false};  ///< Whether to emit vision cone arcs
+    ImVec2 white_uv{0.0F, 0.0F};    ///< UV of the font atlas white pixel
+};
+
+/**
+ * @brief Geometry counters of the last rendered frame.
+ */
+struct world_render_stats {
+    std::size_t vertex_count{0};  ///< Vertices appended to the draw list
+    std::size_t index_count{0};   ///< Indices appended to the draw list
+    std::size_t chunk_count{0};   ///< Number of geometry chunks built
+    bool parallel{false};         ///< Whether chunks were built on worker threads
+};
+
+/**
+ * @brief Builds the world draw-list geometry in chunks on worker threads.
+ *
+ * Foods and birds are split into fixed-size chunks; each chunk is turned into
+ * vertices and indices independently, so the chunks can be built in parallel
+ * from a read-only snapshot. The UI thread then appends the chunks in order to
+ * the ImDrawList, which keeps the draw order of the serial path. Geometry is
+ * emitted without anti-aliased fringes.
+ */
+class world_renderer {
+public:
+    /**
+     * @brief Vertices and indices of one chunk, indices relative to the chunk.
+     */
+    struct geometry_chunk {
+        std::vector<ImDrawVert> vertices;
+        std::vector<ImDrawIdx> indices;
+    };
+
+    /// Upper bound of vertices per chunk, keeps 16-bit indices valid
+    static constexpr std::size_t k_max_chunk_vertices = 60000;
+    /// Number of foods per chunk
+    static constexpr std::size_t k_food_chunk_size = 1024;
+    /// Number of birds per chunk
+    static constexpr std::size_t k_bird_chunk_size = 256;
+    /// Below this number of entities the geometry is built on the UI thread
+    static constexpr std::size_t k_parallel_threshold = 512;
+    /// Number of segments used for vision cone arcs
+    static constexpr int k_arc_segments = 32;
+
+    /**
+     * @brief Constructs a renderer that schedules chunk builds on an executor.
+     * @param executor Executor running the chunk tasks, must outlive the renderer
+     */
+    explicit world_renderer(transwarp::executor& executor);
+
+    /**
+     * @brief Builds and appends the geometry for a world snapshot.
+     * @param draw_list Draw list receiving the geometry
+     * @param data World snapshot, must stay unchanged during the call
+     * @param params Screen-space parameters
+     */
+    void render(ImDrawList* draw_list, const gui_world_data& data,
+                const world_render_params& params);
+
+    /**
+     * @brief Gets the geometry counters of the last call to render().
+     * @return The counters
+     */
+    [[nodiscard]] auto last_stats() const -> const world_render_stats& { return stats_; }
+
+    /**
+     * @brief Number of segments used for a filled circle of the given radius.
+     * @param radius Radius in pixels
+     * @return Segment count
+     */
+    [[nodiscard]] static auto circle_segments(float radius) -> int;
+
+    /**
+     * @brief Appends the geometry of a range of foods to a chunk.
+     * @param foods Foods to emit
+     * @param params Screen-space parameters
+     * @param chunk Chunk receiving the geometry
+     */
+    static void build_foods(nonstd::span<const gui_food> foods, const world_render_params& params,
+                            geometry_chunk& chunk);
+
+    /**
+     * @brief Appends the geometry of a range of birds to a chunk.
+     * @param birds Birds to emit
+     * @param params Screen-space parameters
+     * @param chunk Chunk receiving the geometry
+     */
+    static void build_birds(nonstd::span<const gui_bird> birds, const world_render_params& params,
+                            geometry_chunk& chunk);
+
+private:
+    struct chunk_job {
+        std::size_t first;
+        std::size_t count;
+        bool is_bird;
+    };
+
+    void build_chunk(const chunk_job& job, const gui_world_data& data,
+                     const world_render_params& params, geometry_chunk& chunk) const;
+
+    transwarp::executor& executor_;
+    std::vector<chunk_job> jobs_;
+    std::vector<geometry_chunk> chunks_;
+    std::vector<std::shared_ptr<transwarp::task<void>>> tasks_;
+    world_render_stats stats_;
+};
+
+}  // namespace cshorelark
+
+#endif  // CSHORELARK_APPS_SIMULATION_UI_WORLD_RENDERER_H
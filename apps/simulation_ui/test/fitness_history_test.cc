@@ -0,0 +1,85 @@
+#include "../src/fitness_history.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t k_test_chart_width = 300;
+
+auto make_sample(std::size_t generation) -> cshorelark::fitness_sample {
+    const auto value = static_cast<float>(generation);
+    return cshorelark::fitness_sample{generation, value, value * 2.0F, value * 1.5F, value * 1.4F};
+}
+
+auto total_count(const std::vector<cshorelark::fitness_bucket>& buckets) -> std::size_t {
+    std::size_t total = 0;
+    for (const auto& bucket : buckets) {
+        total += bucket.count;
+    }
+    return total;
+}
+
+}  // namespace
+
+TEST_CASE("fitness_history keeps single generations while they fit", "[fitness_history]") {
+    cshorelark::fitness_history history;
+    for (std::size_t gen = 0; gen < 10; ++gen) {
+        history.push(make_sample(gen));
+    }
+
+    std::vector<cshorelark::fitness_bucket> buckets;
+    REQUIRE(history.collect(k_test_chart_width, buckets) == 0);
+    REQUIRE(buckets.size() == 10);
+    CHECK(buckets.front().first_generation == 0);
+    CHECK(buckets.back().first_generation == 9);
+    CHECK_THAT(buckets.back().max.hi, Catch::Matchers::WithinRel(18.0F));
+    CHECK(history.latest().generation == 9);
+}
+
+TEST_CASE("fitness_history downsamples with min/max envelopes", "[fitness_history]") {
+    cshorelark::fitness_history history;
+    constexpr std::size_t generations = 1003;
+    for (std::size_t gen = 0; gen < generations; ++gen) {
+        history.push(make_sample(gen));
+    }
+
+    std::vector<cshorelark::fitness_bucket> buckets;
+    const auto level = history.collect(k_test_chart_width, buckets);
+    REQUIRE(level > 0);
+    REQUIRE(buckets.size() <= k_test_chart_width);
+    REQUIRE(total_count(buckets) == generations);
+
+    // Buckets are contiguous and ordered from oldest to newest
+    std::size_t next_generation = 0;
+    for (const auto& bucket : buckets) {
+        CHECK(bucket.first_generation == next_generation);
+        next_generation += bucket.count;
+    }
+
+    const auto& first = buckets.front();
+    CHECK_THAT(first.min.lo, Catch::Matchers::WithinAbs(0.0F, 1e-6));
+    CHECK_THAT(first.min.hi, Catch::Matchers::WithinRel(static_cast<float>(first.count - 1)));
+    CHECK_THAT(first.max.hi, Catch::Matchers::WithinRel(2.0F * static_cast<float>(first.count - 1)));
+}
+
+TEST_CASE("fitness_history memory stays bounded", "[fitness_history]") {
+    cshorelark::fitness_history history;
+    constexpr std::size_t generations = 200000;
+    for (std::size_t gen = 0; gen < generations; ++gen) {
+        history.push(make_sample(gen));
+    }
+
+    std::vector<cshorelark::fitness_bucket> buckets;
+    history.collect(k_test_chart_width, buckets);
+    REQUIRE(buckets.size() <= cshorelark::fitness_history::k_level_capacity + 1);
+    REQUIRE(total_count(buckets) == generations);
+    CHECK(history.size() == generations);
+
+    history.clear();
+    history.collect(k_test_chart_width, buckets);
+    CHECK(buckets.empty());
+    CHECK(history.size() == 0);
+}
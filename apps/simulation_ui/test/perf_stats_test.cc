@@ -0,0 +1,68 @@
+#include "../src/perf_stats.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <chrono>
+
+TEST_CASE("rolling_histogram reports percentiles of the window", "[perf_stats]") {
+    cshorelark::rolling_histogram histogram;
+    CHECK(histogram.percentile(0.5F) == 0.0F);
+
+    for (int i = 1; i <= 100; ++i) {
+        histogram.add(static_cast<float>(i));
+    }
+    CHECK(histogram.size() == 100);
+    CHECK_THAT(histogram.percentile(0.0F), Catch::Matchers::WithinRel(1.0F));
+    CHECK_THAT(histogram.percentile(1.0F), Catch::Matchers::WithinRel(100.0F));
+    CHECK_THAT(histogram.percentile(0.5F), Catch::Matchers::WithinAbs(50.5F, 0.5F));
+    CHECK_THAT(histogram.mean(), Catch::Matchers::WithinRel(50.5F));
+    CHECK_THAT(histogram.last(), Catch::Matchers::WithinRel(100.0F));
+    CHECK(histogram.offset() == 0);
+}
+
+TEST_CASE("rolling_histogram keeps only the most recent samples", "[perf_stats]") {
+    cshorelark::rolling_histogram histogram;
+    const auto capacity = cshorelark::rolling_histogram::k_capacity;
+    for (std::size_t i = 0; i < capacity; ++i) {
+        histogram.add(1000.0F);
+    }
+    for (std::size_t i = 0; i < capacity; ++i) {
+        histogram.add(1.0F);
+    }
+    CHECK(histogram.size() == capacity);
+    CHECK_THAT(histogram.percentile(1.0F), Catch::Matchers::WithinRel(1.0F));
+
+    histogram.clear();
+    CHECK(histogram.size() == 0);
+}
+
+TEST_CASE("rate_counter closes windows of at least half a second", "[perf_stats]") {
+    cshorelark::rate_counter counter;
+    counter.add(10, std::chrono::duration<float>(0.25F));
+    CHECK(counter.per_second() == 0.0F);
+    counter.add(10, std::chrono::duration<float>(0.25F));
+    CHECK_THAT(counter.per_second(), Catch::Matchers::WithinRel(40.0F));
+}
+
+TEST_CASE("thread_cpu_time advances while the thread works", "[perf_stats]") {
+    const auto start = cshorelark::thread_cpu_time();
+    volatile double sink = 0.0;
+    for (int i = 0; i < 2000000; ++i) {
+        sink = sink + static_cast<double>(i) * 0.5;
+    }
+    CHECK(cshorelark::thread_cpu_time() > start);
+}
+
+TEST_CASE("cpu_usage_meter reports CPU time as a share of wall time", "[perf_stats]") {
+    using std::chrono::milliseconds;
+    cshorelark::cpu_usage_meter meter;
+    meter.add(std::chrono::duration<float>(0.5F), milliseconds(50), milliseconds(100));
+    CHECK(meter.thread_percent() == 0.0F);
+    CHECK_THAT(meter.total_thread_percent(), Catch::Matchers::WithinRel(10.0F));
+
+    meter.add(std::chrono::duration<float>(0.5F), milliseconds(150), milliseconds(300));
+    CHECK_THAT(meter.thread_percent(), Catch::Matchers::WithinRel(20.0F));
+    CHECK_THAT(meter.process_percent(), Catch::Matchers::WithinRel(40.0F));
+    CHECK_THAT(meter.total_process_percent(), Catch::Matchers::WithinRel(40.0F));
+    CHECK_THAT(meter.total_seconds(), Catch::Matchers::WithinRel(1.0F));
+}
@@ -69,6 +69,7 @@ TEST_CASE("SimulationConfig can save and load configuration", "[config]") {
         REQUIRE(loaded_eye.fov_angle_deg == original_eye.fov_angle_deg);
         REQUIRE(loaded_eye.num_cells == original_eye.num_cells);
         REQUIRE(loaded_eye.num_neurons == original_eye.num_neurons);
+        REQUIRE(loaded_eye.cache_last_input == original_eye.cache_last_input);
 
         // Verify genetic config
         const auto& loaded_genetic = loaded.get_simulation().genetic;
@@ -82,6 +83,8 @@ TEST_CASE("SimulationConfig can save and load configuration", "[config]") {
         REQUIRE(loaded.get_ui().show_vision_cones == original.get_ui().show_vision_cones);
         REQUIRE(loaded.get_ui().show_stats == original.get_ui().show_stats);
         REQUIRE(loaded.get_ui().show_grid == original.get_ui().show_grid);
+        REQUIRE(loaded.get_ui().show_perf_overlay == original.get_ui().show_perf_overlay);
+        REQUIRE(loaded.get_ui().idle_rendering == original.get_ui().idle_rendering);
     }
 
     SECTION("Custom configuration can be saved and loaded") {
@@ -108,6 +111,7 @@ TEST_CASE("SimulationConfig can save and load configuration", "[config]") {
         sim_config.brain_eye.fov_angle_deg = k_test_fov_angle_deg;
         sim_config.brain_eye.num_cells = k_test_num_cells;
         sim_config.brain_eye.num_neurons = k_test_num_neurons;
+        sim_config.brain_eye.cache_last_input = false;
 
         // Modify genetic config
         sim_config.genetic.mutation_chance = k_test_mutation_chance;
@@ -122,6 +126,8 @@ TEST_CASE("SimulationConfig can save and load configuration", "[config]") {
         ui_config.show_vision_cones = false;
         ui_config.show_stats = false;
         ui_config.show_grid = true;
+        ui_config.show_perf_overlay = true;
+        ui_config.idle_rendering = false;
         config.set_ui(ui_config);
 
         // Save the configuration
@@ -154,6 +160,7 @@ TEST_CASE("SimulationConfig can save and load configuration", "[config]") {
         REQUIRE(loaded_eye.fov_angle_deg == sim_config.brain_eye.fov_angle_deg);
         REQUIRE(loaded_eye.num_cells == sim_config.brain_eye.num_cells);
         REQUIRE(loaded_eye.num_neurons == sim_config.brain_eye.num_neurons);
+        REQUIRE(loaded_eye.cache_last_input == sim_config.brain_eye.cache_last_input);
 
         // Verify genetic config
         const auto& loaded_genetic = loaded.get_simulation().genetic;
@@ -166,6 +173,8 @@ TEST_CASE("SimulationConfig can save and load configuration", "[config]") {
         REQUIRE(loaded.get_ui().show_vision_cones == ui_config.show_vision_cones);
         REQUIRE(loaded.get_ui().show_stats == ui_config.show_stats);
         REQUIRE(loaded.get_ui().show_grid == ui_config.show_grid);
+        REQUIRE(loaded.get_ui().show_perf_overlay == ui_config.show_perf_overlay);
+        REQUIRE(loaded.get_ui().idle_rendering == ui_config.idle_rendering);
     }
 
     SECTION("Loading invalid file returns error") {
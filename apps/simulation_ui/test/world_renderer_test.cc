@@ -0,0 +1,71 @@
+#include "../src/world_renderer.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <vector>
+
+namespace {
+
+constexpr float k_test_scale = 100.0F;
+constexpr float k_test_radius = 4.0F;
+constexpr std::size_t k_test_food_count = 3;
+
+auto make_params() -> cshorelark::world_render_params {
+    cshorelark::world_render_params params;
+    params.canvas_pos = ImVec2(10.0F, 20.0F);
+    params.scale = k_test_scale;
+    params.food_radius = k_test_radius;
+    params.bird_radius = k_test_radius;
+    params.vision_radius = k_test_radius * 6.0F;
+    params.fov_radians = 1.0F;
+    return params;
+}
+
+}  // namespace
+
+TEST_CASE("world_renderer emits one filled circle per food", "[world_renderer]") {
+    const auto params = make_params();
+    const std::vector<cshorelark::gui_food> foods{{0.1F, 0.2F}, {0.5F, 0.5F}, {0.9F, 0.3F}};
+    cshorelark::world_renderer::geometry_chunk chunk;
+
+    cshorelark::world_renderer::build_foods(foods, params, chunk);
+
+    const auto segments =
+        static_cast<std::size_t>(cshorelark::world_renderer::circle_segments(k_test_radius));
+    REQUIRE(chunk.vertices.size() == k_test_food_count * (segments + 1));
+    REQUIRE(chunk.indices.size() == k_test_food_count * segments * 3);
+
+    // The first vertex of each circle is its center in screen space
+    const auto &center = chunk.vertices[segments + 1].pos;
+    CHECK_THAT(center.x, Catch::Matchers::WithinRel(10.0F + 0.5F * k_test_scale));
+    CHECK_THAT(center.y, Catch::Matchers::WithinRel(20.0F + 0.5F * k_test_scale));
+
+    for (const auto index : chunk.indices) {
+        CHECK(index < chunk.vertices.size());
+    }
+}
+
+TEST_CASE("world_renderer emits vision cones only when enabled", "[world_renderer]") {
+    auto params = make_params();
+    const std::vector<cshorelark::gui_bird> birds{{0.5F, 0.5F, 0.0F, 0.01F, 2}};
+
+    cshorelark::world_renderer::geometry_chunk without_cones;
+    cshorelark::world_renderer::build_birds(birds, params, without_cones);
+
+    params.show_vision_cones = true;
+    cshorelark::world_renderer::geometry_chunk with_cones;
+    cshorelark::world_renderer::build_birds(birds, params, with_cones);
+
+    constexpr auto arc_points = cshorelark::world_renderer::k_arc_segments + 1;
+    REQUIRE(with_cones.vertices.size() == without_cones.vertices.size() + 2 * arc_points);
+    REQUIRE(with_cones.indices.size() ==
+            without_cones.indices.size() + 6 * cshorelark::world_renderer::k_arc_segments);
+}
+
+TEST_CASE("world_renderer circle tessellation stays within bounds", "[world_renderer]") {
+    CHECK(cshorelark::world_renderer::circle_segments(0.1F) >= 8);
+    CHECK(cshorelark::world_renderer::circle_segments(1000.0F) <= 48);
+    CHECK(cshorelark::world_renderer::circle_segments(2.0F) <=
+          cshorelark::world_renderer::circle_segments(20.0F));
+    CHECK(cshorelark::world_renderer::circle_segments(12.0F) % 2 == 0);
+}
@@ -0,0 +1,80 @@
+# Link-time and profile-guided optimization
+#
+# The hot loops of a training run cross the simulation, neural_network and
+# genetic_algorithm libraries, which are built as separate static libraries,
+# so only link-time optimization can inline across them. Profile-guided
+# optimization takes two builds in the same build directory:
+#
+#   cmake --preset conan-release -DUSE_LTO=ON -DPGO_MODE=GENERATE
+#   cmake --build --preset conan-release --target training-workload
+#   cmake --preset conan-release -DUSE_LTO=ON -DPGO_MODE=USE
+#   cmake --build --preset conan-release
+#
+# tools/pgo_build.py runs these steps and times the result against a plain
+# release build.
+
+option(USE_LTO "Build with link-time optimization" OFF)
+set(PGO_MODE "OFF" CACHE STRING "Profile-guided optimization phase: OFF, GENERATE or USE")
+set_property(CACHE PGO_MODE PROPERTY STRINGS OFF GENERATE USE)
+set(PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH
+    "Where instrumented binaries write profiles and optimized builds read them")
+
+if((USE_LTO OR NOT PGO_MODE STREQUAL "OFF") AND
+   NOT CMAKE_BUILD_TYPE MATCHES "^(Release|RelWithDebInfo)$")
+    message(WARNING "LTO and PGO are meant for Release builds, not ${CMAKE_BUILD_TYPE}")
+endif()
+
+if(USE_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT LTO_SUPPORTED OUTPUT LTO_ERROR LANGUAGES CXX)
+    if(LTO_SUPPORTED)
+        set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+        message(STATUS "Link-time optimization enabled")
+    else()
+        message(WARNING "Link-time optimization not supported: ${LTO_ERROR}")
+    endif()
+endif()
+
+# Commands the training workload runs after the instrumented binaries exit
+set(PGO_MERGE_COMMAND "")
+
+if(PGO_MODE STREQUAL "OFF")
+    return()
+elseif(NOT PGO_MODE MATCHES "^(GENERATE|USE)$")
+    message(FATAL_ERROR "PGO_MODE must be OFF, GENERATE or USE, not ${PGO_MODE}")
+endif()
+
+if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    # GCC names profiles after the object files, so both phases share a build directory
+    if(PGO_MODE STREQUAL "GENERATE")
+        # The sweep counts from many threads at once
+        add_compile_options(-fprofile-generate=${PGO_PROFILE_DIR} -fprofile-update=prefer-atomic)
+        add_link_options(-fprofile-generate=${PGO_PROFILE_DIR})
+    else()
+        add_compile_options(-fprofile-use=${PGO_PROFILE_DIR} -fprofile-correction
+                            -Wno-missing-profile)
+    endif()
+elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    set(PGO_MERGED_PROFILE "${PGO_PROFILE_DIR}/merged.profdata")
+    if(PGO_MODE STREQUAL "GENERATE")
+        find_program(LLVM_PROFDATA_EXE NAMES llvm-profdata REQUIRED)
+        add_compile_options(-fprofile-generate=${PGO_PROFILE_DIR}/raw)
+        add_link_options(-fprofile-generate=${PGO_PROFILE_DIR}/raw)
+        set(PGO_MERGE_COMMAND
+            COMMAND ${LLVM_PROFDATA_EXE} merge -output=${PGO_MERGED_PROFILE}
+                    ${PGO_PROFILE_DIR}/raw)
+    else()
+        if(NOT EXISTS "${PGO_MERGED_PROFILE}")
+            message(WARNING "No profile at ${PGO_MERGED_PROFILE}, run training-workload "
+                            "in a PGO_MODE=GENERATE build first")
+        endif()
+        add_compile_options(-fprofile-use=${PGO_MERGED_PROFILE}
+                            -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date)
+        add_link_options(-fprofile-use=${PGO_MERGED_PROFILE})
+    endif()
+else()
+    message(WARNING "PGO_MODE is only supported with GCC and Clang, ignoring it")
+    return()
+endif()
+
+message(STATUS "Profile-guided optimization: ${PGO_MODE}, profiles in ${PGO_PROFILE_DIR}")
@@ -0,0 +1,132 @@
+#ifndef CSHORELARK_GENETIC_ALGORITHM_FITNESS_HISTOGRAM_H
+#define CSHORELARK_GENETIC_ALGORITHM_FITNESS_HISTOGRAM_H
+
+/**
+ * @file fitness_histogram.h
+ * @brief Counting-based selection and statistics for whole-number fitness
+ *
+ * When every fitness is a small whole number, such as a count of food eaten,
+ * a population is described by how many individuals have each fitness. The
+ * histogram is built once per generation in O(N + max fitness) by counting
+ * sort; afterwards the minimum, maximum and mean are O(1), the median and a
+ * roulette wheel draw are a binary search over the fitness values, and no
+ * draw reads the individuals again.
+ */
+
+// C++ system headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// External library headers
+#include <nonstd/span.hpp>
+
+// Project headers
+#include "genetic_algorithm/individual.h"
+#include "genetic_algorithm/statistics.h"
+#include "random/random.h"
+
+namespace cshorelark::genetic {
+
+/**
+ * @brief Individuals of a generation bucketed by whole-number fitness
+ */
+class fitness_histogram {
+public:
+    /// Largest fitness counted; populations above it use the general float path
+    static constexpr std::uint32_t k_max_fitness = 1U << 20U;
+
+    /**
+     * @brief Builds the histogram of a population
+     * @param population Individuals of the generation
+     * @return Histogram, or nullopt if the population is empty, an individual has
+     *         no integer fitness or a fitness exceeds k_max_fitness
+     */
+    [[nodiscard]] static auto from_population(
+        nonstd::span<const std::unique_ptr<individual>> population)
+        -> std::optional<fitness_histogram>;
+
+    /**
+     * @brief Builds the histogram of fitness values
+     * @param fitness Fitness of every individual
+     * @return Histogram, or nullopt if there are no values or one is not a
+     *         whole number in [0, k_max_fitness]
+     */
+    [[nodiscard]] static auto from_fitness(nonstd::span<const float> fitness)
+        -> std::optional<fitness_histogram>;
+
+    /**
+     * @brief Gets the number of individuals
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return fitness_.size(); }
+
+    /**
+     * @brief Gets the fitness of an individual
+     */
+    [[nodiscard]] auto fitness(std::size_t index) const noexcept -> std::uint32_t {
+        return fitness_[index];
+    }
+
+    /**
+     * @brief Gets the indices of the individuals with a fitness, in index order
+     */
+    [[nodiscard]] auto individuals_with(std::uint32_t fitness) const noexcept
+        -> nonstd::span<const std::size_t>;
+
+    /**
+     * @brief Gets the smallest fitness
+     */
+    [[nodiscard]] auto min_fitness() const noexcept -> std::uint32_t { return min_; }
+
+    /**
+     * @brief Gets the largest fitness
+     */
+    [[nodiscard]] auto max_fitness() const noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>(offsets_.size() - 2);
+    }
+
+    /**
+     * @brief Gets the median fitness, the mean of the two middle ones for even sizes
+     */
+    [[nodiscard]] auto median_fitness() const noexcept -> float;
+
+    /**
+     * @brief Gets the minimum, maximum, average and median fitness
+     *
+     * Equal to statistics::from_population() for the same population as long
+     * as the fitness sum is below 2^24, where float sums stop being exact.
+     */
+    [[nodiscard]] auto summary() const -> statistics;
+
+    /**
+     * @brief Draws an individual with probability proportional to its fitness
+     *
+     * Uses the same weights as roulette_wheel_selection, max(fitness, 0.00001),
+     * and one random number per draw: the number picks a fitness value by its
+     * total weight, and where it falls within that value picks the individual.
+     *
+     * @param random Random number generator
+     * @return Index of the selected individual
+     */
+    [[nodiscard]] auto draw_proportional(cshorelark::random::random_generator& random) const
+        -> std::size_t;
+
+private:
+    explicit fitness_histogram(std::vector<std::uint32_t> fitness);
+
+    // Fitness value holding the individual of a rank in fitness order
+    [[nodiscard]] auto fitness_at_rank(std::size_t rank) const noexcept -> std::uint32_t;
+
+    std::vector<std::uint32_t> fitness_;     ///< Fitness of every individual
+    std::vector<std::size_t> offsets_;       ///< Start of each fitness value in by_fitness_
+    std::vector<std::size_t> by_fitness_;    ///< Indices sorted by fitness, then index
+    std::vector<double> cumulative_weight_;  ///< Roulette weight of each fitness and below
+    std::uint32_t min_ = 0;                  ///< Smallest fitness
+    std::uint64_t sum_ = 0;                  ///< Sum of all fitness values
+};
+
+}  // namespace cshorelark::genetic
+
+#endif  // CSHORELARK_GENETIC_ALGORITHM_FITNESS_HISTOGRAM_H
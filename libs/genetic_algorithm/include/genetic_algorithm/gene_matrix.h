@@ -0,0 +1,153 @@
+#ifndef CSHORELARK_GENETIC_ALGORITHM_GENE_MATRIX_H
+#define CSHORELARK_GENETIC_ALGORITHM_GENE_MATRIX_H
+
+/**
+ * @file gene_matrix.h
+ * @brief Disk-backed storage and evolution for populations larger than memory
+ *
+ * A gene matrix is a file holding one row of genes per individual, mapped into
+ * memory so the page cache rather than the heap decides how much of it is
+ * resident. Only fitness values, one float per individual, stay in RAM.
+ *
+ * File layout, native byte order:
+ *   [0, 32)   header: magic "CSGENES\0", version, byte order mark, rows, genes
+ *   [64, ...) rows * genes floats, row-major
+ */
+
+// C++ system headers
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+// External library headers
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+
+// Project headers
+#include "genetic_algorithm/crossover.h"
+#include "genetic_algorithm/genetic_error.h"
+#include "genetic_algorithm/mutation.h"
+#include "genetic_algorithm/selection.h"
+#include "random/random.h"
+
+namespace cshorelark::genetic {
+
+/**
+ * @brief Memory-mapped, file-backed matrix of genes with one row per individual
+ */
+class gene_matrix {
+public:
+    static constexpr std::uint32_t k_version = 1;  ///< Format version written and read
+
+    /**
+     * @brief Creates a zero-filled matrix, replacing any existing file
+     * @param path Path of the file
+     * @param rows Number of individuals
+     * @param genes Number of genes per individual
+     * @return Expected containing the matrix or error
+     */
+    [[nodiscard]] static auto create(const std::filesystem::path& path, std::size_t rows,
+                                     std::size_t genes) -> tl::expected<gene_matrix, genetic_error>;
+
+    /**
+     * @brief Opens an existing matrix for reading and writing
+     * @param path Path of the file
+     * @return Expected containing the matrix or error
+     */
+    [[nodiscard]] static auto open(const std::filesystem::path& path)
+        -> tl::expected<gene_matrix, genetic_error>;
+
+    gene_matrix(const gene_matrix&) = delete;
+    gene_matrix& operator=(const gene_matrix&) = delete;
+    gene_matrix(gene_matrix&&) noexcept;
+    gene_matrix& operator=(gene_matrix&&) noexcept;
+    ~gene_matrix();
+
+    /**
+     * @brief Gets the number of individuals
+     */
+    [[nodiscard]] auto rows() const noexcept -> std::size_t { return rows_; }
+
+    /**
+     * @brief Gets the number of genes per individual
+     */
+    [[nodiscard]] auto genes() const noexcept -> std::size_t { return genes_; }
+
+    /**
+     * @brief Gets the genes of an individual, pointing into the mapping
+     * @param index Index of the individual, must be below rows()
+     */
+    [[nodiscard]] auto row(std::size_t index) noexcept -> nonstd::span<float> {
+        return {data_ + index * genes_, genes_};
+    }
+    [[nodiscard]] auto row(std::size_t index) const noexcept -> nonstd::span<const float> {
+        return {data_ + index * genes_, genes_};
+    }
+
+    /**
+     * @brief Tells the kernel the matrix is about to be read front to back
+     */
+    void advise_sequential() const noexcept;
+
+    /**
+     * @brief Writes modified rows back to the file
+     * @return Expected containing nothing or error
+     */
+    [[nodiscard]] auto flush() -> tl::expected<void, genetic_error>;
+
+private:
+    class mapping;
+
+    gene_matrix(std::unique_ptr<mapping> file, std::size_t rows, std::size_t genes) noexcept;
+
+    std::unique_ptr<mapping> file_;  ///< Mapped file
+    float* data_ = nullptr;          ///< First gene of the first row
+    std::size_t rows_ = 0;           ///< Individuals
+    std::size_t genes_ = 0;          ///< Genes per individual
+};
+
+/**
+ * @brief Breeds a generation stored in one gene matrix into another
+ *
+ * Evolution runs in two passes. Parents are first chosen for every child
+ * from the fitness values alone; the pairs are then sorted by first parent,
+ * so the streaming pass reads first parents in file order and writes children
+ * in file order, with only the second parent read at random.
+ */
+class gene_matrix_evolver {
+public:
+    /**
+     * @brief Constructs an evolver with the specified strategies
+     *
+     * @param selection Selection strategy, must support select_by_fitness()
+     * @param crossover Crossover strategy to use
+     * @param mutation Mutation strategy to use
+     */
+    gene_matrix_evolver(std::unique_ptr<selection_strategy> selection,
+                        std::unique_ptr<crossover_strategy> crossover,
+                        std::unique_ptr<mutation_strategy> mutation) noexcept;
+
+    /**
+     * @brief Breeds the next generation
+     *
+     * @param parents Current generation
+     * @param fitness Fitness of every parent
+     * @param children Next generation, overwritten; needs the parents' gene count
+     * @param random Random number generator
+     * @return Expected containing nothing or error
+     */
+    [[nodiscard]] auto evolve(const gene_matrix& parents, nonstd::span<const float> fitness,
+                              gene_matrix& children,
+                              cshorelark::random::random_generator& random) const
+        -> tl::expected<void, genetic_error>;
+
+private:
+    std::unique_ptr<selection_strategy> selection_;  ///< Strategy for selecting parents
+    std::unique_ptr<crossover_strategy> crossover_;  ///< Strategy for crossover between parents
+    std::unique_ptr<mutation_strategy> mutation_;    ///< Strategy for mutating children
+};
+
+}  // namespace cshorelark::genetic
+
+#endif  // CSHORELARK_GENETIC_ALGORITHM_GENE_MATRIX_H
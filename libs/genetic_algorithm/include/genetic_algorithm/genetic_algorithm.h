@@ -2,6 +2,7 @@
 #define CSHORELARK_GENETIC_ALGORITHM_GENETIC_ALGORITHM_H
 
 #include <memory>
+#include <optional>
 #include <nonstd/span.hpp>
 #include <type_traits>
 #include <utility>
@@ -9,6 +10,7 @@
 
 #include "genetic_algorithm/chromosome.h"
 #include "genetic_algorithm/crossover.h"
+#include "genetic_algorithm/fitness_histogram.h"
 #include "genetic_algorithm/genetic_error.h"
 #include "genetic_algorithm/individual.h"
 #include "genetic_algorithm/mutation.h"
@@ -49,22 +51,42 @@ public:
      *
      * @param population Current population of individuals
      * @param random_gen Random number generator
+     * @param parents If given, receives the parents of every child, in child order
      * @return A pair containing the new population and statistics about the evolution
      */
     [[nodiscard]] auto evolve(nonstd::span<std::unique_ptr<individual>> population,
-                              cshorelark::random::random_generator& random_gen) const
+                              cshorelark::random::random_generator& random_gen,
+                              std::vector<parent_pair>* parents = nullptr) const
         -> tl::expected<std::pair<std::vector<std::unique_ptr<individual>>, statistics>,
                         genetic_error> {
         if (population.empty()) {
             return tl::make_unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
                                                      "Population cannot be empty"});
         }
-        // Create statistics for the current population
-        const statistics stats = statistics::from_population(population);
+        // Whole-number fitness is counted once, then selection and statistics never call
+        // get_fitness() again
+        std::optional<fitness_histogram> histogram =
+            fitness_histogram::from_population(population);
+        const statistics stats =
+            histogram ? histogram->summary() : statistics::from_population(population);
+        auto select_parent = [&]() -> tl::expected<size_t, genetic_error> {
+            if (histogram) {
+                auto selected = selection_->select_from_histogram(*histogram, random_gen);
+                if (selected || selected.error().code != genetic_error_code::k_invalid_selection) {
+                    return selected;
+                }
+                histogram.reset();
+            }
+            return selection_->select(population, random_gen);
+        };
 
         // Create next generation with same population size
         std::vector<std::unique_ptr<individual>> next_generation;
         next_generation.reserve(population.size());
+        if (parents != nullptr) {
+            parents->clear();
+            parents->reserve(population.size());
+        }
 
         // Elite selection: keep the best individual
         /*if (!population.empty()) {
@@ -83,12 +105,12 @@ public:
         // Fill the rest of the next generation
         while (next_generation.size() < population.size()) {
             // Select parents
-            auto parent_a_result = selection_->select(population, random_gen);
+            auto parent_a_result = select_parent();
             if (!parent_a_result) {
                 return tl::make_unexpected(parent_a_result.error());
             }
 
-            auto parent_b_result = selection_->select(population, random_gen);
+            auto parent_b_result = select_parent();
             if (!parent_b_result) {
                 return tl::make_unexpected(parent_b_result.error());
             }
@@ -120,6 +142,9 @@ public:
                 return tl::make_unexpected(new_individual_result.error());
             }
             next_generation.emplace_back(std::move(new_individual_result.value()));
+            if (parents != nullptr) {
+                parents->push_back(parent_pair{*parent_a_result, *parent_b_result});
+            }
         }
 
         return std::make_pair(std::move(next_generation), stats);
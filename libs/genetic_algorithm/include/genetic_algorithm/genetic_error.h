@@ -15,14 +15,15 @@ namespace cshorelark::genetic {
  * @brief Error codes for genetic algorithm operations
  */
 enum class genetic_error_code {
-    k_invalid_parent_size,       ///< Parents have incompatible sizes
-    k_invalid_population_size,   ///< Population size is invalid
-    k_invalid_chromosome,        ///< Invalid chromosome
-    k_invalid_selection,         ///< Selection operation failed
-    k_selection_failed,          ///< Failed to select individual
-    k_crossover_failed,          ///< Failed to perform crossover
-    k_mutation_failed,           ///< Failed to perform mutation
-    k_offspring_creation_failed  ///< Failed to create offspring individual
+    k_invalid_parent_size,        ///< Parents have incompatible sizes
+    k_invalid_population_size,    ///< Population size is invalid
+    k_invalid_chromosome,         ///< Invalid chromosome
+    k_invalid_selection,          ///< Selection operation failed
+    k_selection_failed,           ///< Failed to select individual
+    k_crossover_failed,           ///< Failed to perform crossover
+    k_mutation_failed,            ///< Failed to perform mutation
+    k_offspring_creation_failed,  ///< Failed to create offspring individual
+    k_storage_failed              ///< Disk-backed population storage failed
 };
 
 /**
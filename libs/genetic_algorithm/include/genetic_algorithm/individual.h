@@ -1,7 +1,9 @@
 #ifndef CSHORELARK_GENETIC_ALGORITHM_INDIVIDUAL_H
 #define CSHORELARK_GENETIC_ALGORITHM_INDIVIDUAL_H
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 #include "genetic_algorithm/chromosome.h"
 
@@ -27,6 +29,19 @@ public:
      */
     [[nodiscard]] virtual auto get_fitness() const -> float = 0;
 
+    /**
+     * @brief Get the fitness as a whole number, for fitness that only counts things
+     *
+     * Individuals that return a value let evolution select and summarize the
+     * population by counting (see fitness_histogram) instead of through
+     * get_fitness(). The value must equal get_fitness().
+     *
+     * @return Fitness, or nullopt if it is not always a whole number
+     */
+    [[nodiscard]] virtual auto get_integer_fitness() const -> std::optional<std::uint32_t> {
+        return std::nullopt;
+    }
+
     /**
      * @brief Get the chromosome representing this individual's genetic material
      *
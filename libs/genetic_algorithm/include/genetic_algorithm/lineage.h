@@ -0,0 +1,229 @@
+#ifndef CSHORELARK_GENETIC_ALGORITHM_LINEAGE_H
+#define CSHORELARK_GENETIC_ALGORITHM_LINEAGE_H
+
+/**
+ * @file lineage.h
+ * @brief Delta-compressed archive of every generation of a population
+ *
+ * A child differs from its parents only where crossover switched parents and
+ * where mutation changed a gene, so the archive stores each child as its
+ * parents' indices, the crossover pattern and the mutated genes. Every
+ * keyframe_interval generations a full keyframe is written instead, which
+ * bounds how far back reconstruction has to go.
+ *
+ * File layout, native byte order:
+ *   [0, 32)  header: magic "CSLINEA\0", version, byte order mark, genes per
+ *            individual, keyframe interval, metadata size
+ *   metadata bytes, free-form
+ *   per generation: kind and individual count (uint32 each), then
+ *     - the parent indices of every child (uint32 pairs), unless it is the first
+ *     - a keyframe: individuals * genes floats, row-major
+ *     - a delta frame, per child: a uint32 whose top bit says whether the
+ *       crossover pattern is a bit mask, one bit per gene set where the gene
+ *       comes from the second parent, or the list of gene indices where the
+ *       child switches parent, the low bits counting those indices; a uint32
+ *       mutation count; the mask words or indices; then each mutated gene as its
+ *       index and new value. The shorter of the two patterns is written, so
+ *       single-point crossover costs one index and uniform crossover one bit
+ *       per gene.
+ *
+ * Mutated genes are stored as values rather than differences, so a
+ * reconstructed chromosome is bit for bit the one that was archived.
+ */
+
+// C++ system headers
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// External library headers
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+
+// Project headers
+#include "genetic_algorithm/chromosome.h"
+#include "genetic_algorithm/genetic_error.h"
+#include "genetic_algorithm/individual.h"
+#include "genetic_algorithm/selection.h"
+
+namespace cshorelark::genetic {
+
+/**
+ * @brief Appends generations to a lineage archive as they are bred
+ */
+class lineage_writer {
+public:
+    static constexpr std::uint32_t k_version = 1;  ///< Format version written and read
+    static constexpr std::size_t k_default_keyframe_interval = 16;  ///< Generations per keyframe
+
+    /**
+     * @brief Creates an empty archive, replacing any existing file
+     * @param path Path of the archive
+     * @param genes Number of genes per individual
+     * @param keyframe_interval Generations between full keyframes, at least 1
+     * @param metadata Free-form text stored in the header, such as the configuration
+     * @return Expected containing the writer or error
+     */
+    [[nodiscard]] static auto create(const std::filesystem::path& path, std::size_t genes,
+                                     std::size_t keyframe_interval = k_default_keyframe_interval,
+                                     const std::string& metadata = {})
+        -> tl::expected<lineage_writer, genetic_error>;
+
+    /**
+     * @brief Appends a generation without known parents, always as a keyframe
+     * @param population Individuals of the generation
+     * @return Expected containing nothing or error
+     */
+    auto append_population(nonstd::span<const std::unique_ptr<individual>> population)
+        -> tl::expected<void, genetic_error>;
+
+    /**
+     * @brief Appends a generation bred from the last one appended
+     * @param children Individuals of the new generation
+     * @param parents Parents of every child, as indices into the last generation
+     * @return Expected containing nothing or error
+     */
+    auto append_offspring(nonstd::span<const std::unique_ptr<individual>> children,
+                          nonstd::span<const parent_pair> parents)
+        -> tl::expected<void, genetic_error>;
+
+    /**
+     * @brief Writes buffered generations to the file
+     * @return Expected containing nothing or error
+     */
+    [[nodiscard]] auto flush() -> tl::expected<void, genetic_error>;
+
+    /**
+     * @brief Gets the number of generations appended
+     */
+    [[nodiscard]] auto generations() const noexcept -> std::size_t { return generations_; }
+
+    /**
+     * @brief Gets the bytes written, header included
+     */
+    [[nodiscard]] auto bytes_written() const noexcept -> std::uint64_t { return bytes_written_; }
+
+    /**
+     * @brief Gets the bytes the appended genes take as plain float arrays
+     */
+    [[nodiscard]] auto raw_bytes() const noexcept -> std::uint64_t { return raw_bytes_; }
+
+private:
+    lineage_writer(std::ofstream file, std::size_t genes, std::size_t keyframe_interval);
+
+    auto collect_genes(nonstd::span<const std::unique_ptr<individual>> population)
+        -> tl::expected<std::vector<float>, genetic_error>;
+    void write_bytes(const void* data, std::size_t size);
+    void write_keyframe(const std::vector<float>& genes);
+    void write_child(nonstd::span<const float> child, nonstd::span<const float> first,
+                     nonstd::span<const float> second);
+
+    std::ofstream file_;                                      ///< Archive being appended to
+    std::size_t genes_;                                       ///< Genes per individual
+    std::size_t keyframe_interval_;                           ///< Generations between keyframes
+    std::size_t generations_ = 0;                             ///< Generations appended
+    std::vector<float> previous_;                             ///< Last generation, row-major
+    std::vector<std::uint32_t> switches_;                     ///< Switch points of one child
+    std::vector<std::uint32_t> mask_;                         ///< Crossover mask of one child
+    std::vector<std::pair<std::uint32_t, float>> mutations_;  ///< Mutated genes of one child
+    std::uint64_t bytes_written_ = 0;                         ///< Bytes written so far
+    std::uint64_t raw_bytes_ = 0;                             ///< Genes as plain arrays
+};
+
+/**
+ * @brief Reads a lineage archive and reconstructs any individual of any generation
+ */
+class lineage_archive {
+public:
+    /**
+     * @brief Reads an archive
+     * @param path Path of the archive
+     * @return Expected containing the archive or error
+     */
+    [[nodiscard]] static auto open(const std::filesystem::path& path)
+        -> tl::expected<lineage_archive, genetic_error>;
+
+    /**
+     * @brief Gets the number of generations in the archive
+     */
+    [[nodiscard]] auto generations() const noexcept -> std::size_t {
+        return generations_.size();
+    }
+
+    /**
+     * @brief Gets the number of individuals of a generation, 0 past the last one
+     */
+    [[nodiscard]] auto population_size(std::size_t generation) const noexcept -> std::size_t;
+
+    /**
+     * @brief Gets the number of genes per individual
+     */
+    [[nodiscard]] auto genes() const noexcept -> std::size_t { return genes_; }
+
+    /**
+     * @brief Gets the metadata the archive was created with
+     */
+    [[nodiscard]] auto metadata() const noexcept -> const std::string& { return metadata_; }
+
+    /**
+     * @brief Gets the parents of an individual
+     * @param generation Generation of the individual, from 1
+     * @param index Index of the individual in its generation
+     * @return Expected containing the parents' indices in the previous generation or error
+     */
+    [[nodiscard]] auto parents(std::size_t generation, std::size_t index) const
+        -> tl::expected<parent_pair, genetic_error>;
+
+    /**
+     * @brief Reconstructs the chromosome of an individual
+     *
+     * Decodes only the ancestors of the individual since the last keyframe.
+     *
+     * @param generation Generation of the individual
+     * @param index Index of the individual in its generation
+     * @return Expected containing the chromosome or error
+     */
+    [[nodiscard]] auto reconstruct(std::size_t generation, std::size_t index) const
+        -> tl::expected<chromosome, genetic_error>;
+
+    /**
+     * @brief Reconstructs every chromosome of a generation
+     * @param generation Generation to reconstruct
+     * @return Expected containing the chromosomes in index order or error
+     */
+    [[nodiscard]] auto reconstruct_generation(std::size_t generation) const
+        -> tl::expected<std::vector<chromosome>, genetic_error>;
+
+private:
+    struct child_delta {
+        bool mask = false;                                       ///< Whether pattern is a mask
+        std::vector<std::uint32_t> pattern;                      ///< Switch points or mask words
+        std::vector<std::pair<std::uint32_t, float>> mutations;  ///< Mutated genes and values
+    };
+
+    struct generation_record {
+        std::size_t individuals = 0;        ///< Individuals of the generation
+        bool is_keyframe = false;           ///< Whether all genes are stored
+        std::vector<parent_pair> parents;   ///< Parents of each child, empty without lineage
+        std::vector<float> keyframe;        ///< All genes if this is a keyframe
+        std::vector<child_delta> children;  ///< Each child otherwise
+    };
+
+    lineage_archive() = default;
+
+    auto decode(std::size_t generation, std::vector<std::size_t> wanted) const
+        -> tl::expected<std::vector<std::pair<std::size_t, std::vector<float>>>, genetic_error>;
+
+    std::size_t genes_ = 0;                       ///< Genes per individual
+    std::string metadata_;                        ///< Free-form header text
+    std::vector<generation_record> generations_;  ///< Every generation in order
+};
+
+}  // namespace cshorelark::genetic
+
+#endif  // CSHORELARK_GENETIC_ALGORITHM_LINEAGE_H
@@ -5,6 +5,7 @@
 #include <memory>
 #include <nonstd/span.hpp>
 
+#include "genetic_algorithm/fitness_histogram.h"
 #include "genetic_algorithm/genetic_error.h"
 #include "genetic_algorithm/individual.h"
 #include "random/random.h"
@@ -12,6 +13,14 @@
 
 namespace cshorelark::genetic {
 
+/**
+ * @brief Indices of the two parents selected for a child
+ */
+struct parent_pair {
+    std::size_t first = 0;   ///< Parent whose genes crossover starts from
+    std::size_t second = 0;  ///< Parent crossed in
+};
+
 /**
  * @brief Interface for selection strategies in genetic algorithms
  *
@@ -31,6 +40,39 @@ public:
                                       cshorelark::random::random_generator& random) const
        -> tl::expected<const size_t, genetic_error> = 0;       
 
+    /**
+     * @brief Select an individual knowing only the fitness of each one
+     *
+     * Used when the population's genes do not live in memory. Strategies that
+     * need more than the fitness fail with genetic_error_code::k_invalid_selection.
+     *
+     * @param fitness Fitness of every individual
+     * @param rng Random number generator
+     * @return Index of the selected individual
+     */
+    [[nodiscard]] virtual auto select_by_fitness(nonstd::span<const float> fitness,
+                                                 cshorelark::random::random_generator& random) const
+        -> tl::expected<const size_t, genetic_error>;
+
+    /**
+     * @brief Select an individual from the histogram of a whole-number fitness population
+     *
+     * Must draw from the same distribution as select(). Strategies without a
+     * counting implementation fail with genetic_error_code::k_invalid_selection,
+     * and callers fall back to select().
+     *
+     * @param histogram Histogram of the population's fitness
+     * @param rng Random number generator
+     * @return Index of the selected individual
+     */
+    [[nodiscard]] virtual auto select_from_histogram(
+        const fitness_histogram& histogram, cshorelark::random::random_generator& random) const
+        -> tl::expected<const size_t, genetic_error>;
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~selection_strategy() = default;
 };
 
 /**
@@ -60,6 +102,28 @@ public:
                               cshorelark::random::random_generator& random) const
         -> tl::expected<const size_t, genetic_error> override;
 
+    /**
+     * @brief Select an individual using tournament selection over fitness values
+     *
+     * @param fitness Fitness of every individual
+     * @param rng Random number generator
+     * @return Index of the selected individual
+     */
+    [[nodiscard]] auto select_by_fitness(nonstd::span<const float> fitness,
+                                         cshorelark::random::random_generator& random) const
+        -> tl::expected<const size_t, genetic_error> override;
+
+    /**
+     * @brief Select an individual using tournament selection over counted fitness
+     *
+     * @param histogram Histogram of the population's fitness
+     * @param rng Random number generator
+     * @return Index of the selected individual
+     */
+    [[nodiscard]] auto select_from_histogram(const fitness_histogram& histogram,
+                                             cshorelark::random::random_generator& random) const
+        -> tl::expected<const size_t, genetic_error> override;
+
 private:
     size_t tournament_size_;  ///< Number of individuals to include in each tournament
     bool reversed_;           ///< If true, lower fitness values are considered better
@@ -90,6 +154,32 @@ public:
                               cshorelark::random::random_generator& random) const
         -> tl::expected<const size_t, genetic_error> override;
 
+    /**
+     * @brief Select an individual using roulette wheel selection over fitness values
+     *
+     * @param fitness Fitness of every individual
+     * @param rng Random number generator
+     * @return Index of the selected individual
+     */
+    [[nodiscard]] auto select_by_fitness(nonstd::span<const float> fitness,
+                                         cshorelark::random::random_generator& random) const
+        -> tl::expected<const size_t, genetic_error> override;
+
+    /**
+     * @brief Select an individual using roulette wheel selection over counted fitness
+     *
+     * A binary search over the fitness values instead of a pass over the
+     * population; draws from the same distribution as select() but not the
+     * same individuals for the same random numbers.
+     *
+     * @param histogram Histogram of the population's fitness
+     * @param rng Random number generator
+     * @return Index of the selected individual
+     */
+    [[nodiscard]] auto select_from_histogram(const fitness_histogram& histogram,
+                                             cshorelark::random::random_generator& random) const
+        -> tl::expected<const size_t, genetic_error> override;
+
 private:
     bool reversed_;  ///< If true, lower fitness values are considered better
 };
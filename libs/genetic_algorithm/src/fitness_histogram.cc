@@ -0,0 +1,140 @@
+/**
+ * @file fitness_histogram.cc
+ * @brief Implementation of counting-based selection and statistics
+ */
+
+#include "genetic_algorithm/fitness_histogram.h"
+
+// C++ system headers
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+namespace cshorelark::genetic {
+
+namespace {
+
+// Same floor as roulette_wheel_selection, so an unfed individual can still be drawn
+constexpr double k_min_individual_fitness = 0.00001F;
+
+auto roulette_weight(std::uint32_t fitness) -> double {
+    return fitness == 0 ? k_min_individual_fitness : static_cast<double>(fitness);
+}
+
+}  // namespace
+
+auto fitness_histogram::from_population(nonstd::span<const std::unique_ptr<individual>> population)
+    -> std::optional<fitness_histogram> {
+    if (population.empty()) {
+        return std::nullopt;
+    }
+    std::vector<std::uint32_t> fitness;
+    fitness.reserve(population.size());
+    for (const auto& member : population) {
+        const auto value = member->get_integer_fitness();
+        if (!value || *value > k_max_fitness) {
+            return std::nullopt;
+        }
+        fitness.push_back(*value);
+    }
+    return fitness_histogram(std::move(fitness));
+}
+
+auto fitness_histogram::from_fitness(nonstd::span<const float> fitness)
+    -> std::optional<fitness_histogram> {
+    if (fitness.empty()) {
+        return std::nullopt;
+    }
+    std::vector<std::uint32_t> counted;
+    counted.reserve(fitness.size());
+    for (const float value : fitness) {
+        // Also rejects NaN, which fails every comparison
+        if (!(value >= 0.0F && value <= static_cast<float>(k_max_fitness)) ||
+            std::floor(value) != value) {
+            return std::nullopt;
+        }
+        counted.push_back(static_cast<std::uint32_t>(value));
+    }
+    return fitness_histogram(std::move(counted));
+}
+
+fitness_histogram::fitness_histogram(std::vector<std::uint32_t> fitness)
+    : fitness_(std::move(fitness)) {
+    const auto [min, max] = std::minmax_element(fitness_.begin(), fitness_.end());
+    min_ = *min;
+
+    // Counting sort: count each value, turn the counts into start offsets, then place the
+    // indices in order so every fitness value keeps its individuals in index order
+    offsets_.assign(static_cast<std::size_t>(*max) + 2, 0);
+    for (const auto value : fitness_) {
+        ++offsets_[value + 1];
+        sum_ += value;
+    }
+    cumulative_weight_.resize(offsets_.size() - 1);
+    double weight = 0.0;
+    for (std::size_t value = 0; value + 1 < offsets_.size(); ++value) {
+        const auto count = offsets_[value + 1];
+        weight += static_cast<double>(count) * roulette_weight(static_cast<std::uint32_t>(value));
+        cumulative_weight_[value] = weight;
+        offsets_[value + 1] += offsets_[value];
+    }
+
+    by_fitness_.resize(fitness_.size());
+    std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+    for (std::size_t i = 0; i < fitness_.size(); ++i) {
+        by_fitness_[next[fitness_[i]]++] = i;
+    }
+}
+
+auto fitness_histogram::individuals_with(std::uint32_t fitness) const noexcept
+    -> nonstd::span<const std::size_t> {
+    if (fitness > max_fitness()) {
+        return {};
+    }
+    return nonstd::span<const std::size_t>(by_fitness_)
+        .subspan(offsets_[fitness], offsets_[fitness + 1] - offsets_[fitness]);
+}
+
+auto fitness_histogram::fitness_at_rank(std::size_t rank) const noexcept -> std::uint32_t {
+    // The first start offset past the rank belongs to the next fitness value
+    const auto next = std::upper_bound(offsets_.begin(), offsets_.end(), rank);
+    return static_cast<std::uint32_t>(next - offsets_.begin() - 1);
+}
+
+auto fitness_histogram::median_fitness() const noexcept -> float {
+    const std::size_t middle = fitness_.size() / 2;
+    if (fitness_.size() % 2 == 0) {
+        return (static_cast<float>(fitness_at_rank(middle - 1)) +
+                static_cast<float>(fitness_at_rank(middle))) /
+               2.0F;
+    }
+    return static_cast<float>(fitness_at_rank(middle));
+}
+
+auto fitness_histogram::summary() const -> statistics {
+    return {static_cast<float>(min_), static_cast<float>(max_fitness()),
+            static_cast<float>(sum_) / static_cast<float>(fitness_.size()), median_fitness()};
+}
+
+auto fitness_histogram::draw_proportional(cshorelark::random::random_generator& random) const
+    -> std::size_t {
+    const double total = cumulative_weight_.back();
+    const double point = static_cast<double>(random.generate_position()) * total;
+
+    // First fitness value whose cumulative weight passes the point; empty values add no
+    // weight, so they are never picked
+    auto chosen = std::upper_bound(cumulative_weight_.begin(), cumulative_weight_.end(), point);
+    if (chosen == cumulative_weight_.end()) {
+        chosen = std::prev(cumulative_weight_.end());
+    }
+    const auto value = static_cast<std::uint32_t>(chosen - cumulative_weight_.begin());
+    const double before = value == 0 ? 0.0 : cumulative_weight_[value - 1];
+
+    // Each individual of the value owns an equal slice of its weight
+    const auto members = individuals_with(value);
+    const auto slice = static_cast<std::size_t>((point - before) / roulette_weight(value));
+    return members[std::min(slice, members.size() - 1)];
+}
+
+}  // namespace cshorelark::genetic
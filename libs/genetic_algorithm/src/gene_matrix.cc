@@ -0,0 +1,310 @@
+#include "genetic_algorithm/gene_matrix.h"
+
+// C++ system headers
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "genetic_algorithm/chromosome.h"
+#include "genetic_algorithm/fitness_histogram.h"
+
+namespace cshorelark::genetic {
+
+namespace {
+
+constexpr std::array<char, 8> k_magic = {'C', 'S', 'G', 'E', 'N', 'E', 'S', '\0'};
+constexpr std::uint32_t k_byte_order_mark = 0x01020304U;
+constexpr std::size_t k_data_offset = 64;  // Cache line aligned rows for vector loads
+
+struct matrix_header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t rows;
+    std::uint64_t genes;
+};
+static_assert(sizeof(matrix_header) == 32, "gene matrix header must be 32 bytes");
+
+auto storage_error(const std::string& message) -> tl::unexpected<genetic_error> {
+    return tl::unexpected(genetic_error{genetic_error_code::k_storage_failed, message});
+}
+
+}  // namespace
+
+/**
+ * @brief Shared read-write mapping of a gene matrix file
+ */
+class gene_matrix::mapping {
+public:
+    mapping() = default;
+    mapping(const mapping&) = delete;
+    mapping& operator=(const mapping&) = delete;
+    mapping(mapping&&) = delete;
+    mapping& operator=(mapping&&) = delete;
+
+    ~mapping() {
+#ifdef _WIN32
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+        }
+#else
+        if (data_ != nullptr) {
+            munmap(data_, size_);
+        }
+#endif
+    }
+
+    // Maps the file, first resizing it to size bytes unless size is 0
+    auto map(const std::filesystem::path& path, std::size_t size) -> bool {
+        const bool create = size != 0;
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                                  nullptr, create ? CREATE_ALWAYS : OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER file_size{};
+        if (create) {
+            file_size.QuadPart = static_cast<LONGLONG>(size);
+            if (!SetFilePointerEx(file, file_size, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+                CloseHandle(file);
+                return false;
+            }
+        } else if (!GetFileSizeEx(file, &file_size)) {
+            CloseHandle(file);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+        if (size_ == 0) {
+            CloseHandle(file);
+            return true;  // Nothing to map, rejected as too small by the caller
+        }
+        HANDLE view = CreateFileMappingW(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+        CloseHandle(file);
+        if (view == nullptr) {
+            return false;
+        }
+        data_ = static_cast<char*>(MapViewOfFile(view, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        CloseHandle(view);
+        return data_ != nullptr;
+#else
+        const int fd = create ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)
+                              : ::open(path.c_str(), O_RDWR);
+        if (fd < 0) {
+            return false;
+        }
+        if (create && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            return false;
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            return true;  // Nothing to map, rejected as too small by the caller
+        }
+        void* address = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);  // The mapping keeps the file alive
+        if (address == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<char*>(address);
+        return true;
+#endif
+    }
+
+    void advise_sequential() const noexcept {
+#ifndef _WIN32
+        if (data_ != nullptr) {
+            madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+#endif
+    }
+
+    auto flush() -> bool {
+        if (data_ == nullptr) {
+            return true;
+        }
+#ifdef _WIN32
+        return FlushViewOfFile(data_, 0) != 0;
+#else
+        return msync(data_, size_, MS_SYNC) == 0;
+#endif
+    }
+
+    [[nodiscard]] auto data() const noexcept -> char* { return data_; }
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+
+private:
+    char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+gene_matrix::gene_matrix(std::unique_ptr<mapping> file, std::size_t rows,
+                         std::size_t genes) noexcept
+    : file_(std::move(file)),
+      data_(reinterpret_cast<float*>(file_->data() + k_data_offset)),
+      rows_(rows),
+      genes_(genes) {}
+
+gene_matrix::gene_matrix(gene_matrix&&) noexcept = default;
+
+gene_matrix& gene_matrix::operator=(gene_matrix&&) noexcept = default;
+
+gene_matrix::~gene_matrix() = default;
+
+auto gene_matrix::create(const std::filesystem::path& path, std::size_t rows, std::size_t genes)
+    -> tl::expected<gene_matrix, genetic_error> {
+    if (rows == 0 || genes == 0) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
+                                            "Gene matrix needs at least one row and one gene"});
+    }
+    auto file = std::make_unique<mapping>();
+    if (!file->map(path, k_data_offset + rows * genes * sizeof(float))) {
+        return storage_error("Failed to create gene matrix: " + path.string());
+    }
+    const matrix_header header{k_magic, k_version, k_byte_order_mark, rows, genes};
+    std::memcpy(file->data(), &header, sizeof(header));
+    return gene_matrix(std::move(file), rows, genes);
+}
+
+auto gene_matrix::open(const std::filesystem::path& path)
+    -> tl::expected<gene_matrix, genetic_error> {
+    auto file = std::make_unique<mapping>();
+    if (!file->map(path, 0)) {
+        return storage_error("Failed to open gene matrix: " + path.string());
+    }
+    if (file->size() < k_data_offset) {
+        return storage_error("Gene matrix is truncated: " + path.string());
+    }
+    matrix_header header{};
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.magic != k_magic || header.byte_order != k_byte_order_mark) {
+        return storage_error("Not a gene matrix of this machine: " + path.string());
+    }
+    if (header.version != k_version) {
+        return storage_error("Unsupported gene matrix version: " + path.string());
+    }
+    const std::uint64_t capacity = (file->size() - k_data_offset) / sizeof(float);
+    if (header.rows == 0 || header.genes == 0 || header.rows > capacity / header.genes ||
+        header.rows * header.genes != capacity) {
+        return storage_error("Gene matrix size does not match its header: " + path.string());
+    }
+    return gene_matrix(std::move(file), static_cast<std::size_t>(header.rows),
+                       static_cast<std::size_t>(header.genes));
+}
+
+void gene_matrix::advise_sequential() const noexcept {
+    if (file_) {
+        file_->advise_sequential();
+    }
+}
+
+auto gene_matrix::flush() -> tl::expected<void, genetic_error> {
+    if (file_ && !file_->flush()) {
+        return storage_error("Failed to write gene matrix back");
+    }
+    return {};
+}
+
+gene_matrix_evolver::gene_matrix_evolver(std::unique_ptr<selection_strategy> selection,
+                                         std::unique_ptr<crossover_strategy> crossover,
+                                         std::unique_ptr<mutation_strategy> mutation) noexcept
+    : selection_(std::move(selection)),
+      crossover_(std::move(crossover)),
+      mutation_(std::move(mutation)) {}
+
+auto gene_matrix_evolver::evolve(const gene_matrix& parents, nonstd::span<const float> fitness,
+                                 gene_matrix& children,
+                                 cshorelark::random::random_generator& random) const
+    -> tl::expected<void, genetic_error> {
+    if (fitness.size() != parents.rows()) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
+                                            "Every parent needs a fitness value"});
+    }
+    if (children.genes() != parents.genes()) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_parent_size,
+                                            "Parents and children must have the same genes"});
+    }
+
+    // Selection pass, in memory: 16 bytes per child. Whole-number fitness is counted first
+    std::optional<fitness_histogram> histogram = fitness_histogram::from_fitness(fitness);
+    auto select_parent = [&]() -> tl::expected<size_t, genetic_error> {
+        if (histogram) {
+            auto selected = selection_->select_from_histogram(*histogram, random);
+            if (selected || selected.error().code != genetic_error_code::k_invalid_selection) {
+                return selected;
+            }
+            histogram.reset();
+        }
+        return selection_->select_by_fitness(fitness, random);
+    };
+    std::vector<std::pair<std::size_t, std::size_t>> pairs(children.rows());
+    for (auto& [first, second] : pairs) {
+        auto parent_a = select_parent();
+        if (!parent_a) {
+            return tl::make_unexpected(parent_a.error());
+        }
+        auto parent_b = select_parent();
+        if (!parent_b) {
+            return tl::make_unexpected(parent_b.error());
+        }
+        first = *parent_a;
+        second = *parent_b;
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    // Streaming pass: first parents and children move front to back through their files
+    parents.advise_sequential();
+    children.advise_sequential();
+    std::size_t loaded = parents.rows();
+    chromosome parent_a(std::vector<float>{});
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        const auto [first, second] = pairs[i];
+        if (first != loaded) {
+            const auto genes = parents.row(first);
+            parent_a = chromosome::from_range(genes.begin(), genes.end());
+            loaded = first;
+        }
+        const auto genes_b = parents.row(second);
+        const auto parent_b = chromosome::from_range(genes_b.begin(), genes_b.end());
+
+        auto child = crossover_->crossover(parent_a, parent_b, random);
+        if (!child) {
+            return tl::make_unexpected(child.error());
+        }
+        if (auto mutated = mutation_->mutate(*child, random); !mutated) {
+            return tl::make_unexpected(mutated.error());
+        }
+        if (child->size() != children.genes()) {
+            return tl::unexpected(genetic_error{genetic_error_code::k_crossover_failed,
+                                                "Crossover changed the number of genes"});
+        }
+        std::copy(child->begin(), child->end(), children.row(i).begin());
+    }
+    return {};
+}
+
+}  // namespace cshorelark::genetic
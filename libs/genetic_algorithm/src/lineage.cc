@@ -0,0 +1,529 @@
+#include "genetic_algorithm/lineage.h"
+
+// C++ system headers
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace cshorelark::genetic {
+
+namespace {
+
+constexpr std::array<char, 8> k_magic = {'C', 'S', 'L', 'I', 'N', 'E', 'A', '\0'};
+constexpr std::uint32_t k_byte_order_mark = 0x01020304U;
+constexpr std::uint32_t k_mask_flag = 0x80000000U;
+constexpr std::size_t k_mask_bits = 32;
+
+struct archive_header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t genes;
+    std::uint32_t keyframe_interval;
+    std::uint32_t metadata_bytes;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(archive_header) == 32, "lineage header must be 32 bytes");
+
+/**
+ * @brief How a generation is stored
+ */
+enum class frame_kind : std::uint32_t {
+    k_population = 0,  ///< Keyframe without parents
+    k_keyframe = 1,    ///< Keyframe with the parents of every child
+    k_delta = 2        ///< Parents, crossover pattern and mutations of every child
+};
+
+auto storage_error(const std::string& message) -> tl::unexpected<genetic_error> {
+    return tl::unexpected(genetic_error{genetic_error_code::k_storage_failed, message});
+}
+
+// Compares the bits so that -0.0 and 0.0 stay apart and NaNs match themselves
+auto same_bits(float lhs, float rhs) noexcept -> bool {
+    return std::memcmp(&lhs, &rhs, sizeof(float)) == 0;
+}
+
+auto mask_words(std::size_t genes) noexcept -> std::size_t {
+    return (genes + k_mask_bits - 1) / k_mask_bits;
+}
+
+/**
+ * @brief Reads values from the bytes of an archive, failing past the end
+ */
+class byte_reader {
+public:
+    explicit byte_reader(const std::vector<char>& bytes) noexcept : bytes_(bytes) {}
+
+    template <typename T>
+    auto read(T& value) noexcept -> bool {
+        return read_array(&value, 1);
+    }
+
+    template <typename T>
+    auto read_array(T* values, std::size_t count) noexcept -> bool {
+        if (!can_read<T>(count)) {
+            return false;
+        }
+        std::memcpy(values, bytes_.data() + offset_, count * sizeof(T));
+        offset_ += count * sizeof(T);
+        return true;
+    }
+
+    // Checked before sizing buffers, so a corrupt count cannot allocate more than the file
+    template <typename T>
+    [[nodiscard]] auto can_read(std::size_t count) const noexcept -> bool {
+        return count <= (bytes_.size() - offset_) / sizeof(T);
+    }
+
+    [[nodiscard]] auto at_end() const noexcept -> bool { return offset_ == bytes_.size(); }
+
+private:
+    const std::vector<char>& bytes_;
+    std::size_t offset_ = 0;
+};
+
+}  // namespace
+
+lineage_writer::lineage_writer(std::ofstream file, std::size_t genes,
+                               std::size_t keyframe_interval)
+    : file_(std::move(file)), genes_(genes), keyframe_interval_(keyframe_interval) {}
+
+auto lineage_writer::create(const std::filesystem::path& path, std::size_t genes,
+                            std::size_t keyframe_interval, const std::string& metadata)
+    -> tl::expected<lineage_writer, genetic_error> {
+    constexpr std::size_t k_max_value = std::numeric_limits<std::uint32_t>::max();
+    if (genes == 0 || genes >= k_mask_flag || keyframe_interval == 0 ||
+        keyframe_interval > k_max_value || metadata.size() > k_max_value) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_chromosome,
+                                            "Invalid gene count or keyframe interval"});
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return storage_error("Failed to create lineage archive " + path.string());
+    }
+
+    lineage_writer writer(std::move(file), genes, keyframe_interval);
+    const archive_header header{k_magic,
+                                k_version,
+                                k_byte_order_mark,
+                                static_cast<std::uint32_t>(genes),
+                                static_cast<std::uint32_t>(keyframe_interval),
+                                static_cast<std::uint32_t>(metadata.size()),
+                                0};
+    writer.write_bytes(&header, sizeof(header));
+    writer.write_bytes(metadata.data(), metadata.size());
+    if (!writer.file_) {
+        return storage_error("Failed to write lineage archive " + path.string());
+    }
+    return writer;
+}
+
+auto lineage_writer::collect_genes(nonstd::span<const std::unique_ptr<individual>> population)
+    -> tl::expected<std::vector<float>, genetic_error> {
+    if (population.empty() || population.size() >= k_mask_flag) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
+                                            "Population cannot be empty"});
+    }
+    std::vector<float> genes;
+    genes.reserve(population.size() * genes_);
+    for (const auto& member : population) {
+        const auto member_genes = member->get_chromosome().genes();
+        if (member_genes.size() != genes_) {
+            return tl::unexpected(genetic_error{genetic_error_code::k_invalid_chromosome,
+                                                "Chromosome size does not match the archive"});
+        }
+        genes.insert(genes.end(), member_genes.begin(), member_genes.end());
+    }
+    return genes;
+}
+
+void lineage_writer::write_bytes(const void* data, std::size_t size) {
+    file_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    bytes_written_ += size;
+}
+
+void lineage_writer::write_keyframe(const std::vector<float>& genes) {
+    write_bytes(genes.data(), genes.size() * sizeof(float));
+}
+
+auto lineage_writer::append_population(nonstd::span<const std::unique_ptr<individual>> population)
+    -> tl::expected<void, genetic_error> {
+    auto genes = collect_genes(population);
+    if (!genes) {
+        return tl::unexpected(genes.error());
+    }
+
+    const std::array<std::uint32_t, 2> frame = {
+        static_cast<std::uint32_t>(frame_kind::k_population),
+        static_cast<std::uint32_t>(population.size())};
+    write_bytes(frame.data(), sizeof(frame));
+    write_keyframe(*genes);
+    raw_bytes_ += genes->size() * sizeof(float);
+    previous_ = std::move(*genes);
+    ++generations_;
+
+    if (!file_) {
+        return storage_error("Failed to append to lineage archive");
+    }
+    return {};
+}
+
+auto lineage_writer::append_offspring(nonstd::span<const std::unique_ptr<individual>> children,
+                                      nonstd::span<const parent_pair> parents)
+    -> tl::expected<void, genetic_error> {
+    if (generations_ == 0) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
+                                            "No generation to breed from in the archive"});
+    }
+    if (parents.size() != children.size()) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
+                                            "Every child needs one pair of parents"});
+    }
+    const std::size_t previous_size = previous_.size() / genes_;
+    for (const auto& pair : parents) {
+        if (pair.first >= previous_size || pair.second >= previous_size) {
+            return tl::unexpected(genetic_error{genetic_error_code::k_invalid_selection,
+                                                "Parent index outside the last generation"});
+        }
+    }
+    auto genes = collect_genes(children);
+    if (!genes) {
+        return tl::unexpected(genes.error());
+    }
+
+    const bool keyframe = generations_ % keyframe_interval_ == 0;
+    const auto kind = keyframe ? frame_kind::k_keyframe : frame_kind::k_delta;
+    const std::array<std::uint32_t, 2> frame = {static_cast<std::uint32_t>(kind),
+                                                static_cast<std::uint32_t>(children.size())};
+    write_bytes(frame.data(), sizeof(frame));
+
+    std::vector<std::uint32_t> indices;
+    indices.reserve(parents.size() * 2);
+    for (const auto& pair : parents) {
+        indices.push_back(static_cast<std::uint32_t>(pair.first));
+        indices.push_back(static_cast<std::uint32_t>(pair.second));
+    }
+    write_bytes(indices.data(), indices.size() * sizeof(std::uint32_t));
+
+    if (keyframe) {
+        write_keyframe(*genes);
+    } else {
+        const nonstd::span<const float> all_parents(previous_);
+        const nonstd::span<const float> all_children(*genes);
+        for (std::size_t i = 0; i < children.size(); ++i) {
+            write_child(all_children.subspan(i * genes_, genes_),
+                        all_parents.subspan(parents[i].first * genes_, genes_),
+                        all_parents.subspan(parents[i].second * genes_, genes_));
+        }
+    }
+    raw_bytes_ += genes->size() * sizeof(float);
+    previous_ = std::move(*genes);
+    ++generations_;
+
+    if (!file_) {
+        return storage_error("Failed to append to lineage archive");
+    }
+    return {};
+}
+
+void lineage_writer::write_child(nonstd::span<const float> child, nonstd::span<const float> first,
+                                 nonstd::span<const float> second) {
+    switches_.clear();
+    mutations_.clear();
+    mask_.assign(mask_words(genes_), 0);
+
+    // Follow one parent until the child stops matching it; genes that match neither are
+    // mutations and do not switch parents
+    bool from_second = false;
+    for (std::size_t i = 0; i < genes_; ++i) {
+        const bool in_first = same_bits(child[i], first[i]);
+        const bool in_second = same_bits(child[i], second[i]);
+        if (from_second ? (!in_second && in_first) : (!in_first && in_second)) {
+            from_second = !from_second;
+            switches_.push_back(static_cast<std::uint32_t>(i));
+        } else if (!in_first && !in_second) {
+            mutations_.emplace_back(static_cast<std::uint32_t>(i), child[i]);
+        }
+        if (from_second) {
+            mask_[i / k_mask_bits] |= 1U << (i % k_mask_bits);
+        }
+    }
+
+    const bool use_mask = switches_.size() > mask_.size();
+    const auto& pattern = use_mask ? mask_ : switches_;
+    const std::array<std::uint32_t, 2> counts = {
+        use_mask ? k_mask_flag : static_cast<std::uint32_t>(switches_.size()),
+        static_cast<std::uint32_t>(mutations_.size())};
+    write_bytes(counts.data(), sizeof(counts));
+    write_bytes(pattern.data(), pattern.size() * sizeof(std::uint32_t));
+    for (const auto& [index, value] : mutations_) {
+        write_bytes(&index, sizeof(index));
+        write_bytes(&value, sizeof(value));
+    }
+}
+
+auto lineage_writer::flush() -> tl::expected<void, genetic_error> {
+    file_.flush();
+    if (!file_) {
+        return storage_error("Failed to flush lineage archive");
+    }
+    return {};
+}
+
+auto lineage_archive::open(const std::filesystem::path& path)
+    -> tl::expected<lineage_archive, genetic_error> {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return storage_error("Failed to open lineage archive " + path.string());
+    }
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                                  std::istreambuf_iterator<char>());
+    byte_reader reader(bytes);
+
+    archive_header header{};
+    if (!reader.read(header) || header.magic != k_magic) {
+        return storage_error(path.string() + " is not a lineage archive");
+    }
+    if (header.version != lineage_writer::k_version) {
+        return storage_error("Unsupported lineage archive version " +
+                             std::to_string(header.version));
+    }
+    if (header.byte_order != k_byte_order_mark) {
+        return storage_error("Lineage archive was written with the other byte order");
+    }
+    if (header.genes == 0 || header.genes >= k_mask_flag) {
+        return storage_error("Lineage archive has an invalid gene count");
+    }
+
+    lineage_archive archive;
+    archive.genes_ = header.genes;
+    if (!reader.can_read<char>(header.metadata_bytes)) {
+        return storage_error("Lineage archive is truncated");
+    }
+    archive.metadata_.resize(header.metadata_bytes);
+    if (!reader.read_array(archive.metadata_.data(), archive.metadata_.size())) {
+        return storage_error("Lineage archive is truncated");
+    }
+
+    const std::size_t genes = archive.genes_;
+    while (!reader.at_end()) {
+        const auto corrupt = [&archive](const char* what) {
+            return storage_error("Lineage archive generation " +
+                                 std::to_string(archive.generations_.size()) + ": " + what);
+        };
+
+        std::array<std::uint32_t, 2> frame{};
+        if (!reader.read(frame)) {
+            return corrupt("truncated");
+        }
+        const auto kind = static_cast<frame_kind>(frame[0]);
+        if (kind != frame_kind::k_population && kind != frame_kind::k_keyframe &&
+            kind != frame_kind::k_delta) {
+            return corrupt("unknown frame kind");
+        }
+        if (kind != frame_kind::k_population && archive.generations_.empty()) {
+            return corrupt("children without parents");
+        }
+
+        generation_record record;
+        record.individuals = frame[1];
+        record.is_keyframe = kind != frame_kind::k_delta;
+        if (record.individuals == 0) {
+            return corrupt("empty generation");
+        }
+        if (kind != frame_kind::k_population) {
+            const std::size_t parent_count = archive.generations_.back().individuals;
+            if (!reader.can_read<std::uint32_t>(record.individuals * 2)) {
+                return corrupt("truncated");
+            }
+            std::vector<std::uint32_t> indices(record.individuals * 2);
+            reader.read_array(indices.data(), indices.size());
+            record.parents.reserve(record.individuals);
+            for (std::size_t i = 0; i < indices.size(); i += 2) {
+                if (indices[i] >= parent_count || indices[i + 1] >= parent_count) {
+                    return corrupt("parent index out of range");
+                }
+                record.parents.push_back(parent_pair{indices[i], indices[i + 1]});
+            }
+        }
+
+        if (record.is_keyframe) {
+            if (!reader.can_read<float>(record.individuals * genes)) {
+                return corrupt("truncated");
+            }
+            record.keyframe.resize(record.individuals * genes);
+            reader.read_array(record.keyframe.data(), record.keyframe.size());
+        } else {
+            record.children.resize(record.individuals);
+            for (auto& child : record.children) {
+                std::array<std::uint32_t, 2> counts{};
+                if (!reader.read(counts)) {
+                    return corrupt("truncated");
+                }
+                child.mask = (counts[0] & k_mask_flag) != 0;
+                const std::size_t pattern_size = child.mask ? mask_words(genes) : counts[0];
+                // Each mutation takes an index and a value
+                if (!reader.can_read<std::uint32_t>(pattern_size + 2 * std::size_t{counts[1]})) {
+                    return corrupt("truncated");
+                }
+                child.pattern.resize(pattern_size);
+                child.mutations.resize(counts[1]);
+                reader.read_array(child.pattern.data(), child.pattern.size());
+                for (auto& [index, value] : child.mutations) {
+                    if (!reader.read(index) || !reader.read(value)) {
+                        return corrupt("truncated");
+                    }
+                    if (index >= genes) {
+                        return corrupt("mutated gene out of range");
+                    }
+                }
+                if (!child.mask && !std::is_sorted(child.pattern.begin(), child.pattern.end())) {
+                    return corrupt("unordered switch points");
+                }
+                if (!child.mask && !child.pattern.empty() && child.pattern.back() >= genes) {
+                    return corrupt("switch point out of range");
+                }
+            }
+        }
+        archive.generations_.push_back(std::move(record));
+    }
+    return archive;
+}
+
+auto lineage_archive::population_size(std::size_t generation) const noexcept -> std::size_t {
+    return generation < generations_.size() ? generations_[generation].individuals : 0;
+}
+
+auto lineage_archive::parents(std::size_t generation, std::size_t index) const
+    -> tl::expected<parent_pair, genetic_error> {
+    if (index >= population_size(generation)) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
+                                            "No such individual in the archive"});
+    }
+    const auto& record = generations_[generation];
+    if (record.parents.empty()) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_selection,
+                                            "Generation was archived without parents"});
+    }
+    return record.parents[index];
+}
+
+auto lineage_archive::decode(std::size_t generation, std::vector<std::size_t> wanted) const
+    -> tl::expected<std::vector<std::pair<std::size_t, std::vector<float>>>, genetic_error> {
+    for (const auto index : wanted) {
+        if (index >= population_size(generation)) {
+            return tl::unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
+                                                "No such individual in the archive"});
+        }
+    }
+
+    // Walk back to the last keyframe, collecting the ancestors each generation needs
+    std::vector<std::vector<std::size_t>> needed;
+    std::sort(wanted.begin(), wanted.end());
+    wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+    needed.push_back(std::move(wanted));
+    std::size_t keyframe = generation;
+    while (!generations_[keyframe].is_keyframe) {
+        const auto& record = generations_[keyframe];
+        std::vector<std::size_t> ancestors;
+        ancestors.reserve(needed.back().size() * 2);
+        for (const auto index : needed.back()) {
+            ancestors.push_back(record.parents[index].first);
+            ancestors.push_back(record.parents[index].second);
+        }
+        std::sort(ancestors.begin(), ancestors.end());
+        ancestors.erase(std::unique(ancestors.begin(), ancestors.end()), ancestors.end());
+        needed.push_back(std::move(ancestors));
+        --keyframe;
+    }
+
+    // Then replay the deltas forward, holding only the individuals still needed
+    const std::size_t genes = genes_;
+    std::vector<std::pair<std::size_t, std::vector<float>>> current;
+    const auto& keyframe_genes = generations_[keyframe].keyframe;
+    for (const auto index : needed.back()) {
+        const auto row = keyframe_genes.begin() + static_cast<std::ptrdiff_t>(index * genes);
+        current.emplace_back(index,
+                             std::vector<float>(row, row + static_cast<std::ptrdiff_t>(genes)));
+    }
+    const auto find = [&current](std::size_t index) -> const std::vector<float>& {
+        const auto found = std::lower_bound(
+            current.begin(), current.end(), index,
+            [](const auto& entry, std::size_t key) { return entry.first < key; });
+        return found->second;
+    };
+
+    for (std::size_t level = needed.size() - 1; level-- > 0;) {
+        const auto& record = generations_[generation - level];
+        std::vector<std::pair<std::size_t, std::vector<float>>> next;
+        next.reserve(needed[level].size());
+        for (const auto index : needed[level]) {
+            const auto& first = find(record.parents[index].first);
+            const auto& second = find(record.parents[index].second);
+            const auto& child = record.children[index];
+
+            std::vector<float> values(genes);
+            if (child.mask) {
+                for (std::size_t i = 0; i < genes; ++i) {
+                    const auto bit = (child.pattern[i / k_mask_bits] >> (i % k_mask_bits)) & 1U;
+                    values[i] = bit != 0 ? second[i] : first[i];
+                }
+            } else {
+                bool from_second = false;
+                std::size_t next_switch = 0;
+                for (std::size_t i = 0; i < genes; ++i) {
+                    while (next_switch < child.pattern.size() &&
+                           child.pattern[next_switch] == i) {
+                        from_second = !from_second;
+                        ++next_switch;
+                    }
+                    values[i] = from_second ? second[i] : first[i];
+                }
+            }
+            for (const auto& [gene, value] : child.mutations) {
+                values[gene] = value;
+            }
+            next.emplace_back(index, std::move(values));
+        }
+        current = std::move(next);
+    }
+    return current;
+}
+
+auto lineage_archive::reconstruct(std::size_t generation, std::size_t index) const
+    -> tl::expected<chromosome, genetic_error> {
+    auto decoded = decode(generation, {index});
+    if (!decoded) {
+        return tl::unexpected(decoded.error());
+    }
+    return chromosome(std::move(decoded->front().second));
+}
+
+auto lineage_archive::reconstruct_generation(std::size_t generation) const
+    -> tl::expected<std::vector<chromosome>, genetic_error> {
+    std::vector<std::size_t> all(population_size(generation));
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        all[i] = i;
+    }
+    if (all.empty()) {
+        return tl::unexpected(genetic_error{genetic_error_code::k_invalid_population_size,
+                                            "No such generation in the archive"});
+    }
+    auto decoded = decode(generation, std::move(all));
+    if (!decoded) {
+        return tl::unexpected(decoded.error());
+    }
+
+    std::vector<chromosome> chromosomes;
+    chromosomes.reserve(decoded->size());
+    for (auto& [index, genes] : *decoded) {
+        chromosomes.emplace_back(std::move(genes));
+    }
+    return chromosomes;
+}
+
+}  // namespace cshorelark::genetic
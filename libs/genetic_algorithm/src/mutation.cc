@@ -1,5 +1,8 @@
 #include "genetic_algorithm/mutation.h"
 
+#include <cmath>
+#include <cstddef>
+
 namespace cshorelark::genetic {
 
 gaussian_mutation::gaussian_mutation(float mutation_probability, float mutation_strength) noexcept
@@ -16,16 +19,27 @@ tl::expected<void, genetic_error> gaussian_mutation::mutate(
         }
     }*/
 
-    // Mutate each gene with configured probability
-    for (auto& gene : child) {
-        if (random.generate_position() < mutation_probability_) {
-            // Generate mutation amount from normal distribution
-            float mutation = random.generate_position() * mutation_strength_;
-            // Apply random sign
-            mutation = random.generate_weight() > 0 ? mutation : -mutation;
-            // Apply mutation to gene
-            gene += mutation;
+    if (mutation_probability_ <= 0.0F) {
+        return {};
+    }
+    if (mutation_probability_ >= 1.0F) {
+        for (auto& gene : child) {
+            gene += random.generate_normal(0.0F, mutation_strength_);
+        }
+        return {};
+    }
+
+    // Rather than a draw per gene, jump to the next mutated gene: the number of
+    // genes skipped before it is geometric, so a single draw gives it
+    const double log_keep = std::log1p(-static_cast<double>(mutation_probability_));
+    for (std::size_t index = 0;; ++index) {
+        const double skipped =
+            std::floor(std::log(static_cast<double>(random.generate_position())) / log_keep);
+        if (skipped >= static_cast<double>(child.size() - index)) {
+            break;
         }
+        index += static_cast<std::size_t>(skipped);
+        child[index] += random.generate_normal(0.0F, mutation_strength_);
     }
 
     return {};
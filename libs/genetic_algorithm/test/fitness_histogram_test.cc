@@ -0,0 +1,204 @@
+#include "genetic_algorithm/fitness_histogram.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "genetic_algorithm/chromosome.h"
+#include "genetic_algorithm/crossover.h"
+#include "genetic_algorithm/genetic_algorithm.h"
+#include "genetic_algorithm/individual.h"
+#include "genetic_algorithm/mutation.h"
+#include "genetic_algorithm/selection.h"
+#include "genetic_algorithm/statistics.h"
+#include "random/random.h"
+#include "test_individual.h"
+
+using namespace cshorelark::genetic;
+
+namespace {
+
+// Individual whose fitness counts something, like the food an animal ate
+class counted_individual : public individual {
+public:
+    counted_individual(std::uint32_t fitness, chromosome&& genes)
+        : fitness_(fitness), chromosome_(std::move(genes)) {}
+    explicit counted_individual(std::uint32_t fitness)
+        : counted_individual(fitness, chromosome({0.0F})) {}
+
+    [[nodiscard]] auto get_fitness() const -> float override {
+        return static_cast<float>(fitness_);
+    }
+    [[nodiscard]] auto get_integer_fitness() const -> std::optional<std::uint32_t> override {
+        return fitness_;
+    }
+    [[nodiscard]] auto get_chromosome() const -> const chromosome& override { return chromosome_; }
+
+private:
+    std::uint32_t fitness_;
+    chromosome chromosome_;
+};
+
+auto counted_population(const std::vector<std::uint32_t>& fitness_values)
+    -> std::vector<std::unique_ptr<individual>> {
+    std::vector<std::unique_ptr<individual>> population;
+    population.reserve(fitness_values.size());
+    for (const auto fitness : fitness_values) {
+        population.push_back(std::make_unique<counted_individual>(fitness));
+    }
+    return population;
+}
+
+// Counted individual the genetic algorithm can breed
+class counted_offspring : public counted_individual {
+public:
+    using counted_individual::counted_individual;
+
+    static auto from_chromosome(chromosome&& genes)
+        -> tl::expected<std::unique_ptr<individual>, genetic_error> {
+        return std::make_unique<counted_offspring>(0, std::move(genes));
+    }
+};
+
+// Selection strategy that only knows how to select from individuals
+class first_selection : public selection_strategy {
+public:
+    [[nodiscard]] auto select(nonstd::span<const std::unique_ptr<individual>> /*population*/,
+                              cshorelark::random::random_generator& /*random*/) const
+        -> tl::expected<const size_t, genetic_error> override {
+        return 0;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Fitness histogram - Summary matches the float statistics", "[fitness_histogram]") {
+    const std::size_t size = GENERATE(1, 2, 7, 100, 1001);
+    cshorelark::random::random_generator random(size);
+    std::vector<std::uint32_t> fitness_values(size);
+    for (auto& fitness : fitness_values) {
+        fitness = static_cast<std::uint32_t>(random.generate_position() * 40.0F);
+    }
+    const auto population = counted_population(fitness_values);
+
+    const auto histogram = fitness_histogram::from_population(population);
+    REQUIRE(histogram.has_value());
+    const auto counted = histogram->summary();
+    const auto sorted = statistics::from_population(population);
+    CHECK(counted.min_fitness() == sorted.min_fitness());
+    CHECK(counted.max_fitness() == sorted.max_fitness());
+    CHECK(counted.avg_fitness() == sorted.avg_fitness());
+    CHECK(counted.median_fitness() == sorted.median_fitness());
+}
+
+TEST_CASE("Fitness histogram - Buckets keep index order", "[fitness_histogram]") {
+    const auto histogram = fitness_histogram::from_fitness(
+        std::vector<float>{3.0F, 1.0F, 3.0F, 0.0F, 1.0F, 3.0F});
+    REQUIRE(histogram.has_value());
+    CHECK(histogram->size() == 6);
+    CHECK(histogram->min_fitness() == 0);
+    CHECK(histogram->max_fitness() == 3);
+    CHECK(histogram->fitness(2) == 3);
+    CHECK(histogram->median_fitness() == 2.0F);
+
+    const auto threes = histogram->individuals_with(3);
+    CHECK(std::vector<std::size_t>(threes.begin(), threes.end()) ==
+          std::vector<std::size_t>{0, 2, 5});
+    CHECK(histogram->individuals_with(2).empty());
+    CHECK(histogram->individuals_with(4).empty());
+}
+
+TEST_CASE("Fitness histogram - Only whole numbers are counted", "[fitness_histogram]") {
+    CHECK_FALSE(fitness_histogram::from_fitness(std::vector<float>{}).has_value());
+    CHECK_FALSE(fitness_histogram::from_fitness(std::vector<float>{1.0F, 0.5F}).has_value());
+    CHECK_FALSE(fitness_histogram::from_fitness(std::vector<float>{-1.0F}).has_value());
+    CHECK_FALSE(fitness_histogram::from_fitness(
+                    std::vector<float>{std::numeric_limits<float>::quiet_NaN()})
+                    .has_value());
+    CHECK_FALSE(fitness_histogram::from_fitness(
+                    std::vector<float>{static_cast<float>(fitness_histogram::k_max_fitness) * 2})
+                    .has_value());
+
+    // Individuals without integer fitness keep the float path
+    std::vector<std::unique_ptr<individual>> population;
+    population.push_back(std::make_unique<counted_individual>(1));
+    CHECK(fitness_histogram::from_population(population).has_value());
+    auto uncounted = std::make_unique<test_individual>(chromosome({0.0F}));
+    uncounted->set_fitness(1.0F);
+    population.push_back(std::move(uncounted));
+    CHECK_FALSE(fitness_histogram::from_population(population).has_value());
+}
+
+TEST_CASE("Fitness histogram - Roulette draws follow the fitness", "[fitness_histogram]") {
+    const auto population = counted_population({2, 0, 1, 4, 3, 0, 2});
+    const auto histogram = fitness_histogram::from_population(population);
+    REQUIRE(histogram.has_value());
+
+    const roulette_wheel_selection selector;
+    cshorelark::random::random_generator random(42);
+    constexpr int k_draws = 120000;
+    std::vector<int> drawn(population.size(), 0);
+    for (int i = 0; i < k_draws; ++i) {
+        auto selected = selector.select_from_histogram(*histogram, random);
+        REQUIRE(selected.has_value());
+        REQUIRE(*selected < population.size());
+        ++drawn[*selected];
+    }
+
+    // Total weight 12: every unit of fitness is drawn about 10000 times
+    for (std::size_t i = 0; i < population.size(); ++i) {
+        const float expected = population[i]->get_fitness() * k_draws / 12.0F;
+        CHECK(std::abs(static_cast<float>(drawn[i]) - expected) < 400.0F);
+    }
+}
+
+TEST_CASE("Fitness histogram - Tournaments pick the same individuals", "[fitness_histogram]") {
+    const auto population = counted_population({5, 1, 9, 9, 0, 3, 7, 2});
+    const auto histogram = fitness_histogram::from_population(population);
+    REQUIRE(histogram.has_value());
+
+    const tournament_selection selector(3);
+    cshorelark::random::random_generator counted_random(7);
+    cshorelark::random::random_generator sorted_random(7);
+    for (int i = 0; i < 100; ++i) {
+        CHECK(selector.select_from_histogram(*histogram, counted_random).value() ==
+              selector.select(population, sorted_random).value());
+    }
+}
+
+TEST_CASE("Fitness histogram - Evolution counts whole-number fitness", "[fitness_histogram]") {
+    std::vector<std::unique_ptr<individual>> population;
+    for (std::uint32_t i = 0; i < 20; ++i) {
+        population.push_back(
+            std::make_unique<counted_offspring>(i % 5, chromosome({static_cast<float>(i)})));
+    }
+    cshorelark::random::random_generator random(3);
+
+    SECTION("With a counting strategy") {
+        const genetic_algorithm<counted_offspring> algorithm(
+            std::make_unique<roulette_wheel_selection>(), std::make_unique<uniform_crossover>(),
+            std::make_unique<gaussian_mutation>(0.0F, 0.1F));
+        auto result = algorithm.evolve(population, random);
+        REQUIRE(result.has_value());
+        CHECK(result->first.size() == population.size());
+        CHECK(result->second.max_fitness() == 4.0F);
+        CHECK(result->second.median_fitness() == 2.0F);
+    }
+
+    SECTION("Strategies without one fall back to select()") {
+        const genetic_algorithm<counted_offspring> algorithm(
+            std::make_unique<first_selection>(), std::make_unique<uniform_crossover>(),
+            std::make_unique<gaussian_mutation>(0.0F, 0.1F));
+        auto result = algorithm.evolve(population, random);
+        REQUIRE(result.has_value());
+        for (const auto& child : result->first) {
+            CHECK(child->get_chromosome()[0] == 0.0F);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+#include "genetic_algorithm/gene_matrix.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "genetic_algorithm/crossover.h"
+#include "genetic_algorithm/genetic_error.h"
+#include "genetic_algorithm/mutation.h"
+#include "genetic_algorithm/selection.h"
+#include "random/random.h"
+
+namespace cshorelark::genetic {
+namespace {
+
+constexpr std::size_t k_rows = 200;
+constexpr std::size_t k_genes = 17;
+
+// Matrix file in the temp directory, removed when the test ends
+class temp_file {
+public:
+    explicit temp_file(const char* name) : path_(std::filesystem::temp_directory_path() / name) {}
+    temp_file(const temp_file&) = delete;
+    temp_file& operator=(const temp_file&) = delete;
+    ~temp_file() {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+
+    [[nodiscard]] auto path() const -> const std::filesystem::path& { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+// Row r holds r in every gene, so a child's genes name the parents they came from
+void fill_with_row_index(gene_matrix& matrix) {
+    for (std::size_t r = 0; r < matrix.rows(); ++r) {
+        for (auto& gene : matrix.row(r)) {
+            gene = static_cast<float>(r);
+        }
+    }
+}
+
+TEST_CASE("Gene matrix storage", "[gene_matrix]") {
+    const temp_file file("cshorelark_gene_matrix.genes");
+
+    SECTION("Rows survive closing and reopening") {
+        {
+            auto matrix = gene_matrix::create(file.path(), k_rows, k_genes);
+            REQUIRE(matrix.has_value());
+            REQUIRE(matrix->rows() == k_rows);
+            REQUIRE(matrix->genes() == k_genes);
+            fill_with_row_index(*matrix);
+            REQUIRE(matrix->flush().has_value());
+        }
+        auto reopened = gene_matrix::open(file.path());
+        REQUIRE(reopened.has_value());
+        REQUIRE(reopened->rows() == k_rows);
+        REQUIRE(reopened->genes() == k_genes);
+        for (std::size_t r = 0; r < k_rows; ++r) {
+            for (const float gene : reopened->row(r)) {
+                REQUIRE(gene == static_cast<float>(r));
+            }
+        }
+    }
+
+    SECTION("Invalid shapes and files are rejected") {
+        CHECK(gene_matrix::create(file.path(), 0, k_genes).error().code ==
+              genetic_error_code::k_invalid_population_size);
+        CHECK(gene_matrix::open(file.path().string() + ".missing").error().code ==
+              genetic_error_code::k_storage_failed);
+
+        std::ofstream(file.path(), std::ios::binary | std::ios::trunc) << "not a gene matrix";
+        CHECK(gene_matrix::open(file.path()).error().code == genetic_error_code::k_storage_failed);
+    }
+}
+
+TEST_CASE("Gene matrix evolution", "[gene_matrix]") {
+    const temp_file parents_file("cshorelark_parents.genes");
+    const temp_file children_file("cshorelark_children.genes");
+    auto parents = gene_matrix::create(parents_file.path(), k_rows, k_genes);
+    auto children = gene_matrix::create(children_file.path(), k_rows, k_genes);
+    REQUIRE(parents.has_value());
+    REQUIRE(children.has_value());
+    fill_with_row_index(*parents);
+
+    std::vector<float> fitness(k_rows);
+    for (std::size_t r = 0; r < k_rows; ++r) {
+        fitness[r] = static_cast<float>(r);
+    }
+    random::random_generator random(5);
+
+    SECTION("Children are bred from the selected parents") {
+        const gene_matrix_evolver evolver(std::make_unique<tournament_selection>(4),
+                                          std::make_unique<uniform_crossover>(),
+                                          std::make_unique<gaussian_mutation>(0.0F, 0.1F));
+        REQUIRE(evolver.evolve(*parents, fitness, *children, random).has_value());
+
+        // Without mutation every gene comes from a parent; tournaments favour fit ones
+        float gene_sum = 0.0F;
+        for (std::size_t r = 0; r < k_rows; ++r) {
+            for (const float gene : children->row(r)) {
+                REQUIRE(gene == static_cast<float>(static_cast<std::size_t>(gene)));
+                REQUIRE(gene < static_cast<float>(k_rows));
+                gene_sum += gene;
+            }
+        }
+        const float mean = gene_sum / static_cast<float>(k_rows * k_genes);
+        CHECK(mean > static_cast<float>(k_rows) / 2.0F);
+    }
+
+    SECTION("Mutation changes the children") {
+        const gene_matrix_evolver evolver(std::make_unique<roulette_wheel_selection>(),
+                                          std::make_unique<single_point_crossover>(),
+                                          std::make_unique<gaussian_mutation>(1.0F, 0.1F));
+        REQUIRE(evolver.evolve(*parents, fitness, *children, random).has_value());
+        std::size_t whole = 0;
+        for (std::size_t r = 0; r < k_rows; ++r) {
+            for (const float gene : children->row(r)) {
+                whole += gene == static_cast<float>(static_cast<std::size_t>(gene)) ? 1 : 0;
+            }
+        }
+        CHECK(whole < k_rows);
+    }
+
+    SECTION("Mismatched inputs are rejected") {
+        const gene_matrix_evolver evolver(std::make_unique<tournament_selection>(),
+                                          std::make_unique<uniform_crossover>(),
+                                          std::make_unique<gaussian_mutation>());
+        const std::vector<float> short_fitness(k_rows - 1, 1.0F);
+        CHECK(evolver.evolve(*parents, short_fitness, *children, random).error().code ==
+              genetic_error_code::k_invalid_population_size);
+
+        const temp_file narrow_file("cshorelark_narrow.genes");
+        auto narrow = gene_matrix::create(narrow_file.path(), k_rows, k_genes - 1);
+        REQUIRE(narrow.has_value());
+        CHECK(evolver.evolve(*parents, fitness, *narrow, random).error().code ==
+              genetic_error_code::k_invalid_parent_size);
+    }
+}
+
+}  // namespace
+}  // namespace cshorelark::genetic
@@ -0,0 +1,243 @@
+#include "genetic_algorithm/lineage.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "genetic_algorithm/genetic_algorithm.h"
+#include "random/random.h"
+#include "test_individual.h"
+
+namespace cshorelark::genetic {
+namespace {
+
+constexpr std::size_t k_population = 40;
+constexpr std::size_t k_genes = 50;
+constexpr std::size_t k_generations = 20;
+constexpr std::size_t k_keyframe_interval = 8;
+
+// Archive in the temp directory, removed when the test ends
+class temp_file {
+public:
+    explicit temp_file(const char* name) : path_(std::filesystem::temp_directory_path() / name) {}
+    temp_file(const temp_file&) = delete;
+    temp_file& operator=(const temp_file&) = delete;
+    ~temp_file() {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+
+    [[nodiscard]] auto path() const -> const std::filesystem::path& { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+auto random_population(cshorelark::random::random_generator& random)
+    -> std::vector<std::unique_ptr<individual>> {
+    std::vector<std::unique_ptr<individual>> population;
+    for (std::size_t i = 0; i < k_population; ++i) {
+        std::vector<float> genes(k_genes);
+        for (auto& gene : genes) {
+            gene = random.generate_weight();
+        }
+        population.push_back(std::make_unique<test_individual>(chromosome(std::move(genes))));
+    }
+    return population;
+}
+
+auto copy_genes(const std::vector<std::unique_ptr<individual>>& population)
+    -> std::vector<std::vector<float>> {
+    std::vector<std::vector<float>> genes;
+    for (const auto& member : population) {
+        const auto chromosome_genes = member->get_chromosome().genes();
+        genes.emplace_back(chromosome_genes.begin(), chromosome_genes.end());
+    }
+    return genes;
+}
+
+auto same_bits(nonstd::span<const float> lhs, const std::vector<float>& rhs) -> bool {
+    return lhs.size() == rhs.size() &&
+           std::memcmp(lhs.data(), rhs.data(), rhs.size() * sizeof(float)) == 0;
+}
+
+/**
+ * @brief Evolves a random population, archiving every generation and keeping a plain copy
+ */
+struct evolved_history {
+    std::vector<std::vector<std::vector<float>>> genes;  ///< Genes by generation and individual
+    std::vector<std::vector<parent_pair>> parents;        ///< Parents by generation, from 1
+    std::uint64_t bytes_written = 0;                      ///< Size of the archive
+    std::uint64_t raw_bytes = 0;                          ///< Size of the plain genes
+};
+
+auto evolve_into(const std::filesystem::path& path,
+                 std::unique_ptr<crossover_strategy> crossover) -> evolved_history {
+    cshorelark::random::random_generator random(7);
+    const genetic_algorithm<test_individual> algorithm(
+        std::make_unique<roulette_wheel_selection>(), std::move(crossover),
+        std::make_unique<gaussian_mutation>(0.01F, 0.3F));
+
+    auto writer = lineage_writer::create(path, k_genes, k_keyframe_interval, "{\"test\": 1}");
+    REQUIRE(writer.has_value());
+
+    evolved_history history;
+    auto population = random_population(random);
+    REQUIRE(writer->append_population(population).has_value());
+    history.genes.push_back(copy_genes(population));
+    history.parents.emplace_back();
+
+    for (std::size_t generation = 1; generation < k_generations; ++generation) {
+        for (auto& member : population) {
+            static_cast<test_individual&>(*member).set_fitness(random.generate_position() + 0.1F);
+        }
+        std::vector<parent_pair> parents;
+        auto evolved = algorithm.evolve(population, random, &parents);
+        REQUIRE(evolved.has_value());
+        population = std::move(evolved->first);
+
+        REQUIRE(parents.size() == population.size());
+        REQUIRE(writer->append_offspring(population, parents).has_value());
+        history.genes.push_back(copy_genes(population));
+        history.parents.push_back(std::move(parents));
+    }
+    REQUIRE(writer->flush().has_value());
+    CHECK(writer->generations() == k_generations);
+    history.bytes_written = writer->bytes_written();
+    history.raw_bytes = writer->raw_bytes();
+    return history;
+}
+
+}  // namespace
+
+TEST_CASE("Lineage archive reconstructs every individual", "[lineage]") {
+    const temp_file file("cshorelark_lineage.lineage");
+    const bool uniform = GENERATE(true, false);
+    const auto history = evolve_into(
+        file.path(), uniform ? std::unique_ptr<crossover_strategy>(new uniform_crossover())
+                             : std::unique_ptr<crossover_strategy>(new single_point_crossover()));
+
+    // Masks for uniform crossover, a switch point or two for single-point crossover; plus the
+    // keyframes and the parent indices
+    CHECK(std::filesystem::file_size(file.path()) == history.bytes_written);
+    CHECK(history.raw_bytes == k_generations * k_population * k_genes * sizeof(float));
+    CHECK(history.bytes_written * 3 < history.raw_bytes);
+
+    auto archive = lineage_archive::open(file.path());
+    REQUIRE(archive.has_value());
+    CHECK(archive->generations() == k_generations);
+    CHECK(archive->genes() == k_genes);
+    CHECK(archive->metadata() == "{\"test\": 1}");
+
+    SECTION("One individual at a time") {
+        for (std::size_t generation = 0; generation < k_generations; ++generation) {
+            REQUIRE(archive->population_size(generation) == k_population);
+            for (std::size_t index = 0; index < k_population; ++index) {
+                auto chromosome = archive->reconstruct(generation, index);
+                REQUIRE(chromosome.has_value());
+                CHECK(same_bits(chromosome->genes(), history.genes[generation][index]));
+            }
+        }
+    }
+
+    SECTION("Whole generations") {
+        for (std::size_t generation = 0; generation < k_generations; ++generation) {
+            auto chromosomes = archive->reconstruct_generation(generation);
+            REQUIRE(chromosomes.has_value());
+            REQUIRE(chromosomes->size() == k_population);
+            for (std::size_t index = 0; index < k_population; ++index) {
+                CHECK(same_bits((*chromosomes)[index].genes(), history.genes[generation][index]));
+            }
+        }
+    }
+
+    SECTION("Parents") {
+        CHECK_FALSE(archive->parents(0, 0).has_value());
+        for (std::size_t generation = 1; generation < k_generations; ++generation) {
+            for (std::size_t index = 0; index < k_population; ++index) {
+                auto parents = archive->parents(generation, index);
+                REQUIRE(parents.has_value());
+                CHECK(parents->first == history.parents[generation][index].first);
+                CHECK(parents->second == history.parents[generation][index].second);
+            }
+        }
+    }
+
+    SECTION("Out of range") {
+        CHECK_FALSE(archive->reconstruct(k_generations, 0).has_value());
+        CHECK_FALSE(archive->reconstruct(0, k_population).has_value());
+        CHECK_FALSE(archive->reconstruct_generation(k_generations).has_value());
+        CHECK(archive->population_size(k_generations) == 0);
+    }
+}
+
+TEST_CASE("Lineage archive errors", "[lineage]") {
+    const temp_file file("cshorelark_lineage_errors.lineage");
+    cshorelark::random::random_generator random(3);
+
+    SECTION("Offspring need a parent generation") {
+        auto writer = lineage_writer::create(file.path(), k_genes);
+        REQUIRE(writer.has_value());
+        const auto population = random_population(random);
+        const std::vector<parent_pair> parents(population.size());
+        CHECK(writer->append_offspring(population, parents).error().code ==
+              genetic_error_code::k_invalid_population_size);
+
+        REQUIRE(writer->append_population(population).has_value());
+        const std::vector<parent_pair> too_few(1);
+        CHECK_FALSE(writer->append_offspring(population, too_few).has_value());
+        std::vector<parent_pair> out_of_range(population.size());
+        out_of_range.back().second = population.size();
+        CHECK(writer->append_offspring(population, out_of_range).error().code ==
+              genetic_error_code::k_invalid_selection);
+    }
+
+    SECTION("Chromosomes must match the archive") {
+        auto writer = lineage_writer::create(file.path(), k_genes + 1);
+        REQUIRE(writer.has_value());
+        CHECK(writer->append_population(random_population(random)).error().code ==
+              genetic_error_code::k_invalid_chromosome);
+    }
+
+    SECTION("Other files are rejected") {
+        {
+            std::ofstream out(file.path(), std::ios::binary);
+            out << "not an archive at all, but long enough for a header";
+        }
+        CHECK(lineage_archive::open(file.path()).error().code ==
+              genetic_error_code::k_storage_failed);
+    }
+
+    SECTION("Truncated archives are rejected") {
+        {
+            auto writer = lineage_writer::create(file.path(), k_genes);
+            REQUIRE(writer.has_value());
+            REQUIRE(writer->append_population(random_population(random)).has_value());
+        }
+        std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 4);
+        CHECK(lineage_archive::open(file.path()).error().code ==
+              genetic_error_code::k_storage_failed);
+    }
+
+    SECTION("Metadata sizes past the end are rejected") {
+        {
+            auto writer = lineage_writer::create(file.path(), k_genes, 1, "{}");
+            REQUIRE(writer.has_value());
+        }
+        {
+            // Metadata size field of the header, claiming 4 GiB
+            std::fstream out(file.path(), std::ios::binary | std::ios::in | std::ios::out);
+            const std::uint32_t metadata_bytes = 0xFFFFFFFFU;
+            out.seekp(24);
+            out.write(reinterpret_cast<const char*>(&metadata_bytes), sizeof(metadata_bytes));
+        }
+        CHECK(lineage_archive::open(file.path()).error().code ==
+              genetic_error_code::k_storage_failed);
+    }
+}
+
+}  // namespace cshorelark::genetic
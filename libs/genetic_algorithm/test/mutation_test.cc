@@ -183,17 +183,20 @@ TEST_CASE("Gaussian mutation", "[mutation]") {
                 k_low_mutation_threshold);  // Allow some variance due to randomness
     }
 
-    SECTION("Mutation respects range limits") {
-        const gaussian_mutation mutation(1.0F,
-                                         k_limited_range);  // High mutation rate but limited range
+    SECTION("Mutation noise scales with the strength") {
+        const gaussian_mutation mutation(1.0F, k_limited_range);  // Always mutate with std=0.5
 
-        auto chromo = create_zero_chromosome();
-        auto result = mutation.mutate(chromo, rng);
-        REQUIRE(result.has_value());
-
-        for (const float gene : chromo) {
-            REQUIRE(std::abs(gene) <= k_limited_range);
+        // About 68% of normal noise lies within one standard deviation
+        std::size_t within_one_std_dev = 0;
+        for (int i = 0; i < k_statistical_trials; ++i) {
+            auto chromo = create_test_chromosome({k_zero_gene});
+            auto result = mutation.mutate(chromo, rng);
+            REQUIRE(result.has_value());
+            within_one_std_dev += std::abs(chromo[0]) <= k_limited_range ? 1 : 0;
         }
+        const float ratio =
+            static_cast<float>(within_one_std_dev) / static_cast<float>(k_statistical_trials);
+        CHECK_THAT(ratio, WithinRel(0.6827F, k_statistical_tolerance));
     }
 }
 
@@ -285,16 +288,17 @@ TEST_CASE("Gaussian mutation with default parameters", "[mutation]") {
                 k_low_mutation_threshold);  // Allow some variance due to randomness
     }
 
-    SECTION("Mutation with limited range") {
-        const gaussian_mutation mutation(1.0F,
-                                         k_limited_range);  // High mutation rate but limited range
+    SECTION("Mutation with limited strength") {
+        const gaussian_mutation mutation(1.0F, k_limited_range);  // Always mutate with std=0.5
 
         auto chromo = create_zero_chromosome();
         auto result = mutation.mutate(chromo, rng);
         REQUIRE(result.has_value());
 
+        // Normal noise beyond six standard deviations is practically impossible
         for (const float gene : chromo) {
-            REQUIRE(std::abs(gene) <= k_limited_range);
+            REQUIRE(gene != k_zero_gene);
+            REQUIRE(std::abs(gene) <= 6.0F * k_limited_range);
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,145 @@
+#ifndef CSHORELARK_NEURAL_NETWORK_BRAIN_PACK_H
+#define CSHORELARK_NEURAL_NETWORK_BRAIN_PACK_H
+
+/**
+ * @file brain_pack.h
+ * @brief Versioned binary container for trained networks
+ *
+ * A brain pack stores any number of networks in one file:
+ *
+ * - a 32-byte header: magic "CSBPACK\0", format version, network count and
+ *   the offset of the index;
+ * - per network, its layer sizes (uint32) followed by its weights (float32)
+ *   starting on a 64-byte boundary;
+ * - the index, one 32-byte entry per network with the offsets of its layer
+ *   sizes and weights, the layer count, the activation tag and the weight
+ *   count.
+ *
+ * Values are stored in the byte order of the machine that wrote the pack; the
+ * header records it and packs of the other byte order are rejected.
+ */
+
+// C++ system headers
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+// External library headers
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+
+// Project headers
+#include "neural_network/activation.h"    // NOLINT
+#include "neural_network/network.h"       // NOLINT
+#include "neural_network/network_view.h"  // NOLINT
+
+namespace cshorelark::neural_network {
+
+/**
+ * @brief Error types that can occur while writing or reading a brain pack
+ */
+enum class brain_pack_error {
+    k_io_error,             ///< The file could not be opened, mapped or written
+    k_bad_magic,            ///< The file is not a brain pack
+    k_unsupported_version,  ///< The pack was written by an incompatible format version
+    k_byte_order_mismatch,  ///< The pack was written on a machine of the other byte order
+    k_corrupt,              ///< Offsets or sizes point outside the file
+    k_index_out_of_range,   ///< No network at the requested index
+    k_invalid_network       ///< A network's weights do not match its topology
+};
+
+/**
+ * @brief Collects networks and writes them as a brain pack
+ */
+class brain_pack_writer {
+public:
+    /**
+     * @brief Adds a network given by its topology and weights
+     * @param layer_sizes Neuron count of each layer, input layer first
+     * @param activation Activation applied by every neuron
+     * @param weights Weights in the layout of network::weights()
+     * @return Expected containing the index of the network in the pack or error
+     */
+    auto add(nonstd::span<const std::uint32_t> layer_sizes, activation_function activation,
+             nonstd::span<const float> weights) -> tl::expected<std::size_t, brain_pack_error>;
+
+    /**
+     * @brief Adds a network, networks always use ReLU
+     * @param net Network to add
+     * @return Expected containing the index of the network in the pack or error
+     */
+    auto add(const network<float>& net) -> tl::expected<std::size_t, brain_pack_error>;
+
+    /**
+     * @brief Gets the number of networks added so far
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return entries_.size(); }
+
+    /**
+     * @brief Writes all added networks to a file, replacing it
+     * @param path Path of the pack
+     * @return Expected containing nothing or error
+     */
+    [[nodiscard]] auto write(const std::filesystem::path& path) const
+        -> tl::expected<void, brain_pack_error>;
+
+private:
+    struct entry {
+        std::vector<std::uint32_t> layer_sizes;
+        activation_function activation;
+        std::vector<float> weights;
+    };
+
+    std::vector<entry> entries_;  ///< Networks in insertion order
+};
+
+/**
+ * @brief Memory-mapped brain pack handing out zero-copy network views
+ *
+ * Opening a pack maps the file and validates the header and index; views
+ * point straight into the mapping and stay valid until the pack is destroyed.
+ */
+class brain_pack {
+public:
+    static constexpr std::uint32_t k_version = 1;  ///< Format version written and read
+
+    /**
+     * @brief Opens and maps a pack
+     * @param path Path of the pack
+     * @return Expected containing the pack or error
+     */
+    [[nodiscard]] static auto open(const std::filesystem::path& path)
+        -> tl::expected<brain_pack, brain_pack_error>;
+
+    brain_pack(const brain_pack&) = delete;
+    brain_pack& operator=(const brain_pack&) = delete;
+    brain_pack(brain_pack&&) noexcept;
+    brain_pack& operator=(brain_pack&&) noexcept;
+    ~brain_pack();
+
+    /**
+     * @brief Gets the number of networks in the pack
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    /**
+     * @brief Gets a view of a network
+     * @param index Index of the network
+     * @return Expected containing the view or error
+     */
+    [[nodiscard]] auto view(std::size_t index) const
+        -> tl::expected<network_view, brain_pack_error>;
+
+private:
+    class mapping;
+
+    explicit brain_pack(std::unique_ptr<mapping> file) noexcept;
+
+    std::unique_ptr<mapping> file_;  ///< Mapped file and validated index
+};
+
+}  // namespace cshorelark::neural_network
+
+#endif  // CSHORELARK_NEURAL_NETWORK_BRAIN_PACK_H
@@ -0,0 +1,140 @@
+#ifndef CSHORELARK_NEURAL_NETWORK_JIT_H
+#define CSHORELARK_NEURAL_NETWORK_JIT_H
+
+/**
+ * @file jit.h
+ * @brief Runtime-generated x86-64 inference kernels for fixed topologies
+ *
+ * A kernel is straight-line SSE code specialised for one topology: every
+ * loop is unrolled, accumulators of four neurons each stay in registers for a
+ * whole layer and the activation is applied in place. Lanes hold different
+ * neurons, so each neuron still sums bias first and then one product per
+ * input in order; outputs are bit-identical to network::propagate as long as
+ * the generic path is not compiled with fused multiply-adds.
+ *
+ * Kernels are only generated on x86-64 POSIX systems; elsewhere compile()
+ * fails with jit_error::k_unsupported_platform and callers keep the generic
+ * path.
+ */
+
+// C++ system headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// External library headers
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+
+// Project headers
+#include "neural_network/activation.h"  // NOLINT
+
+namespace cshorelark::neural_network {
+
+/**
+ * @brief Error types that can occur while generating or running a kernel
+ */
+enum class jit_error {
+    k_unsupported_platform,    ///< No code generator for this machine
+    k_unsupported_activation,  ///< Only ReLU kernels are generated
+    k_invalid_topology,        ///< Fewer than two layers or an empty layer
+    k_invalid_weights,         ///< Weights do not match the topology
+    k_invalid_input_size,      ///< Input, weights or scratch have the wrong size
+    k_memory_error             ///< Executable memory could not be obtained
+};
+
+/**
+ * @brief Where a kernel reads its weights from
+ */
+enum class jit_weights {
+    k_pointer,  ///< Packed weights are passed on every call, one kernel serves any weights
+    k_embedded  ///< Weights are stored next to the code, one kernel per network
+};
+
+/**
+ * @brief Generated inference kernel for one topology
+ */
+class jit_kernel {
+public:
+    /**
+     * @brief Whether kernels can be generated on this machine
+     */
+    [[nodiscard]] static auto is_supported() noexcept -> bool;
+
+    /**
+     * @brief Generates a kernel
+     * @param layer_sizes Neuron count of each layer, input layer first
+     * @param activation Activation applied by every neuron
+     * @param mode Where the kernel reads its weights from
+     * @param weights Weights in the layout of network::weights(), only for k_embedded
+     * @return Expected containing the kernel or error
+     */
+    [[nodiscard]] static auto compile(nonstd::span<const std::uint32_t> layer_sizes,
+                                      activation_function activation, jit_weights mode,
+                                      nonstd::span<const float> weights = {})
+        -> tl::expected<jit_kernel, jit_error>;
+
+    /**
+     * @brief Gets the process-wide pointer-mode kernel of a topology, generating it once
+     * @param layer_sizes Neuron count of each layer, input layer first
+     * @param activation Activation applied by every neuron
+     * @return Expected containing the shared kernel or error
+     */
+    [[nodiscard]] static auto shared(nonstd::span<const std::uint32_t> layer_sizes,
+                                     activation_function activation)
+        -> tl::expected<std::shared_ptr<const jit_kernel>, jit_error>;
+
+    jit_kernel(const jit_kernel&) = delete;
+    jit_kernel& operator=(const jit_kernel&) = delete;
+    jit_kernel(jit_kernel&& other) noexcept;
+    jit_kernel& operator=(jit_kernel&& other) noexcept;
+    ~jit_kernel();
+
+    /**
+     * @brief Rearranges weights into the layout pointer-mode kernels read
+     * @param weights Weights in the layout of network::weights()
+     * @return Expected containing the packed weights or error
+     */
+    [[nodiscard]] auto pack(nonstd::span<const float> weights) const
+        -> tl::expected<std::vector<float>, jit_error>;
+
+    /**
+     * @brief Runs the kernel
+     * @param inputs Input values
+     * @param packed Weights from pack() for k_pointer kernels, empty for k_embedded ones
+     * @param scratch Working memory of scratch_size() floats, not shared between threads
+     * @return Expected containing a view of the outputs inside scratch or error
+     */
+    [[nodiscard]] auto propagate(nonstd::span<const float> inputs,
+                                 nonstd::span<const float> packed,
+                                 nonstd::span<float> scratch) const
+        -> tl::expected<nonstd::span<const float>, jit_error>;
+
+    [[nodiscard]] auto input_size() const noexcept -> std::size_t { return layer_sizes_.front(); }
+    [[nodiscard]] auto output_size() const noexcept -> std::size_t { return layer_sizes_.back(); }
+    [[nodiscard]] auto mode() const noexcept -> jit_weights { return mode_; }
+    [[nodiscard]] auto packed_size() const noexcept -> std::size_t { return packed_size_; }
+    [[nodiscard]] auto scratch_size() const noexcept -> std::size_t { return scratch_size_; }
+    [[nodiscard]] auto code_size() const noexcept -> std::size_t { return code_size_; }
+
+private:
+    using entry_point = void (*)(const float* inputs, const float* weights, float* scratch);
+
+    jit_kernel() = default;
+
+    void release() noexcept;
+
+    std::vector<std::uint32_t> layer_sizes_;  ///< Neurons per layer
+    jit_weights mode_ = jit_weights::k_pointer;
+    std::size_t packed_size_ = 0;    ///< Floats of packed weights
+    std::size_t scratch_size_ = 0;   ///< Floats of scratch memory
+    std::size_t output_offset_ = 0;  ///< Position of the outputs in scratch
+    void* code_ = nullptr;           ///< Executable mapping
+    std::size_t code_size_ = 0;      ///< Bytes mapped
+    entry_point entry_ = nullptr;    ///< Start of the code
+};
+
+}  // namespace cshorelark::neural_network
+
+#endif  // CSHORELARK_NEURAL_NETWORK_JIT_H
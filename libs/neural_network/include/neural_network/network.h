@@ -38,7 +38,8 @@ enum class network_error {
     k_not_enough_weights,       ///< Fewer weights provided than needed
     k_network_not_initialized,  ///< Network not initialized
     k_propagation_error,        ///< Propagation error
-    k_invalid_layer_topology    ///< Layer topology is invalid (empty or mismatched inputs)
+    k_invalid_layer_topology,   ///< Layer topology is invalid (empty or mismatched inputs)
+    k_unsupported_activation    ///< Activation the network cannot represent
 };
 
 /**
@@ -134,6 +135,14 @@ public:
      */
     [[nodiscard]] auto weights() const -> std::vector<value_type>;
 
+    /**
+     * @brief Gets the layers of the network
+     * @return Span over the layers, input side first
+     */
+    [[nodiscard]] auto layers() const noexcept -> nonstd::span<const layer_type> {
+        return layers_;
+    }
+
 private:
     std::vector<layer_type> layers_;  ///< Layers in the network
 };
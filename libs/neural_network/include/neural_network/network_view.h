@@ -0,0 +1,107 @@
+#ifndef CSHORELARK_NEURAL_NETWORK_NETWORK_VIEW_H
+#define CSHORELARK_NEURAL_NETWORK_NETWORK_VIEW_H
+
+/**
+ * @file network_view.h
+ * @brief Non-owning feed-forward network over externally stored weights
+ */
+
+// C++ system headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// External library headers
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+
+// Project headers
+#include "neural_network/activation.h"  // NOLINT
+#include "neural_network/network.h"     // NOLINT
+
+namespace cshorelark::neural_network {
+
+/**
+ * @brief Read-only network that borrows its topology and weights
+ *
+ * Weights use the layout of network::weights(): layer by layer, and for each
+ * neuron its bias followed by one weight per input. Nothing is copied, so the
+ * storage, typically a memory-mapped brain pack, must outlive the view.
+ */
+class network_view {
+public:
+    /**
+     * @brief Constructs a view, checking that the weights match the topology
+     * @param layer_sizes Neuron count of each layer, input layer first
+     * @param activation Activation applied by every neuron
+     * @param weights Weights of all layers
+     * @return Expected containing the view or error
+     */
+    [[nodiscard]] static auto create(nonstd::span<const std::uint32_t> layer_sizes,
+                                     activation_function activation,
+                                     nonstd::span<const float> weights)
+        -> tl::expected<network_view, network_error>;
+
+    /**
+     * @brief Gets the number of inputs this network accepts
+     */
+    [[nodiscard]] auto input_size() const noexcept -> std::size_t { return layer_sizes_.front(); }
+
+    /**
+     * @brief Gets the number of outputs this network produces
+     */
+    [[nodiscard]] auto output_size() const noexcept -> std::size_t { return layer_sizes_.back(); }
+
+    /**
+     * @brief Gets the neuron count of each layer, input layer first
+     */
+    [[nodiscard]] auto layer_sizes() const noexcept -> nonstd::span<const std::uint32_t> {
+        return layer_sizes_;
+    }
+
+    /**
+     * @brief Gets the activation applied by every neuron
+     */
+    [[nodiscard]] auto activation() const noexcept -> activation_function { return activation_; }
+
+    /**
+     * @brief Gets the borrowed weights
+     */
+    [[nodiscard]] auto weights() const noexcept -> nonstd::span<const float> { return weights_; }
+
+    /**
+     * @brief Propagates input values through the network
+     * @param inputs Span of input values
+     * @return Expected containing output values or error if the input size is wrong
+     */
+    [[nodiscard]] auto propagate(nonstd::span<const float> inputs) const
+        -> tl::expected<std::vector<float>, network_error>;
+
+    /**
+     * @brief Copies the view into an owning network
+     * @return Expected containing the network or error, k_unsupported_activation unless the
+     *         view uses ReLU, the only activation owning networks apply
+     */
+    [[nodiscard]] auto to_network() const -> tl::expected<network<float>, network_error>;
+
+    /**
+     * @brief Computes the number of weights a topology needs
+     * @param layer_sizes Neuron count of each layer, input layer first
+     * @return Weight count including biases, the largest size_t if it does not fit in one
+     */
+    [[nodiscard]] static auto weight_count(nonstd::span<const std::uint32_t> layer_sizes) noexcept
+        -> std::size_t;
+
+private:
+    network_view(nonstd::span<const std::uint32_t> layer_sizes, activation_function activation,
+                 nonstd::span<const float> weights) noexcept
+        : layer_sizes_(layer_sizes), activation_(activation), weights_(weights) {}
+
+    nonstd::span<const std::uint32_t> layer_sizes_;  ///< Neurons per layer
+    activation_function activation_;                 ///< Activation of every neuron
+    nonstd::span<const float> weights_;              ///< Borrowed weights
+};
+
+}  // namespace cshorelark::neural_network
+
+#endif  // CSHORELARK_NEURAL_NETWORK_NETWORK_VIEW_H
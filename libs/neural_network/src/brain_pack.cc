@@ -0,0 +1,294 @@
+#include "neural_network/brain_pack.h"
+
+// C++ system headers
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cshorelark::neural_network {
+
+namespace {
+
+constexpr std::array<char, 8> k_magic = {'C', 'S', 'B', 'P', 'A', 'C', 'K', '\0'};
+constexpr std::uint32_t k_byte_order_mark = 0x01020304U;
+constexpr std::uint32_t k_swapped_byte_order_mark = 0x04030201U;
+constexpr std::size_t k_weights_alignment = 64;  // Cache line, also suits SIMD loads
+
+struct pack_header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t count;
+    std::uint64_t index_offset;
+};
+static_assert(sizeof(pack_header) == 32, "brain pack header must be 32 bytes");
+
+struct index_entry {
+    std::uint64_t layers_offset;
+    std::uint64_t weights_offset;
+    std::uint64_t weight_count;
+    std::uint32_t layer_count;
+    std::uint32_t activation;
+};
+static_assert(sizeof(index_entry) == 32, "brain pack index entry must be 32 bytes");
+
+void pad_to(std::vector<char>& buffer, std::size_t alignment) {
+    buffer.resize((buffer.size() + alignment - 1) / alignment * alignment, '\0');
+}
+
+template <typename T>
+void append(std::vector<char>& buffer, const T* data, std::size_t count) {
+    const auto* bytes = reinterpret_cast<const char*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+}
+
+// Checks that count aligned elements of T starting at offset lie within size bytes
+template <typename T>
+auto fits(std::uint64_t offset, std::uint64_t count, std::size_t size) -> bool {
+    if (offset > size || count > (size - offset) / sizeof(T)) {
+        return false;
+    }
+    return offset % alignof(T) == 0;
+}
+
+}  // namespace
+
+auto brain_pack_writer::add(nonstd::span<const std::uint32_t> layer_sizes,
+                            activation_function activation, nonstd::span<const float> weights)
+    -> tl::expected<std::size_t, brain_pack_error> {
+    if (!network_view::create(layer_sizes, activation, weights)) {
+        return tl::make_unexpected(brain_pack_error::k_invalid_network);
+    }
+    entries_.push_back(entry{{layer_sizes.begin(), layer_sizes.end()},
+                             activation,
+                             {weights.begin(), weights.end()}});
+    return entries_.size() - 1;
+}
+
+auto brain_pack_writer::add(const network<float>& net)
+    -> tl::expected<std::size_t, brain_pack_error> {
+    const auto weights = net.weights();
+
+    std::vector<std::uint32_t> layer_sizes{static_cast<std::uint32_t>(net.input_size())};
+    for (const auto& layer : net.layers()) {
+        layer_sizes.push_back(static_cast<std::uint32_t>(layer.size()));
+    }
+    return add(layer_sizes, activation_function::k_relu, weights);
+}
+
+auto brain_pack_writer::write(const std::filesystem::path& path) const
+    -> tl::expected<void, brain_pack_error> {
+    std::vector<char> buffer(sizeof(pack_header), '\0');
+    std::vector<index_entry> index;
+    index.reserve(entries_.size());
+
+    for (const auto& item : entries_) {
+        index_entry record{};
+        pad_to(buffer, alignof(std::uint32_t));
+        record.layers_offset = buffer.size();
+        record.layer_count = static_cast<std::uint32_t>(item.layer_sizes.size());
+        append(buffer, item.layer_sizes.data(), item.layer_sizes.size());
+
+        pad_to(buffer, k_weights_alignment);
+        record.weights_offset = buffer.size();
+        record.weight_count = item.weights.size();
+        record.activation = static_cast<std::uint32_t>(item.activation);
+        append(buffer, item.weights.data(), item.weights.size());
+        index.push_back(record);
+    }
+
+    pad_to(buffer, alignof(index_entry));
+    pack_header header{k_magic, brain_pack::k_version, k_byte_order_mark, index.size(),
+                       buffer.size()};
+    append(buffer, index.data(), index.size());
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return tl::make_unexpected(brain_pack_error::k_io_error);
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!file) {
+        return tl::make_unexpected(brain_pack_error::k_io_error);
+    }
+    return {};
+}
+
+/**
+ * @brief Read-only mapping of a pack file and its validated index
+ */
+class brain_pack::mapping {
+public:
+    mapping() = default;
+    mapping(const mapping&) = delete;
+    mapping& operator=(const mapping&) = delete;
+    mapping(mapping&&) = delete;
+    mapping& operator=(mapping&&) = delete;
+
+    ~mapping() {
+#ifdef _WIN32
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+        }
+#else
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+    }
+
+    auto map(const std::filesystem::path& path) -> bool {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size)) {
+            CloseHandle(file);
+            return false;
+        }
+        if (file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return true;  // Nothing to map, rejected as too small by the caller
+        }
+        HANDLE view = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (view == nullptr) {
+            return false;
+        }
+        data_ = static_cast<const char*>(MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(view);
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+        return data_ != nullptr;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            return true;  // Nothing to map, rejected as too small by the caller
+        }
+        void* address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping keeps the file alive
+        if (address == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<const char*>(address);
+        return true;
+#endif
+    }
+
+    auto validate() -> tl::expected<void, brain_pack_error> {
+        if (size_ < sizeof(pack_header)) {
+            return tl::make_unexpected(brain_pack_error::k_corrupt);
+        }
+        pack_header header{};
+        std::memcpy(&header, data_, sizeof(header));
+        if (header.magic != k_magic) {
+            return tl::make_unexpected(brain_pack_error::k_bad_magic);
+        }
+        if (header.byte_order == k_swapped_byte_order_mark) {
+            return tl::make_unexpected(brain_pack_error::k_byte_order_mismatch);
+        }
+        if (header.version != brain_pack::k_version) {
+            return tl::make_unexpected(brain_pack_error::k_unsupported_version);
+        }
+        if (header.byte_order != k_byte_order_mark ||
+            !fits<index_entry>(header.index_offset, header.count, size_)) {
+            return tl::make_unexpected(brain_pack_error::k_corrupt);
+        }
+
+        index_.resize(static_cast<std::size_t>(header.count));
+        std::memcpy(index_.data(), data_ + header.index_offset,
+                    index_.size() * sizeof(index_entry));
+        for (const auto& record : index_) {
+            if (!fits<std::uint32_t>(record.layers_offset, record.layer_count, size_) ||
+                !fits<float>(record.weights_offset, record.weight_count, size_) ||
+                record.activation > static_cast<std::uint32_t>(activation_function::k_tanh)) {
+                return tl::make_unexpected(brain_pack_error::k_corrupt);
+            }
+        }
+        return {};
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return index_.size(); }
+
+    [[nodiscard]] auto view(std::size_t index) const
+        -> tl::expected<network_view, brain_pack_error> {
+        if (index >= index_.size()) {
+            return tl::make_unexpected(brain_pack_error::k_index_out_of_range);
+        }
+        const auto& record = index_[index];
+        const nonstd::span<const std::uint32_t> layer_sizes(
+            reinterpret_cast<const std::uint32_t*>(data_ + record.layers_offset),
+            static_cast<std::size_t>(record.layer_count));
+        const nonstd::span<const float> weights(
+            reinterpret_cast<const float*>(data_ + record.weights_offset),
+            static_cast<std::size_t>(record.weight_count));
+        auto result = network_view::create(
+            layer_sizes, static_cast<activation_function>(record.activation), weights);
+        if (!result) {
+            return tl::make_unexpected(brain_pack_error::k_invalid_network);
+        }
+        return *result;
+    }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<index_entry> index_;
+};
+
+brain_pack::brain_pack(std::unique_ptr<mapping> file) noexcept : file_(std::move(file)) {}
+
+brain_pack::brain_pack(brain_pack&&) noexcept = default;
+
+brain_pack& brain_pack::operator=(brain_pack&&) noexcept = default;
+
+brain_pack::~brain_pack() = default;
+
+auto brain_pack::open(const std::filesystem::path& path)
+    -> tl::expected<brain_pack, brain_pack_error> {
+    auto file = std::make_unique<mapping>();
+    if (!file->map(path)) {
+        return tl::make_unexpected(brain_pack_error::k_io_error);
+    }
+    if (auto valid = file->validate(); !valid) {
+        return tl::make_unexpected(valid.error());
+    }
+    return brain_pack(std::move(file));
+}
+
+auto brain_pack::size() const noexcept -> std::size_t { return file_ ? file_->size() : 0; }
+
+auto brain_pack::view(std::size_t index) const -> tl::expected<network_view, brain_pack_error> {
+    if (!file_) {
+        return tl::make_unexpected(brain_pack_error::k_index_out_of_range);
+    }
+    return file_->view(index);
+}
+
+}  // namespace cshorelark::neural_network
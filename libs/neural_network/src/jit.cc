@@ -0,0 +1,375 @@
+#include "neural_network/jit.h"
+
+// C++ system headers
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#if defined(__x86_64__) && !defined(_WIN32)
+#define CSHORELARK_JIT_X86_64 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace cshorelark::neural_network {
+
+namespace {
+
+constexpr std::size_t k_lanes = 4;  // Floats per SSE register
+
+auto blocks_of(std::size_t neurons) -> std::size_t { return (neurons + k_lanes - 1) / k_lanes; }
+
+// Floats of one block: four biases, then four weights per input
+auto block_floats(std::size_t inputs) -> std::size_t { return k_lanes * (inputs + 1); }
+
+auto valid_topology(nonstd::span<const std::uint32_t> layer_sizes) -> bool {
+    return layer_sizes.size() >= 2 &&
+           std::none_of(layer_sizes.begin(), layer_sizes.end(),
+                        [](std::uint32_t size) { return size == 0; });
+}
+
+auto weight_count(nonstd::span<const std::uint32_t> layer_sizes) -> std::size_t {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i + 1 < layer_sizes.size(); ++i) {
+        count += (static_cast<std::size_t>(layer_sizes[i]) + 1) * layer_sizes[i + 1];
+    }
+    return count;
+}
+
+auto packed_count(nonstd::span<const std::uint32_t> layer_sizes) -> std::size_t {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i + 1 < layer_sizes.size(); ++i) {
+        count += blocks_of(layer_sizes[i + 1]) * block_floats(layer_sizes[i]);
+    }
+    return count;
+}
+
+// Transposes each group of four neurons so one load fetches the same weight of all four;
+// padding lanes of a partial group stay zero
+void pack_weights(nonstd::span<const std::uint32_t> layer_sizes,
+                  nonstd::span<const float> weights, std::vector<float>& packed) {
+    packed.assign(packed_count(layer_sizes), 0.0F);
+    std::size_t source = 0;
+    std::size_t target = 0;
+    for (std::size_t i = 0; i + 1 < layer_sizes.size(); ++i) {
+        const std::size_t inputs = layer_sizes[i];
+        const std::size_t neurons = layer_sizes[i + 1];
+        for (std::size_t neuron = 0; neuron < neurons; ++neuron) {
+            const std::size_t block = target + (neuron / k_lanes) * block_floats(inputs);
+            const std::size_t lane = neuron % k_lanes;
+            for (std::size_t k = 0; k <= inputs; ++k) {
+                packed[block + k * k_lanes + lane] = weights[source++];
+            }
+        }
+        target += blocks_of(neurons) * block_floats(inputs);
+    }
+}
+
+#ifdef CSHORELARK_JIT_X86_64
+
+// General purpose registers holding the arguments (System V)
+constexpr int k_inputs_register = 7;   // rdi
+constexpr int k_weights_register = 6;  // rsi
+constexpr int k_scratch_register = 2;  // rdx
+
+// Vector registers: accumulators first, then the fixed roles
+constexpr int k_accumulators = 13;
+constexpr int k_product_register = 13;
+constexpr int k_input_register = 14;
+constexpr int k_zero_register = 15;
+
+constexpr std::uint8_t k_no_prefix = 0x00;
+constexpr std::uint8_t k_scalar_prefix = 0xF3;
+constexpr std::uint8_t k_op_movups_load = 0x10;
+constexpr std::uint8_t k_op_movups_store = 0x11;
+constexpr std::uint8_t k_op_xorps = 0x57;
+constexpr std::uint8_t k_op_addps = 0x58;
+constexpr std::uint8_t k_op_mulps = 0x59;
+constexpr std::uint8_t k_op_maxps = 0x5F;
+constexpr std::uint8_t k_op_shufps = 0xC6;
+constexpr std::uint8_t k_ret = 0xC3;
+
+/**
+ * @brief Encodes the handful of SSE instructions the kernels need
+ */
+class assembler {
+public:
+    explicit assembler(jit_weights mode) : mode_(mode) {}
+
+    // op xmm, xmm
+    void register_op(std::uint8_t prefix, std::uint8_t opcode, int reg, int rm) {
+        opcode_bytes(prefix, opcode, reg, rm);
+        byte(static_cast<std::uint8_t>(0xC0 | ((reg & 7) << 3) | (rm & 7)));
+    }
+
+    // op xmm, [base + disp32], or op [base + disp32], xmm for stores
+    void memory_op(std::uint8_t prefix, std::uint8_t opcode, int reg, int base,
+                   std::int32_t displacement) {
+        opcode_bytes(prefix, opcode, reg, base);
+        byte(static_cast<std::uint8_t>(0x80 | ((reg & 7) << 3) | (base & 7)));
+        dword(displacement);
+    }
+
+    void shuffle(int reg, int rm, std::uint8_t selector) {
+        register_op(k_no_prefix, k_op_shufps, reg, rm);
+        byte(selector);
+    }
+
+    // Loads four weights, from the weights argument or from the data after the code
+    void load_weights(int reg, std::size_t offset) {
+        const auto displacement = static_cast<std::int32_t>(offset * sizeof(float));
+        if (mode_ == jit_weights::k_pointer) {
+            memory_op(k_no_prefix, k_op_movups_load, reg, k_weights_register, displacement);
+            return;
+        }
+        opcode_bytes(k_no_prefix, k_op_movups_load, reg, 0);
+        byte(static_cast<std::uint8_t>(((reg & 7) << 3) | 0x05));  // [rip + disp32]
+        patches_.emplace_back(code_.size(), displacement);
+        dword(0);
+    }
+
+    void byte(std::uint8_t value) { code_.push_back(value); }
+
+    // Appends the data and points the RIP-relative loads at it
+    auto finish(nonstd::span<const float> data) -> std::vector<std::uint8_t> {
+        code_.resize((code_.size() + 15) / 16 * 16, k_ret);
+        const std::size_t data_start = code_.size();
+        for (const auto& [position, offset] : patches_) {
+            const auto relative = static_cast<std::int64_t>(data_start) + offset -
+                                  static_cast<std::int64_t>(position + sizeof(std::int32_t));
+            const auto value = static_cast<std::int32_t>(relative);
+            std::memcpy(code_.data() + position, &value, sizeof(value));
+        }
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+        code_.insert(code_.end(), bytes, bytes + data.size() * sizeof(float));
+        return std::move(code_);
+    }
+
+private:
+    void opcode_bytes(std::uint8_t prefix, std::uint8_t opcode, int reg, int rm) {
+        if (prefix != k_no_prefix) {
+            byte(prefix);
+        }
+        const auto rex = static_cast<std::uint8_t>(0x40 | ((reg >> 3) & 1) << 2 | ((rm >> 3) & 1));
+        if (rex != 0x40) {
+            byte(rex);
+        }
+        byte(0x0F);
+        byte(opcode);
+    }
+
+    void dword(std::int32_t value) {
+        std::uint8_t bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        code_.insert(code_.end(), bytes, bytes + sizeof(value));
+    }
+
+    jit_weights mode_;
+    std::vector<std::uint8_t> code_;
+    std::vector<std::pair<std::size_t, std::int32_t>> patches_;  ///< disp32 positions, targets
+};
+
+#endif  // CSHORELARK_JIT_X86_64
+
+}  // namespace
+
+auto jit_kernel::is_supported() noexcept -> bool {
+#ifdef CSHORELARK_JIT_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+auto jit_kernel::compile(nonstd::span<const std::uint32_t> layer_sizes,
+                         activation_function activation, jit_weights mode,
+                         nonstd::span<const float> weights) -> tl::expected<jit_kernel, jit_error> {
+    if (!is_supported()) {
+        return tl::make_unexpected(jit_error::k_unsupported_platform);
+    }
+    if (activation != activation_function::k_relu) {
+        return tl::make_unexpected(jit_error::k_unsupported_activation);
+    }
+    if (!valid_topology(layer_sizes)) {
+        return tl::make_unexpected(jit_error::k_invalid_topology);
+    }
+    if (mode == jit_weights::k_embedded && weights.size() != weight_count(layer_sizes)) {
+        return tl::make_unexpected(jit_error::k_invalid_weights);
+    }
+
+    jit_kernel kernel;
+    kernel.layer_sizes_.assign(layer_sizes.begin(), layer_sizes.end());
+    kernel.mode_ = mode;
+    kernel.packed_size_ = packed_count(layer_sizes);
+
+    std::size_t width = 0;
+    for (std::size_t i = 1; i < layer_sizes.size(); ++i) {
+        width = std::max(width, blocks_of(layer_sizes[i]) * k_lanes);
+    }
+    kernel.scratch_size_ = 2 * width;
+    kernel.output_offset_ = ((layer_sizes.size() - 2) % 2) * width;
+
+    // Displacements are 32-bit
+    constexpr auto k_max_offset =
+        static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+    if ((kernel.packed_size_ + kernel.scratch_size_) * sizeof(float) >= k_max_offset / 2) {
+        return tl::make_unexpected(jit_error::k_invalid_topology);
+    }
+
+#ifdef CSHORELARK_JIT_X86_64
+    assembler code(mode);
+    code.register_op(k_no_prefix, k_op_xorps, k_zero_register, k_zero_register);
+
+    std::size_t layer_offset = 0;
+    for (std::size_t layer = 1; layer < layer_sizes.size(); ++layer) {
+        const std::size_t inputs = layer_sizes[layer - 1];
+        const std::size_t blocks = blocks_of(layer_sizes[layer]);
+        const std::size_t stride = block_floats(inputs);
+        const int source = layer == 1 ? k_inputs_register : k_scratch_register;
+        const std::size_t source_offset = layer == 1 ? 0 : ((layer - 2) % 2) * width;
+        const std::size_t target_offset = ((layer - 1) % 2) * width;
+
+        // As many blocks as there are accumulators share each broadcast input
+        for (std::size_t first = 0; first < blocks; first += k_accumulators) {
+            const int count = static_cast<int>(
+                std::min<std::size_t>(k_accumulators, blocks - first));
+            for (int b = 0; b < count; ++b) {
+                code.load_weights(b, layer_offset + (first + b) * stride);
+            }
+            for (std::size_t j = 0; j < inputs; ++j) {
+                const auto input = static_cast<std::int32_t>((source_offset + j) * sizeof(float));
+                code.memory_op(k_scalar_prefix, k_op_movups_load, k_input_register, source, input);
+                code.shuffle(k_input_register, k_input_register, 0x00);
+                for (int b = 0; b < count; ++b) {
+                    code.load_weights(k_product_register,
+                                      layer_offset + (first + b) * stride + (j + 1) * k_lanes);
+                    code.register_op(k_no_prefix, k_op_mulps, k_product_register,
+                                     k_input_register);
+                    code.register_op(k_no_prefix, k_op_addps, b, k_product_register);
+                }
+            }
+            for (int b = 0; b < count; ++b) {
+                // maxps returns the zero operand for NaN and -0, like std::max(0, x)
+                code.register_op(k_no_prefix, k_op_maxps, b, k_zero_register);
+                const auto target = static_cast<std::int32_t>(
+                    (target_offset + (first + b) * k_lanes) * sizeof(float));
+                code.memory_op(k_no_prefix, k_op_movups_store, b, k_scratch_register, target);
+            }
+        }
+        layer_offset += blocks * stride;
+    }
+    code.byte(k_ret);
+
+    std::vector<float> data;
+    if (mode == jit_weights::k_embedded) {
+        pack_weights(layer_sizes, weights, data);
+    }
+    const auto bytes = code.finish(data);
+
+    // Written while writable, then switched to executable
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    kernel.code_size_ = (bytes.size() + page - 1) / page * page;
+    void* memory = mmap(nullptr, kernel.code_size_, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        kernel.code_size_ = 0;
+        return tl::make_unexpected(jit_error::k_memory_error);
+    }
+    kernel.code_ = memory;
+    std::memcpy(memory, bytes.data(), bytes.size());
+    if (mprotect(memory, kernel.code_size_, PROT_READ | PROT_EXEC) != 0) {
+        return tl::make_unexpected(jit_error::k_memory_error);
+    }
+    kernel.entry_ = reinterpret_cast<entry_point>(memory);
+    return kernel;
+#else
+    static_cast<void>(weights);
+    return tl::make_unexpected(jit_error::k_unsupported_platform);
+#endif
+}
+
+auto jit_kernel::shared(nonstd::span<const std::uint32_t> layer_sizes,
+                        activation_function activation)
+    -> tl::expected<std::shared_ptr<const jit_kernel>, jit_error> {
+    using key = std::pair<std::vector<std::uint32_t>, activation_function>;
+    using result = tl::expected<std::shared_ptr<const jit_kernel>, jit_error>;
+    static std::mutex mutex;
+    static std::map<key, result> kernels;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    key wanted{{layer_sizes.begin(), layer_sizes.end()}, activation};
+    if (auto found = kernels.find(wanted); found != kernels.end()) {
+        return found->second;
+    }
+
+    // Failures are remembered too, so a topology is only ever tried once
+    auto kernel = compile(layer_sizes, activation, jit_weights::k_pointer);
+    result entry = kernel ? result(std::make_shared<const jit_kernel>(std::move(*kernel)))
+                          : result(tl::make_unexpected(kernel.error()));
+    return kernels.emplace(std::move(wanted), std::move(entry)).first->second;
+}
+
+jit_kernel::jit_kernel(jit_kernel&& other) noexcept
+    : layer_sizes_(std::move(other.layer_sizes_)),
+      mode_(other.mode_),
+      packed_size_(other.packed_size_),
+      scratch_size_(other.scratch_size_),
+      output_offset_(other.output_offset_),
+      code_(std::exchange(other.code_, nullptr)),
+      code_size_(std::exchange(other.code_size_, 0)),
+      entry_(std::exchange(other.entry_, nullptr)) {}
+
+jit_kernel& jit_kernel::operator=(jit_kernel&& other) noexcept {
+    if (this != &other) {
+        release();
+        layer_sizes_ = std::move(other.layer_sizes_);
+        mode_ = other.mode_;
+        packed_size_ = other.packed_size_;
+        scratch_size_ = other.scratch_size_;
+        output_offset_ = other.output_offset_;
+        code_ = std::exchange(other.code_, nullptr);
+        code_size_ = std::exchange(other.code_size_, 0);
+        entry_ = std::exchange(other.entry_, nullptr);
+    }
+    return *this;
+}
+
+jit_kernel::~jit_kernel() { release(); }
+
+void jit_kernel::release() noexcept {
+#ifdef CSHORELARK_JIT_X86_64
+    if (code_ != nullptr) {
+        munmap(code_, code_size_);
+    }
+#endif
+    code_ = nullptr;
+    code_size_ = 0;
+    entry_ = nullptr;
+}
+
+auto jit_kernel::pack(nonstd::span<const float> weights) const
+    -> tl::expected<std::vector<float>, jit_error> {
+    if (weights.size() != weight_count(layer_sizes_)) {
+        return tl::make_unexpected(jit_error::k_invalid_weights);
+    }
+    std::vector<float> packed;
+    pack_weights(layer_sizes_, weights, packed);
+    return packed;
+}
+
+auto jit_kernel::propagate(nonstd::span<const float> inputs, nonstd::span<const float> packed,
+                           nonstd::span<float> scratch) const
+    -> tl::expected<nonstd::span<const float>, jit_error> {
+    const std::size_t expected_packed = mode_ == jit_weights::k_pointer ? packed_size_ : 0;
+    if (entry_ == nullptr || inputs.size() != input_size() || packed.size() != expected_packed ||
+        scratch.size() < scratch_size_) {
+        return tl::make_unexpected(jit_error::k_invalid_input_size);
+    }
+    entry_(inputs.data(), packed.data(), scratch.data());
+    return nonstd::span<const float>(scratch.data() + output_offset_, output_size());
+}
+
+}  // namespace cshorelark::neural_network
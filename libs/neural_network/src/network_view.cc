@@ -0,0 +1,96 @@
+#include "neural_network/network_view.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "neural_network/layer_topology.h"
+
+namespace cshorelark::neural_network {
+
+auto network_view::weight_count(nonstd::span<const std::uint32_t> layer_sizes) noexcept
+    -> std::size_t {
+    // Sizes may come from a mapped file, so a count that wrapped around could match its weights
+    constexpr std::size_t k_max_count = std::numeric_limits<std::size_t>::max();
+    std::size_t count = 0;
+    for (std::size_t i = 0; i + 1 < layer_sizes.size(); ++i) {
+        const std::size_t inputs = static_cast<std::size_t>(layer_sizes[i]) + 1;
+        const std::size_t outputs = layer_sizes[i + 1];
+        if (outputs != 0 && inputs > k_max_count / outputs) {
+            return k_max_count;
+        }
+        const std::size_t layer_count = inputs * outputs;
+        if (layer_count > k_max_count - count) {
+            return k_max_count;
+        }
+        count += layer_count;
+    }
+    return count;
+}
+
+auto network_view::create(nonstd::span<const std::uint32_t> layer_sizes,
+                          activation_function activation, nonstd::span<const float> weights)
+    -> tl::expected<network_view, network_error> {
+    if (layer_sizes.size() < 2) {
+        return tl::make_unexpected(network_error::k_invalid_layer_count);
+    }
+    if (std::any_of(layer_sizes.begin(), layer_sizes.end(),
+                    [](std::uint32_t size) { return size == 0; })) {
+        return tl::make_unexpected(network_error::k_invalid_layer_topology);
+    }
+
+    const std::size_t expected = weight_count(layer_sizes);
+    if (expected == std::numeric_limits<std::size_t>::max()) {
+        return tl::make_unexpected(network_error::k_invalid_layer_topology);
+    }
+    if (weights.size() < expected) {
+        return tl::make_unexpected(network_error::k_not_enough_weights);
+    }
+    if (weights.size() > expected) {
+        return tl::make_unexpected(network_error::k_too_many_weights);
+    }
+    return network_view(layer_sizes, activation, weights);
+}
+
+auto network_view::propagate(nonstd::span<const float> inputs) const
+    -> tl::expected<std::vector<float>, network_error> {
+    if (inputs.size() != input_size()) {
+        return tl::make_unexpected(network_error::k_invalid_input_size);
+    }
+
+    std::vector<float> current(inputs.begin(), inputs.end());
+    std::vector<float> next;
+    const float* weight = weights_.data();
+    for (std::size_t i = 0; i + 1 < layer_sizes_.size(); ++i) {
+        const std::size_t inputs_count = layer_sizes_[i];
+        const std::size_t outputs_count = layer_sizes_[i + 1];
+        next.resize(outputs_count);
+        for (std::size_t n = 0; n < outputs_count; ++n) {
+            // Same summation order as neuron::propagate, bias first
+            float sum = *weight++;
+            for (std::size_t j = 0; j < inputs_count; ++j) {
+                sum += current[j] * weight[j];
+            }
+            weight += inputs_count;
+            next[n] = activation::apply(activation_, sum);
+        }
+        current.swap(next);
+    }
+    return current;
+}
+
+auto network_view::to_network() const -> tl::expected<network<float>, network_error> {
+    // Owning networks always apply ReLU, any other activation would compute something else
+    if (activation_ != activation_function::k_relu) {
+        return tl::make_unexpected(network_error::k_unsupported_activation);
+    }
+
+    std::vector<layer_topology> topology;
+    topology.reserve(layer_sizes_.size());
+    for (const auto size : layer_sizes_) {
+        topology.emplace_back(size);
+    }
+    return network<float>::from_weights(topology, weights_);
+}
+
+}  // namespace cshorelark::neural_network
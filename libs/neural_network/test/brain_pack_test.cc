@@ -0,0 +1,168 @@
+#include "neural_network/brain_pack.h"
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "neural_network/layer_topology.h"
+#include "neural_network/network.h"
+#include "random/random.h"
+
+using cshorelark::neural_network::activation_function;
+using cshorelark::neural_network::brain_pack;
+using cshorelark::neural_network::brain_pack_error;
+using cshorelark::neural_network::brain_pack_writer;
+using cshorelark::neural_network::layer_topology;
+using cshorelark::neural_network::network;
+using cshorelark::random::random_generator;
+
+namespace {
+
+constexpr std::uint64_t k_test_seed = 7;
+constexpr std::size_t k_test_network_count = 25;
+
+// Pack file in the temp directory, removed when the test ends
+class temp_pack {
+public:
+    explicit temp_pack(const char* name)
+        : path_(std::filesystem::temp_directory_path() / name) {}
+    temp_pack(const temp_pack&) = delete;
+    temp_pack& operator=(const temp_pack&) = delete;
+    ~temp_pack() {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+
+    [[nodiscard]] auto path() const -> const std::filesystem::path& { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+auto read_bytes(const std::filesystem::path& path) -> std::vector<char> {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+void write_bytes(const std::filesystem::path& path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+}  // namespace
+
+TEST_CASE("Brain pack - Round trip of many networks", "[brain_pack]") {
+    const temp_pack pack_file("cshorelark_round_trip.bpack");
+    random_generator random(k_test_seed);
+
+    std::vector<network<float>> networks;
+    brain_pack_writer writer;
+    for (std::size_t i = 0; i < k_test_network_count; ++i) {
+        // Vary the hidden layer so entries have different sizes
+        const std::array<layer_topology, 3> topology = {layer_topology{9},
+                                                        layer_topology{1 + i % 6},
+                                                        layer_topology{2}};
+        auto net = network<float>::random(topology, random);
+        REQUIRE(net.has_value());
+        auto index = writer.add(*net);
+        REQUIRE(index.has_value());
+        REQUIRE(*index == i);
+        networks.push_back(std::move(*net));
+    }
+    REQUIRE(writer.write(pack_file.path()).has_value());
+
+    auto pack = brain_pack::open(pack_file.path());
+    REQUIRE(pack.has_value());
+    REQUIRE(pack->size() == k_test_network_count);
+
+    const std::vector<float> inputs = {0.0F, 0.2F, 0.0F, 0.9F, 0.1F, 0.0F, 0.5F, 0.3F, 0.0F};
+    for (std::size_t i = 0; i < networks.size(); ++i) {
+        auto view = pack->view(i);
+        REQUIRE(view.has_value());
+        REQUIRE(view->activation() == activation_function::k_relu);
+        REQUIRE(view->layer_sizes().size() == 3);
+        REQUIRE(view->layer_sizes()[1] == 1 + i % 6);
+
+        // Weights are read in place and aligned for vector loads
+        const auto address = reinterpret_cast<std::uintptr_t>(view->weights().data());
+        REQUIRE(address % 64 == 0);
+
+        const auto weights = networks[i].weights();
+        REQUIRE(std::vector<float>(view->weights().begin(), view->weights().end()) == weights);
+        REQUIRE(*view->propagate(inputs) == *networks[i].propagate(inputs));
+    }
+
+    auto missing = pack->view(k_test_network_count);
+    REQUIRE_FALSE(missing.has_value());
+    REQUIRE(missing.error() == brain_pack_error::k_index_out_of_range);
+}
+
+TEST_CASE("Brain pack - Rejects invalid files", "[brain_pack]") {
+    const temp_pack pack_file("cshorelark_invalid.bpack");
+    const std::array<std::uint32_t, 2> layers = {2, 1};
+    const std::array<float, 3> weights = {0.1F, 0.2F, 0.3F};
+
+    brain_pack_writer writer;
+    REQUIRE(writer.add(layers, activation_function::k_tanh, weights).has_value());
+    REQUIRE(writer.write(pack_file.path()).has_value());
+    const auto valid = read_bytes(pack_file.path());
+
+    SECTION("Networks whose weights do not match their topology are not added") {
+        const std::array<float, 2> short_weights = {0.1F, 0.2F};
+        auto result = writer.add(layers, activation_function::k_relu, short_weights);
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == brain_pack_error::k_invalid_network);
+    }
+
+    SECTION("Missing file") {
+        auto pack = brain_pack::open(pack_file.path().string() + ".missing");
+        REQUIRE_FALSE(pack.has_value());
+        REQUIRE(pack.error() == brain_pack_error::k_io_error);
+    }
+
+    SECTION("Wrong magic") {
+        auto bytes = valid;
+        bytes[0] = 'X';
+        write_bytes(pack_file.path(), bytes);
+        auto pack = brain_pack::open(pack_file.path());
+        REQUIRE_FALSE(pack.has_value());
+        REQUIRE(pack.error() == brain_pack_error::k_bad_magic);
+    }
+
+    SECTION("Unsupported version") {
+        auto bytes = valid;
+        bytes[8] = static_cast<char>(brain_pack::k_version + 1);
+        write_bytes(pack_file.path(), bytes);
+        auto pack = brain_pack::open(pack_file.path());
+        REQUIRE_FALSE(pack.has_value());
+        REQUIRE(pack.error() == brain_pack_error::k_unsupported_version);
+    }
+
+    SECTION("Truncated index") {
+        auto bytes = valid;
+        bytes.resize(bytes.size() - 8);
+        write_bytes(pack_file.path(), bytes);
+        auto pack = brain_pack::open(pack_file.path());
+        REQUIRE_FALSE(pack.has_value());
+        REQUIRE(pack.error() == brain_pack_error::k_corrupt);
+    }
+
+    SECTION("Empty file") {
+        write_bytes(pack_file.path(), {});
+        auto pack = brain_pack::open(pack_file.path());
+        REQUIRE_FALSE(pack.has_value());
+        REQUIRE(pack.error() == brain_pack_error::k_corrupt);
+    }
+
+    SECTION("Valid file keeps its activation tag") {
+        auto pack = brain_pack::open(pack_file.path());
+        REQUIRE(pack.has_value());
+        auto view = pack->view(0);
+        REQUIRE(view.has_value());
+        REQUIRE(view->activation() == activation_function::k_tanh);
+    }
+}
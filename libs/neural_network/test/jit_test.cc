@@ -0,0 +1,169 @@
+#include "neural_network/jit.h"
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "neural_network/layer_topology.h"
+#include "neural_network/network.h"
+#include "random/random.h"
+
+using cshorelark::neural_network::activation_function;
+using cshorelark::neural_network::jit_error;
+using cshorelark::neural_network::jit_kernel;
+using cshorelark::neural_network::jit_weights;
+using cshorelark::neural_network::layer_topology;
+using cshorelark::neural_network::network;
+using cshorelark::random::random_generator;
+
+namespace {
+
+constexpr std::uint64_t k_test_seed = 11;
+constexpr std::size_t k_test_input_count = 20;
+
+auto same_bits(nonstd::span<const float> lhs, const std::vector<float>& rhs) -> bool {
+    return lhs.size() == rhs.size() &&
+           std::memcmp(lhs.data(), rhs.data(), rhs.size() * sizeof(float)) == 0;
+}
+
+}  // namespace
+
+TEST_CASE("JIT - Outputs match the generic network bit for bit", "[jit]") {
+    if (!jit_kernel::is_supported()) {
+        return;  // No code generator for this platform
+    }
+    random_generator random(k_test_seed);
+
+    // Odd widths leave partial blocks, 60 neurons need more blocks than accumulators
+    const std::vector<std::vector<std::uint32_t>> shapes = {
+        {9, 9, 2}, {1, 1}, {5, 3}, {9, 60, 7, 2}, {13, 17, 4, 3, 1}};
+    for (const auto& shape : shapes) {
+        std::vector<layer_topology> topology;
+        for (const auto size : shape) {
+            topology.emplace_back(size);
+        }
+        auto net = network<float>::random(topology, random);
+        REQUIRE(net.has_value());
+        const auto weights = net->weights();
+
+        auto pointer = jit_kernel::compile(shape, activation_function::k_relu,
+                                           jit_weights::k_pointer);
+        REQUIRE(pointer.has_value());
+        auto embedded = jit_kernel::compile(shape, activation_function::k_relu,
+                                            jit_weights::k_embedded, weights);
+        REQUIRE(embedded.has_value());
+        auto packed = pointer->pack(weights);
+        REQUIRE(packed.has_value());
+        REQUIRE(packed->size() == pointer->packed_size());
+
+        std::vector<float> scratch(pointer->scratch_size());
+        std::vector<float> inputs(shape.front());
+        for (std::size_t round = 0; round < k_test_input_count; ++round) {
+            for (auto& input : inputs) {
+                input = random.generate_in_range(-1.0F, 1.0F);
+            }
+            const auto expected = net->propagate(inputs);
+            REQUIRE(expected.has_value());
+
+            auto from_pointer = pointer->propagate(inputs, *packed, scratch);
+            REQUIRE(from_pointer.has_value());
+            CHECK(same_bits(*from_pointer, *expected));
+
+            auto from_embedded = embedded->propagate(inputs, {}, scratch);
+            REQUIRE(from_embedded.has_value());
+            CHECK(same_bits(*from_embedded, *expected));
+        }
+    }
+}
+
+TEST_CASE("JIT - Shared kernels are generated once per topology", "[jit]") {
+    const std::array<std::uint32_t, 3> shape = {4, 6, 2};
+    auto first = jit_kernel::shared(shape, activation_function::k_relu);
+    auto second = jit_kernel::shared(shape, activation_function::k_relu);
+    if (!jit_kernel::is_supported()) {
+        REQUIRE_FALSE(first.has_value());
+        REQUIRE(first.error() == jit_error::k_unsupported_platform);
+        return;
+    }
+    REQUIRE(first.has_value());
+    REQUIRE(second.has_value());
+    CHECK(first->get() == second->get());
+    CHECK((*first)->mode() == jit_weights::k_pointer);
+    CHECK((*first)->input_size() == 4);
+    CHECK((*first)->output_size() == 2);
+    // Two blocks of 4 neurons with 4 inputs, then one block with 6 inputs
+    CHECK((*first)->packed_size() == 2 * 4 * 5 + 4 * 7);
+}
+
+TEST_CASE("JIT - Error handling", "[jit]") {
+    if (!jit_kernel::is_supported()) {
+        return;  // No code generator for this platform
+    }
+    const std::array<std::uint32_t, 2> shape = {2, 1};
+
+    SECTION("Only ReLU is generated") {
+        auto kernel =
+            jit_kernel::compile(shape, activation_function::k_tanh, jit_weights::k_pointer);
+        REQUIRE_FALSE(kernel.has_value());
+        CHECK(kernel.error() == jit_error::k_unsupported_activation);
+    }
+
+    SECTION("Invalid topologies") {
+        const std::array<std::uint32_t, 1> single = {2};
+        const std::array<std::uint32_t, 3> empty_layer = {2, 0, 1};
+        CHECK(jit_kernel::compile(single, activation_function::k_relu, jit_weights::k_pointer)
+                  .error() == jit_error::k_invalid_topology);
+        CHECK(jit_kernel::compile(empty_layer, activation_function::k_relu,
+                                  jit_weights::k_pointer)
+                  .error() == jit_error::k_invalid_topology);
+    }
+
+    SECTION("Weights must match the topology") {
+        const std::array<float, 2> weights = {0.1F, 0.2F};
+        CHECK(jit_kernel::compile(shape, activation_function::k_relu, jit_weights::k_embedded,
+                                  weights)
+                  .error() == jit_error::k_invalid_weights);
+        auto kernel =
+            jit_kernel::compile(shape, activation_function::k_relu, jit_weights::k_pointer);
+        REQUIRE(kernel.has_value());
+        CHECK(kernel->pack(weights).error() == jit_error::k_invalid_weights);
+    }
+
+    SECTION("Inputs, packed weights and scratch are checked") {
+        auto kernel =
+            jit_kernel::compile(shape, activation_function::k_relu, jit_weights::k_pointer);
+        REQUIRE(kernel.has_value());
+        const std::array<float, 3> weights = {0.5F, 1.0F, -1.0F};
+        const auto packed = kernel->pack(weights);
+        REQUIRE(packed.has_value());
+        std::vector<float> scratch(kernel->scratch_size());
+        const std::array<float, 2> inputs = {3.0F, 1.0F};
+        const std::array<float, 3> too_many = {3.0F, 1.0F, 0.0F};
+
+        CHECK(kernel->propagate(too_many, *packed, scratch).error() ==
+              jit_error::k_invalid_input_size);
+        CHECK(kernel->propagate(inputs, {}, scratch).error() == jit_error::k_invalid_input_size);
+        CHECK(kernel->propagate(inputs, *packed, {}).error() == jit_error::k_invalid_input_size);
+
+        auto outputs = kernel->propagate(inputs, *packed, scratch);
+        REQUIRE(outputs.has_value());
+        REQUIRE(outputs->size() == 1);
+        CHECK((*outputs)[0] == 2.5F);
+    }
+
+    SECTION("NaN and negative sums clamp to zero like the generic path") {
+        const std::array<float, 3> weights = {0.0F, 1.0F, 1.0F};
+        auto kernel = jit_kernel::compile(shape, activation_function::k_relu,
+                                          jit_weights::k_embedded, weights);
+        REQUIRE(kernel.has_value());
+        std::vector<float> scratch(kernel->scratch_size());
+        const std::array<float, 2> nan_inputs = {std::numeric_limits<float>::quiet_NaN(), 1.0F};
+        const std::array<float, 2> negative_inputs = {-3.0F, 1.0F};
+        CHECK((*kernel->propagate(nan_inputs, {}, scratch))[0] == 0.0F);
+        CHECK((*kernel->propagate(negative_inputs, {}, scratch))[0] == 0.0F);
+    }
+}
@@ -0,0 +1,96 @@
+#include "neural_network/network_view.h"
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "neural_network/layer_topology.h"
+#include "neural_network/network.h"
+#include "random/random.h"
+
+using cshorelark::neural_network::activation_function;
+using cshorelark::neural_network::layer_topology;
+using cshorelark::neural_network::network;
+using cshorelark::neural_network::network_error;
+using cshorelark::neural_network::network_view;
+using cshorelark::random::random_generator;
+
+namespace {
+constexpr std::uint64_t k_test_seed = 42;
+const std::array<std::uint32_t, 3> k_test_layers = {4, 3, 2};
+}  // namespace
+
+TEST_CASE("Network view - Matches the owning network", "[network_view]") {
+    random_generator random(k_test_seed);
+    const std::array<layer_topology, 3> topology = {layer_topology{4}, layer_topology{3},
+                                                    layer_topology{2}};
+    auto net = network<float>::random(topology, random);
+    REQUIRE(net.has_value());
+    const auto weights = net->weights();
+
+    auto view = network_view::create(k_test_layers, activation_function::k_relu, weights);
+    REQUIRE(view.has_value());
+    REQUIRE(view->input_size() == 4);
+    REQUIRE(view->output_size() == 2);
+    REQUIRE(view->weights().data() == weights.data());
+
+    const std::vector<float> inputs = {0.1F, -0.4F, 0.7F, 1.0F};
+    auto expected = net->propagate(inputs);
+    auto actual = view->propagate(inputs);
+    REQUIRE(expected.has_value());
+    REQUIRE(actual.has_value());
+    REQUIRE(*actual == *expected);
+
+    auto copy = view->to_network();
+    REQUIRE(copy.has_value());
+    REQUIRE(copy->weights() == weights);
+}
+
+TEST_CASE("Network view - Only ReLU views convert to a network", "[network_view]") {
+    std::vector<float> weights(network_view::weight_count(k_test_layers), 0.5F);
+    for (const auto activation : {activation_function::k_sigmoid, activation_function::k_tanh}) {
+        auto view = network_view::create(k_test_layers, activation, weights);
+        REQUIRE(view.has_value());
+        auto copy = view->to_network();
+        REQUIRE_FALSE(copy.has_value());
+        REQUIRE(copy.error() == network_error::k_unsupported_activation);
+    }
+}
+
+TEST_CASE("Network view - Rejects mismatched weights and inputs", "[network_view]") {
+    const std::size_t count = network_view::weight_count(k_test_layers);
+    REQUIRE(count == (4 + 1) * 3 + (3 + 1) * 2);
+
+    std::vector<float> weights(count - 1, 0.5F);
+    auto too_few = network_view::create(k_test_layers, activation_function::k_relu, weights);
+    REQUIRE_FALSE(too_few.has_value());
+    REQUIRE(too_few.error() == network_error::k_not_enough_weights);
+
+    weights.resize(count + 1, 0.5F);
+    auto too_many = network_view::create(k_test_layers, activation_function::k_relu, weights);
+    REQUIRE_FALSE(too_many.has_value());
+    REQUIRE(too_many.error() == network_error::k_too_many_weights);
+
+    weights.resize(count);
+    auto view = network_view::create(k_test_layers, activation_function::k_relu, weights);
+    REQUIRE(view.has_value());
+    const std::vector<float> short_input = {1.0F};
+    auto result = view->propagate(short_input);
+    REQUIRE_FALSE(result.has_value());
+    REQUIRE(result.error() == network_error::k_invalid_input_size);
+}
+
+TEST_CASE("Network view - Rejects topologies whose weight count overflows", "[network_view]") {
+    // Without overflow checks the count wraps around to 2, the size of the weights given
+    constexpr std::uint32_t k_huge = std::numeric_limits<std::uint32_t>::max();
+    const std::array<std::uint32_t, 4> layers = {k_huge, k_huge, 1, 1};
+    REQUIRE(network_view::weight_count(layers) == std::numeric_limits<std::size_t>::max());
+
+    const std::vector<float> weights(2, 0.5F);
+    auto view = network_view::create(layers, activation_function::k_relu, weights);
+    REQUIRE_FALSE(view.has_value());
+    REQUIRE(view.error() == network_error::k_invalid_layer_topology);
+}
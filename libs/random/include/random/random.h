@@ -6,6 +6,7 @@
  * @brief Random number generation utilities for neural networks
  */
 
+#include <cstddef>
 #include <cstdint>
 #include <random>
 #include <stdexcept>
@@ -77,12 +78,48 @@ public:
         return generate_position() * (max - min) + min;
     }
 
+    /**
+     * @brief Generates a normally distributed value
+     * @param mean Mean of the distribution
+     * @param stddev Standard deviation of the distribution
+     * @return Random value from N(mean, stddev^2)
+     *
+     * @details Uses a 128-layer ziggurat, which needs a single engine draw for
+     * about 99% of the values; the rest take a few more.
+     */
+    [[nodiscard]] auto generate_normal(float mean = 0.0F, float stddev = 1.0F) -> float {
+        return mean + stddev * static_cast<float>(standard_normal());
+    }
+
+    /**
+     * @brief Fills a buffer with normally distributed values
+     * @param values First value to fill
+     * @param count Number of values to fill
+     * @param mean Mean of the distribution
+     * @param stddev Standard deviation of the distribution
+     *
+     * @details Gives the same values as calling generate_normal() count times.
+     */
+    void fill_normal(float* values, std::size_t count, float mean = 0.0F, float stddev = 1.0F);
+
     /**
      * @brief Gets the underlying random number generator
      * @return Reference to the random number generator
      */
     [[nodiscard]] auto get_engine() -> std::mt19937_64& { return generator_; }
 
+    /**
+     * @brief Identifies the position in the random sequence without advancing it
+     * @return The next value the engine would produce
+     *
+     * @details Two generators at the same position of the same sequence give the
+     * same fingerprint; copies the engine state, about 2.5 KiB.
+     */
+    [[nodiscard]] auto fingerprint() const -> std::uint64_t {
+        auto engine = generator_;
+        return engine();
+    }
+
     /**
      * @brief Seeds the random number generator
      * @param seed Seed value to use
@@ -90,11 +127,35 @@ public:
     void seed(std::uint64_t seed) { generator_.seed(seed); }
 
 private:
+    /**
+     * @brief Draws a value from N(0, 1)
+     */
+    [[nodiscard]] auto standard_normal() -> double;
+
     std::mt19937_64 generator_;
     std::uniform_real_distribution<float> default_distribution_ =
         std::uniform_real_distribution<float>(-1.0F, 1.0F);
 };
 
+/**
+ * @brief Derives an independent seed for one stream of a seeded computation
+ *
+ * Mixes the base seed and the stream index with the SplitMix64 finalizer, so
+ * neighbouring streams (episodes, work units, ...) start from unrelated
+ * generator states and the result depends only on the two inputs.
+ *
+ * @param seed Base seed
+ * @param stream Stream index
+ * @return Seed for the stream
+ */
+[[nodiscard]] constexpr auto derive_seed(std::uint64_t seed, std::uint64_t stream) noexcept
+    -> std::uint64_t {
+    std::uint64_t value = seed + 0x9E3779B97F4A7C15ULL * (stream + 1);
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
 }  // namespace cshorelark::random
 
 #endif  // CSHORELARK_NEURAL_NETWORK_RANDOM_H_
\ No newline at end of file
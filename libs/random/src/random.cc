@@ -0,0 +1,90 @@
+#include "random/random.h"
+
+#include <array>
+#include <cmath>
+
+namespace cshorelark::random {
+
+namespace {
+
+// Ziggurat of Marsaglia and Tsang with the refinements of Doornik (2005)
+constexpr std::size_t k_layers = 128;
+constexpr double k_tail_start = 3.442619855899;       // Right edge of the bottom layer
+constexpr double k_layer_area = 9.91256303526217e-3;  // Area of every layer
+constexpr double k_unit_scale = 1.0 / 9007199254740992.0;  // 2^-53
+
+auto density(double x) -> double { return std::exp(-0.5 * x * x); }
+
+/**
+ * @brief Layer edges and the share of each layer inside the next one
+ */
+struct ziggurat_tables {
+    std::array<double, k_layers + 1> edge{};
+    std::array<double, k_layers> inner_ratio{};
+
+    ziggurat_tables() {
+        edge[0] = k_layer_area / density(k_tail_start);
+        edge[1] = k_tail_start;
+        for (std::size_t i = 2; i < k_layers; ++i) {
+            edge[i] = std::sqrt(-2.0 * std::log(k_layer_area / edge[i - 1] + density(edge[i - 1])));
+        }
+        edge[k_layers] = 0.0;
+        for (std::size_t i = 0; i < k_layers; ++i) {
+            inner_ratio[i] = edge[i + 1] / edge[i];
+        }
+    }
+};
+
+auto tables() -> const ziggurat_tables& {
+    static const ziggurat_tables instance;
+    return instance;
+}
+
+// Uniform in (0, 1) from the top 53 bits of a draw, never 0 so its log is finite
+auto open_unit(std::uint64_t bits) -> double {
+    return (static_cast<double>(bits >> 11U) + 0.5) * k_unit_scale;
+}
+
+}  // namespace
+
+auto random_generator::standard_normal() -> double {
+    const auto& zig = tables();
+    for (;;) {
+        // The low bits pick the layer, the high bits the signed position in it
+        const std::uint64_t bits = generator_();
+        const std::size_t layer = bits & (k_layers - 1);
+        const double u = 2.0 * open_unit(bits) - 1.0;
+
+        // Inside the rectangle every layer shares with the one above it
+        if (std::abs(u) < zig.inner_ratio[layer]) {
+            return u * zig.edge[layer];
+        }
+
+        if (layer == 0) {
+            // Bottom layer beyond the rectangle: sample the tail past k_tail_start
+            double x = 0.0;
+            double y = 0.0;
+            do {
+                x = std::log(open_unit(generator_())) / k_tail_start;
+                y = std::log(open_unit(generator_()));
+            } while (-2.0 * y < x * x);
+            return u > 0.0 ? k_tail_start - x : x - k_tail_start;
+        }
+
+        // Wedge between the rectangle and the curve
+        const double x = u * zig.edge[layer];
+        const double outer = density(zig.edge[layer]);
+        const double inner = density(zig.edge[layer + 1]);
+        if (outer + open_unit(generator_()) * (inner - outer) < density(x)) {
+            return x;
+        }
+    }
+}
+
+void random_generator::fill_normal(float* values, std::size_t count, float mean, float stddev) {
+    for (std::size_t i = 0; i < count; ++i) {
+        values[i] = mean + stddev * static_cast<float>(standard_normal());
+    }
+}
+
+}  // namespace cshorelark::random
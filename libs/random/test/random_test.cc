@@ -158,4 +158,74 @@ TEST_CASE("RandomGenerator methods", "[random]") {
         // Should match the direct value
         CHECK_THAT(weight, WithinRel(direct_value));
     }
-}
\ No newline at end of file
+
+    SECTION("fingerprint follows the position without advancing it") {
+        random_generator first(7);
+        random_generator second(7);
+        CHECK(first.fingerprint() == first.fingerprint());
+        CHECK(first.fingerprint() == second.fingerprint());
+        (void)first.generate_weight();
+        CHECK(first.fingerprint() != second.fingerprint());
+        (void)second.generate_weight();
+        CHECK(first.fingerprint() == second.fingerprint());
+    }
+}
+TEST_CASE("derive_seed", "[random]") {
+    SECTION("is a pure function of seed and stream") {
+        CHECK(derive_seed(42, 7) == derive_seed(42, 7));
+        static_assert(derive_seed(1, 2) == derive_seed(1, 2), "derive_seed is constexpr");
+    }
+
+    SECTION("separates streams and base seeds") {
+        CHECK(derive_seed(42, 0) != derive_seed(42, 1));
+        CHECK(derive_seed(42, 0) != derive_seed(43, 0));
+        // Adjacent (seed, stream) pairs must not collide diagonally
+        CHECK(derive_seed(0, 1) != derive_seed(1, 0));
+    }
+}
+
+TEST_CASE("Normal sampling", "[random]") {
+    constexpr std::size_t k_samples = 200000;
+    random_generator gen(7);
+
+    SECTION("matches the moments and tails of N(0, 1)") {
+        std::vector<float> values(k_samples);
+        gen.fill_normal(values.data(), values.size());
+
+        double sum = 0.0;
+        double sq_sum = 0.0;
+        std::size_t within_one = 0;
+        std::size_t beyond_three = 0;
+        for (const float value : values) {
+            sum += value;
+            sq_sum += static_cast<double>(value) * value;
+            within_one += std::abs(value) < 1.0F ? 1 : 0;
+            beyond_three += std::abs(value) > 3.0F ? 1 : 0;
+        }
+        const double mean = sum / k_samples;
+        const double variance = sq_sum / k_samples - mean * mean;
+        CHECK(std::abs(mean) < 0.01);
+        CHECK_THAT(variance, WithinRel(1.0, 0.02));
+        CHECK_THAT(static_cast<double>(within_one) / k_samples, WithinRel(0.6827, 0.01));
+        // The bottom layer's tail starts at 3.44, so values past 3 come from both paths
+        CHECK_THAT(static_cast<double>(beyond_three) / k_samples, WithinRel(0.0027, 0.15));
+    }
+
+    SECTION("scales by mean and standard deviation") {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < k_samples; ++i) {
+            sum += gen.generate_normal(5.0F, 0.5F);
+        }
+        CHECK_THAT(sum / k_samples, WithinRel(5.0, 0.01));
+    }
+
+    SECTION("bulk fill gives the same values as single draws") {
+        random_generator single(11);
+        random_generator bulk(11);
+        std::array<float, 64> values{};
+        bulk.fill_normal(values.data(), values.size());
+        for (const float value : values) {
+            CHECK(value == single.generate_normal());
+        }
+    }
+}
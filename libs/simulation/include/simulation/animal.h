@@ -68,6 +68,12 @@ public:
      */
     [[nodiscard]] auto vision() const noexcept -> const std::vector<float>& { return vision_; }
 
+    /**
+     * @brief Gets the animal's brain
+     * @return Reference to the brain
+     */
+    [[nodiscard]] auto get_brain() const noexcept -> const brain& { return brain_; }
+
     /**
      * @brief Get the amount of food eaten
      * @return Food eaten count
@@ -88,6 +94,12 @@ public:
     [[nodiscard]] static auto random(const config& config,
                                      cshorelark::random::random_generator& random) -> animal;
 
+    /**
+     * @brief Creates a copy of the animal whose brain shares this animal's network
+     * @return Animal with the same position, heading, speed, vision and food eaten
+     */
+    [[nodiscard]] auto fork() const -> animal;
+
     /**
      * @brief Creates an animal from a chromosome
      *
@@ -114,6 +126,15 @@ public:
      */
     void process_brain(const config& config, nonstd::span<const food> foods);
 
+    /**
+     * @brief Process brain outputs seeing only some of the foods
+     * @param config Configuration settings
+     * @param foods Collection of food items in the world
+     * @param nearby Ascending indices of the foods that may be within the eye's range
+     */
+    void process_brain(const config& config, nonstd::span<const food> foods,
+                       nonstd::span<const std::size_t> nearby);
+
     /**
      * @brief Process the animal's movement based on speed and rotation
      */
@@ -130,7 +151,17 @@ private:
 
     animal(const config& config, cshorelark::random::random_generator& random, brain brain);
 
+    /**
+     * @brief Copies the state of another animal around the given brain
+     */
+    animal(const animal& other, brain brain);
+
     void set_position(const float& pos_x, const float& pos_y) noexcept;
+
+    /**
+     * @brief Feeds the current vision to the brain and applies its outputs
+     */
+    void think(const config& config);
 };
 
 }  // namespace cshorelark::simulation
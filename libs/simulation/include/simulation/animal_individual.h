@@ -3,7 +3,9 @@
 
 // C++ system headers
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <tl/expected.hpp>
 
 // Project headers
@@ -38,6 +40,12 @@ public:
 
     [[nodiscard]] auto get_chromosome() const noexcept -> const genetic::chromosome& override;
     [[nodiscard]] auto get_fitness() const noexcept -> float override;
+    /**
+     * @brief Gets the food eaten, which lets evolution count instead of sort
+     * @return Food eaten, or nullopt if it does not fit 32 bits
+     */
+    [[nodiscard]] auto get_integer_fitness() const noexcept
+        -> std::optional<std::uint32_t> override;
     /**
      * @brief Inverts the food eaten counter
      * @param max_value Maximum value for the food eaten counter
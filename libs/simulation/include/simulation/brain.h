@@ -4,7 +4,9 @@
 // C++ system headers
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 // Third-party headers
@@ -13,6 +15,7 @@
 
 // Project headers
 #include "genetic_algorithm/chromosome.h"
+#include "neural_network/jit.h"
 #include "neural_network/layer_topology.h"
 #include "neural_network/network.h"
 #include "random/random.h"
@@ -21,11 +24,54 @@
 
 namespace cshorelark::simulation {
 
+/**
+ * @brief Counters of the brain output caches
+ */
+struct brain_cache_stats {
+    std::uint64_t zero_hits = 0;    ///< Propagations answered by the zero-input response
+    std::uint64_t repeat_hits = 0;  ///< Propagations answered by the last-input cache
+    std::uint64_t misses = 0;       ///< Propagations that ran the network
+
+    /**
+     * @brief Gets the number of propagations answered from a cache
+     */
+    [[nodiscard]] auto hits() const noexcept -> std::uint64_t { return zero_hits + repeat_hits; }
+
+    /**
+     * @brief Gets the share of propagations answered from a cache
+     * @return Hit rate in [0, 1], 0 when nothing was propagated
+     */
+    [[nodiscard]] auto hit_rate() const noexcept -> float {
+        const std::uint64_t total = hits() + misses;
+        return total == 0 ? 0.0F : static_cast<float>(hits()) / static_cast<float>(total);
+    }
+
+    auto operator+=(const brain_cache_stats& other) noexcept -> brain_cache_stats& {
+        zero_hits += other.zero_hits;
+        repeat_hits += other.repeat_hits;
+        misses += other.misses;
+        return *this;
+    }
+};
+
 /**
  * @brief Brain class for controlling animal behavior
  *
  * The brain class uses a neural network to process sensory inputs and
  * produce movement outputs for an animal in the simulation.
+ *
+ * The response to an all-zero vision, what an animal sees with no food in
+ * range, is computed once when the brain is built. When enabled in the
+ * configuration the last input and output are also kept, so a vision that
+ * did not change since the previous step skips the network.
+ *
+ * With a generated inference kernel selected in the configuration, misses run
+ * the kernel instead of the network; brains the kernel cannot serve keep the
+ * generic path. Verification runs both and drops the kernel on the first
+ * output that differs.
+ *
+ * The network and packed kernel weights never change once the brain is built,
+ * so forks of a brain share them and only copy the small per-brain caches.
  */
 class brain {
 public:
@@ -37,9 +83,8 @@ public:
     explicit brain(const config& config, neural_network::network<float>&& network);
 
     /**
-     * @brief Brain is non-copyable because it contains a network which is non-copyable
+     * @brief Brain is only copied through fork(), so sharing the network stays explicit
      */
-    brain(const brain&) = delete;
     brain& operator=(const brain&) = delete;
 
     /**
@@ -56,6 +101,14 @@ public:
     [[nodiscard]] static auto random(const config& config,
                                      cshorelark::random::random_generator& random) -> brain;
 
+    /**
+     * @brief Creates a brain sharing this brain's network and kernel weights
+     *
+     * The fork starts with a copy of the caches and counters and updates them on
+     * its own, so a brain and its forks may propagate from different threads.
+     */
+    [[nodiscard]] auto fork() const -> brain;
+
     /**
      * @brief Processes inputs to produce behavior outputs
      * @param inputs Sensory inputs from the animal's environment
@@ -64,6 +117,13 @@ public:
     [[nodiscard]] auto propagate(nonstd::span<const float> vision) const
         -> tl::expected<std::vector<float>, simulation_error>;
 
+    /**
+     * @brief Gets the cache counters accumulated since the brain was built
+     */
+    [[nodiscard]] auto cache_stats() const noexcept -> const brain_cache_stats& {
+        return cache_stats_;
+    }
+
     /**
      * @brief Gets the neural network weights
      * @return Vector of neural network weights
@@ -97,6 +157,25 @@ public:
                                               const genetic::chromosome& chromosome)
         -> tl::expected<brain, simulation_error>;
 
+    /**
+     * @brief Fits a chromosome of another brain size to the configured brain
+     *
+     * Weights of the eye cells and hidden neurons both brains have are kept.
+     * Missing ones are added with zero weights and bias, so they contribute
+     * nothing, and surplus ones are dropped. A brain that only grew therefore
+     * behaves exactly like the one the chromosome came from.
+     *
+     * @param chromosome Weights of a brain with num_cells inputs and num_neurons hidden neurons
+     * @param num_cells Eye cells of the chromosome's brain
+     * @param num_neurons Hidden neurons of the chromosome's brain
+     * @param config Configuration of the brain to fit
+     * @return Chromosome with the configured brain's size, or k_invalid_chromosome
+     */
+    [[nodiscard]] static auto adapt_chromosome(const genetic::chromosome& chromosome,
+                                               std::size_t num_cells, std::size_t num_neurons,
+                                               const config& config)
+        -> tl::expected<genetic::chromosome, simulation_error>;
+
     /**
      * @brief Creates a network topology based on configuration
      * @param config Brain configuration
@@ -106,11 +185,56 @@ public:
         -> std::array<neural_network::layer_topology, 3>;
 
 private:
+    using output = std::array<float, 2>;
+
     float speed_accel_;
     float rotation_accel_;
-    neural_network::network<float> network_;
+    std::shared_ptr<const neural_network::network<float>> network_;  ///< Shared with forks
+
+    bool has_zero_output_ = false;  ///< False if the network rejected the zero input
+    output zero_output_{};
+    bool cache_last_input_ = false;
+    mutable bool has_last_output_ = false;
+    mutable std::vector<float> last_input_;
+    mutable output last_output_{};
+    mutable brain_cache_stats cache_stats_;
+
+    mutable std::shared_ptr<const neural_network::jit_kernel> jit_;  ///< Null for generic
+    std::shared_ptr<const std::vector<float>> jit_weights_;  ///< Null for embedded kernels
+    mutable std::vector<float> jit_scratch_;  ///< Kernel working memory
+    bool verify_inference_ = false;
 
     brain(const config& config, cshorelark::random::random_generator& random);
+
+    brain(const brain&) = default;
+
+    /**
+     * @brief Sets up the generated inference kernel selected in the configuration
+     */
+    void init_jit(const config& config);
+
+    /**
+     * @brief Computes the zero-input response
+     */
+    void init_zero_output();
+
+    /**
+     * @brief Runs the generated kernel
+     * @return Raw network response, or nothing if the generic path has to answer
+     */
+    [[nodiscard]] auto propagate_jit(nonstd::span<const float> vision) const
+        -> std::optional<output>;
+
+    /**
+     * @brief Maps a raw network response to speed and rotation
+     */
+    [[nodiscard]] auto to_output(float response0, float response1) const -> output;
+
+    /**
+     * @brief Runs the network and maps its response to speed and rotation
+     */
+    [[nodiscard]] auto evaluate(nonstd::span<const float> vision) const
+        -> tl::expected<output, simulation_error>;
 };
 
 }  // namespace cshorelark::simulation
@@ -29,6 +29,7 @@ struct brain_eye_config {
     float fov_angle_deg = 225.0F;  ///< Field of view angle in degrees
     std::size_t num_cells = 9;     ///< Number of "photoreceptors"
     std::size_t num_neurons = 9;   ///< Brain neurons
+    bool cache_last_input = true;  ///< Skip inference when the vision did not change
 };
 
 /**
@@ -52,6 +53,44 @@ struct genetic_config {
     bool reverse = false;           ///< Whether to reverse the selection process
 };
 
+/**
+ * @brief Implementation of the animal-food collision pass
+ */
+enum class collision_kernel {
+    k_brute_force,  ///< Every animal against every food
+    k_grid          ///< Animals against the foods of nearby cells of a uniform grid
+};
+
+/**
+ * @brief Implementation of the vision pass
+ */
+enum class vision_kernel {
+    k_brute_force,  ///< Every eye scans every food
+    k_grid          ///< Eyes scan the foods of grid cells within their range
+};
+
+/**
+ * @brief Implementation of brain inference
+ */
+enum class inference_kernel {
+    k_generic,      ///< The network's own layer by layer propagation
+    k_jit,          ///< Generated code shared by all brains, weights read from memory
+    k_jit_embedded  ///< Generated code per brain with the weights stored in the code
+};
+
+/**
+ * @brief Implementations of the simulation hot paths
+ *
+ * Every combination gives bit-identical results; only speed differs, which
+ * depends on the world size, the field of view range and the brain width.
+ */
+struct kernel_config {
+    collision_kernel collisions = collision_kernel::k_brute_force;  ///< Collision pass
+    vision_kernel vision = vision_kernel::k_brute_force;            ///< Vision pass
+    inference_kernel inference = inference_kernel::k_generic;       ///< Brain inference
+    bool verify_inference = false;  ///< Checks generated inference against the generic path
+};
+
 /**
  * @brief Configuration for the entire simulation
  */
@@ -63,6 +102,7 @@ struct config {
     genetic_config genetic;      ///< Genetic algorithm configuration
     sim_config sim;              ///< Simulation configuration
     world_config world;          ///< World configuration
+    kernel_config kernels;       ///< Hot path implementations
 };
 
 }  // namespace cshorelark::simulation
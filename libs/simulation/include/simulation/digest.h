@@ -0,0 +1,124 @@
+#ifndef CSHORELARK_SIMULATION_DIGEST_H
+#define CSHORELARK_SIMULATION_DIGEST_H
+
+/**
+ * @file digest.h
+ * @brief 64-bit digests of the world state for comparing runs step by step
+ *
+ * A digest covers the position, rotation, speed and food eaten of every
+ * animal, the position of every food and the position of the random number
+ * generator. Digests are chained: each one also covers the digest before it,
+ * so two runs that diverged once never agree again and a stream is compared
+ * by its first difference.
+ *
+ * Streams are text, one step per line: the step number followed by the
+ * digest after each phase, in hexadecimal.
+ */
+
+// C++ system headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+// External library headers
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+
+// Project headers
+#include "simulation/simulation_error.h"
+
+namespace cshorelark::simulation {
+
+class world;
+
+/**
+ * @brief Phases of a simulation step, in the order they run
+ */
+enum class step_phase : std::uint8_t {
+    k_collisions,  ///< Animals eat foods, eaten foods move
+    k_brains,      ///< Animals see and think
+    k_movements,   ///< Animals move
+    k_evolution,   ///< The population may be replaced
+};
+
+inline constexpr std::size_t k_step_phase_count = 4;  ///< Number of step phases
+
+/**
+ * @brief Gets the name of a step phase
+ */
+[[nodiscard]] auto to_string(step_phase phase) -> const char*;
+
+/**
+ * @brief Chained digests of the world after each phase of one step
+ */
+struct step_digest {
+    std::uint64_t step = 0;                                 ///< Steps taken before this one
+    std::array<std::uint64_t, k_step_phase_count> phases{};  ///< Digest after each phase
+
+    /**
+     * @brief Gets the digest of the whole step, covering all steps before it
+     */
+    [[nodiscard]] auto value() const noexcept -> std::uint64_t { return phases.back(); }
+
+    auto operator==(const step_digest& other) const noexcept -> bool {
+        return step == other.step && phases == other.phases;
+    }
+    auto operator!=(const step_digest& other) const noexcept -> bool { return !(*this == other); }
+};
+
+/**
+ * @brief Hashes world states, reusing its buffer between calls
+ */
+class world_digest {
+public:
+    /**
+     * @brief Hashes the state of a world
+     * @param world World to hash
+     * @param random_position Fingerprint of the random number generator
+     * @param previous Digest the new one is chained to
+     * @return Digest of the state
+     */
+    [[nodiscard]] auto hash(const world& world, std::uint64_t random_position,
+                            std::uint64_t previous) -> std::uint64_t;
+
+private:
+    std::vector<std::uint32_t> words_;  ///< State flattened to 32-bit words
+};
+
+/**
+ * @brief Where two digest streams first differ
+ */
+struct digest_divergence {
+    std::size_t index = 0;            ///< Record of the streams that differs
+    std::uint64_t step = 0;           ///< Step of the reference record
+    std::optional<step_phase> phase;  ///< First differing phase, none if a stream ended
+};
+
+/**
+ * @brief Finds the first record where two digest streams differ
+ * @param reference Stream of the reference run
+ * @param candidate Stream of the run under test
+ * @return Divergence, or nothing if the streams are identical
+ */
+[[nodiscard]] auto first_divergence(nonstd::span<const step_digest> reference,
+                                    nonstd::span<const step_digest> candidate)
+    -> std::optional<digest_divergence>;
+
+/**
+ * @brief Writes one record of a digest stream
+ */
+void write_digest(std::ostream& out, const step_digest& digest);
+
+/**
+ * @brief Reads a whole digest stream
+ * @return Records in stream order, or k_invalid_digest_stream
+ */
+[[nodiscard]] auto read_digests(std::istream& in)
+    -> tl::expected<std::vector<step_digest>, simulation_error>;
+
+}  // namespace cshorelark::simulation
+
+#endif  // CSHORELARK_SIMULATION_DIGEST_H
@@ -58,6 +58,24 @@ public:
                                       nonstd::span<const food> food_items) const
         -> std::vector<float>;
 
+    /**
+     * @brief Updates the eye's view of some of the foods.
+     *
+     * @details Same as the overload above restricted to the foods at the given
+     * indices, visited in the order given; gives the same result whenever
+     * every food within range is listed in ascending order.
+     *
+     * @param position Current position in the world
+     * @param rotation Current rotation in radians
+     * @param food_items Collection of food items
+     * @param nearby Indices of the food items to consider
+     * @return Visual input from the environment
+     */
+    [[nodiscard]] auto process_vision(const vector2d& position, float rotation,
+                                      nonstd::span<const food> food_items,
+                                      nonstd::span<const std::size_t> nearby) const
+        -> std::vector<float>;
+
     /**
      * @brief Gets the number of photoreceptors.
      * @return Number of receptors
@@ -73,6 +91,12 @@ public:
     [[nodiscard]] auto get_fov_degrees() const noexcept -> float;
 
 private:
+    /**
+     * @brief Adds one food to the receptors that see it
+     */
+    void see(std::vector<float>& cells, const vector2d& position, float rotation,
+             const food& food_value) const;
+
     float fov_range_;  ///< Field of view range
     float fov_angle_;  ///< Field of view angle in radians
     size_t cells_;     ///< Number of photoreceptors
@@ -0,0 +1,66 @@
+#ifndef CSHORELARK_SIMULATION_FOOD_GRID_H
+#define CSHORELARK_SIMULATION_FOOD_GRID_H
+
+// C++ system headers
+#include <cstddef>
+#include <vector>
+
+// External library headers
+#include <nonstd/span.hpp>
+
+// Project headers
+#include "simulation/food.h"
+#include "simulation/vector2d.h"
+
+namespace cshorelark::simulation {
+
+/**
+ * @brief Uniform grid over the unit world bucketing foods by position
+ *
+ * Cells are at least as wide as the search radius, so every food within the
+ * radius of a point lies in the point's cell or one of its eight neighbours.
+ */
+class food_grid {
+public:
+    /**
+     * @brief Creates an empty grid
+     * @param radius Largest distance queries must cover
+     */
+    explicit food_grid(float radius = 1.0F);
+
+    /**
+     * @brief Buckets all foods, replacing the previous contents
+     * @param foods Foods to bucket, referred to by index
+     */
+    void rebuild(nonstd::span<const food> foods);
+
+    /**
+     * @brief Moves a food to the cell of its new position
+     * @param index Index of the food
+     * @param from Position the food was bucketed at
+     * @param to New position of the food
+     */
+    void move(std::size_t index, const vector2d& from, const vector2d& to);
+
+    /**
+     * @brief Collects the foods that may lie within the radius of a point
+     * @param position Point to search around
+     * @param indices Receives the food indices in ascending order, cleared first
+     */
+    void query(const vector2d& position, std::vector<std::size_t>& indices) const;
+
+    /**
+     * @brief Gets the number of cells along each side of the world
+     */
+    [[nodiscard]] auto cells_per_side() const noexcept -> std::size_t { return side_; }
+
+private:
+    [[nodiscard]] auto column_of(float coordinate) const noexcept -> std::size_t;
+
+    std::size_t side_;                             ///< Cells along each side
+    std::vector<std::vector<std::size_t>> cells_;  ///< Food indices per cell, row-major
+};
+
+}  // namespace cshorelark::simulation
+
+#endif  // CSHORELARK_SIMULATION_FOOD_GRID_H
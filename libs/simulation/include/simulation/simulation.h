@@ -2,10 +2,24 @@
 #define CSHORELARK_SIMULATION_SIMULATION_H
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+
+#include "genetic_algorithm/chromosome.h"
+#include "genetic_algorithm/lineage.h"
 
 #include "random/random.h"
+#include "simulation/brain.h"
 #include "simulation/config.h"
+#include "simulation/digest.h"
+#include "simulation/food_grid.h"
+#include "simulation/simulation_error.h"
 #include "simulation/statistics.h"
 #include "simulation/world.h"
 
@@ -30,16 +44,32 @@ public:
                        cshorelark::random::random_generator& random) -> simulation;
 
     /**
-     * @brief Creates a new food in random position
+     * @brief Creates a simulation whose animals carry the given brains
+     *
+     * One animal is created per chromosome, in order, at a random position;
+     * config.world.num_animals is ignored. Foods are placed at random.
      *
+     * @param config Configuration settings for the simulation
+     * @param chromosomes Brain weights of the animals
      * @param random Random number generator
+     * @return A new simulation instance, or an error if a chromosome does not fit the brain
+     */
+    static auto from_chromosomes(const config& config,
+                                 nonstd::span<const genetic::chromosome> chromosomes,
+                                 cshorelark::random::random_generator& random)
+        -> tl::expected<simulation, simulation_error>;
+
+    /**
+     * @brief Queues a new food at a random position
      *
-     * @return void
+     * Like every spawn and despawn, this may be called from any thread: the
+     * change is queued and applied at the start of the next step, or by
+     * apply_pending(), so it never lands while a step walks the world.
      */
-    void spawn_food(cshorelark::random::random_generator& random);
+    void spawn_food();
 
     /**
-     * @brief Creates a new food at a specific position
+     * @brief Queues a new food at a specific position
      *
      * @param pos_x X-coordinate of the food position (normalized)
      * @param pos_y Y-coordinate of the food position (normalized)
@@ -47,13 +77,54 @@ public:
     void spawn_food(float pos_x, float pos_y);
 
     /**
-     * @brief Creates a new animal in random position
+     * @brief Queues a new animal with a random brain at a random position
+     */
+    void spawn_animal();
+
+    /**
+     * @brief Queues the removal of a food
      *
-     * @param random Random number generator
+     * @param target Handle to the food, ignored if the food is gone by then
+     */
+    void despawn_food(food_handle target);
+
+    /**
+     * @brief Queues the removal of an animal
      *
-     * @return void
+     * @param target Handle to the animal, ignored if the animal is gone by then
      */
-    void spawn_animal(cshorelark::random::random_generator& random);
+    void despawn_animal(animal_handle target);
+
+    /**
+     * @brief Applies the queued spawns and despawns
+     *
+     * Removals go first, then additions. Must be called from the thread that
+     * steps the simulation; step() and advance() call it themselves.
+     *
+     * @param random Random number generator for spawned positions and brains
+     * @return Whether anything was queued
+     */
+    auto apply_pending(cshorelark::random::random_generator& random) -> bool;
+
+    /**
+     * @brief Tells whether spawns or despawns are queued
+     *
+     * May be called from any thread, e.g. to wake a paused stepping thread.
+     */
+    [[nodiscard]] auto has_pending() const -> bool;
+
+    /**
+     * @brief Creates a branch of the simulation in its current state
+     *
+     * The branch shares every brain network and, until one side eats a food, the
+     * food array with this simulation, so its memory grows only with what it
+     * changes. Branches are independent afterwards: each may be stepped on its
+     * own thread with its own random number generator. Queued spawns and
+     * despawns stay with this simulation.
+     *
+     * @return Branch at the same age and generation
+     */
+    [[nodiscard]] auto fork() const -> simulation;
 
     /**
      * @brief Get the current configuration
@@ -83,6 +154,44 @@ public:
      */
     [[nodiscard]] auto get_age() const -> std::size_t { return age_; }
 
+    /**
+     * @brief Get the brain cache counters of every animal since the simulation started
+     *
+     * @return Counters summed over the current and all previous generations
+     */
+    [[nodiscard]] auto get_brain_cache_stats() const -> brain_cache_stats;
+
+    /**
+     * @brief Turns the per-step world digest on or off
+     *
+     * While on, every step hashes the world after each of its phases, which
+     * costs a pass over the animals and foods per phase. Turning it on starts
+     * a new chain at step 0.
+     *
+     * @param enabled Whether to compute digests
+     */
+    void set_digest_enabled(bool enabled);
+
+    /**
+     * @brief Get the digest of the last step
+     *
+     * @return Digest, or nullopt if digests are off or no step ran since they were turned on
+     */
+    [[nodiscard]] auto get_last_digest() const -> std::optional<step_digest>;
+
+    /**
+     * @brief Archives every generation bred from now on
+     *
+     * The population the next evolution breeds from is archived first, as a
+     * keyframe, and so is the population after any spawn or despawn; each new
+     * generation is archived as its parents and differences from them. If
+     * the archive cannot be written, a warning is logged and archiving stops.
+     * Branches created by fork() do not archive.
+     *
+     * @param lineage Empty archive to append to, or nullptr to stop archiving
+     */
+    void set_lineage(std::unique_ptr<genetic::lineage_writer> lineage);
+
     /**
      * @brief Advance the simulation by one step
      *
@@ -92,6 +201,16 @@ public:
     auto step(cshorelark::random::random_generator& random)
         -> std::optional<cshorelark::simulation::statistics>;
 
+    /**
+     * @brief Advance the world by one step without ever evolving
+     *
+     * Moves animals and foods like step() but leaves the age, the generation
+     * and the population untouched, for evaluating fixed brains.
+     *
+     * @param random Random number generator
+     */
+    void advance(cshorelark::random::random_generator& random);
+
     /**
      * @brief Runs a complete training cycle until the next generation
      *
@@ -109,6 +228,38 @@ private:
      */
     simulation(config config, world&& world);
 
+    /**
+     * @brief Spawns and despawns requested since the last step
+     */
+    struct pending_changes {
+        std::mutex mutex;                            ///< Guards the other members
+        std::size_t random_foods = 0;                ///< Foods to place at random
+        std::vector<vector2d> foods;                 ///< Foods to place at a position
+        std::size_t random_animals = 0;              ///< Animals to create at random
+        std::vector<food_handle> food_removals;      ///< Foods to remove
+        std::vector<animal_handle> animal_removals;  ///< Animals to remove
+
+        [[nodiscard]] auto empty() const noexcept -> bool {
+            return random_foods == 0 && foods.empty() && random_animals == 0 &&
+                   food_removals.empty() && animal_removals.empty();
+        }
+    };
+
+    /**
+     * @brief Runs the collision, brain and movement phases of a step
+     *
+     * @param random Random number generator
+     */
+    void advance_world(cshorelark::random::random_generator& random);
+
+    /**
+     * @brief Chains the digest of the world after a phase, if digests are on
+     *
+     * @param phase Phase that just ran
+     * @param random Random number generator used by the step
+     */
+    void record_digest(step_phase phase, const cshorelark::random::random_generator& random);
+
     /**
      * @brief Processes collisions between animals and food
      *
@@ -116,6 +267,13 @@ private:
      */
     void process_collisions(cshorelark::random::random_generator& random);
 
+    /**
+     * @brief Processes collisions using the collision grid
+     *
+     * @param random Random generator for food repositioning
+     */
+    void process_collisions_grid(cshorelark::random::random_generator& random);
+
     /**
      * @brief Process brain calculations for all animals
      */
@@ -143,10 +301,21 @@ private:
      */
     auto evolve(cshorelark::random::random_generator& random) -> cshorelark::simulation::statistics;
 
-    config config_;               ///< Simulation configuration
-    world world_;                 ///< Current world state
-    std::size_t age_ = 0;         ///< Current age (steps since last evolution)
-    std::size_t generation_ = 0;  ///< Current generation counter
+    config config_;                             ///< Simulation configuration
+    world world_;                               ///< Current world state
+    std::size_t age_ = 0;                       ///< Current age (steps since last evolution)
+    std::size_t generation_ = 0;                ///< Current generation counter
+    brain_cache_stats retired_cache_stats_;     ///< Brain cache counters of past generations
+    food_grid collision_grid_;                  ///< Foods bucketed for the grid collision kernel
+    food_grid vision_grid_;                     ///< Foods bucketed for the grid vision kernel
+    std::vector<std::size_t> nearby_;           ///< Scratch list of candidate foods
+    bool digest_enabled_ = false;               ///< Whether steps compute digests
+    std::uint64_t digest_steps_ = 0;            ///< Steps digested since digests were turned on
+    step_digest digest_;                        ///< Digests of the last or current step
+    world_digest digest_hasher_;                ///< Buffer for hashing the world
+    std::unique_ptr<pending_changes> pending_;  ///< Changes queued for the next step
+    std::unique_ptr<genetic::lineage_writer> lineage_;  ///< Archive of every generation if set
+    bool lineage_linked_ = false;               ///< Animals are the last archived generation
 };
 
 }  // namespace cshorelark::simulation
@@ -21,6 +21,7 @@ enum class simulation_error {
     k_invalid_brain_config,       ///< Invalid brain configuration
     k_invalid_chromosome,         ///< Invalid chromosome for brain creation
     k_brain_operation_failed,     ///< Brain operation failed
+    k_invalid_digest_stream,      ///< Malformed world digest stream
 };
 
 /**
@@ -0,0 +1,188 @@
+#ifndef CSHORELARK_SIMULATION_SLOT_MAP_H
+#define CSHORELARK_SIMULATION_SLOT_MAP_H
+
+// C++ system headers
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// External library headers
+#include <nonstd/span.hpp>
+
+namespace cshorelark::simulation {
+
+/**
+ * @brief Stable reference to a value in a slot_map
+ *
+ * A handle outlives the value it refers to: once the value is erased the slot's
+ * generation moves on and the handle no longer resolves, even after the slot is
+ * reused.
+ *
+ * @tparam T Type of the values, so handles of different maps do not mix
+ */
+template <typename T>
+struct slot_handle {
+    static constexpr std::uint32_t k_invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index = k_invalid_index;  ///< Slot the value was inserted into
+    std::uint32_t generation = 0;           ///< Generation of the slot at insertion
+
+    [[nodiscard]] auto is_valid() const noexcept -> bool { return index != k_invalid_index; }
+
+    friend auto operator==(const slot_handle& lhs, const slot_handle& rhs) noexcept -> bool {
+        return lhs.index == rhs.index && lhs.generation == rhs.generation;
+    }
+
+    friend auto operator!=(const slot_handle& lhs, const slot_handle& rhs) noexcept -> bool {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief Densely stored values addressed by generation-checked handles
+ *
+ * Values live in one contiguous array in no particular order, so iterating
+ * them is as cheap as iterating a vector. Inserting and erasing are O(1):
+ * erasing moves the last value into the gap, and freed slots are reused
+ * through a free list threaded through the slot array.
+ *
+ * Indices into values() change whenever a value is erased; handles do not.
+ *
+ * @tparam T Type of the values
+ */
+template <typename T>
+class slot_map {
+public:
+    using handle = slot_handle<T>;
+
+    /**
+     * @brief Inserts a value
+     * @param value Value to insert
+     * @return Handle to the value
+     */
+    auto insert(T value) -> handle {
+        std::uint32_t index = free_head_;
+        if (index == handle::k_invalid_index) {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(slot{});
+        } else {
+            free_head_ = slots_[index].target;
+        }
+        slots_[index].target = static_cast<std::uint32_t>(values_.size());
+        values_.push_back(std::move(value));
+        slot_of_.push_back(index);
+        return handle{index, slots_[index].generation};
+    }
+
+    /**
+     * @brief Erases the value a handle refers to
+     * @param target Handle to the value
+     * @return Whether the handle still referred to a value
+     */
+    auto erase(handle target) -> bool {
+        if (!contains(target)) {
+            return false;
+        }
+        auto& erased = slots_[target.index];
+        const std::uint32_t dense = erased.target;
+        const std::uint32_t last = static_cast<std::uint32_t>(values_.size() - 1);
+        if (dense != last) {
+            values_[dense] = std::move(values_[last]);
+            slot_of_[dense] = slot_of_[last];
+            slots_[slot_of_[dense]].target = dense;
+        }
+        values_.pop_back();
+        slot_of_.pop_back();
+        release(target.index);
+        return true;
+    }
+
+    /**
+     * @brief Erases every value, invalidating all handles
+     */
+    void clear() {
+        for (const auto index : slot_of_) {
+            release(index);
+        }
+        values_.clear();
+        slot_of_.clear();
+    }
+
+    /**
+     * @brief Reserves room so that inserting up to a total of capacity values does not allocate
+     * @param capacity Number of values
+     */
+    void reserve(std::size_t capacity) {
+        values_.reserve(capacity);
+        slot_of_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    /**
+     * @brief Checks whether a handle still refers to a value
+     */
+    [[nodiscard]] auto contains(handle target) const noexcept -> bool {
+        return target.index < slots_.size() && slots_[target.index].generation == target.generation;
+    }
+
+    /**
+     * @brief Gets the value a handle refers to
+     * @return Pointer to the value, or nullptr if it was erased
+     */
+    [[nodiscard]] auto get(handle target) noexcept -> T* {
+        return contains(target) ? &values_[slots_[target.index].target] : nullptr;
+    }
+
+    [[nodiscard]] auto get(handle target) const noexcept -> const T* {
+        return contains(target) ? &values_[slots_[target.index].target] : nullptr;
+    }
+
+    /**
+     * @brief Gets the handle of the value at a position of values()
+     * @param dense_index Position of the value
+     */
+    [[nodiscard]] auto handle_at(std::size_t dense_index) const noexcept -> handle {
+        const std::uint32_t index = slot_of_[dense_index];
+        return handle{index, slots_[index].generation};
+    }
+
+    /**
+     * @brief Gets all values, contiguous and in no particular order
+     */
+    [[nodiscard]] auto values() noexcept -> nonstd::span<T> { return values_; }
+
+    [[nodiscard]] auto values() const noexcept -> nonstd::span<const T> { return values_; }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return values_.size(); }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return values_.empty(); }
+
+private:
+    /**
+     * @brief Entry of the slot array
+     *
+     * A live slot's target is the position of its value; a free slot's target is
+     * the next free slot.
+     */
+    struct slot {
+        std::uint32_t target = handle::k_invalid_index;  ///< Dense index or next free slot
+        std::uint32_t generation = 0;                    ///< Bumped every time the slot is freed
+    };
+
+    void release(std::uint32_t index) noexcept {
+        ++slots_[index].generation;
+        slots_[index].target = free_head_;
+        free_head_ = index;
+    }
+
+    std::vector<T> values_;                              ///< Values, densely packed
+    std::vector<std::uint32_t> slot_of_;                 ///< Slot of each value
+    std::vector<slot> slots_;                            ///< Slots, indexed by handle
+    std::uint32_t free_head_ = handle::k_invalid_index;  ///< First free slot
+};
+
+}  // namespace cshorelark::simulation
+
+#endif  // CSHORELARK_SIMULATION_SLOT_MAP_H
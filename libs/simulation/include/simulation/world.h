@@ -8,6 +8,7 @@
 #include "simulation/config.h"
 #include "simulation/constants.h"
 #include "simulation/food.h"
+#include "simulation/slot_map.h"
 #include "simulation/vector2d.h"
 
 // C++ system headers
@@ -18,13 +19,26 @@
 #include <utility>
 #include <vector>
 
+// External library headers
+#include <nonstd/span.hpp>
+
 namespace cshorelark::simulation {
 
 // Forward declarations
 class animal;
 
+using animal_handle = slot_handle<animal>;  ///< Stable reference to an animal of a world
+using food_handle = slot_handle<food>;      ///< Stable reference to a food of a world
+
 /**
  * @brief Simulation world containing animals and food.
+ *
+ * Animals and foods live in slot maps: they are iterated as dense arrays in
+ * no particular order, and handles keep referring to the same entity while
+ * others are added and removed around it.
+ *
+ * Foods are held copy-on-write: a forked world shares the food array of its
+ * origin until one of them asks for mutable access with get_foods().
  */
 class world {
 public:
@@ -33,8 +47,7 @@ public:
      * @param animals Vector of animals to store
      * @param foods Vector of foods to store
      */
-    explicit world(std::vector<animal>&& animals, std::vector<food>&& foods)
-        : animals_(std::move(animals)), foods_(std::move(foods)) {}
+    explicit world(std::vector<animal>&& animals, std::vector<food>&& foods);
 
     // Delete copy constructor and copy assignment operator to prevent copying
     world(const world&) = delete;
@@ -51,24 +64,100 @@ public:
     world& operator=(world&&) noexcept = default;
 
     /**
-     * @brief Gets all food items in the world.
-     * @return Vector of food items
+     * @brief Gets all food items in the world for modification.
+     *
+     * Copies the food array first if it is still shared with a fork.
+     *
+     * @return Food items
+     */
+    [[nodiscard]] auto get_foods() const -> nonstd::span<food>;
+
+    /**
+     * @brief Gets all food items in the world for reading, never copying them.
+     * @return Food items
      */
-    [[nodiscard]] auto get_foods() const -> std::vector<food>& { return foods_; }
+    [[nodiscard]] auto foods() const noexcept -> nonstd::span<const food> {
+        return foods_->values();
+    }
 
-    [[nodiscard]] auto foods_count() const -> std::size_t { return foods_.size(); }
+    [[nodiscard]] auto foods_count() const -> std::size_t { return foods_->size(); }
 
     /**
      * @brief Gets all animals in the world.
-     * @return Vector of animals
+     * @return Animals
      */
-    [[nodiscard]] auto get_animals() const -> std::vector<animal>& { return animals_; }
+    [[nodiscard]] auto get_animals() const -> nonstd::span<animal>;
 
     /**
-     * @brief Sets the animals in the world.
+     * @brief Replaces the animals in the world, invalidating every animal handle.
      * @param animals Vector of animals to set
      */
-    auto set_animals(std::vector<animal>&& animals) -> void { animals_ = std::move(animals); }
+    auto set_animals(std::vector<animal>&& animals) -> void;
+
+    /**
+     * @brief Adds a food
+     * @param new_food Food to add
+     * @return Handle to the food
+     */
+    auto add_food(food new_food) -> food_handle;
+
+    /**
+     * @brief Adds an animal
+     * @param new_animal Animal to add
+     * @return Handle to the animal
+     */
+    auto add_animal(animal new_animal) -> animal_handle;
+
+    /**
+     * @brief Removes a food, moving the last food into its place in foods()
+     * @param target Handle to the food
+     * @return Whether the food was still in the world
+     */
+    auto remove_food(food_handle target) -> bool;
+
+    /**
+     * @brief Removes an animal, moving the last animal into its place in get_animals()
+     * @param target Handle to the animal
+     * @return Whether the animal was still in the world
+     */
+    auto remove_animal(animal_handle target) -> bool;
+
+    /**
+     * @brief Gets the handle of the food at an index of foods()
+     */
+    [[nodiscard]] auto food_handle_at(std::size_t index) const -> food_handle {
+        return foods_->handle_at(index);
+    }
+
+    /**
+     * @brief Gets the handle of the animal at an index of get_animals()
+     */
+    [[nodiscard]] auto animal_handle_at(std::size_t index) const -> animal_handle;
+
+    /**
+     * @brief Gets the food a handle refers to
+     * @return Food, or nullptr if it was removed
+     */
+    [[nodiscard]] auto find_food(food_handle target) const -> const food* {
+        return foods_->get(target);
+    }
+
+    /**
+     * @brief Gets the animal a handle refers to
+     * @return Animal, or nullptr if it was removed
+     */
+    [[nodiscard]] auto find_animal(animal_handle target) const -> const animal*;
+
+    /**
+     * @brief Creates a world in the same state that shares brains and foods with this one
+     *
+     * Animals are copied with forked brains and the food array is shared until
+     * either world changes it. The fork and this world may then be advanced from
+     * different threads.
+     *
+     * @return Forked world
+     */
+    [[nodiscard]] auto fork() const -> world;
 
     [[nodiscard]] static auto random(const config& cfg,
                                      cshorelark::random::random_generator& random) -> world;
@@ -77,9 +166,14 @@ public:
     ~world();
 
 private:
+    /**
+     * @brief Gets the foods for modification, copying them first if a fork shares them
+     */
+    auto detach_foods() const -> slot_map<food>&;
+
     ///< Configuration parameters
-    mutable std::vector<animal> animals_;  ///< Animals in the world
-    mutable std::vector<food> foods_;      ///< Food items in the world
+    mutable slot_map<animal> animals_;                ///< Animals in the world
+    mutable std::shared_ptr<slot_map<food>> foods_;  ///< Food items, shared with forks
 };
 
 }  // namespace cshorelark::simulation
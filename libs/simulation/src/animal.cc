@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 #include <nonstd/span.hpp>  // Add span include
 
 #include "genetic_algorithm/chromosome.h"
@@ -41,9 +42,29 @@ animal::animal(const config& config, cshorelark::random::random_generator& rando
                   rotation_);
 }
 
+animal::animal(const animal& other, brain brain)
+    : position_(other.position_),
+      rotation_(other.rotation_),
+      vision_(other.vision_),
+      speed_(other.speed_),
+      eye_(other.eye_),
+      brain_(std::move(brain)),
+      food_eaten_(other.food_eaten_) {}
+
+auto animal::fork() const -> animal { return animal(*this, brain_.fork()); }
+
 void animal::process_brain(const config& config, nonstd::span<const food> foods) {
     vision_ = eye_.process_vision(position_, rotation_, foods);
+    think(config);
+}
+
+void animal::process_brain(const config& config, nonstd::span<const food> foods,
+                           nonstd::span<const std::size_t> nearby) {
+    vision_ = eye_.process_vision(position_, rotation_, foods, nearby);
+    think(config);
+}
 
+void animal::think(const config& config) {
     // Process inputs through the neural network
     auto outputs_result = brain_.propagate(vision_);
 
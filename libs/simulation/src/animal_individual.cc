@@ -3,6 +3,7 @@
 // C++ system headers
 #include <cstddef>
 #include <exception>  // Added for std::exception
+#include <limits>
 #include <memory>     // Added for std::unique_ptr, std::make_unique
 #include <string>     // Added for std::string
 #include <utility>
@@ -35,6 +36,13 @@ auto animal_individual::get_fitness() const noexcept -> float {
     return static_cast<float>(food_eaten_);
 }
 
+auto animal_individual::get_integer_fitness() const noexcept -> std::optional<std::uint32_t> {
+    if (food_eaten_ > std::numeric_limits<std::uint32_t>::max()) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint32_t>(food_eaten_);
+}
+
 [[nodiscard]] auto animal_individual::from_animal(const animal& animal) -> animal_individual {
     // Get the chromosome from the animal and immediately move it into the constructor
     return animal_individual{animal.food_eaten(), animal.as_chromosome()};
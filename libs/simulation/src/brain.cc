@@ -1,6 +1,16 @@
 #include "simulation/brain.h"
 
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 #include "genetic_algorithm/chromosome.h"
+#include "neural_network/jit.h"
 #include "neural_network/layer_topology.h"
 #include "neural_network/network.h"
 #include "nonstd/span.hpp"
@@ -13,17 +23,133 @@ namespace cshorelark::simulation {
 brain::brain(const config& config, neural_network::network<float>&& network)
     : speed_accel_(config.sim.speed_accel),
       rotation_accel_(config.sim.rotation_accel_deg * constants::k_deg_to_rad),
-      network_(std::move(network)) {}
+      network_(std::make_shared<const neural_network::network<float>>(std::move(network))),
+      cache_last_input_(config.brain_eye.cache_last_input) {
+    init_jit(config);
+    init_zero_output();
+}
 
 brain::brain(const config& config, cshorelark::random::random_generator& random)
     : speed_accel_(config.sim.speed_accel),
       rotation_accel_(config.sim.rotation_accel_deg * constants::k_deg_to_rad),
-      network_(std::move(*neural_network::network<float>::random(topology(config), random))) {}
+      network_(std::make_shared<const neural_network::network<float>>(
+          std::move(*neural_network::network<float>::random(topology(config), random)))),
+      cache_last_input_(config.brain_eye.cache_last_input) {
+    init_jit(config);
+    init_zero_output();
+}
+
+void brain::init_jit(const config& config) {
+    const auto inference = config.kernels.inference;
+    if (inference == inference_kernel::k_generic) {
+        return;
+    }
+
+    std::vector<std::uint32_t> layer_sizes{static_cast<std::uint32_t>(network_->input_size())};
+    for (const auto& layer : network_->layers()) {
+        layer_sizes.push_back(static_cast<std::uint32_t>(layer.get_neurons().size()));
+    }
+    const auto weights = network_->weights();
+
+    // Any failure leaves jit_ empty and the brain on the generic path
+    if (inference == inference_kernel::k_jit) {
+        auto kernel = neural_network::jit_kernel::shared(
+            layer_sizes, neural_network::activation_function::k_relu);
+        if (!kernel) {
+            return;
+        }
+        auto packed = (*kernel)->pack(weights);
+        if (!packed) {
+            return;
+        }
+        jit_ = std::move(*kernel);
+        jit_weights_ = std::make_shared<const std::vector<float>>(std::move(*packed));
+    } else {
+        auto kernel = neural_network::jit_kernel::compile(
+            layer_sizes, neural_network::activation_function::k_relu,
+            neural_network::jit_weights::k_embedded, weights);
+        if (!kernel) {
+            return;
+        }
+        jit_ = std::make_shared<const neural_network::jit_kernel>(std::move(*kernel));
+    }
+    jit_scratch_.resize(jit_->scratch_size());
+    verify_inference_ = config.kernels.verify_inference;
+}
+
+void brain::init_zero_output() {
+    const std::vector<float> zeros(network_->input_size(), 0.0F);
+    auto result = evaluate(zeros);
+    has_zero_output_ = result.has_value();
+    if (has_zero_output_) {
+        zero_output_ = *result;
+    }
+}
 
 auto brain::propagate(nonstd::span<const float> vision) const
     -> tl::expected<std::vector<float>, simulation_error> {
+    // Cached responses only apply to inputs the network would accept
+    if (vision.size() == network_->input_size()) {
+        if (has_zero_output_ &&
+            std::all_of(vision.begin(), vision.end(), [](float v) { return v == 0.0F; })) {
+            ++cache_stats_.zero_hits;
+            return std::vector<float>{zero_output_[0], zero_output_[1]};
+        }
+        if (cache_last_input_ && has_last_output_ &&
+            std::equal(vision.begin(), vision.end(), last_input_.begin())) {
+            ++cache_stats_.repeat_hits;
+            return std::vector<float>{last_output_[0], last_output_[1]};
+        }
+    }
+
+    auto result = evaluate(vision);
+    if (!result) {
+        return tl::make_unexpected(result.error());
+    }
+    ++cache_stats_.misses;
+
+    if (cache_last_input_) {
+        last_input_.assign(vision.begin(), vision.end());
+        last_output_ = *result;
+        has_last_output_ = true;
+    }
+    return std::vector<float>{(*result)[0], (*result)[1]};
+}
+
+auto brain::propagate_jit(nonstd::span<const float> vision) const -> std::optional<output> {
+    const auto packed =
+        jit_weights_ ? nonstd::span<const float>(*jit_weights_) : nonstd::span<const float>();
+    auto outputs = jit_->propagate(vision, packed, jit_scratch_);
+    if (!outputs || outputs->size() < 2) {
+        return std::nullopt;
+    }
+    const output response{(*outputs)[0], (*outputs)[1]};
+
+    if (verify_inference_) {
+        auto expected = network_->propagate(vision);
+        if (!expected || expected->size() < 2 ||
+            std::memcmp(expected->data(), response.data(), sizeof(response)) != 0) {
+            static std::atomic<bool> warned{false};
+            if (!warned.exchange(true)) {
+                spdlog::warn("Generated inference differs from the network, using the network");
+            }
+            jit_.reset();
+            return std::nullopt;
+        }
+    }
+    return response;
+}
+
+auto brain::evaluate(nonstd::span<const float> vision) const
+    -> tl::expected<output, simulation_error> {
+    if (jit_) {
+        if (auto response = propagate_jit(vision)) {
+            return to_output((*response)[0], (*response)[1]);
+        }
+    }
+
     // Get raw neural network response
-    auto result = network_.propagate(vision);
+    auto result = network_->propagate(vision);
 
     // Check if propagation was successful
     if (!result) {
@@ -47,6 +173,10 @@ auto brain::propagate(nonstd::span<const float> vision) const
         return tl::make_unexpected(simulation_error::k_insufficient_outputs);
     }
 
+    return to_output(response[0], response[1]);
+}
+
+auto brain::to_output(float response0, float response1) const -> output {
     // Following the Rust implementation logic:
     // let r0 = response[0].clamp(0.0, 1.0) - 0.5;
     // let r1 = response[1].clamp(0.0, 1.0) - 0.5;
@@ -54,21 +184,23 @@ auto brain::propagate(nonstd::span<const float> vision) const
     // let rotation = (r0 - r1).clamp(-self.rotation_accel, self.rotation_accel);
 
     // Clamp and normalize the outputs
-    float r0 = std::clamp(response[0], 0.0F, 1.0F) - 0.5F;
-    float r1 = std::clamp(response[1], 0.0F, 1.0F) - 0.5F;
+    float r0 = std::clamp(response0, 0.0F, 1.0F) - 0.5F;
+    float r1 = std::clamp(response1, 0.0F, 1.0F) - 0.5F;
 
     // Calculate speed and rotation from normalized outputs
     const float speed = std::clamp(r0 + r1, -speed_accel_, speed_accel_);
     const float rotation = std::clamp(r0 - r1, -rotation_accel_, rotation_accel_);
 
-    return std::vector<float>{speed, rotation};
+    return output{speed, rotation};
 }
 
-auto brain::weights() const -> std::vector<float> { return network_.weights(); }
+auto brain::fork() const -> brain { return brain(*this); }
+
+auto brain::weights() const -> std::vector<float> { return network_->weights(); }
 
-auto brain::input_size() const -> std::size_t { return network_.input_size(); }
+auto brain::input_size() const -> std::size_t { return network_->input_size(); }
 
-auto brain::output_size() const -> std::size_t { return network_.output_size(); }
+auto brain::output_size() const -> std::size_t { return network_->output_size(); }
 
 auto brain::topology(const config& config) -> std::array<neural_network::layer_topology, 3> {
     return std::array<neural_network::layer_topology, 3>{
@@ -79,7 +211,7 @@ auto brain::topology(const config& config) -> std::array<neural_network::layer_t
 }
 
 auto brain::as_chromosome() const -> cshorelark::genetic::chromosome {
-    return cshorelark::genetic::chromosome(network_.weights());
+    return cshorelark::genetic::chromosome(network_->weights());
 }
 
 auto brain::from_chromosome(const config& config, const genetic::chromosome& chromosome)
@@ -107,6 +239,7 @@ auto brain::from_chromosome(const config& config, const genetic::chromosome& chr
             case neural_network::network_error::k_too_many_weights:
                 return tl::unexpected(simulation_error::k_invalid_chromosome);
             case neural_network::network_error::k_invalid_layer_topology:
+            case neural_network::network_error::k_unsupported_activation:
                 return tl::unexpected(simulation_error::k_invalid_brain_config);
             case neural_network::network_error::k_network_not_initialized:
             case neural_network::network_error::k_invalid_input_size:
@@ -119,6 +252,43 @@ auto brain::from_chromosome(const config& config, const genetic::chromosome& chr
     return brain(config, std::move(network_result.value()));
 }
 
+auto brain::adapt_chromosome(const genetic::chromosome& chromosome, std::size_t num_cells,
+                             std::size_t num_neurons, const config& config)
+    -> tl::expected<genetic::chromosome, simulation_error> {
+    constexpr std::size_t k_outputs = 2;
+    const auto genes = chromosome.genes();
+    if (num_cells == 0 || num_neurons == 0 ||
+        genes.size() != num_neurons * (num_cells + 1) + k_outputs * (num_neurons + 1)) {
+        return tl::make_unexpected(simulation_error::k_invalid_chromosome);
+    }
+
+    // Every neuron is its bias followed by one weight per input, layer after layer
+    const std::size_t cells = config.brain_eye.num_cells;
+    const std::size_t neurons = config.brain_eye.num_neurons;
+    std::vector<float> adapted;
+    adapted.reserve(neurons * (cells + 1) + k_outputs * (neurons + 1));
+    const auto append_neuron = [&adapted](const float* from, std::size_t from_inputs,
+                                          std::size_t inputs) {
+        adapted.push_back(from[0]);
+        const std::size_t kept = std::min(from_inputs, inputs);
+        adapted.insert(adapted.end(), from + 1, from + 1 + kept);
+        adapted.resize(adapted.size() + (inputs - kept), 0.0F);
+    };
+
+    for (std::size_t neuron = 0; neuron < neurons; ++neuron) {
+        if (neuron < num_neurons) {
+            append_neuron(genes.data() + neuron * (num_cells + 1), num_cells, cells);
+        } else {
+            adapted.resize(adapted.size() + cells + 1, 0.0F);
+        }
+    }
+    const float* outputs = genes.data() + num_neurons * (num_cells + 1);
+    for (std::size_t output = 0; output < k_outputs; ++output) {
+        append_neuron(outputs + output * (num_neurons + 1), num_neurons, neurons);
+    }
+    return genetic::chromosome(std::move(adapted));
+}
+
 auto brain::random(const config& config, cshorelark::random::random_generator& random) -> brain {
     // Create a local copy of the topologies to ensure proper lifetime
     const std::array<neural_network::layer_topology, 3> topologies = topology(config);
@@ -0,0 +1,150 @@
+#include "simulation/digest.h"
+
+// C++ system headers
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "random/random.h"
+#include "simulation/animal.h"
+#include "simulation/food.h"
+#include "simulation/world.h"
+
+namespace cshorelark::simulation {
+
+namespace {
+
+// Independent 32-bit lanes, so the loop below compiles to vector multiplies. Each lane
+// step is a bijection of the lane state, so a changed word always changes its lane.
+constexpr std::size_t k_lanes = 8;
+constexpr std::uint32_t k_multiplier = 0x9E3779B1U;
+constexpr std::uint32_t k_lane_seed = 0x85EBCA77U;
+
+constexpr std::array<const char*, k_step_phase_count> k_phase_names = {
+    "collisions", "brains", "movements", "evolution"};
+
+auto bits_of(float value) -> std::uint32_t {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void push_u64(std::vector<std::uint32_t>& words, std::uint64_t value) {
+    words.push_back(static_cast<std::uint32_t>(value));
+    words.push_back(static_cast<std::uint32_t>(value >> 32U));
+}
+
+}  // namespace
+
+auto to_string(step_phase phase) -> const char* {
+    const auto index = static_cast<std::size_t>(phase);
+    return index < k_phase_names.size() ? k_phase_names[index] : "unknown";
+}
+
+auto world_digest::hash(const world& world, std::uint64_t random_position,
+                        std::uint64_t previous) -> std::uint64_t {
+    const auto& animals = world.get_animals();
+    const auto& foods = world.foods();
+
+    words_.clear();
+    words_.reserve(animals.size() * 6 + foods.size() * 2 + 2 * k_lanes);
+    for (const auto& animal : animals) {
+        words_.push_back(bits_of(animal.position().x()));
+        words_.push_back(bits_of(animal.position().y()));
+        words_.push_back(bits_of(animal.rotation()));
+        words_.push_back(bits_of(animal.speed()));
+        push_u64(words_, animal.food_eaten());
+    }
+    for (const auto& food : foods) {
+        words_.push_back(bits_of(food.position().x()));
+        words_.push_back(bits_of(food.position().y()));
+    }
+    push_u64(words_, random_position);
+    // The counts keep worlds that only differ by trailing zero words apart
+    push_u64(words_, animals.size());
+    push_u64(words_, foods.size());
+    words_.resize((words_.size() + k_lanes - 1) / k_lanes * k_lanes, 0U);
+
+    std::array<std::uint32_t, k_lanes> lanes{};
+    for (std::size_t lane = 0; lane < k_lanes; ++lane) {
+        lanes[lane] = static_cast<std::uint32_t>(lane + 1) * k_lane_seed;
+    }
+    for (std::size_t i = 0; i < words_.size(); i += k_lanes) {
+        for (std::size_t lane = 0; lane < k_lanes; ++lane) {
+            const std::uint32_t mixed = (lanes[lane] ^ words_[i + lane]) * k_multiplier;
+            lanes[lane] = mixed ^ (mixed >> 15U);
+        }
+    }
+
+    std::uint64_t digest = previous;
+    for (const auto lane : lanes) {
+        digest = cshorelark::random::derive_seed(digest, lane);
+    }
+    return digest;
+}
+
+auto first_divergence(nonstd::span<const step_digest> reference,
+                      nonstd::span<const step_digest> candidate)
+    -> std::optional<digest_divergence> {
+    const std::size_t common = std::min(reference.size(), candidate.size());
+    for (std::size_t i = 0; i < common; ++i) {
+        if (reference[i] == candidate[i]) {
+            continue;
+        }
+        digest_divergence divergence{i, reference[i].step, std::nullopt};
+        if (reference[i].step == candidate[i].step) {
+            for (std::size_t phase = 0; phase < k_step_phase_count; ++phase) {
+                if (reference[i].phases[phase] != candidate[i].phases[phase]) {
+                    divergence.phase = static_cast<step_phase>(phase);
+                    break;
+                }
+            }
+        }
+        return divergence;
+    }
+    if (reference.size() == candidate.size()) {
+        return std::nullopt;
+    }
+    const std::uint64_t step = common < reference.size() ? reference[common].step
+                                                         : candidate[common].step;
+    return digest_divergence{common, step, std::nullopt};
+}
+
+void write_digest(std::ostream& out, const step_digest& digest) {
+    const char fill = out.fill('0');
+    out << std::dec << digest.step << std::hex;
+    for (const auto phase : digest.phases) {
+        out << ' ' << std::setw(16) << phase;
+    }
+    out << std::dec << '\n';
+    out.fill(fill);
+}
+
+auto read_digests(std::istream& in) -> tl::expected<std::vector<step_digest>, simulation_error> {
+    std::vector<step_digest> digests;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::istringstream fields(line);
+        step_digest digest;
+        fields >> std::dec >> digest.step >> std::hex;
+        for (auto& phase : digest.phases) {
+            fields >> phase;
+        }
+        std::string rest;
+        if (!fields || (fields >> rest)) {
+            return tl::make_unexpected(simulation_error::k_invalid_digest_stream);
+        }
+        digests.push_back(digest);
+    }
+    return digests;
+}
+
+}  // namespace cshorelark::simulation
@@ -0,0 +1,72 @@
+#include "simulation/food_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cshorelark::simulation {
+
+namespace {
+
+// Cells are widened slightly so rounding in column_of never splits a pair
+// within the radius by more than one cell
+constexpr float k_cell_margin = 1.001F;
+// Bounds the grid for tiny radii, larger cells only cost extra candidates
+constexpr std::size_t k_max_cells_per_side = 256;
+
+}  // namespace
+
+food_grid::food_grid(float radius) {
+    const float cells = radius > 0.0F ? std::floor(1.0F / (radius * k_cell_margin)) : 1.0F;
+    side_ = std::clamp<std::size_t>(static_cast<std::size_t>(std::max(cells, 1.0F)), 1,
+                                    k_max_cells_per_side);
+    cells_.resize(side_ * side_);
+}
+
+auto food_grid::column_of(float coordinate) const noexcept -> std::size_t {
+    const float scaled = std::floor(coordinate * static_cast<float>(side_));
+    if (!(scaled > 0.0F)) {
+        return 0;
+    }
+    return std::min(static_cast<std::size_t>(scaled), side_ - 1);
+}
+
+void food_grid::rebuild(nonstd::span<const food> foods) {
+    for (auto& cell : cells_) {
+        cell.clear();
+    }
+    for (std::size_t index = 0; index < foods.size(); ++index) {
+        const auto& position = foods[index].position();
+        cells_[column_of(position.y()) * side_ + column_of(position.x())].push_back(index);
+    }
+}
+
+void food_grid::move(std::size_t index, const vector2d& from, const vector2d& to) {
+    auto& source = cells_[column_of(from.y()) * side_ + column_of(from.x())];
+    const auto found = std::find(source.begin(), source.end(), index);
+    if (found != source.end()) {
+        *found = source.back();
+        source.pop_back();
+    }
+    cells_[column_of(to.y()) * side_ + column_of(to.x())].push_back(index);
+}
+
+void food_grid::query(const vector2d& position, std::vector<std::size_t>& indices) const {
+    indices.clear();
+    const std::size_t column = column_of(position.x());
+    const std::size_t row = column_of(position.y());
+    const std::size_t first_column = column > 0 ? column - 1 : 0;
+    const std::size_t last_column = std::min(column + 1, side_ - 1);
+    const std::size_t first_row = row > 0 ? row - 1 : 0;
+    const std::size_t last_row = std::min(row + 1, side_ - 1);
+
+    for (std::size_t y = first_row; y <= last_row; ++y) {
+        for (std::size_t x = first_column; x <= last_column; ++x) {
+            const auto& cell = cells_[y * side_ + x];
+            indices.insert(indices.end(), cell.begin(), cell.end());
+        }
+    }
+    // Callers visit foods in index order, like the brute-force passes
+    std::sort(indices.begin(), indices.end());
+}
+
+}  // namespace cshorelark::simulation
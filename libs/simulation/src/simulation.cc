@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "genetic_algorithm/crossover.h"
@@ -26,34 +28,185 @@ using cshorelark::random::random_generator;
 using cshorelark::simulation::statistics;
 
 simulation::simulation(config config, world&& world)
-    : config_(config), world_(std::move(world)), age_(0), generation_(0) {}
+    : config_(config),
+      world_(std::move(world)),
+      age_(0),
+      generation_(0),
+      collision_grid_(config.world.food_size + config.world.bird_size),
+      vision_grid_(config.brain_eye.fov_range),
+      pending_(std::make_unique<pending_changes>()) {}
 
 auto simulation::random(const config& config, random_generator& random) -> simulation {
     world world = world::random(config, random);
     return simulation(config, std::move(world));
 }
 
-void simulation::spawn_food(cshorelark::random::random_generator& random) {
-    float pos_x = random.generate_position();
-    float pos_y = random.generate_position();
-    spawn_food(pos_x, pos_y);
+auto simulation::from_chromosomes(const config& config,
+                                  nonstd::span<const genetic::chromosome> chromosomes,
+                                  random_generator& random)
+    -> tl::expected<simulation, simulation_error> {
+    std::vector<animal> animals;
+    animals.reserve(chromosomes.size());
+    for (const auto& chromosome : chromosomes) {
+        auto new_animal = animal::from_chromosome(config, random, chromosome);
+        if (!new_animal) {
+            return tl::make_unexpected(new_animal.error());
+        }
+        animals.push_back(std::move(new_animal.value()));
+    }
+
+    std::vector<food> foods;
+    foods.reserve(config.world.num_foods);
+    for (std::size_t i = 0; i < config.world.num_foods; ++i) {
+        foods.push_back(food::random(random));
+    }
+
+    return simulation(config, world(std::move(animals), std::move(foods)));
+}
+
+void simulation::spawn_food() {
+    const std::lock_guard<std::mutex> lock(pending_->mutex);
+    ++pending_->random_foods;
 }
 
 void simulation::spawn_food(float pos_x, float pos_y) {
-    food new_food(vector2d{pos_x, pos_y});
-    world_.get_foods().push_back(std::move(new_food));
+    const std::lock_guard<std::mutex> lock(pending_->mutex);
+    pending_->foods.emplace_back(pos_x, pos_y);
 }
 
-void simulation::spawn_animal(cshorelark::random::random_generator& random) {
-    animal new_animal = animal::random(config_, random);
-    world_.get_animals().push_back(std::move(new_animal));
+void simulation::spawn_animal() {
+    const std::lock_guard<std::mutex> lock(pending_->mutex);
+    ++pending_->random_animals;
+}
+
+void simulation::despawn_food(food_handle target) {
+    const std::lock_guard<std::mutex> lock(pending_->mutex);
+    pending_->food_removals.push_back(target);
+}
+
+void simulation::despawn_animal(animal_handle target) {
+    const std::lock_guard<std::mutex> lock(pending_->mutex);
+    pending_->animal_removals.push_back(target);
+}
+
+auto simulation::apply_pending(random_generator& random) -> bool {
+    // Swap the queues out so the lock is not held while the world changes
+    pending_changes changes;
+    {
+        const std::lock_guard<std::mutex> lock(pending_->mutex);
+        if (pending_->empty()) {
+            return false;
+        }
+        std::swap(changes.random_foods, pending_->random_foods);
+        changes.foods.swap(pending_->foods);
+        std::swap(changes.random_animals, pending_->random_animals);
+        changes.food_removals.swap(pending_->food_removals);
+        changes.animal_removals.swap(pending_->animal_removals);
+    }
+
+    for (const auto target : changes.food_removals) {
+        world_.remove_food(target);
+    }
+    for (const auto target : changes.animal_removals) {
+        if (const auto* removed = world_.find_animal(target)) {
+            retired_cache_stats_ += removed->get_brain().cache_stats();
+            world_.remove_animal(target);
+            lineage_linked_ = false;
+        }
+    }
+    for (const auto& position : changes.foods) {
+        world_.add_food(food(position));
+    }
+    for (std::size_t i = 0; i < changes.random_foods; ++i) {
+        world_.add_food(food::random(random));
+    }
+    for (std::size_t i = 0; i < changes.random_animals; ++i) {
+        world_.add_animal(animal::random(config_, random));
+        lineage_linked_ = false;
+    }
+    return true;
+}
+
+auto simulation::has_pending() const -> bool {
+    const std::lock_guard<std::mutex> lock(pending_->mutex);
+    return !pending_->empty();
+}
+
+auto simulation::fork() const -> simulation {
+    simulation forked(config_, world_.fork());
+    forked.age_ = age_;
+    forked.generation_ = generation_;
+    forked.retired_cache_stats_ = retired_cache_stats_;
+    forked.digest_enabled_ = digest_enabled_;
+    forked.digest_steps_ = digest_steps_;
+    forked.digest_ = digest_;
+    return forked;
+}
+
+auto simulation::get_brain_cache_stats() const -> brain_cache_stats {
+    brain_cache_stats total = retired_cache_stats_;
+    for (const auto& animal : world_.get_animals()) {
+        total += animal.get_brain().cache_stats();
+    }
+    return total;
+}
+
+void simulation::set_lineage(std::unique_ptr<genetic::lineage_writer> lineage) {
+    lineage_ = std::move(lineage);
+    lineage_linked_ = false;
+}
+
+void simulation::set_digest_enabled(bool enabled) {
+    digest_enabled_ = enabled;
+    digest_steps_ = 0;
+    digest_ = step_digest{};
+}
+
+auto simulation::get_last_digest() const -> std::optional<step_digest> {
+    if (!digest_enabled_ || digest_steps_ == 0) {
+        return std::nullopt;
+    }
+    return digest_;
 }
 
 auto simulation::step(random_generator& random) -> std::optional<statistics> {
+    apply_pending(random);
+    advance_world(random);
+    auto stats = try_evolving(random);
+    record_digest(step_phase::k_evolution, random);
+    return stats;
+}
+
+void simulation::advance(random_generator& random) {
+    apply_pending(random);
+    advance_world(random);
+    record_digest(step_phase::k_evolution, random);
+}
+
+void simulation::advance_world(random_generator& random) {
     process_collisions(random);
+    record_digest(step_phase::k_collisions, random);
     process_brains();
+    record_digest(step_phase::k_brains, random);
     process_movements();
-    return try_evolving(random);
+    record_digest(step_phase::k_movements, random);
+}
+
+void simulation::record_digest(step_phase phase, const random_generator& random) {
+    if (!digest_enabled_) {
+        return;
+    }
+    // Every phase chains onto the one before it, the first onto the previous step
+    const auto index = static_cast<std::size_t>(phase);
+    const std::uint64_t previous =
+        index == 0 ? digest_.value() : digest_.phases[index - 1];
+    if (index == 0) {
+        digest_.step = digest_steps_;
+    }
+    digest_.phases[index] = digest_hasher_.hash(world_, random.fingerprint(), previous);
+    if (phase == step_phase::k_evolution) {
+        ++digest_steps_;
+    }
 }
 
 auto simulation::train(random_generator& random) -> statistics {
@@ -65,9 +218,16 @@ auto simulation::train(random_generator& random) -> statistics {
 }
 
 void simulation::process_collisions(random_generator& random) {
+    if (config_.kernels.collisions == collision_kernel::k_grid) {
+        process_collisions_grid(random);
+        return;
+    }
+
+    // Foods are read through foods() so a forked world only copies them once one is eaten
     for (auto& animal : world_.get_animals()) {
-        for (auto& food : world_.get_foods()) {
+        for (std::size_t i = 0; i < world_.foods_count(); ++i) {
             // Calculate distance between animal and food
+            const auto& food = world_.foods()[i];
             const float disx = animal.position().x() - food.position().x();
             const float disy = animal.position().y() - food.position().y();
             const float distance = std::sqrt(disx * disx + disy * disy);
@@ -78,14 +238,46 @@ void simulation::process_collisions(random_generator& random) {
                 // Animal has a method to increment food_eaten
                 animal.increment_food_eaten();
                 // For now, ensure the food moves to a new random position
+                world_.get_foods()[i].randomize_position(random);
+            }
+        }
+    }
+}
+
+void simulation::process_collisions_grid(random_generator& random) {
+    collision_grid_.rebuild(world_.foods());
+
+    // Same pairs in the same order as the brute-force pass: only the food just eaten
+    // moves while an animal is handled, and the grid follows it for later animals
+    const float collision_distance = config_.world.food_size + config_.world.bird_size;
+    for (auto& animal : world_.get_animals()) {
+        collision_grid_.query(animal.position(), nearby_);
+        for (const auto index : nearby_) {
+            const vector2d food_at = world_.foods()[index].position();
+            const float disx = animal.position().x() - food_at.x();
+            const float disy = animal.position().y() - food_at.y();
+            const float distance = std::sqrt(disx * disx + disy * disy);
+            if (distance <= collision_distance) {
+                animal.increment_food_eaten();
+                auto& food = world_.get_foods()[index];
                 food.randomize_position(random);
+                collision_grid_.move(index, food_at, food.position());
             }
         }
     }
 }
 
 void simulation::process_brains() {
-    auto& foods = world_.get_foods();
+    const auto& foods = world_.foods();
+    if (config_.kernels.vision == vision_kernel::k_grid) {
+        vision_grid_.rebuild(foods);
+        for (auto& animal : world_.get_animals()) {
+            vision_grid_.query(animal.position(), nearby_);
+            animal.process_brain(config_, foods, nearby_);
+        }
+        return;
+    }
+
     for (auto& animal : world_.get_animals()) {
         animal.process_brain(config_, foods);
     }
@@ -113,6 +305,14 @@ auto simulation::evolve(cshorelark::random::random_generator& random) -> statist
 
     spdlog::debug("Evolving generation {}", generation_);
 
+    // Every animal may have been despawned; there is nothing to breed then
+    if (world_.get_animals().empty()) {
+        for (auto& food : world_.get_foods()) {
+            food.randomize_position(random);
+        }
+        return statistics{generation_ - 1, genetic::statistics(0.0F, 0.0F, 0.0F, 0.0F)};
+    }
+
     // Convert animals to individuals for genetic algorithm
     std::vector<std::unique_ptr<cshorelark::genetic::individual>> individuals;
     individuals.reserve(world_.get_animals().size());
@@ -152,8 +352,17 @@ auto simulation::evolve(cshorelark::random::random_generator& random) -> statist
         std::make_unique<genetic::gaussian_mutation>(config_.genetic.mutation_chance,
                                                      config_.genetic.mutation_coeff));
 
+    // The archive needs the parents as a keyframe unless they are its last generation
+    if (lineage_ && !lineage_linked_) {
+        if (auto appended = lineage_->append_population(individuals); !appended) {
+            spdlog::warn("Lineage archiving stopped: {}", appended.error().message);
+            lineage_.reset();
+        }
+    }
+
     // Evolve the population
-    auto evolved_result = gen_algorithm.evolve(individuals, random);
+    std::vector<genetic::parent_pair> parents;
+    auto evolved_result = gen_algorithm.evolve(individuals, random, lineage_ ? &parents : nullptr);
     if (!evolved_result) {
         spdlog::error("Evolution failed: error code {}, message: {}",
                       static_cast<int>(evolved_result.error().code),
@@ -163,6 +372,13 @@ auto simulation::evolve(cshorelark::random::random_generator& random) -> statist
 
     // Access the successful result: first part is evolved individuals, second part is statistics
     auto [evolved_individuals, evolution_stats] = std::move(evolved_result.value());
+    if (lineage_) {
+        if (auto appended = lineage_->append_offspring(evolved_individuals, parents); !appended) {
+            spdlog::warn("Lineage archiving stopped: {}", appended.error().message);
+            lineage_.reset();
+        }
+        lineage_linked_ = true;
+    }
 
     // Convert evolved individuals back to animals
     std::vector<animal> new_animals;
@@ -176,7 +392,10 @@ auto simulation::evolve(cshorelark::random::random_generator& random) -> statist
         }
     }
 
-    // Replace the world's animals with the new generation
+    // Replace the world's animals with the new generation, keeping their cache counters
+    for (const auto& animal : world_.get_animals()) {
+        retired_cache_stats_ += animal.get_brain().cache_stats();
+    }
     world_.set_animals(std::move(new_animals));
 
     // Reset food positions
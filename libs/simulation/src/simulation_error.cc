@@ -28,6 +28,8 @@ auto simulation_error_to_string(simulation_error error) -> const char* {
             return "Invalid chromosome for brain creation";
         case simulation_error::k_brain_operation_failed:
             return "Brain operation failed";
+        case simulation_error::k_invalid_digest_stream:
+            return "Malformed world digest stream";
         default:
             return "Unknown simulation error";
     }
@@ -9,7 +9,9 @@
 #include "simulation/food.h"
 
 // C++ system headers
+#include <atomic>
 #include <cstddef>  // for std::size_t
+#include <memory>
 #include <utility>
 #include <vector>  // for std::vector
 
@@ -18,6 +20,69 @@ namespace cshorelark::simulation {
 // Define world's destructor here where animal is complete
 world::~world() = default;
 
+world::world(std::vector<animal>&& animals, std::vector<food>&& foods)
+    : foods_(std::make_shared<slot_map<food>>()) {
+    set_animals(std::move(animals));
+    foods_->reserve(foods.size());
+    for (auto& new_food : foods) {
+        foods_->insert(new_food);
+    }
+}
+
+auto world::detach_foods() const -> slot_map<food>& {
+    if (foods_.use_count() > 1) {
+        foods_ = std::make_shared<slot_map<food>>(*foods_);
+    } else {
+        // The last fork to let go of the array may have been reading it on another thread
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *foods_;
+}
+
+auto world::get_foods() const -> nonstd::span<food> { return detach_foods().values(); }
+
+auto world::get_animals() const -> nonstd::span<animal> { return animals_.values(); }
+
+auto world::set_animals(std::vector<animal>&& animals) -> void {
+    animals_.clear();
+    animals_.reserve(animals.size());
+    for (auto& new_animal : animals) {
+        animals_.insert(std::move(new_animal));
+    }
+}
+
+auto world::add_food(food new_food) -> food_handle { return detach_foods().insert(new_food); }
+
+auto world::add_animal(animal new_animal) -> animal_handle {
+    return animals_.insert(std::move(new_animal));
+}
+
+auto world::remove_food(food_handle target) -> bool {
+    // A stale handle must not cost a copy of a shared array
+    return foods_->contains(target) && detach_foods().erase(target);
+}
+
+auto world::remove_animal(animal_handle target) -> bool { return animals_.erase(target); }
+
+auto world::animal_handle_at(std::size_t index) const -> animal_handle {
+    return animals_.handle_at(index);
+}
+
+auto world::find_animal(animal_handle target) const -> const animal* {
+    return animals_.get(target);
+}
+
+auto world::fork() const -> world {
+    std::vector<animal> animals;
+    animals.reserve(animals_.size());
+    for (const auto& animal : animals_.values()) {
+        animals.push_back(animal.fork());
+    }
+    world forked(std::move(animals), {});
+    forked.foods_ = foods_;
+    return forked;
+}
+
 auto world::random(const config& cfg, cshorelark::random::random_generator& random) -> world {
     auto foods = std::vector<food>{};
     foods.reserve(cfg.world.num_foods);
@@ -14,6 +14,7 @@
 using Catch::Matchers::WithinRel;
 using cshorelark::simulation::brain;
 using cshorelark::simulation::config;
+using cshorelark::simulation::inference_kernel;
 
 namespace {
 
@@ -161,6 +162,52 @@ TEST_CASE("Brain - Chromosome conversion", "[brain]") {
     }
 }
 
+TEST_CASE("Brain - Adapting chromosomes", "[brain]") {
+    const auto small_cfg = create_test_config();
+    auto large_cfg = small_cfg;
+    large_cfg.brain_eye.num_cells = k_test_eye_cells + 2;
+    large_cfg.brain_eye.num_neurons = k_test_brain_neurons + 3;
+    test_rng rng;
+    const auto original = brain::random(small_cfg, rng).as_chromosome();
+
+    SECTION("A grown brain behaves like the original") {
+        auto grown = brain::adapt_chromosome(original, k_test_eye_cells, k_test_brain_neurons,
+                                             large_cfg);
+        REQUIRE(grown.has_value());
+        auto grown_brain = brain::from_chromosome(large_cfg, *grown);
+        REQUIRE(grown_brain.has_value());
+        auto original_brain = brain::from_chromosome(small_cfg, original);
+        REQUIRE(original_brain.has_value());
+
+        std::vector<float> vision(k_test_eye_cells);
+        for (std::size_t i = 0; i < vision.size(); ++i) {
+            vision[i] = static_cast<float>(i % 4) * 0.25F;
+        }
+        auto wider_vision = vision;
+        wider_vision.resize(large_cfg.brain_eye.num_cells, 0.75F);  // Unseen before, ignored
+        CHECK(grown_brain->propagate(wider_vision).value() ==
+              original_brain->propagate(vision).value());
+    }
+
+    SECTION("Shrinking drops exactly what growing added") {
+        auto grown = brain::adapt_chromosome(original, k_test_eye_cells, k_test_brain_neurons,
+                                             large_cfg);
+        REQUIRE(grown.has_value());
+        auto shrunk = brain::adapt_chromosome(*grown, large_cfg.brain_eye.num_cells,
+                                              large_cfg.brain_eye.num_neurons, small_cfg);
+        REQUIRE(shrunk.has_value());
+        const auto genes = original.genes();
+        const auto shrunk_genes = shrunk->genes();
+        CHECK(std::equal(genes.begin(), genes.end(), shrunk_genes.begin(), shrunk_genes.end()));
+    }
+
+    SECTION("The chromosome must match the size it claims") {
+        CHECK(brain::adapt_chromosome(original, k_test_eye_cells + 1, k_test_brain_neurons,
+                                      large_cfg)
+                  .error() == cshorelark::simulation::simulation_error::k_invalid_chromosome);
+    }
+}
+
 TEST_CASE("Brain - Output ranges", "[brain]") {
     auto cfg = create_test_config();
     test_rng rng;
@@ -185,4 +232,95 @@ TEST_CASE("Brain - Output ranges", "[brain]") {
         REQUIRE(outputs[1] >= -rotation_limit_rad);
         REQUIRE(outputs[1] <= rotation_limit_rad);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Brain - Output caches", "[brain]") {
+    auto cfg = create_test_config();
+    test_rng rng;
+    auto cached = brain::random(cfg, rng);
+    auto uncached_cfg = cfg;
+    uncached_cfg.brain_eye.cache_last_input = false;
+    auto uncached_result = brain::from_chromosome(uncached_cfg, cached.as_chromosome());
+    REQUIRE(uncached_result.has_value());
+    auto uncached = std::move(uncached_result.value());
+
+    const std::vector<float> zeros(cfg.brain_eye.num_cells, 0.0F);
+    std::vector<float> input(cfg.brain_eye.num_cells, 0.0F);
+    input[2] = k_test_value;
+
+    SECTION("Zero input is answered from the precomputed response") {
+        auto result = cached.propagate(zeros);
+        REQUIRE(result.has_value());
+        REQUIRE(cached.cache_stats().zero_hits == 1);
+        REQUIRE(cached.cache_stats().misses == 0);
+
+        // The precomputed response matches a regular propagation of zeros
+        auto other = uncached.propagate(zeros);
+        REQUIRE(other.has_value());
+        REQUIRE(result.value() == other.value());
+    }
+
+    SECTION("Repeated input skips inference and matches the network") {
+        auto first = cached.propagate(input);
+        auto second = cached.propagate(input);
+        REQUIRE(first.has_value());
+        REQUIRE(second.has_value());
+        REQUIRE(first.value() == second.value());
+        REQUIRE(cached.cache_stats().misses == 1);
+        REQUIRE(cached.cache_stats().repeat_hits == 1);
+        REQUIRE_THAT(cached.cache_stats().hit_rate(), WithinRel(0.5F));
+
+        input[2] = 1.0F;
+        auto changed = cached.propagate(input);
+        auto reference = uncached.propagate(input);
+        REQUIRE(changed.has_value());
+        REQUIRE(reference.has_value());
+        REQUIRE(changed.value() == reference.value());
+        REQUIRE(cached.cache_stats().misses == 2);
+    }
+
+    SECTION("Last-input cache can be disabled") {
+        REQUIRE(uncached.propagate(input).has_value());
+        REQUIRE(uncached.propagate(input).has_value());
+        REQUIRE(uncached.cache_stats().repeat_hits == 0);
+        REQUIRE(uncached.cache_stats().misses == 2);
+    }
+
+    SECTION("Invalid input sizes are still rejected") {
+        const std::vector<float> short_zeros(cfg.brain_eye.num_cells - 1, 0.0F);
+        REQUIRE_FALSE(cached.propagate(short_zeros).has_value());
+        REQUIRE(cached.cache_stats().hits() == 0);
+    }
+}
+
+TEST_CASE("Brain - Generated inference", "[brain]") {
+    auto cfg = create_test_config();
+    cfg.brain_eye.cache_last_input = false;
+    test_rng rng;
+    auto generic = brain::random(cfg, rng);
+
+    std::vector<float> input(cfg.brain_eye.num_cells, 0.0F);
+    for (const auto inference : {inference_kernel::k_jit, inference_kernel::k_jit_embedded}) {
+        for (const bool verify : {false, true}) {
+            auto jit_cfg = cfg;
+            jit_cfg.kernels.inference = inference;
+            jit_cfg.kernels.verify_inference = verify;
+            auto generated = brain::from_chromosome(jit_cfg, generic.as_chromosome());
+            REQUIRE(generated.has_value());
+
+            // Platforms without a code generator silently keep the generic path
+            for (std::size_t step = 0; step < k_test_eye_cells; ++step) {
+                input[step] = k_test_value + static_cast<float>(step) / k_test_eye_cells;
+                auto expected = generic.propagate(input);
+                auto actual = generated->propagate(input);
+                REQUIRE(expected.has_value());
+                REQUIRE(actual.has_value());
+                REQUIRE(actual.value() == expected.value());
+            }
+            std::fill(input.begin(), input.end(), 0.0F);
+
+            const std::vector<float> short_input(cfg.brain_eye.num_cells - 1, k_test_value);
+            REQUIRE_FALSE(generated->propagate(short_input).has_value());
+        }
+    }
+}
@@ -57,6 +57,7 @@ TEST_CASE("Config default values match Rust implementation", "[config]") {
     REQUIRE_THAT(cfg.brain_eye.fov_range, WithinRel(k_default_fov_range));
     REQUIRE_THAT(cfg.brain_eye.fov_angle_deg, WithinRel(k_default_fov_angle_deg));
     REQUIRE(cfg.brain_eye.num_cells == k_default_eye_cells);
+    REQUIRE(cfg.brain_eye.cache_last_input);
 
     // World configuration (includes food size)
     REQUIRE_THAT(cfg.world.food_size, WithinRel(k_default_food_size));
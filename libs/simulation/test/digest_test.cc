@@ -0,0 +1,130 @@
+#include "simulation/digest.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+#include "random/random.h"
+#include "simulation/animal.h"
+#include "simulation/config.h"
+#include "simulation/simulation.h"
+
+using cshorelark::random::random_generator;
+using cshorelark::simulation::collision_kernel;
+using cshorelark::simulation::config;
+using cshorelark::simulation::first_divergence;
+using cshorelark::simulation::read_digests;
+using cshorelark::simulation::simulation;
+using cshorelark::simulation::simulation_error;
+using cshorelark::simulation::step_digest;
+using cshorelark::simulation::step_phase;
+using cshorelark::simulation::vision_kernel;
+using cshorelark::simulation::write_digest;
+
+namespace {
+
+constexpr std::uint64_t k_test_rng_seed = 42;
+constexpr std::size_t k_test_steps = 30;
+constexpr std::size_t k_test_perturbed_step = 12;
+
+auto create_test_config() -> config {
+    config cfg;
+    cfg.world.num_foods = 40;
+    cfg.brain_eye.fov_range = 0.2F;
+    cfg.sim.generation_length = 10;
+    return cfg;
+}
+
+// Steps a seeded simulation, drawing one extra random number before perturb_at if given
+auto run(const config& cfg, std::size_t perturb_at = k_test_steps) -> std::vector<step_digest> {
+    random_generator random(k_test_rng_seed);
+    auto sim = simulation::random(cfg, random);
+    sim.set_digest_enabled(true);
+    std::vector<step_digest> digests;
+    for (std::size_t i = 0; i < k_test_steps; ++i) {
+        if (i == perturb_at) {
+            (void)random.generate_position();
+        }
+        sim.step(random);
+        const auto digest = sim.get_last_digest();
+        REQUIRE(digest.has_value());
+        digests.push_back(*digest);
+    }
+    return digests;
+}
+
+}  // namespace
+
+TEST_CASE("Digest - Identical runs give identical streams", "[digest]") {
+    auto cfg = create_test_config();
+    const auto reference = run(cfg);
+    REQUIRE(reference.size() == k_test_steps);
+    CHECK(reference.front().step == 0);
+    CHECK(reference.back().step == k_test_steps - 1);
+    CHECK(reference.front().value() != reference.back().value());
+    CHECK_FALSE(first_divergence(reference, run(cfg)).has_value());
+
+    // Kernels only change speed, so they must not change the digests
+    cfg.kernels.collisions = collision_kernel::k_grid;
+    cfg.kernels.vision = vision_kernel::k_grid;
+    CHECK_FALSE(first_divergence(reference, run(cfg)).has_value());
+}
+
+TEST_CASE("Digest - Divergence is reported at its step and phase", "[digest]") {
+    const auto cfg = create_test_config();
+    const auto reference = run(cfg);
+    const auto perturbed = run(cfg, k_test_perturbed_step);
+
+    const auto divergence = first_divergence(reference, perturbed);
+    REQUIRE(divergence.has_value());
+    CHECK(divergence->index == k_test_perturbed_step);
+    CHECK(divergence->step == k_test_perturbed_step);
+    REQUIRE(divergence->phase.has_value());
+    CHECK(*divergence->phase == step_phase::k_collisions);
+
+    // Chaining keeps every later step apart
+    for (std::size_t i = k_test_perturbed_step; i < k_test_steps; ++i) {
+        CHECK(reference[i].value() != perturbed[i].value());
+    }
+}
+
+TEST_CASE("Digest - Streams", "[digest]") {
+    const auto reference = run(create_test_config());
+
+    SECTION("Round trip") {
+        std::stringstream stream;
+        for (const auto& digest : reference) {
+            write_digest(stream, digest);
+        }
+        const auto read = read_digests(stream);
+        REQUIRE(read.has_value());
+        CHECK(*read == reference);
+    }
+
+    SECTION("A shorter stream diverges where it ends") {
+        const std::vector<step_digest> shorter(reference.begin(), reference.begin() + 5);
+        const auto divergence = first_divergence(reference, shorter);
+        REQUIRE(divergence.has_value());
+        CHECK(divergence->index == 5);
+        CHECK(divergence->step == 5);
+        CHECK_FALSE(divergence->phase.has_value());
+    }
+
+    SECTION("Malformed records are rejected") {
+        std::istringstream missing_phase("0 1 2 3\n");
+        std::istringstream extra_field("0 1 2 3 4 5\n");
+        std::istringstream not_hex("0 1 2 3 xyz\n");
+        CHECK(read_digests(missing_phase).error() == simulation_error::k_invalid_digest_stream);
+        CHECK(read_digests(extra_field).error() == simulation_error::k_invalid_digest_stream);
+        CHECK(read_digests(not_hex).error() == simulation_error::k_invalid_digest_stream);
+    }
+
+    SECTION("Nothing is digested while turned off") {
+        random_generator random(k_test_rng_seed);
+        auto sim = simulation::random(create_test_config(), random);
+        sim.step(random);
+        CHECK_FALSE(sim.get_last_digest().has_value());
+    }
+}
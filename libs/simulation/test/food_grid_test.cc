@@ -0,0 +1,91 @@
+#include "simulation/food_grid.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "random/random.h"
+#include "simulation/food.h"
+#include "simulation/vector2d.h"
+
+using cshorelark::simulation::food;
+using cshorelark::simulation::food_grid;
+using cshorelark::simulation::vector2d;
+
+namespace {
+
+// Test constants to avoid magic numbers
+constexpr float k_test_radius = 0.1F;
+constexpr std::size_t k_test_num_foods = 200;
+constexpr std::size_t k_test_num_queries = 100;
+constexpr std::uint64_t k_test_rng_seed = 7;
+
+auto random_foods(cshorelark::random::random_generator& random) -> std::vector<food> {
+    std::vector<food> foods;
+    for (std::size_t i = 0; i < k_test_num_foods; ++i) {
+        foods.push_back(food::random(random));
+    }
+    return foods;
+}
+
+// Every food within the radius must be a candidate
+auto covers(const food_grid& grid, const std::vector<food>& foods, const vector2d& position)
+    -> bool {
+    std::vector<std::size_t> nearby;
+    grid.query(position, nearby);
+    if (!std::is_sorted(nearby.begin(), nearby.end())) {
+        return false;
+    }
+    for (std::size_t index = 0; index < foods.size(); ++index) {
+        const auto distance = (foods[index].position() - position).length();
+        if (distance <= k_test_radius &&
+            !std::binary_search(nearby.begin(), nearby.end(), index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("Food grid - Sizing", "[food_grid]") {
+    CHECK(food_grid(k_test_radius).cells_per_side() == 9);
+    CHECK(food_grid(0.5F).cells_per_side() == 1);
+    CHECK(food_grid(2.0F).cells_per_side() == 1);
+    CHECK(food_grid(0.0F).cells_per_side() == 1);
+    CHECK(food_grid(1e-6F).cells_per_side() == 256);
+}
+
+TEST_CASE("Food grid - Queries cover the radius", "[food_grid]") {
+    cshorelark::random::random_generator random(k_test_rng_seed);
+    auto foods = random_foods(random);
+    food_grid grid(k_test_radius);
+    grid.rebuild(foods);
+
+    SECTION("Random points") {
+        for (std::size_t i = 0; i < k_test_num_queries; ++i) {
+            const vector2d position{random.generate_position(), random.generate_position()};
+            CHECK(covers(grid, foods, position));
+        }
+    }
+
+    SECTION("World corners and edges") {
+        for (const auto& position : {vector2d{0.0F, 0.0F}, vector2d{1.0F, 1.0F},
+                                     vector2d{0.0F, 1.0F}, vector2d{0.5F, 0.0F}}) {
+            CHECK(covers(grid, foods, position));
+        }
+    }
+
+    SECTION("Moved foods are found at their new position") {
+        for (std::size_t index = 0; index < foods.size(); index += 3) {
+            const vector2d from = foods[index].position();
+            foods[index].randomize_position(random);
+            grid.move(index, from, foods[index].position());
+        }
+        for (std::size_t i = 0; i < k_test_num_queries; ++i) {
+            const vector2d position{random.generate_position(), random.generate_position()};
+            CHECK(covers(grid, foods, position));
+        }
+    }
+}
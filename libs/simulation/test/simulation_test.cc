@@ -0,0 +1,336 @@
+#include "simulation/simulation.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "genetic_algorithm/chromosome.h"
+#include "genetic_algorithm/lineage.h"
+#include "random/random.h"
+#include "simulation/animal.h"
+#include "simulation/config.h"
+#include "simulation/simulation_error.h"
+
+using cshorelark::genetic::chromosome;
+using cshorelark::random::random_generator;
+using cshorelark::simulation::config;
+using cshorelark::simulation::simulation;
+using cshorelark::simulation::simulation_error;
+
+namespace {
+
+// Test constants to avoid magic numbers
+constexpr std::size_t k_test_num_foods = 10;
+constexpr std::size_t k_test_num_genomes = 4;
+constexpr std::size_t k_test_generation_length = 20;
+constexpr std::uint64_t k_test_rng_seed = 42;
+
+auto create_test_config() -> config {
+    config cfg;
+    cfg.world.num_foods = k_test_num_foods;
+    cfg.sim.generation_length = k_test_generation_length;
+    return cfg;
+}
+
+auto random_genomes(const config& cfg, std::size_t count) -> std::vector<chromosome> {
+    random_generator random(k_test_rng_seed);
+    auto source = simulation::random(cfg, random);
+    std::vector<chromosome> genomes;
+    for (const auto& animal : source.get_world().get_animals()) {
+        if (genomes.size() == count) {
+            break;
+        }
+        genomes.push_back(animal.as_chromosome());
+    }
+    return genomes;
+}
+
+auto same_genes(const chromosome& lhs, const chromosome& rhs) -> bool {
+    const auto lhs_genes = lhs.genes();
+    const auto rhs_genes = rhs.genes();
+    return std::equal(lhs_genes.begin(), lhs_genes.end(), rhs_genes.begin(), rhs_genes.end());
+}
+
+}  // namespace
+
+TEST_CASE("Simulation - From chromosomes", "[simulation]") {
+    const auto cfg = create_test_config();
+    const auto genomes = random_genomes(cfg, k_test_num_genomes);
+
+    SECTION("One animal per chromosome, in order") {
+        random_generator random(k_test_rng_seed);
+        auto sim = simulation::from_chromosomes(cfg, genomes, random);
+
+        REQUIRE(sim.has_value());
+        const auto& animals = sim->get_world().get_animals();
+        REQUIRE(animals.size() == genomes.size());
+        REQUIRE(sim->get_world().foods_count() == k_test_num_foods);
+        for (std::size_t i = 0; i < genomes.size(); ++i) {
+            REQUIRE(same_genes(animals[i].as_chromosome(), genomes[i]));
+        }
+    }
+
+    SECTION("Chromosomes of the wrong size are rejected") {
+        std::vector<chromosome> bad;
+        bad.emplace_back(std::vector<float>{1.0F, 2.0F});
+        random_generator random(k_test_rng_seed);
+        auto sim = simulation::from_chromosomes(cfg, bad, random);
+
+        REQUIRE_FALSE(sim.has_value());
+        REQUIRE(sim.error() == simulation_error::k_invalid_chromosome);
+    }
+}
+
+TEST_CASE("Simulation - Advance never evolves", "[simulation]") {
+    const auto cfg = create_test_config();
+    const auto genomes = random_genomes(cfg, k_test_num_genomes);
+    random_generator random(k_test_rng_seed);
+    auto sim = simulation::from_chromosomes(cfg, genomes, random);
+    REQUIRE(sim.has_value());
+
+    for (std::size_t i = 0; i < 3 * k_test_generation_length; ++i) {
+        sim->advance(random);
+    }
+
+    REQUIRE(sim->get_generation() == 0);
+    REQUIRE(sim->get_age() == 0);
+    const auto& animals = sim->get_world().get_animals();
+    for (std::size_t i = 0; i < genomes.size(); ++i) {
+        REQUIRE(same_genes(animals[i].as_chromosome(), genomes[i]));
+    }
+}
+
+TEST_CASE("Simulation - Seeded episodes are reproducible", "[simulation]") {
+    const auto cfg = create_test_config();
+    const auto genomes = random_genomes(cfg, k_test_num_genomes);
+
+    auto run_episode = [&](std::uint64_t seed) {
+        random_generator random(seed);
+        auto sim = simulation::from_chromosomes(cfg, genomes, random);
+        REQUIRE(sim.has_value());
+        for (std::size_t i = 0; i < k_test_generation_length; ++i) {
+            sim->advance(random);
+        }
+        std::vector<std::size_t> eaten;
+        for (const auto& animal : sim->get_world().get_animals()) {
+            eaten.push_back(animal.food_eaten());
+        }
+        return eaten;
+    };
+
+    REQUIRE(run_episode(k_test_rng_seed) == run_episode(k_test_rng_seed));
+}
+
+TEST_CASE("Simulation - Kernels give identical results", "[simulation]") {
+    auto cfg = create_test_config();
+    cfg.world.num_foods = 60;
+    cfg.brain_eye.fov_range = 0.1F;
+
+    const auto run = [&cfg](cshorelark::simulation::collision_kernel collisions,
+                            cshorelark::simulation::vision_kernel vision) {
+        auto kernel_cfg = cfg;
+        kernel_cfg.kernels.collisions = collisions;
+        kernel_cfg.kernels.vision = vision;
+        random_generator random(k_test_rng_seed);
+        auto sim = simulation::random(kernel_cfg, random);
+        std::vector<float> trace;
+        for (int generation = 0; generation < 3; ++generation) {
+            const auto stats = sim.train(random);
+            trace.push_back(stats.ga_stats().avg_fitness());
+        }
+        for (const auto& animal : sim.get_world().get_animals()) {
+            trace.push_back(animal.position().x());
+            trace.push_back(animal.position().y());
+            trace.insert(trace.end(), animal.vision().begin(), animal.vision().end());
+        }
+        return trace;
+    };
+
+    using cshorelark::simulation::collision_kernel;
+    using cshorelark::simulation::vision_kernel;
+    const auto reference = run(collision_kernel::k_brute_force, vision_kernel::k_brute_force);
+    CHECK(run(collision_kernel::k_grid, vision_kernel::k_brute_force) == reference);
+    CHECK(run(collision_kernel::k_brute_force, vision_kernel::k_grid) == reference);
+    CHECK(run(collision_kernel::k_grid, vision_kernel::k_grid) == reference);
+}
+
+TEST_CASE("Simulation - Forks branch from a common state", "[simulation]") {
+    const auto cfg = create_test_config();
+    random_generator random(k_test_rng_seed);
+    auto sim = simulation::random(cfg, random);
+    for (std::size_t i = 0; i < k_test_generation_length / 2; ++i) {
+        sim.step(random);
+    }
+
+    const auto trace = [](const simulation& branch) {
+        std::vector<float> values;
+        for (const auto& animal : branch.get_world().get_animals()) {
+            values.push_back(animal.position().x());
+            values.push_back(animal.position().y());
+            values.push_back(static_cast<float>(animal.food_eaten()));
+        }
+        for (const auto& food : branch.get_world().foods()) {
+            values.push_back(food.position().x());
+            values.push_back(food.position().y());
+        }
+        return values;
+    };
+
+    SECTION("A fork starts in the same state and shares the foods") {
+        const auto branch = sim.fork();
+        CHECK(branch.get_age() == sim.get_age());
+        CHECK(branch.get_generation() == sim.get_generation());
+        CHECK(trace(branch) == trace(sim));
+        CHECK(branch.get_world().foods().data() == sim.get_world().foods().data());
+    }
+
+    SECTION("Changing a fork leaves the origin untouched") {
+        const auto before = trace(sim);
+        auto branch = sim.fork();
+        branch.spawn_food(0.5F, 0.5F);
+        CHECK(branch.apply_pending(random));
+        CHECK(branch.get_world().foods_count() == k_test_num_foods + 1);
+        CHECK(sim.get_world().foods_count() == k_test_num_foods);
+        for (std::size_t i = 0; i < k_test_generation_length; ++i) {
+            branch.step(random);
+        }
+        CHECK(trace(sim) == before);
+    }
+
+    SECTION("Forks stepped in parallel match the origin stepped alone") {
+        constexpr std::size_t k_branches = 4;
+        std::vector<simulation> branches;
+        for (std::size_t i = 0; i < k_branches; ++i) {
+            branches.push_back(sim.fork());
+        }
+        const auto run = [](simulation& branch, std::uint64_t seed) {
+            random_generator branch_random(seed);
+            for (std::size_t i = 0; i < 3 * k_test_generation_length; ++i) {
+                branch.step(branch_random);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < k_branches; ++i) {
+            threads.emplace_back(run, std::ref(branches[i]), k_test_rng_seed + i % 2);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        run(sim, k_test_rng_seed);
+        CHECK(trace(branches[0]) == trace(sim));
+        CHECK(trace(branches[2]) == trace(sim));
+        CHECK(trace(branches[1]) == trace(branches[3]));
+    }
+}
+
+TEST_CASE("Simulation - Spawns and despawns wait for a step boundary", "[simulation]") {
+    const auto cfg = create_test_config();
+    random_generator random(k_test_rng_seed);
+    auto sim = simulation::random(cfg, random);
+    const auto num_animals = sim.get_world().get_animals().size();
+
+    SECTION("Queued spawns land when applied") {
+        CHECK_FALSE(sim.has_pending());
+        sim.spawn_food(0.25F, 0.75F);
+        sim.spawn_food();
+        sim.spawn_animal();
+        CHECK(sim.has_pending());
+        CHECK(sim.get_world().foods_count() == k_test_num_foods);
+        CHECK(sim.get_world().get_animals().size() == num_animals);
+
+        CHECK(sim.apply_pending(random));
+        CHECK(sim.get_world().foods_count() == k_test_num_foods + 2);
+        CHECK(sim.get_world().get_animals().size() == num_animals + 1);
+        CHECK_FALSE(sim.has_pending());
+        CHECK_FALSE(sim.apply_pending(random));
+    }
+
+    SECTION("Despawned handles go stale and are ignored afterwards") {
+        const auto food = sim.get_world().food_handle_at(0);
+        const auto animal = sim.get_world().animal_handle_at(num_animals - 1);
+        sim.despawn_food(food);
+        sim.despawn_animal(animal);
+        REQUIRE(sim.get_world().find_food(food) != nullptr);
+
+        sim.step(random);
+        CHECK(sim.get_world().find_food(food) == nullptr);
+        CHECK(sim.get_world().find_animal(animal) == nullptr);
+        CHECK(sim.get_world().foods_count() == k_test_num_foods - 1);
+        CHECK(sim.get_world().get_animals().size() == num_animals - 1);
+
+        sim.despawn_food(food);
+        sim.spawn_food();
+        sim.step(random);
+        CHECK(sim.get_world().foods_count() == k_test_num_foods);
+        CHECK(sim.get_world().find_food(food) == nullptr);
+    }
+
+    SECTION("Spawning from another thread while stepping") {
+        constexpr std::size_t k_spawned = 200;
+        std::thread spawner([&sim] {
+            for (std::size_t i = 0; i < k_spawned; ++i) {
+                sim.spawn_food(0.5F, 0.5F);
+            }
+        });
+        for (std::size_t i = 0; i < k_test_generation_length / 2; ++i) {
+            sim.step(random);
+        }
+        spawner.join();
+        sim.apply_pending(random);
+        CHECK(sim.get_world().foods_count() == k_test_num_foods + k_spawned);
+    }
+
+    SECTION("An empty world still evolves") {
+        for (std::size_t i = 0; i < num_animals; ++i) {
+            sim.despawn_animal(sim.get_world().animal_handle_at(i));
+        }
+        for (std::size_t i = 0; i <= k_test_generation_length; ++i) {
+            sim.step(random);
+        }
+        CHECK(sim.get_world().get_animals().empty());
+        CHECK(sim.get_generation() == 1);
+    }
+}
+
+TEST_CASE("Simulation - Lineage archive follows the animals", "[simulation]") {
+    const auto path = std::filesystem::temp_directory_path() / "cshorelark_simulation.lineage";
+    const auto cfg = create_test_config();
+    random_generator random(k_test_rng_seed);
+    auto sim = simulation::random(cfg, random);
+    const auto genes = sim.get_world().get_animals().front().as_chromosome().size();
+
+    auto writer = cshorelark::genetic::lineage_writer::create(path, genes, 2);
+    REQUIRE(writer.has_value());
+    sim.set_lineage(std::make_unique<cshorelark::genetic::lineage_writer>(std::move(*writer)));
+    for (int generation = 0; generation < 3; ++generation) {
+        sim.train(random);
+    }
+
+    // A despawn breaks the chain of parents, so the next evolution starts from a keyframe
+    sim.despawn_animal(sim.get_world().animal_handle_at(0));
+    sim.train(random);
+    sim.train(random);
+    sim.set_lineage(nullptr);
+
+    {
+        auto archive = cshorelark::genetic::lineage_archive::open(path);
+        REQUIRE(archive.has_value());
+        CHECK(archive->generations() == 7);
+        auto last = archive->reconstruct_generation(archive->generations() - 1);
+        REQUIRE(last.has_value());
+        const auto& animals = sim.get_world().get_animals();
+        REQUIRE(last->size() == animals.size());
+        for (std::size_t i = 0; i < animals.size(); ++i) {
+            CHECK(same_genes((*last)[i], animals[i].as_chromosome()));
+        }
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,80 @@
+#include "simulation/slot_map.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <vector>
+
+using cshorelark::simulation::slot_map;
+
+namespace {
+
+// Test constants to avoid magic numbers
+constexpr int k_test_num_values = 64;
+
+auto sorted_values(const slot_map<int>& map) -> std::vector<int> {
+    std::vector<int> values(map.values().begin(), map.values().end());
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+}  // namespace
+
+TEST_CASE("Slot map - Insert and erase", "[slot_map]") {
+    slot_map<int> map;
+    std::vector<slot_map<int>::handle> handles;
+    for (int i = 0; i < k_test_num_values; ++i) {
+        handles.push_back(map.insert(i));
+    }
+    REQUIRE(map.size() == k_test_num_values);
+
+    SECTION("Handles find their values") {
+        for (int i = 0; i < k_test_num_values; ++i) {
+            REQUIRE(map.get(handles[i]) != nullptr);
+            CHECK(*map.get(handles[i]) == i);
+        }
+    }
+
+    SECTION("Erasing keeps the other handles and packs the values") {
+        for (int i = 0; i < k_test_num_values; i += 2) {
+            CHECK(map.erase(handles[i]));
+        }
+        CHECK(map.size() == k_test_num_values / 2);
+        for (int i = 0; i < k_test_num_values; ++i) {
+            CHECK(map.contains(handles[i]) == (i % 2 == 1));
+            if (i % 2 == 1) {
+                CHECK(*map.get(handles[i]) == i);
+            }
+        }
+        for (std::size_t i = 0; i < map.size(); ++i) {
+            CHECK(*map.get(map.handle_at(i)) == map.values()[i]);
+        }
+        CHECK_FALSE(map.erase(handles[0]));
+    }
+
+    SECTION("Freed slots are reused under a new generation") {
+        map.erase(handles[3]);
+        const auto reused = map.insert(100);
+        CHECK(reused.index == handles[3].index);
+        CHECK(reused != handles[3]);
+        CHECK(map.get(handles[3]) == nullptr);
+        CHECK(*map.get(reused) == 100);
+    }
+
+    SECTION("Clearing invalidates every handle") {
+        map.clear();
+        CHECK(map.empty());
+        for (const auto handle : handles) {
+            CHECK_FALSE(map.contains(handle));
+        }
+        const auto handle = map.insert(7);
+        CHECK(sorted_values(map) == std::vector<int>{7});
+        CHECK(*map.get(handle) == 7);
+    }
+
+    SECTION("Default handles refer to nothing") {
+        const slot_map<int>::handle none;
+        CHECK_FALSE(none.is_valid());
+        CHECK_FALSE(map.contains(none));
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef CSHORELARK_WORLD_STREAM_CLIENT_H
+#define CSHORELARK_WORLD_STREAM_CLIENT_H
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tl/expected.hpp>
+
+#include "world_stream/frame.h"
+#include "world_stream/stream_error.h"
+
+namespace cshorelark::world_stream {
+
+/**
+ * @brief Receives world frames and statistics from a stream_server.
+ *
+ * Frames are decoded on a network thread; the consumer picks up the most
+ * recent one with take_frame(), older frames it did not pick up are dropped.
+ */
+class stream_client {
+public:
+    stream_client();
+
+    /**
+     * @brief Disconnects from the server.
+     */
+    ~stream_client();
+
+    stream_client(const stream_client&) = delete;
+    stream_client& operator=(const stream_client&) = delete;
+    stream_client(stream_client&&) = delete;
+    stream_client& operator=(stream_client&&) = delete;
+
+    /**
+     * @brief Connects to a server and starts receiving.
+     * @param host Server host name or address
+     * @param port Server port
+     * @param frame_rate Frames per second wanted, 0 pauses the stream
+     * @return The world parameters sent by the server, or the error
+     */
+    auto connect(const std::string& host, std::uint16_t port, float frame_rate)
+        -> tl::expected<world_info, stream_error>;
+
+    /**
+     * @brief Closes the connection and stops the network thread.
+     */
+    void disconnect();
+
+    /**
+     * @brief Asks the server for another frame rate.
+     * @param frame_rate Frames per second, 0 pauses the stream
+     */
+    void set_frame_rate(float frame_rate);
+
+    /**
+     * @brief Takes the most recent frame if one arrived since the last call.
+     * @param frame Receives the frame, its buffers are recycled by the client
+     * @return true if a new frame was taken
+     */
+    auto take_frame(world_frame& frame) -> bool;
+
+    /**
+     * @brief Takes the oldest statistics message not taken yet.
+     * @return The statistics, or nullopt if there are none
+     */
+    auto take_stats() -> std::optional<generation_stats>;
+
+    /**
+     * @brief Checks whether the connection is up.
+     * @return true while connected
+     */
+    [[nodiscard]] auto is_connected() const noexcept -> bool;
+
+    /**
+     * @brief Gets the number of frames decoded since connecting.
+     * @return Frame count
+     */
+    [[nodiscard]] auto frames_received() const noexcept -> std::uint64_t;
+
+    /**
+     * @brief Gets the number of bytes received since connecting.
+     * @return Byte count
+     */
+    [[nodiscard]] auto bytes_received() const noexcept -> std::uint64_t;
+
+private:
+    struct impl;
+    std::shared_ptr<impl> impl_;
+};
+
+}  // namespace cshorelark::world_stream
+
+#endif  // CSHORELARK_WORLD_STREAM_CLIENT_H
@@ -0,0 +1,89 @@
+#ifndef CSHORELARK_WORLD_STREAM_FRAME_H
+#define CSHORELARK_WORLD_STREAM_FRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "simulation/animal.h"
+#include "simulation/simulation.h"
+
+namespace cshorelark::world_stream {
+
+/**
+ * @brief Streamed state of an animal.
+ */
+struct bird_state {
+    float pos_x{0.0F};
+    float pos_y{0.0F};
+    float rotation{0.0F};
+    float speed{0.0F};
+    std::uint32_t fitness{0};
+};
+
+/**
+ * @brief Streamed state of a food.
+ */
+struct food_state {
+    float pos_x{0.0F};
+    float pos_y{0.0F};
+};
+
+/**
+ * @brief Snapshot of the world sent to clients.
+ */
+struct world_frame {
+    std::uint64_t sequence{0};    ///< Increases with every published snapshot
+    std::uint64_t generation{0};  ///< Simulation generation
+    std::uint64_t age{0};         ///< Steps into the current generation
+    std::vector<bird_state> birds;
+    std::vector<food_state> foods;
+};
+
+/**
+ * @brief Fitness statistics of a completed generation.
+ */
+struct generation_stats {
+    std::uint64_t generation{0};
+    float min_fitness{0.0F};
+    float max_fitness{0.0F};
+    float avg_fitness{0.0F};
+    float median_fitness{0.0F};
+};
+
+/**
+ * @brief World parameters a client needs to draw the frames.
+ */
+struct world_info {
+    float food_size{0.0F};
+    float bird_size{0.0F};
+    float fov_range{0.0F};
+    float fov_angle_deg{0.0F};
+};
+
+/**
+ * @brief Copies the current state of a simulation into a frame.
+ *
+ * @param sim The simulation
+ * @param sequence Sequence number of the snapshot
+ * @param frame Frame to fill, its buffers are reused
+ */
+void capture_frame(const simulation::simulation& sim, std::uint64_t sequence, world_frame& frame);
+
+/**
+ * @brief Converts simulation statistics to their streamed form.
+ * @param stats The statistics
+ * @return The streamed statistics
+ */
+[[nodiscard]] auto to_generation_stats(const simulation::statistics& stats) -> generation_stats;
+
+/**
+ * @brief Extracts the drawing parameters of a simulation config.
+ * @param config The configuration
+ * @return The world parameters
+ */
+[[nodiscard]] auto to_world_info(const simulation::config& config) -> world_info;
+
+}  // namespace cshorelark::world_stream
+
+#endif  // CSHORELARK_WORLD_STREAM_FRAME_H
@@ -0,0 +1,106 @@
+#ifndef CSHORELARK_WORLD_STREAM_FRAME_CODEC_H
+#define CSHORELARK_WORLD_STREAM_FRAME_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+#include <vector>
+
+#include "world_stream/frame.h"
+#include "world_stream/stream_error.h"
+
+namespace cshorelark::world_stream {
+
+/// Largest speed that survives quantization, higher speeds are clamped
+inline constexpr float k_max_encoded_speed = 0.05F;
+
+/**
+ * @brief World frame quantized to 16-bit fixed point, the unit of delta coding.
+ */
+struct quantized_frame {
+    std::uint64_t sequence{0};
+    std::uint64_t generation{0};
+    std::uint64_t age{0};
+    std::vector<std::uint16_t> bird_x;
+    std::vector<std::uint16_t> bird_y;
+    std::vector<std::uint16_t> bird_rotation;
+    std::vector<std::uint16_t> bird_speed;
+    std::vector<std::uint32_t> bird_fitness;
+    std::vector<std::uint16_t> food_x;
+    std::vector<std::uint16_t> food_y;
+};
+
+/**
+ * @brief Encodes world frames for one client.
+ *
+ * Positions, rotations and speeds are quantized to 16 bits. A frame is sent
+ * as the zigzag varint difference to the previous frame sent to the same
+ * client, so a bird moving a few pixels costs a couple of bytes. A keyframe is
+ * sent first, whenever the number of entities changes and every
+ * keyframe_interval frames.
+ */
+class frame_encoder {
+public:
+    /**
+     * @brief Constructs an encoder.
+     * @param keyframe_interval Maximum number of delta frames between keyframes
+     */
+    explicit frame_encoder(std::uint32_t keyframe_interval = 120);
+
+    /**
+     * @brief Appends a complete k_frame message to a buffer.
+     * @param frame The frame to encode
+     * @param out Buffer receiving the message
+     */
+    void encode(const world_frame& frame, std::vector<std::uint8_t>& out);
+
+    /**
+     * @brief Forces the next frame to be a keyframe.
+     */
+    void reset() noexcept { has_reference_ = false; }
+
+private:
+    std::uint32_t keyframe_interval_;
+    std::uint32_t frames_since_keyframe_{0};
+    bool has_reference_{false};
+    quantized_frame reference_;
+    quantized_frame current_;
+};
+
+/**
+ * @brief Decodes the k_frame messages produced by a frame_encoder.
+ */
+class frame_decoder {
+public:
+    /**
+     * @brief Decodes a k_frame payload.
+     * @param payload Message payload without the header
+     * @param frame Frame receiving the decoded state
+     * @return Nothing on success, or the decoding error
+     */
+    auto decode(nonstd::span<const std::uint8_t> payload, world_frame& frame)
+        -> tl::expected<void, stream_error>;
+
+private:
+    bool has_reference_{false};
+    quantized_frame reference_;
+};
+
+/**
+ * @brief Quantizes a frame.
+ * @param frame The frame
+ * @param out Receives the quantized frame, its buffers are reused
+ */
+void quantize(const world_frame& frame, quantized_frame& out);
+
+/**
+ * @brief Converts a quantized frame back to floating point.
+ * @param frame The quantized frame
+ * @param out Receives the frame, its buffers are reused
+ */
+void dequantize(const quantized_frame& frame, world_frame& out);
+
+}  // namespace cshorelark::world_stream
+
+#endif  // CSHORELARK_WORLD_STREAM_FRAME_CODEC_H
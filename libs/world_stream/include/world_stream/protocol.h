@@ -0,0 +1,139 @@
+#ifndef CSHORELARK_WORLD_STREAM_PROTOCOL_H
+#define CSHORELARK_WORLD_STREAM_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <nonstd/span.hpp>
+#include <tl/expected.hpp>
+#include <vector>
+
+#include "world_stream/frame.h"
+#include "world_stream/stream_error.h"
+
+namespace cshorelark::world_stream {
+
+/**
+ * @brief Wire protocol between the simulation server and its clients.
+ *
+ * Every message is a 4-byte little-endian payload size, a 1-byte message type
+ * and the payload. A client sends k_hello with its frame rate and gets
+ * k_welcome back; afterwards the server streams k_frame and k_stats messages
+ * while the client may change its rate with k_set_rate at any time.
+ */
+enum class message_type : std::uint8_t {
+    k_hello = 1,     ///< Client: protocol version and requested frame rate
+    k_welcome = 2,   ///< Server: protocol version and world parameters
+    k_set_rate = 3,  ///< Client: new frame rate, 0 pauses the stream
+    k_frame = 4,     ///< Server: keyframe or delta-encoded world frame
+    k_stats = 5,     ///< Server: statistics of a completed generation
+};
+
+inline constexpr std::uint16_t k_protocol_version = 1;
+inline constexpr std::size_t k_header_size = 5;
+inline constexpr std::uint32_t k_max_payload_size = 64U * 1024U * 1024U;  ///< Server messages
+inline constexpr std::uint32_t k_max_client_payload_size = 64U * 1024U;    ///< Client messages
+
+/**
+ * @brief Tells whether clients send a message type, rather than the server.
+ */
+constexpr auto is_client_message(message_type type) noexcept -> bool {
+    return type == message_type::k_hello || type == message_type::k_set_rate;
+}
+
+/**
+ * @brief Decoded message header.
+ */
+struct message_header {
+    std::uint32_t payload_size{0};
+    message_type type{message_type::k_hello};
+};
+
+/**
+ * @brief Appends little-endian primitives and varints to a byte buffer.
+ */
+class byte_writer {
+public:
+    explicit byte_writer(std::vector<std::uint8_t>& out) : out_(out) {}
+
+    void put_u8(std::uint8_t value) { out_.push_back(value); }
+    void put_u16(std::uint16_t value);
+    void put_u32(std::uint32_t value);
+    void put_f32(float value);
+    void put_varint(std::uint64_t value);
+    void put_zigzag(std::int64_t value);
+
+    /**
+     * @brief Starts a message, the size is patched by end_message().
+     * @param type Message type
+     * @return Offset of the message in the buffer
+     */
+    auto begin_message(message_type type) -> std::size_t;
+
+    /**
+     * @brief Writes the payload size of a message started with begin_message().
+     * @param offset Offset returned by begin_message()
+     */
+    void end_message(std::size_t offset);
+
+private:
+    std::vector<std::uint8_t>& out_;
+};
+
+/**
+ * @brief Reads little-endian primitives and varints from a byte buffer.
+ *
+ * Reads past the end leave the reader in a failed state and return zero, so a
+ * decoder checks ok() once at the end.
+ */
+class byte_reader {
+public:
+    explicit byte_reader(nonstd::span<const std::uint8_t> data) : data_(data) {}
+
+    auto get_u8() -> std::uint8_t;
+    auto get_u16() -> std::uint16_t;
+    auto get_u32() -> std::uint32_t;
+    auto get_f32() -> float;
+    auto get_varint() -> std::uint64_t;
+    auto get_zigzag() -> std::int64_t;
+
+    [[nodiscard]] auto ok() const noexcept -> bool { return ok_; }
+    [[nodiscard]] auto remaining() const noexcept -> std::size_t {
+        return data_.size() - position_;
+    }
+
+private:
+    nonstd::span<const std::uint8_t> data_;
+    std::size_t position_{0};
+    bool ok_{true};
+};
+
+/**
+ * @brief Parses a message header.
+ *
+ * Client messages are small control messages and may not exceed
+ * k_max_client_payload_size, so a client cannot make the server allocate
+ * the room of a world frame.
+ *
+ * @param data At least k_header_size bytes
+ * @return The header or an error if it is invalid
+ */
+auto parse_header(nonstd::span<const std::uint8_t> data)
+    -> tl::expected<message_header, stream_error>;
+
+void write_hello(std::vector<std::uint8_t>& out, float frame_rate);
+auto read_hello(nonstd::span<const std::uint8_t> payload) -> tl::expected<float, stream_error>;
+
+void write_welcome(std::vector<std::uint8_t>& out, const world_info& info);
+auto read_welcome(nonstd::span<const std::uint8_t> payload)
+    -> tl::expected<world_info, stream_error>;
+
+void write_set_rate(std::vector<std::uint8_t>& out, float frame_rate);
+auto read_set_rate(nonstd::span<const std::uint8_t> payload) -> tl::expected<float, stream_error>;
+
+void write_stats(std::vector<std::uint8_t>& out, const generation_stats& stats);
+auto read_stats(nonstd::span<const std::uint8_t> payload)
+    -> tl::expected<generation_stats, stream_error>;
+
+}  // namespace cshorelark::world_stream
+
+#endif  // CSHORELARK_WORLD_STREAM_PROTOCOL_H
@@ -0,0 +1,92 @@
+#ifndef CSHORELARK_WORLD_STREAM_SERVER_H
+#define CSHORELARK_WORLD_STREAM_SERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tl/expected.hpp>
+
+#include "world_stream/frame.h"
+#include "world_stream/stream_error.h"
+
+namespace cshorelark::world_stream {
+
+inline constexpr std::uint16_t k_default_port = 7878;
+
+/**
+ * @brief Options of a stream_server.
+ */
+struct server_options {
+    std::string address{"127.0.0.1"};      ///< Address to listen on
+    std::uint16_t port{k_default_port};    ///< Port to listen on, 0 picks a free one
+    float max_frame_rate{120.0F};          ///< Upper bound of the rate a client may ask for
+    std::uint32_t keyframe_interval{120};  ///< Delta frames between keyframes per client
+};
+
+/**
+ * @brief Streams world frames and generation statistics to TCP clients.
+ *
+ * The simulation publishes snapshots from its own thread; the server never
+ * blocks it. Each client is served on an asio thread at the frame rate it
+ * asked for, with frames delta-encoded against the previous frame sent to that
+ * client. A client that cannot keep up skips frames instead of queueing them,
+ * generation statistics are always delivered.
+ */
+class stream_server {
+public:
+    /**
+     * @brief Constructs a server, call start() to accept clients.
+     * @param info World parameters sent to clients on connection
+     * @param options Listening and streaming options
+     */
+    stream_server(world_info info, server_options options);
+
+    /**
+     * @brief Stops the server and disconnects all clients.
+     */
+    ~stream_server();
+
+    stream_server(const stream_server&) = delete;
+    stream_server& operator=(const stream_server&) = delete;
+    stream_server(stream_server&&) = delete;
+    stream_server& operator=(stream_server&&) = delete;
+
+    /**
+     * @brief Binds the listening socket and starts the network thread.
+     * @return The bound port, or k_connection_failed
+     */
+    auto start() -> tl::expected<std::uint16_t, stream_error>;
+
+    /**
+     * @brief Stops the network thread, safe to call more than once.
+     */
+    void stop();
+
+    /**
+     * @brief Publishes the latest world snapshot, thread-safe.
+     * @param frame The snapshot, must not be modified afterwards
+     */
+    void publish(std::shared_ptr<const world_frame> frame);
+
+    /**
+     * @brief Sends the statistics of a completed generation to all clients, thread-safe.
+     * @param stats The statistics
+     */
+    void publish_stats(const generation_stats& stats);
+
+    /**
+     * @brief Gets the number of connected clients.
+     * @return Client count
+     */
+    [[nodiscard]] auto client_count() const noexcept -> std::size_t;
+
+private:
+    class session;
+    struct impl;
+    std::shared_ptr<impl> impl_;
+};
+
+}  // namespace cshorelark::world_stream
+
+#endif  // CSHORELARK_WORLD_STREAM_SERVER_H
@@ -0,0 +1,27 @@
+#ifndef CSHORELARK_WORLD_STREAM_STREAM_ERROR_H
+#define CSHORELARK_WORLD_STREAM_STREAM_ERROR_H
+
+namespace cshorelark::world_stream {
+
+/**
+ * @brief Enumeration of possible world stream errors
+ */
+enum class stream_error {
+    k_none,                 ///< No error
+    k_truncated_message,    ///< Message ended before all fields were read
+    k_invalid_message,      ///< Message type or size is not valid
+    k_protocol_mismatch,    ///< Peer speaks another protocol version
+    k_missing_keyframe,     ///< Delta frame received without a reference frame
+    k_connection_failed,    ///< Could not connect, bind or talk to the peer
+};
+
+/**
+ * @brief Gets a string representation of a stream error
+ * @param error The error to convert
+ * @return String describing the error
+ */
+auto stream_error_to_string(stream_error error) -> const char*;
+
+}  // namespace cshorelark::world_stream
+
+#endif  // CSHORELARK_WORLD_STREAM_STREAM_ERROR_H
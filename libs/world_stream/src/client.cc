@@ -0,0 +1,262 @@
+#include "world_stream/client.h"
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <asio.hpp>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "world_stream/frame_codec.h"
+#include "world_stream/protocol.h"
+
+namespace cshorelark::world_stream {
+
+using asio::ip::tcp;
+
+namespace {
+
+/// Statistics kept for a consumer that does not pick them up
+constexpr std::size_t k_max_pending_stats = 1024;
+
+}  // namespace
+
+struct stream_client::impl : std::enable_shared_from_this<impl> {
+    void read_header() {
+        asio::async_read(socket, asio::buffer(header),
+                         [self = shared_from_this()](const asio::error_code& error, std::size_t) {
+                             if (error) {
+                                 self->close();
+                                 return;
+                             }
+                             auto parsed = parse_header(self->header);
+                             if (!parsed) {
+                                 spdlog::warn("Invalid message from server: {}",
+                                              stream_error_to_string(parsed.error()));
+                                 self->close();
+                                 return;
+                             }
+                             self->read_payload(*parsed);
+                         });
+    }
+
+    void read_payload(message_header message) {
+        payload.resize(message.payload_size);
+        asio::async_read(
+            socket, asio::buffer(payload),
+            [self = shared_from_this(), message](const asio::error_code& error, std::size_t) {
+                if (error) {
+                    self->close();
+                    return;
+                }
+                self->bytes += k_header_size + message.payload_size;
+                if (!self->handle(message.type)) {
+                    self->close();
+                    return;
+                }
+                self->read_header();
+            });
+    }
+
+    auto handle(message_type type) -> bool {
+        switch (type) {
+            case message_type::k_frame: {
+                const auto decoded_ok = decoder.decode(payload, decoded);
+                if (!decoded_ok) {
+                    spdlog::warn("Dropping connection: {}",
+                                 stream_error_to_string(decoded_ok.error()));
+                    return false;
+                }
+                {
+                    const std::lock_guard<std::mutex> lock(mutex);
+                    std::swap(latest, decoded);
+                    has_new_frame = true;
+                }
+                ++frames;
+                return true;
+            }
+            case message_type::k_stats: {
+                const auto stats = read_stats(payload);
+                if (!stats) {
+                    return false;
+                }
+                const std::lock_guard<std::mutex> lock(mutex);
+                if (pending_stats.size() == k_max_pending_stats) {
+                    pending_stats.pop_front();
+                }
+                pending_stats.push_back(*stats);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    void send(std::shared_ptr<std::vector<std::uint8_t>> buffer) {
+        writes.push_back(std::move(buffer));
+        if (writes.size() == 1) {
+            write_next();
+        }
+    }
+
+    void write_next() {
+        asio::async_write(socket, asio::buffer(*writes.front()),
+                          [self = shared_from_this()](const asio::error_code& error, std::size_t) {
+                              if (error) {
+                                  self->close();
+                                  return;
+                              }
+                              self->writes.pop_front();
+                              if (!self->writes.empty()) {
+                                  self->write_next();
+                              }
+                          });
+    }
+
+    void close() {
+        connected = false;
+        asio::error_code ignored;
+        socket.shutdown(tcp::socket::shutdown_both, ignored);
+        socket.close(ignored);
+    }
+
+    asio::io_context io;
+    tcp::socket socket{io};
+    std::thread thread;
+
+    // Network thread only
+    std::array<std::uint8_t, k_header_size> header{};
+    std::vector<std::uint8_t> payload;
+    std::deque<std::shared_ptr<std::vector<std::uint8_t>>> writes;
+    frame_decoder decoder;
+    world_frame decoded;
+
+    std::mutex mutex;
+    world_frame latest;                          ///< Guarded by mutex
+    bool has_new_frame{false};                   ///< Guarded by mutex
+    std::deque<generation_stats> pending_stats;  ///< Guarded by mutex
+
+    std::atomic<bool> connected{false};
+    std::atomic<std::uint64_t> frames{0};
+    std::atomic<std::uint64_t> bytes{0};
+};
+
+stream_client::stream_client() = default;
+
+stream_client::~stream_client() { disconnect(); }
+
+auto stream_client::connect(const std::string& host, std::uint16_t port, float frame_rate)
+    -> tl::expected<world_info, stream_error> {
+    disconnect();
+    impl_ = std::make_shared<impl>();
+
+    // The handshake is blocking, only the stream afterwards runs on the network thread
+    world_info info;
+    try {
+        tcp::resolver resolver(impl_->io);
+        asio::connect(impl_->socket, resolver.resolve(host, std::to_string(port)));
+        impl_->socket.set_option(tcp::no_delay(true));
+
+        std::vector<std::uint8_t> hello;
+        write_hello(hello, frame_rate);
+        asio::write(impl_->socket, asio::buffer(hello));
+
+        std::array<std::uint8_t, k_header_size> header{};
+        asio::read(impl_->socket, asio::buffer(header));
+        const auto parsed = parse_header(header);
+        if (!parsed) {
+            impl_->close();
+            return tl::make_unexpected(parsed.error());
+        }
+        if (parsed->type != message_type::k_welcome) {
+            impl_->close();
+            return tl::make_unexpected(stream_error::k_invalid_message);
+        }
+        std::vector<std::uint8_t> payload(parsed->payload_size);
+        asio::read(impl_->socket, asio::buffer(payload));
+        auto welcome = read_welcome(payload);
+        if (!welcome) {
+            impl_->close();
+            return tl::make_unexpected(welcome.error());
+        }
+        info = *welcome;
+        impl_->bytes = k_header_size + payload.size();
+    } catch (const std::exception& e) {
+        spdlog::error("Cannot connect to {}:{}: {}", host, port, e.what());
+        impl_->close();
+        return tl::make_unexpected(stream_error::k_connection_failed);
+    }
+
+    impl_->connected = true;
+    impl_->read_header();
+    impl_->thread = std::thread([client = impl_] { client->io.run(); });
+    return info;
+}
+
+void stream_client::disconnect() {
+    if (!impl_) {
+        return;
+    }
+    if (impl_->thread.joinable()) {
+        asio::post(impl_->io, [client = impl_] { client->close(); });
+        impl_->thread.join();
+    }
+    impl_->connected = false;
+    impl_.reset();
+}
+
+void stream_client::set_frame_rate(float frame_rate) {
+    if (!impl_) {
+        return;
+    }
+    auto buffer = std::make_shared<std::vector<std::uint8_t>>();
+    write_set_rate(*buffer, frame_rate);
+    asio::post(impl_->io, [client = impl_, buffer = std::move(buffer)]() mutable {
+        if (client->connected) {
+            client->send(std::move(buffer));
+        }
+    });
+}
+
+auto stream_client::take_frame(world_frame& frame) -> bool {
+    if (!impl_) {
+        return false;
+    }
+    const std::lock_guard<std::mutex> lock(impl_->mutex);
+    if (!impl_->has_new_frame) {
+        return false;
+    }
+    std::swap(frame, impl_->latest);
+    impl_->has_new_frame = false;
+    return true;
+}
+
+auto stream_client::take_stats() -> std::optional<generation_stats> {
+    if (!impl_) {
+        return std::nullopt;
+    }
+    const std::lock_guard<std::mutex> lock(impl_->mutex);
+    if (impl_->pending_stats.empty()) {
+        return std::nullopt;
+    }
+    auto stats = impl_->pending_stats.front();
+    impl_->pending_stats.pop_front();
+    return stats;
+}
+
+auto stream_client::is_connected() const noexcept -> bool {
+    return impl_ && impl_->connected;
+}
+
+auto stream_client::frames_received() const noexcept -> std::uint64_t {
+    return impl_ ? impl_->frames.load() : 0;
+}
+
+auto stream_client::bytes_received() const noexcept -> std::uint64_t {
+    return impl_ ? impl_->bytes.load() : 0;
+}
+
+}  // namespace cshorelark::world_stream
@@ -0,0 +1,42 @@
+#include "world_stream/frame.h"
+
+namespace cshorelark::world_stream {
+
+void capture_frame(const simulation::simulation& sim, std::uint64_t sequence, world_frame& frame) {
+    const auto& world = sim.get_world();
+    frame.sequence = sequence;
+    frame.generation = sim.get_generation();
+    frame.age = sim.get_age();
+
+    const auto& animals = world.get_animals();
+    frame.birds.resize(animals.size());
+    for (std::size_t i = 0; i < animals.size(); ++i) {
+        const auto& animal = animals[i];
+        auto& bird = frame.birds[i];
+        bird.pos_x = animal.position().x();
+        bird.pos_y = animal.position().y();
+        bird.rotation = animal.rotation();
+        bird.speed = animal.speed();
+        bird.fitness = static_cast<std::uint32_t>(animal.food_eaten());
+    }
+
+    const auto& foods = world.foods();
+    frame.foods.resize(foods.size());
+    for (std::size_t i = 0; i < foods.size(); ++i) {
+        frame.foods[i].pos_x = foods[i].position().x();
+        frame.foods[i].pos_y = foods[i].position().y();
+    }
+}
+
+auto to_generation_stats(const simulation::statistics& stats) -> generation_stats {
+    const auto& ga_stats = stats.ga_stats();
+    return generation_stats{stats.generation(), ga_stats.min_fitness(), ga_stats.max_fitness(),
+                            ga_stats.avg_fitness(), ga_stats.median_fitness()};
+}
+
+auto to_world_info(const simulation::config& config) -> world_info {
+    return world_info{config.world.food_size, config.world.bird_size, config.brain_eye.fov_range,
+                      config.brain_eye.fov_angle_deg};
+}
+
+}  // namespace cshorelark::world_stream
@@ -0,0 +1,221 @@
+#include "world_stream/frame_codec.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "world_stream/protocol.h"
+
+namespace cshorelark::world_stream {
+
+namespace {
+
+constexpr float k_two_pi = 6.28318530717958647692F;
+constexpr float k_unit_scale = 65535.0F;
+constexpr float k_angle_scale = 65536.0F;
+constexpr std::uint8_t k_keyframe_flag = 0x01;
+
+auto quantize_unit(float value) -> std::uint16_t {
+    return static_cast<std::uint16_t>(std::lround(std::clamp(value, 0.0F, 1.0F) * k_unit_scale));
+}
+
+auto quantize_angle(float radians) -> std::uint16_t {
+    float turns = std::fmod(radians / k_two_pi, 1.0F);
+    if (turns < 0.0F) {
+        turns += 1.0F;
+    }
+    // lround(65536) wraps to 0, which is the same angle
+    return static_cast<std::uint16_t>(std::lround(turns * k_angle_scale) & 0xFFFF);
+}
+
+// Deltas of 16-bit fields wrap around, so a bird crossing the world edge stays cheap
+void put_deltas(byte_writer& writer, const std::vector<std::uint16_t>& values,
+                const std::vector<std::uint16_t>& reference) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        writer.put_zigzag(static_cast<std::int16_t>(values[i] - reference[i]));
+    }
+}
+
+void get_deltas(byte_reader& reader, std::vector<std::uint16_t>& values) {
+    for (auto& value : values) {
+        value = static_cast<std::uint16_t>(value + reader.get_zigzag());
+    }
+}
+
+void put_raw(byte_writer& writer, const std::vector<std::uint16_t>& values) {
+    for (const auto value : values) {
+        writer.put_u16(value);
+    }
+}
+
+void get_raw(byte_reader& reader, std::vector<std::uint16_t>& values) {
+    for (auto& value : values) {
+        value = reader.get_u16();
+    }
+}
+
+}  // namespace
+
+void quantize(const world_frame& frame, quantized_frame& out) {
+    out.sequence = frame.sequence;
+    out.generation = frame.generation;
+    out.age = frame.age;
+
+    const std::size_t birds = frame.birds.size();
+    out.bird_x.resize(birds);
+    out.bird_y.resize(birds);
+    out.bird_rotation.resize(birds);
+    out.bird_speed.resize(birds);
+    out.bird_fitness.resize(birds);
+    for (std::size_t i = 0; i < birds; ++i) {
+        const auto& bird = frame.birds[i];
+        out.bird_x[i] = quantize_unit(bird.pos_x);
+        out.bird_y[i] = quantize_unit(bird.pos_y);
+        out.bird_rotation[i] = quantize_angle(bird.rotation);
+        out.bird_speed[i] = quantize_unit(bird.speed / k_max_encoded_speed);
+        out.bird_fitness[i] = bird.fitness;
+    }
+
+    const std::size_t foods = frame.foods.size();
+    out.food_x.resize(foods);
+    out.food_y.resize(foods);
+    for (std::size_t i = 0; i < foods; ++i) {
+        out.food_x[i] = quantize_unit(frame.foods[i].pos_x);
+        out.food_y[i] = quantize_unit(frame.foods[i].pos_y);
+    }
+}
+
+void dequantize(const quantized_frame& frame, world_frame& out) {
+    out.sequence = frame.sequence;
+    out.generation = frame.generation;
+    out.age = frame.age;
+
+    out.birds.resize(frame.bird_x.size());
+    for (std::size_t i = 0; i < out.birds.size(); ++i) {
+        auto& bird = out.birds[i];
+        bird.pos_x = static_cast<float>(frame.bird_x[i]) / k_unit_scale;
+        bird.pos_y = static_cast<float>(frame.bird_y[i]) / k_unit_scale;
+        bird.rotation = static_cast<float>(frame.bird_rotation[i]) / k_angle_scale * k_two_pi;
+        bird.speed = static_cast<float>(frame.bird_speed[i]) / k_unit_scale * k_max_encoded_speed;
+        bird.fitness = frame.bird_fitness[i];
+    }
+
+    out.foods.resize(frame.food_x.size());
+    for (std::size_t i = 0; i < out.foods.size(); ++i) {
+        out.foods[i].pos_x = static_cast<float>(frame.food_x[i]) / k_unit_scale;
+        out.foods[i].pos_y = static_cast<float>(frame.food_y[i]) / k_unit_scale;
+    }
+}
+
+frame_encoder::frame_encoder(std::uint32_t keyframe_interval)
+    : keyframe_interval_(std::max<std::uint32_t>(keyframe_interval, 1)) {}
+
+void frame_encoder::encode(const world_frame& frame, std::vector<std::uint8_t>& out) {
+    quantize(frame, current_);
+
+    const bool keyframe = !has_reference_ || frames_since_keyframe_ >= keyframe_interval_ ||
+                          current_.bird_x.size() != reference_.bird_x.size() ||
+                          current_.food_x.size() != reference_.food_x.size();
+
+    byte_writer writer(out);
+    const auto offset = writer.begin_message(message_type::k_frame);
+    writer.put_u8(keyframe ? k_keyframe_flag : 0);
+    writer.put_varint(current_.sequence);
+    writer.put_varint(current_.generation);
+    writer.put_varint(current_.age);
+    writer.put_varint(current_.bird_x.size());
+    writer.put_varint(current_.food_x.size());
+
+    if (keyframe) {
+        put_raw(writer, current_.bird_x);
+        put_raw(writer, current_.bird_y);
+        put_raw(writer, current_.bird_rotation);
+        put_raw(writer, current_.bird_speed);
+        for (const auto fitness : current_.bird_fitness) {
+            writer.put_varint(fitness);
+        }
+        put_raw(writer, current_.food_x);
+        put_raw(writer, current_.food_y);
+        frames_since_keyframe_ = 0;
+    } else {
+        put_deltas(writer, current_.bird_x, reference_.bird_x);
+        put_deltas(writer, current_.bird_y, reference_.bird_y);
+        put_deltas(writer, current_.bird_rotation, reference_.bird_rotation);
+        put_deltas(writer, current_.bird_speed, reference_.bird_speed);
+        for (std::size_t i = 0; i < current_.bird_fitness.size(); ++i) {
+            writer.put_zigzag(static_cast<std::int64_t>(current_.bird_fitness[i]) -
+                              static_cast<std::int64_t>(reference_.bird_fitness[i]));
+        }
+        put_deltas(writer, current_.food_x, reference_.food_x);
+        put_deltas(writer, current_.food_y, reference_.food_y);
+        ++frames_since_keyframe_;
+    }
+    writer.end_message(offset);
+
+    std::swap(reference_, current_);
+    has_reference_ = true;
+}
+
+auto frame_decoder::decode(nonstd::span<const std::uint8_t> payload, world_frame& frame)
+    -> tl::expected<void, stream_error> {
+    byte_reader reader(payload);
+    const bool keyframe = (reader.get_u8() & k_keyframe_flag) != 0;
+    const auto sequence = reader.get_varint();
+    const auto generation = reader.get_varint();
+    const auto age = reader.get_varint();
+    const auto birds = reader.get_varint();
+    const auto foods = reader.get_varint();
+    if (!reader.ok()) {
+        return tl::make_unexpected(stream_error::k_truncated_message);
+    }
+    // Every entity takes at least one byte per field, bounding the counts by the payload
+    if (birds > reader.remaining() || foods > reader.remaining()) {
+        return tl::make_unexpected(stream_error::k_invalid_message);
+    }
+
+    if (keyframe) {
+        reference_.bird_x.resize(birds);
+        reference_.bird_y.resize(birds);
+        reference_.bird_rotation.resize(birds);
+        reference_.bird_speed.resize(birds);
+        reference_.bird_fitness.resize(birds);
+        reference_.food_x.resize(foods);
+        reference_.food_y.resize(foods);
+        get_raw(reader, reference_.bird_x);
+        get_raw(reader, reference_.bird_y);
+        get_raw(reader, reference_.bird_rotation);
+        get_raw(reader, reference_.bird_speed);
+        for (auto& fitness : reference_.bird_fitness) {
+            fitness = static_cast<std::uint32_t>(reader.get_varint());
+        }
+        get_raw(reader, reference_.food_x);
+        get_raw(reader, reference_.food_y);
+    } else {
+        if (!has_reference_ || birds != reference_.bird_x.size() ||
+            foods != reference_.food_x.size()) {
+            return tl::make_unexpected(stream_error::k_missing_keyframe);
+        }
+        get_deltas(reader, reference_.bird_x);
+        get_deltas(reader, reference_.bird_y);
+        get_deltas(reader, reference_.bird_rotation);
+        get_deltas(reader, reference_.bird_speed);
+        for (auto& fitness : reference_.bird_fitness) {
+            fitness = static_cast<std::uint32_t>(static_cast<std::int64_t>(fitness) +
+                                                 reader.get_zigzag());
+        }
+        get_deltas(reader, reference_.food_x);
+        get_deltas(reader, reference_.food_y);
+    }
+    if (!reader.ok()) {
+        has_reference_ = false;
+        return tl::make_unexpected(stream_error::k_truncated_message);
+    }
+
+    reference_.sequence = sequence;
+    reference_.generation = generation;
+    reference_.age = age;
+    has_reference_ = true;
+    dequantize(reference_, frame);
+    return {};
+}
+
+}  // namespace cshorelark::world_stream
@@ -0,0 +1,211 @@
+#include "world_stream/protocol.h"
+
+#include <cstring>
+
+namespace cshorelark::world_stream {
+
+void byte_writer::put_u16(std::uint16_t value) {
+    out_.push_back(static_cast<std::uint8_t>(value));
+    out_.push_back(static_cast<std::uint8_t>(value >> 8));
+}
+
+void byte_writer::put_u32(std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out_.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+void byte_writer::put_f32(float value) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_u32(bits);
+}
+
+void byte_writer::put_varint(std::uint64_t value) {
+    while (value >= 0x80) {
+        out_.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out_.push_back(static_cast<std::uint8_t>(value));
+}
+
+void byte_writer::put_zigzag(std::int64_t value) {
+    put_varint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+auto byte_writer::begin_message(message_type type) -> std::size_t {
+    const std::size_t offset = out_.size();
+    put_u32(0);
+    put_u8(static_cast<std::uint8_t>(type));
+    return offset;
+}
+
+void byte_writer::end_message(std::size_t offset) {
+    const auto size = static_cast<std::uint32_t>(out_.size() - offset - k_header_size);
+    for (std::size_t i = 0; i < 4; ++i) {
+        out_[offset + i] = static_cast<std::uint8_t>(size >> (8 * i));
+    }
+}
+
+auto byte_reader::get_u8() -> std::uint8_t {
+    if (position_ + 1 > data_.size()) {
+        ok_ = false;
+        return 0;
+    }
+    return data_[position_++];
+}
+
+auto byte_reader::get_u16() -> std::uint16_t {
+    const auto low = get_u8();
+    const auto high = get_u8();
+    return static_cast<std::uint16_t>(low | (high << 8));
+}
+
+auto byte_reader::get_u32() -> std::uint32_t {
+    std::uint32_t value = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        value |= static_cast<std::uint32_t>(get_u8()) << shift;
+    }
+    return value;
+}
+
+auto byte_reader::get_f32() -> float {
+    const std::uint32_t bits = get_u32();
+    float value = 0.0F;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+auto byte_reader::get_varint() -> std::uint64_t {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const auto byte = get_u8();
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    ok_ = false;
+    return 0;
+}
+
+auto byte_reader::get_zigzag() -> std::int64_t {
+    const std::uint64_t value = get_varint();
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+auto parse_header(nonstd::span<const std::uint8_t> data)
+    -> tl::expected<message_header, stream_error> {
+    byte_reader reader(data);
+    message_header header;
+    header.payload_size = reader.get_u32();
+    const auto type = reader.get_u8();
+    if (!reader.ok()) {
+        return tl::make_unexpected(stream_error::k_truncated_message);
+    }
+    if (type < static_cast<std::uint8_t>(message_type::k_hello) ||
+        type > static_cast<std::uint8_t>(message_type::k_stats)) {
+        return tl::make_unexpected(stream_error::k_invalid_message);
+    }
+    header.type = static_cast<message_type>(type);
+    const auto max_size =
+        is_client_message(header.type) ? k_max_client_payload_size : k_max_payload_size;
+    if (header.payload_size > max_size) {
+        return tl::make_unexpected(stream_error::k_invalid_message);
+    }
+    return header;
+}
+
+void write_hello(std::vector<std::uint8_t>& out, float frame_rate) {
+    byte_writer writer(out);
+    const auto offset = writer.begin_message(message_type::k_hello);
+    writer.put_u16(k_protocol_version);
+    writer.put_f32(frame_rate);
+    writer.end_message(offset);
+}
+
+auto read_hello(nonstd::span<const std::uint8_t> payload) -> tl::expected<float, stream_error> {
+    byte_reader reader(payload);
+    const auto version = reader.get_u16();
+    const auto frame_rate = reader.get_f32();
+    if (!reader.ok()) {
+        return tl::make_unexpected(stream_error::k_truncated_message);
+    }
+    if (version != k_protocol_version) {
+        return tl::make_unexpected(stream_error::k_protocol_mismatch);
+    }
+    return frame_rate;
+}
+
+void write_welcome(std::vector<std::uint8_t>& out, const world_info& info) {
+    byte_writer writer(out);
+    const auto offset = writer.begin_message(message_type::k_welcome);
+    writer.put_u16(k_protocol_version);
+    writer.put_f32(info.food_size);
+    writer.put_f32(info.bird_size);
+    writer.put_f32(info.fov_range);
+    writer.put_f32(info.fov_angle_deg);
+    writer.end_message(offset);
+}
+
+auto read_welcome(nonstd::span<const std::uint8_t> payload)
+    -> tl::expected<world_info, stream_error> {
+    byte_reader reader(payload);
+    const auto version = reader.get_u16();
+    world_info info;
+    info.food_size = reader.get_f32();
+    info.bird_size = reader.get_f32();
+    info.fov_range = reader.get_f32();
+    info.fov_angle_deg = reader.get_f32();
+    if (!reader.ok()) {
+        return tl::make_unexpected(stream_error::k_truncated_message);
+    }
+    if (version != k_protocol_version) {
+        return tl::make_unexpected(stream_error::k_protocol_mismatch);
+    }
+    return info;
+}
+
+void write_set_rate(std::vector<std::uint8_t>& out, float frame_rate) {
+    byte_writer writer(out);
+    const auto offset = writer.begin_message(message_type::k_set_rate);
+    writer.put_f32(frame_rate);
+    writer.end_message(offset);
+}
+
+auto read_set_rate(nonstd::span<const std::uint8_t> payload) -> tl::expected<float, stream_error> {
+    byte_reader reader(payload);
+    const auto frame_rate = reader.get_f32();
+    if (!reader.ok()) {
+        return tl::make_unexpected(stream_error::k_truncated_message);
+    }
+    return frame_rate;
+}
+
+void write_stats(std::vector<std::uint8_t>& out, const generation_stats& stats) {
+    byte_writer writer(out);
+    const auto offset = writer.begin_message(message_type::k_stats);
+    writer.put_varint(stats.generation);
+    writer.put_f32(stats.min_fitness);
+    writer.put_f32(stats.max_fitness);
+    writer.put_f32(stats.avg_fitness);
+    writer.put_f32(stats.median_fitness);
+    writer.end_message(offset);
+}
+
+auto read_stats(nonstd::span<const std::uint8_t> payload)
+    -> tl::expected<generation_stats, stream_error> {
+    byte_reader reader(payload);
+    generation_stats stats;
+    stats.generation = reader.get_varint();
+    stats.min_fitness = reader.get_f32();
+    stats.max_fitness = reader.get_f32();
+    stats.avg_fitness = reader.get_f32();
+    stats.median_fitness = reader.get_f32();
+    if (!reader.ok()) {
+        return tl::make_unexpected(stream_error::k_truncated_message);
+    }
+    return stats;
+}
+
+}  // namespace cshorelark::world_stream
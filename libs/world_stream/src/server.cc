@@ -0,0 +1,336 @@
+#include "world_stream/server.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "world_stream/frame_codec.h"
+#include "world_stream/protocol.h"
+
+namespace cshorelark::world_stream {
+
+using asio::ip::tcp;
+
+struct stream_server::impl {
+    impl(world_info world, server_options opts) : info(world), options(std::move(opts)) {}
+
+    void accept();
+    void broadcast_stats(const generation_stats& stats);
+    auto latest_frame() -> std::shared_ptr<const world_frame> {
+        const std::lock_guard<std::mutex> lock(frame_mutex);
+        return latest;
+    }
+
+    world_info info;
+    server_options options;
+    std::weak_ptr<impl> self;  ///< Handed to sessions so they keep the server state alive
+    asio::io_context io;
+    tcp::acceptor acceptor{io};
+    std::thread thread;
+
+    std::mutex frame_mutex;
+    std::shared_ptr<const world_frame> latest;  ///< Guarded by frame_mutex
+
+    std::vector<std::weak_ptr<session>> sessions;  ///< Touched on the network thread only
+    std::atomic<std::size_t> clients{0};
+};
+
+/**
+ * @brief One connected client, all members are used on the network thread only.
+ */
+class stream_server::session : public std::enable_shared_from_this<session> {
+public:
+    session(tcp::socket socket, std::shared_ptr<impl> server)
+        : socket_(std::move(socket)),
+          timer_(socket_.get_executor()),
+          server_(std::move(server)),
+          encoder_(server_->options.keyframe_interval) {
+        ++server_->clients;
+    }
+
+    ~session() { --server_->clients; }
+
+    session(const session&) = delete;
+    session& operator=(const session&) = delete;
+    session(session&&) = delete;
+    session& operator=(session&&) = delete;
+
+    void start() { read_header(); }
+
+    void send_stats(const generation_stats& stats) {
+        auto buffer = std::make_shared<std::vector<std::uint8_t>>();
+        write_stats(*buffer, stats);
+        enqueue(std::move(buffer), false);
+    }
+
+    void close() {
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        asio::error_code ignored;
+        timer_.cancel();
+        socket_.shutdown(tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+    }
+
+private:
+    void read_header() {
+        asio::async_read(socket_, asio::buffer(header_),
+                         [self = shared_from_this()](const asio::error_code& error, std::size_t) {
+                             if (error) {
+                                 self->close();
+                                 return;
+                             }
+                             auto header = parse_header(self->header_);
+                             if (header && !is_client_message(header->type)) {
+                                 // Only client messages are capped at a small size
+                                 header = tl::make_unexpected(stream_error::k_invalid_message);
+                             }
+                             if (!header) {
+                                 spdlog::warn("Dropping client: {}",
+                                              stream_error_to_string(header.error()));
+                                 self->close();
+                                 return;
+                             }
+                             self->read_payload(*header);
+                         });
+    }
+
+    void read_payload(message_header header) {
+        payload_.resize(header.payload_size);
+        asio::async_read(
+            socket_, asio::buffer(payload_),
+            [self = shared_from_this(), header](const asio::error_code& error, std::size_t) {
+                if (error) {
+                    self->close();
+                    return;
+                }
+                if (!self->handle(header.type)) {
+                    self->close();
+                    return;
+                }
+                self->read_header();
+            });
+    }
+
+    auto handle(message_type type) -> bool {
+        switch (type) {
+            case message_type::k_hello: {
+                const auto frame_rate = read_hello(payload_);
+                if (!frame_rate) {
+                    spdlog::warn("Rejecting client: {}",
+                                 stream_error_to_string(frame_rate.error()));
+                    return false;
+                }
+                auto buffer = std::make_shared<std::vector<std::uint8_t>>();
+                write_welcome(*buffer, server_->info);
+                enqueue(std::move(buffer), false);
+                welcomed_ = true;
+                set_rate(*frame_rate);
+                return true;
+            }
+            case message_type::k_set_rate: {
+                const auto frame_rate = read_set_rate(payload_);
+                if (!frame_rate || !welcomed_) {
+                    return false;
+                }
+                set_rate(*frame_rate);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    void set_rate(float frame_rate) {
+        frame_rate_ = std::clamp(frame_rate, 0.0F, server_->options.max_frame_rate);
+        if (ticking_) {
+            // The pending wait completes with operation_aborted and re-arms with the new rate
+            timer_.cancel();
+        } else if (frame_rate_ > 0.0F) {
+            schedule_tick();
+        }
+    }
+
+    void schedule_tick() {
+        ticking_ = true;
+        const auto interval = std::chrono::duration<float>(1.0F / frame_rate_);
+        timer_.expires_after(std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval));
+        timer_.async_wait([self = shared_from_this()](const asio::error_code& error) {
+            self->ticking_ = false;
+            if (self->closed_) {
+                return;
+            }
+            if (!error) {
+                self->send_frame();
+            }
+            if (self->frame_rate_ > 0.0F) {
+                self->schedule_tick();
+            }
+        });
+    }
+
+    void send_frame() {
+        // A client that has not drained the previous frame skips this one
+        if (frame_pending_) {
+            return;
+        }
+        const auto frame = server_->latest_frame();
+        if (!frame || (sent_any_ && frame->sequence == last_sequence_)) {
+            return;
+        }
+        auto buffer = std::make_shared<std::vector<std::uint8_t>>();
+        encoder_.encode(*frame, *buffer);
+        last_sequence_ = frame->sequence;
+        sent_any_ = true;
+        enqueue(std::move(buffer), true);
+    }
+
+    void enqueue(std::shared_ptr<std::vector<std::uint8_t>> buffer, bool is_frame) {
+        if (closed_) {
+            return;
+        }
+        frame_pending_ = frame_pending_ || is_frame;
+        queue_.push_back(queued_write{std::move(buffer), is_frame});
+        if (queue_.size() == 1) {
+            write_next();
+        }
+    }
+
+    void write_next() {
+        const auto& front = queue_.front();
+        asio::async_write(socket_, asio::buffer(*front.buffer),
+                          [self = shared_from_this()](const asio::error_code& error, std::size_t) {
+                              if (error) {
+                                  self->close();
+                                  return;
+                              }
+                              if (self->queue_.front().is_frame) {
+                                  self->frame_pending_ = false;
+                              }
+                              self->queue_.pop_front();
+                              if (!self->queue_.empty()) {
+                                  self->write_next();
+                              }
+                          });
+    }
+
+    struct queued_write {
+        std::shared_ptr<std::vector<std::uint8_t>> buffer;
+        bool is_frame;
+    };
+
+    tcp::socket socket_;
+    asio::steady_timer timer_;
+    std::shared_ptr<impl> server_;
+    frame_encoder encoder_;
+    std::array<std::uint8_t, k_header_size> header_{};
+    std::vector<std::uint8_t> payload_;
+    std::deque<queued_write> queue_;
+    float frame_rate_{0.0F};
+    std::uint64_t last_sequence_{0};
+    bool sent_any_{false};
+    bool frame_pending_{false};
+    bool ticking_{false};
+    bool welcomed_{false};
+    bool closed_{false};
+};
+
+void stream_server::impl::accept() {
+    acceptor.async_accept([this](const asio::error_code& error, tcp::socket socket) {
+        if (error) {
+            if (error != asio::error::operation_aborted) {
+                spdlog::warn("Accept failed: {}", error.message());
+                accept();
+            }
+            return;
+        }
+        asio::error_code ignored;
+        socket.set_option(tcp::no_delay(true), ignored);
+        spdlog::info("Client connected from {}", socket.remote_endpoint(ignored).address().to_string());
+
+        auto client = std::make_shared<session>(std::move(socket), self.lock());
+        sessions.erase(std::remove_if(sessions.begin(), sessions.end(),
+                                      [](const auto& weak) { return weak.expired(); }),
+                       sessions.end());
+        sessions.push_back(client);
+        client->start();
+        accept();
+    });
+}
+
+void stream_server::impl::broadcast_stats(const generation_stats& stats) {
+    for (const auto& weak : sessions) {
+        if (auto client = weak.lock()) {
+            client->send_stats(stats);
+        }
+    }
+}
+
+stream_server::stream_server(world_info info, server_options options)
+    : impl_(std::make_shared<impl>(info, std::move(options))) {
+    impl_->self = impl_;
+}
+
+stream_server::~stream_server() { stop(); }
+
+auto stream_server::start() -> tl::expected<std::uint16_t, stream_error> {
+    try {
+        const tcp::endpoint endpoint(asio::ip::make_address(impl_->options.address),
+                                     impl_->options.port);
+        impl_->acceptor.open(endpoint.protocol());
+        impl_->acceptor.set_option(tcp::acceptor::reuse_address(true));
+        impl_->acceptor.bind(endpoint);
+        impl_->acceptor.listen();
+    } catch (const std::exception& e) {
+        spdlog::error("Cannot listen on {}:{}: {}", impl_->options.address, impl_->options.port,
+                      e.what());
+        return tl::make_unexpected(stream_error::k_connection_failed);
+    }
+
+    const auto port = impl_->acceptor.local_endpoint().port();
+    impl_->accept();
+    impl_->thread = std::thread([server = impl_] { server->io.run(); });
+    spdlog::info("Streaming simulation on {}:{}", impl_->options.address, port);
+    return port;
+}
+
+void stream_server::stop() {
+    if (!impl_->thread.joinable()) {
+        return;
+    }
+    asio::post(impl_->io, [server = impl_] {
+        asio::error_code ignored;
+        server->acceptor.close(ignored);
+        for (const auto& weak : server->sessions) {
+            if (auto client = weak.lock()) {
+                client->close();
+            }
+        }
+        server->sessions.clear();
+    });
+    // Closing every socket and the timers leaves no work, so run() returns on its own
+    impl_->thread.join();
+}
+
+void stream_server::publish(std::shared_ptr<const world_frame> frame) {
+    const std::lock_guard<std::mutex> lock(impl_->frame_mutex);
+    impl_->latest = std::move(frame);
+}
+
+void stream_server::publish_stats(const generation_stats& stats) {
+    asio::post(impl_->io, [server = impl_, stats] { server->broadcast_stats(stats); });
+}
+
+auto stream_server::client_count() const noexcept -> std::size_t { return impl_->clients; }
+
+}  // namespace cshorelark::world_stream
@@ -0,0 +1,24 @@
+#include "world_stream/stream_error.h"
+
+namespace cshorelark::world_stream {
+
+auto stream_error_to_string(stream_error error) -> const char* {
+    switch (error) {
+        case stream_error::k_none:
+            return "No error";
+        case stream_error::k_truncated_message:
+            return "Truncated message";
+        case stream_error::k_invalid_message:
+            return "Invalid message";
+        case stream_error::k_protocol_mismatch:
+            return "Protocol version mismatch";
+        case stream_error::k_missing_keyframe:
+            return "Delta frame without keyframe";
+        case stream_error::k_connection_failed:
+            return "Connection failed";
+        default:
+            return "Unknown stream error";
+    }
+}
+
+}  // namespace cshorelark::world_stream
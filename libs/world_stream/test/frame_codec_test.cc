@@ -0,0 +1,168 @@
+#include "world_stream/frame_codec.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "world_stream/protocol.h"
+
+using cshorelark::world_stream::bird_state;
+using cshorelark::world_stream::food_state;
+using cshorelark::world_stream::frame_decoder;
+using cshorelark::world_stream::frame_encoder;
+using cshorelark::world_stream::k_header_size;
+using cshorelark::world_stream::k_max_client_payload_size;
+using cshorelark::world_stream::k_max_payload_size;
+using cshorelark::world_stream::message_type;
+using cshorelark::world_stream::parse_header;
+using cshorelark::world_stream::stream_error;
+using cshorelark::world_stream::world_frame;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+constexpr std::size_t k_test_birds = 40;
+constexpr std::size_t k_test_foods = 60;
+constexpr float k_position_tolerance = 1.0F / 65535.0F;
+constexpr float k_rotation_tolerance = 6.2832F / 65536.0F;
+
+auto make_frame(std::uint64_t sequence, float offset) -> world_frame {
+    world_frame frame;
+    frame.sequence = sequence;
+    frame.generation = 3;
+    frame.age = sequence * 2;
+    for (std::size_t i = 0; i < k_test_birds; ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(k_test_birds);
+        frame.birds.push_back(bird_state{t, 0.9F - t * 0.8F + offset * 0.5F, t * 6.0F + offset,
+                                         0.001F + t * 0.004F, static_cast<std::uint32_t>(i)});
+    }
+    for (std::size_t i = 0; i < k_test_foods; ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(k_test_foods);
+        frame.foods.push_back(food_state{t, t * t});
+    }
+    return frame;
+}
+
+// Strips the header off an encoded message
+auto payload_of(const std::vector<std::uint8_t>& message) -> std::vector<std::uint8_t> {
+    const auto header = parse_header(message);
+    REQUIRE(header.has_value());
+    REQUIRE(header->type == message_type::k_frame);
+    REQUIRE(header->payload_size + k_header_size == message.size());
+    return {message.begin() + k_header_size, message.end()};
+}
+
+void require_close(const world_frame& decoded, const world_frame& original) {
+    REQUIRE(decoded.sequence == original.sequence);
+    REQUIRE(decoded.generation == original.generation);
+    REQUIRE(decoded.age == original.age);
+    REQUIRE(decoded.birds.size() == original.birds.size());
+    REQUIRE(decoded.foods.size() == original.foods.size());
+    for (std::size_t i = 0; i < original.birds.size(); ++i) {
+        CHECK_THAT(decoded.birds[i].pos_x, WithinAbs(original.birds[i].pos_x, k_position_tolerance));
+        CHECK_THAT(decoded.birds[i].pos_y, WithinAbs(original.birds[i].pos_y, k_position_tolerance));
+        CHECK_THAT(decoded.birds[i].rotation,
+                   WithinAbs(original.birds[i].rotation, k_rotation_tolerance));
+        CHECK(decoded.birds[i].fitness == original.birds[i].fitness);
+    }
+    for (std::size_t i = 0; i < original.foods.size(); ++i) {
+        CHECK_THAT(decoded.foods[i].pos_x, WithinAbs(original.foods[i].pos_x, k_position_tolerance));
+        CHECK_THAT(decoded.foods[i].pos_y, WithinAbs(original.foods[i].pos_y, k_position_tolerance));
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Frame codec round trips keyframes and deltas", "[world_stream][frame_codec]") {
+    frame_encoder encoder;
+    frame_decoder decoder;
+    world_frame decoded;
+
+    std::vector<std::uint8_t> keyframe;
+    const auto first = make_frame(1, 0.0F);
+    encoder.encode(first, keyframe);
+    REQUIRE(decoder.decode(payload_of(keyframe), decoded).has_value());
+    require_close(decoded, first);
+
+    std::vector<std::uint8_t> delta;
+    const auto second = make_frame(2, 0.001F);
+    encoder.encode(second, delta);
+    REQUIRE(decoder.decode(payload_of(delta), decoded).has_value());
+    require_close(decoded, second);
+
+    // Small movements cost a single byte per field
+    constexpr std::size_t k_frame_fields = 5 * k_test_birds + 2 * k_test_foods;
+    constexpr std::size_t k_max_preamble = 16;
+    REQUIRE(delta.size() <= k_header_size + k_max_preamble + k_frame_fields);
+    REQUIRE(delta.size() < keyframe.size());
+}
+
+TEST_CASE("Frame codec sends a keyframe when entity counts change",
+          "[world_stream][frame_codec]") {
+    frame_encoder encoder;
+    std::vector<std::uint8_t> message;
+    encoder.encode(make_frame(1, 0.0F), message);
+
+    auto grown = make_frame(2, 0.0F);
+    grown.foods.push_back(food_state{0.5F, 0.5F});
+    message.clear();
+    encoder.encode(grown, message);
+
+    // A fresh decoder only accepts keyframes
+    frame_decoder decoder;
+    world_frame decoded;
+    REQUIRE(decoder.decode(payload_of(message), decoded).has_value());
+    require_close(decoded, grown);
+}
+
+TEST_CASE("Frame codec rejects deltas without a keyframe", "[world_stream][frame_codec]") {
+    frame_encoder encoder;
+    std::vector<std::uint8_t> message;
+    encoder.encode(make_frame(1, 0.0F), message);
+    message.clear();
+    encoder.encode(make_frame(2, 0.001F), message);
+
+    frame_decoder decoder;
+    world_frame decoded;
+    const auto result = decoder.decode(payload_of(message), decoded);
+    REQUIRE_FALSE(result.has_value());
+    REQUIRE(result.error() == stream_error::k_missing_keyframe);
+}
+
+TEST_CASE("Frame codec rejects truncated payloads", "[world_stream][frame_codec]") {
+    frame_encoder encoder;
+    std::vector<std::uint8_t> message;
+    encoder.encode(make_frame(1, 0.0F), message);
+    auto payload = payload_of(message);
+    payload.resize(payload.size() - 3);
+
+    frame_decoder decoder;
+    world_frame decoded;
+    const auto result = decoder.decode(payload, decoded);
+    REQUIRE_FALSE(result.has_value());
+    REQUIRE(result.error() == stream_error::k_truncated_message);
+}
+
+TEST_CASE("Message headers cap client messages at a small size", "[world_stream][frame_codec]") {
+    const auto header_of = [](message_type type, std::uint32_t payload_size) {
+        return std::vector<std::uint8_t>{static_cast<std::uint8_t>(payload_size),
+                                         static_cast<std::uint8_t>(payload_size >> 8U),
+                                         static_cast<std::uint8_t>(payload_size >> 16U),
+                                         static_cast<std::uint8_t>(payload_size >> 24U),
+                                         static_cast<std::uint8_t>(type)};
+    };
+
+    REQUIRE(parse_header(header_of(message_type::k_hello, k_max_client_payload_size)).has_value());
+    REQUIRE(parse_header(header_of(message_type::k_frame, k_max_payload_size)).has_value());
+
+    const auto hello =
+        parse_header(header_of(message_type::k_hello, k_max_client_payload_size + 1));
+    REQUIRE_FALSE(hello.has_value());
+    REQUIRE(hello.error() == stream_error::k_invalid_message);
+    REQUIRE_FALSE(
+        parse_header(header_of(message_type::k_set_rate, k_max_payload_size)).has_value());
+    REQUIRE_FALSE(
+        parse_header(header_of(message_type::k_frame, k_max_payload_size + 1)).has_value());
+}
@@ -0,0 +1,140 @@
+#include "world_stream/server.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "random/random.h"
+#include "simulation/config.h"
+#include "simulation/simulation.h"
+#include "world_stream/client.h"
+
+using cshorelark::simulation::config;
+using cshorelark::simulation::simulation;
+using cshorelark::world_stream::capture_frame;
+using cshorelark::world_stream::generation_stats;
+using cshorelark::world_stream::server_options;
+using cshorelark::world_stream::stream_client;
+using cshorelark::world_stream::stream_server;
+using cshorelark::world_stream::to_generation_stats;
+using cshorelark::world_stream::to_world_info;
+using cshorelark::world_stream::world_frame;
+
+namespace {
+
+constexpr std::size_t k_test_num_foods = 7;
+constexpr std::size_t k_test_num_animals = 5;
+constexpr std::size_t k_test_generation_length = 10;
+constexpr unsigned int k_test_rng_seed = 42;
+constexpr float k_test_frame_rate = 100.0F;
+constexpr auto k_timeout = std::chrono::seconds(5);
+
+auto create_test_config() -> config {
+    config cfg;
+    cfg.world.num_foods = k_test_num_foods;
+    cfg.world.num_animals = k_test_num_animals;
+    cfg.sim.generation_length = k_test_generation_length;
+    return cfg;
+}
+
+}  // namespace
+
+TEST_CASE("Server streams frames and statistics to a localhost client",
+          "[world_stream][server]") {
+    const auto cfg = create_test_config();
+    cshorelark::random::random_generator rng(k_test_rng_seed);
+    auto sim = simulation::random(cfg, rng);
+
+    server_options options;
+    options.port = 0;
+    stream_server server(to_world_info(cfg), options);
+    const auto port = server.start();
+    REQUIRE(port.has_value());
+
+    stream_client client;
+    const auto info = client.connect("127.0.0.1", *port, k_test_frame_rate);
+    REQUIRE(info.has_value());
+    REQUIRE(info->bird_size == cfg.world.bird_size);
+    REQUIRE(client.is_connected());
+
+    // Drive the simulation until a generation completes and a frame arrives
+    world_frame received;
+    std::optional<generation_stats> stats;
+    bool got_frame = false;
+    std::uint64_t sequence = 0;
+    const auto deadline = std::chrono::steady_clock::now() + k_timeout;
+    while ((!got_frame || !stats) && std::chrono::steady_clock::now() < deadline) {
+        if (auto sim_stats = sim.step(rng)) {
+            server.publish_stats(to_generation_stats(*sim_stats));
+        }
+        auto frame = std::make_shared<world_frame>();
+        capture_frame(sim, ++sequence, *frame);
+        server.publish(std::move(frame));
+
+        got_frame = client.take_frame(received) || got_frame;
+        if (!stats) {
+            stats = client.take_stats();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    REQUIRE(got_frame);
+    REQUIRE(received.birds.size() == k_test_num_animals);
+    REQUIRE(received.foods.size() == k_test_num_foods);
+    REQUIRE(stats.has_value());
+    REQUIRE(stats->generation == 0);
+    REQUIRE(server.client_count() == 1);
+    REQUIRE(client.frames_received() > 0);
+
+    client.disconnect();
+    REQUIRE_FALSE(client.is_connected());
+}
+
+TEST_CASE("Server does not send frames to a paused client", "[world_stream][server]") {
+    const auto cfg = create_test_config();
+    cshorelark::random::random_generator rng(k_test_rng_seed);
+    auto sim = simulation::random(cfg, rng);
+
+    server_options options;
+    options.port = 0;
+    stream_server server(to_world_info(cfg), options);
+    const auto port = server.start();
+    REQUIRE(port.has_value());
+
+    stream_client client;
+    REQUIRE(client.connect("127.0.0.1", *port, 0.0F).has_value());
+
+    auto frame = std::make_shared<world_frame>();
+    capture_frame(sim, 1, *frame);
+    server.publish(std::move(frame));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    REQUIRE(client.frames_received() == 0);
+
+    // Resuming delivers the latest frame
+    client.set_frame_rate(k_test_frame_rate);
+    world_frame received;
+    const auto deadline = std::chrono::steady_clock::now() + k_timeout;
+    while (!client.take_frame(received) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE(received.sequence == 1);
+}
+
+TEST_CASE("Client reports a refused connection", "[world_stream][server]") {
+    server_options options;
+    options.port = 0;
+    std::uint16_t port = 0;
+    {
+        stream_server server(to_world_info(create_test_config()), options);
+        const auto bound = server.start();
+        REQUIRE(bound.has_value());
+        port = *bound;
+    }
+
+    stream_client client;
+    const auto info = client.connect("127.0.0.1", port, k_test_frame_rate);
+    REQUIRE_FALSE(info.has_value());
+    REQUIRE_FALSE(client.is_connected());
+}
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Builds a PGO and LTO optimized release and times it against a plain release.
+
+Both builds use the Conan toolchain of the release configuration:
+
+    conan install . --output-folder=. --build=missing -s build_type=Release
+    python3 tools/pgo_build.py
+
+The plain release goes to build/pgo-baseline and the optimized one to
+build/pgo-optimized. The training-workload target is run once in the
+instrumented build to collect profiles, then timed in both final builds.
+"""
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+
+def run(command):
+    print("+", " ".join(command), flush=True)
+    subprocess.run(command, check=True)
+
+
+def configure(source_dir, build_dir, toolchain, options):
+    command = [
+        "cmake", "-S", source_dir, "-B", build_dir,
+        "-DCMAKE_BUILD_TYPE=Release",
+        "-DENABLE_TESTING=OFF",
+        "-DENABLE_CLANG_TIDY=OFF",
+        "-DENABLE_CLANG_FORMAT=OFF",
+    ]
+    if toolchain:
+        command.append("-DCMAKE_TOOLCHAIN_FILE=" + toolchain)
+    run(command + ["-D" + option for option in options])
+
+
+def build(build_dir, jobs, target=None):
+    command = ["cmake", "--build", build_dir, "-j", str(jobs)]
+    if target:
+        command += ["--target", target]
+    run(command)
+
+
+def time_workload(build_dir, runs):
+    """Returns the fastest of several runs of the training workload, in seconds."""
+    best = None
+    for _ in range(runs):
+        start = time.perf_counter()
+        build(build_dir, 1, "training-workload")
+        elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def main():
+    workspace_root = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+    default_toolchain = os.path.join(workspace_root, "build", "Release", "generators",
+                                     "conan_toolchain.cmake")
+
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--toolchain", default=default_toolchain,
+                        help="CMake toolchain file providing the dependencies")
+    parser.add_argument("--build-root", default=os.path.join(workspace_root, "build"),
+                        help="Directory to create both build directories in")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1,
+                        help="Parallel build jobs")
+    parser.add_argument("--runs", type=int, default=3,
+                        help="Timed runs of the workload per build, the fastest counts")
+    args = parser.parse_args()
+
+    toolchain = args.toolchain if os.path.exists(args.toolchain) else None
+    if toolchain is None:
+        print(f"No toolchain at {args.toolchain}, relying on installed packages")
+
+    baseline_dir = os.path.join(args.build_root, "pgo-baseline")
+    optimized_dir = os.path.join(args.build_root, "pgo-optimized")
+    profile_dir = os.path.join(optimized_dir, "pgo-profiles")
+
+    # Plain release
+    configure(workspace_root, baseline_dir, toolchain, ["USE_LTO=OFF", "PGO_MODE=OFF"])
+    build(baseline_dir, args.jobs)
+
+    # Instrumented build, profiled on the workload. Old profiles would describe old code
+    shutil.rmtree(profile_dir, ignore_errors=True)
+    optimized_options = ["USE_LTO=ON", "PGO_PROFILE_DIR=" + profile_dir]
+    configure(workspace_root, optimized_dir, toolchain, optimized_options + ["PGO_MODE=GENERATE"])
+    build(optimized_dir, args.jobs)
+    build(optimized_dir, 1, "training-workload")
+
+    # Rebuild in the same directory with the profiles
+    configure(workspace_root, optimized_dir, toolchain, optimized_options + ["PGO_MODE=USE"])
+    build(optimized_dir, args.jobs)
+
+    baseline = time_workload(baseline_dir, args.runs)
+    optimized = time_workload(optimized_dir, args.runs)
+    print()
+    print(f"Training workload, fastest of {args.runs} runs")
+    print(f"  plain release: {baseline:8.2f} s")
+    print(f"  PGO + LTO:     {optimized:8.2f} s")
+    print(f"  speedup:       {baseline / optimized:8.2f}x")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())